@@ -0,0 +1,91 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "RTTR_Assert.h"
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace helpers {
+/// Allocator for many objects of the same type which are created and destroyed at a high rate.
+/// Memory is requested from the system in slabs of T_numObjsPerSlab objects and freed slots are kept in a free list,
+/// so allocate and deallocate are O(1) and do not touch the global heap once the pool is warm.
+/// Memory is only given back to the system when the pool is destroyed.
+template<class T, size_t T_numObjsPerSlab = 1024>
+class ObjectPool
+{
+    static_assert(T_numObjsPerSlab > 0u, "Slabs must hold at least 1 object");
+
+    union Slot
+    {
+        Slot* next;
+        std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> slabs_;
+    Slot* freeList_ = nullptr;
+    size_t numAllocated_ = 0;
+
+    void addSlab()
+    {
+        slabs_.emplace_back(new Slot[T_numObjsPerSlab]);
+        Slot* slab = slabs_.back().get();
+        // Link in reverse so slots are handed out in address order
+        for(size_t i = T_numObjsPerSlab; i-- > 0u;)
+        {
+            slab[i].next = freeList_;
+            freeList_ = &slab[i];
+        }
+    }
+
+public:
+    ObjectPool() = default;
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+    ~ObjectPool() { RTTR_Assert(numAllocated_ == 0u); }
+
+    /// Return uninitialized memory suitable for one T
+    void* allocate()
+    {
+        if(!freeList_)
+            addSlab();
+        Slot* slot = freeList_;
+        freeList_ = slot->next;
+        ++numAllocated_;
+        return &slot->storage;
+    }
+    /// Return memory acquired by allocate() to the pool. The object must already be destroyed
+    void deallocate(void* ptr) noexcept
+    {
+        if(!ptr)
+            return;
+        RTTR_Assert(numAllocated_ > 0u);
+        auto* slot = static_cast<Slot*>(ptr);
+        slot->next = freeList_;
+        freeList_ = slot;
+        --numAllocated_;
+    }
+
+    /// Number of objects currently handed out
+    size_t size() const { return numAllocated_; }
+    /// Number of objects that can be handed out without requesting more memory from the system
+    size_t capacity() const { return slabs_.size() * T_numObjsPerSlab; }
+};
+} // namespace helpers
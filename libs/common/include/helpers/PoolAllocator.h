@@ -0,0 +1,74 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "ObjectPool.h"
+#include <cstddef>
+#include <memory>
+
+namespace helpers {
+/// Stateless allocator for node based containers (e.g. std::list) which takes single elements from an ObjectPool.
+/// Each (rebound) type has its own pool shared by all containers using it, so elements can be moved freely between
+/// containers and the order of elements is unchanged compared to the standard allocator.
+/// Allocations of more than 1 element are forwarded to std::allocator.
+/// Note: The pools are not thread safe, so containers using this must only be modified from 1 thread
+template<class T>
+class PoolAllocator
+{
+public:
+    using value_type = T;
+
+    PoolAllocator() noexcept = default;
+    template<class U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept
+    {}
+
+    T* allocate(size_t n)
+    {
+        if(n == 1u)
+            return static_cast<T*>(getPool().allocate());
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* ptr, size_t n) noexcept
+    {
+        if(n == 1u)
+            getPool().deallocate(ptr);
+        else
+            std::allocator<T>().deallocate(ptr, n);
+    }
+
+    /// Pool used for all single element allocations of T
+    static ObjectPool<T>& getPool()
+    {
+        // Never destroyed as containers with static storage duration might still return their elements at exit
+        static auto* pool = new ObjectPool<T>;
+        return *pool;
+    }
+};
+
+template<class T, class U>
+bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept
+{
+    return true;
+}
+template<class T, class U>
+bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept
+{
+    return false;
+}
+} // namespace helpers
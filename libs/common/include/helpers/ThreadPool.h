@@ -0,0 +1,76 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace helpers {
+/// Fixed set of worker threads executing jobs.
+/// Either submit single jobs and wait on the returned future or let the pool run a batch of tasks via run()
+class ThreadPool
+{
+public:
+    /// Create the pool with the given number of threads. 0 = number of hardware threads
+    explicit ThreadPool(unsigned numThreads = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned getNumThreads() const { return static_cast<unsigned>(threads_.size()); }
+
+    /// Run task(taskIdx, threadIdx) for each taskIdx in [0, numTasks) and wait until all are done.
+    /// threadIdx is in [0, getNumThreads()) and unique for all concurrently running tasks,
+    /// so it can be used to access per thread state.
+    /// The first exception thrown by a task is rethrown after all tasks finished
+    void run(unsigned numTasks, const std::function<void(unsigned taskIdx, unsigned threadIdx)>& task);
+
+    /// Execute the function on one of the threads
+    template<class F>
+    std::future<std::result_of_t<F()>> submit(F&& func);
+
+private:
+    using Job = std::function<void(unsigned threadIdx)>;
+
+    void addJob(Job job);
+    void workerLoop(unsigned threadIdx);
+
+    std::vector<std::thread> threads_;
+    std::deque<Job> jobs_;
+    std::mutex mutex_;
+    std::condition_variable jobAdded_;
+    bool stop_ = false;
+};
+
+template<class F>
+std::future<std::result_of_t<F()>> ThreadPool::submit(F&& func)
+{
+    // std::function requires a copyable callable, so keep the task in a shared_ptr
+    auto job = std::make_shared<std::packaged_task<std::result_of_t<F()>()>>(std::forward<F>(func));
+    auto result = job->get_future();
+    addJob([job](unsigned) { (*job)(); });
+    return result;
+}
+} // namespace helpers
@@ -0,0 +1,111 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "helpers/ThreadPool.h"
+#include <algorithm>
+#include <exception>
+
+namespace helpers {
+
+ThreadPool::ThreadPool(unsigned numThreads)
+{
+    if(numThreads == 0u)
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    threads_.reserve(numThreads);
+    for(unsigned i = 0; i < numThreads; i++)
+        threads_.emplace_back([this, i]() { workerLoop(i); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    jobAdded_.notify_all();
+    for(std::thread& thread : threads_)
+        thread.join();
+}
+
+void ThreadPool::run(unsigned numTasks, const std::function<void(unsigned taskIdx, unsigned threadIdx)>& task)
+{
+    if(numTasks == 0u)
+        return;
+
+    struct State
+    {
+        std::mutex mutex;
+        std::condition_variable finished;
+        unsigned numOpen;
+        std::exception_ptr error;
+    };
+    State state;
+    state.numOpen = numTasks;
+
+    for(unsigned taskIdx = 0; taskIdx < numTasks; taskIdx++)
+    {
+        addJob([&state, &task, taskIdx](unsigned threadIdx) {
+            std::exception_ptr error;
+            try
+            {
+                task(taskIdx, threadIdx);
+            } catch(...)
+            {
+                error = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock(state.mutex);
+            if(error && !state.error)
+                state.error = error;
+            // Notify while holding the lock as state is destroyed as soon as the waiting thread returns
+            if(--state.numOpen == 0u)
+                state.finished.notify_one();
+        });
+    }
+
+    std::unique_lock<std::mutex> lock(state.mutex);
+    state.finished.wait(lock, [&state]() { return state.numOpen == 0u; });
+    if(state.error)
+        std::rethrow_exception(state.error);
+}
+
+void ThreadPool::addJob(Job job)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.emplace_back(std::move(job));
+    }
+    jobAdded_.notify_one();
+}
+
+void ThreadPool::workerLoop(unsigned threadIdx)
+{
+    while(true)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            jobAdded_.wait(lock, [this]() { return stop_ || !jobs_.empty(); });
+            if(jobs_.empty())
+                return;
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        job(threadIdx);
+    }
+}
+
+} // namespace helpers
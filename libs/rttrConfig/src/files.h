@@ -51,11 +51,13 @@ namespace folders {
     constexpr auto mbob = "<RTTR_GAME>/DATA/MBOB";      // nation graphics
     constexpr auto music = "<RTTR_RTTR>/MUSIC";
     constexpr auto playlists = "<RTTR_USERDATA>/playlists";
+    constexpr auto replayKeyframes = "<RTTR_USERDATA>/REPLAYS/KEYFRAMES"; // temporary snapshots for seeking
     constexpr auto replays = "<RTTR_USERDATA>/REPLAYS";
     constexpr auto save = "<RTTR_USERDATA>/SAVE";
     constexpr auto screenshots = "<RTTR_USERDATA>/screenshots";
     constexpr auto sng = "<RTTR_RTTR>/MUSIC/SNG"; // downloaded background music files
     constexpr auto texte = "<RTTR_RTTR>/texte";
+    constexpr auto textureCache = "<RTTR_USERDATA>/CACHE"; // packed textures of the last game
     constexpr auto textures = "<RTTR_GAME>/GFX/TEXTURES"; // Terrain textures
 } // namespace folders
 namespace files {
@@ -63,6 +65,7 @@ namespace files {
     constexpr auto soundOrig = "<RTTR_GAME>/DATA/SOUNDDAT/SOUND.LST"; // original sound.lst
     constexpr auto soundScript = "<RTTR_RTTR>/sound.scs";             // converter script
     constexpr auto defaultPlaylist = "<RTTR_RTTR>/MUSIC/S2_Standard.pll";
+    constexpr auto mapIndex = "<RTTR_USERDATA>/CACHE/maps.idx"; // headers of the maps in the map selection
 } // namespace files
 namespace resources {
     constexpr auto boat = "<RTTR_GAME>/DATA/BOBS/BOAT.LST";
@@ -20,14 +20,16 @@
 #include "FileChecksum.h"
 #include "Game.h"
 #include "GameObject.h"
+#include "GamePlayer.h"
 #include "random/Random.h"
 #include "s25util/Serializer.h"
 
-AsyncChecksum::AsyncChecksum() : randChecksum(0), objCt(0), objIdCt(0), eventCt(0), evInstanceCt(0) {}
+AsyncChecksum::AsyncChecksum() : randChecksum(0), objCt(0), objIdCt(0), eventCt(0), evInstanceCt(0), stateHash(0) {}
 
 AsyncChecksum::AsyncChecksum(unsigned randChecksum, unsigned objCt, unsigned objIdCt, unsigned eventCt,
-                             unsigned evInstanceCt)
-    : randChecksum(randChecksum), objCt(objCt), objIdCt(objIdCt), eventCt(eventCt), evInstanceCt(evInstanceCt)
+                             unsigned evInstanceCt, unsigned stateHash)
+    : randChecksum(randChecksum), objCt(objCt), objIdCt(objIdCt), eventCt(eventCt), evInstanceCt(evInstanceCt),
+      stateHash(stateHash)
 {}
 
 void AsyncChecksum::Serialize(Serializer& ser) const
@@ -37,6 +39,7 @@ void AsyncChecksum::Serialize(Serializer& ser) const
     ser.PushUnsignedInt(objIdCt);
     ser.PushUnsignedInt(eventCt);
     ser.PushUnsignedInt(evInstanceCt);
+    ser.PushUnsignedInt(stateHash);
 }
 
 void AsyncChecksum::Deserialize(Serializer& ser)
@@ -46,6 +49,7 @@ void AsyncChecksum::Deserialize(Serializer& ser)
     objIdCt = ser.PopUnsignedInt();
     eventCt = ser.PopUnsignedInt();
     evInstanceCt = ser.PopUnsignedInt();
+    stateHash = ser.PopUnsignedInt();
 }
 
 unsigned AsyncChecksum::getHash() const
@@ -57,6 +61,10 @@ unsigned AsyncChecksum::getHash() const
 
 AsyncChecksum AsyncChecksum::create(const Game& game)
 {
+    // Both parts are kept up to date on changes so this is cheap
+    unsigned stateHash = game.world_.GetStateHash().GetHash();
+    for(unsigned i = 0; i < game.world_.GetNumPlayers(); i++)
+        stateHash = WorldStateHash::Combine(stateHash, game.world_.GetPlayer(i).GetInventoryHash());
     return AsyncChecksum(RANDOM.GetChecksum(), GameObject::GetNumObjs(), GameObject::GetObjIDCounter(),
-                         game.em_->GetNumActiveEvents(), game.em_->GetEventInstanceCtr());
+                         game.em_->GetNumActiveEvents(), game.em_->GetEventInstanceCtr(), stateHash);
 }
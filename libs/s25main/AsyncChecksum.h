@@ -26,8 +26,11 @@ struct AsyncChecksum
     unsigned randChecksum;
     unsigned objCt, objIdCt;
     unsigned eventCt, evInstanceCt;
+    /// Hash of the world state (owners, objects, roads) and the inventories of all players
+    unsigned stateHash;
     AsyncChecksum();
-    AsyncChecksum(unsigned randChecksum, unsigned objCt, unsigned objIdCt, unsigned eventCt, unsigned evInstanceCt);
+    AsyncChecksum(unsigned randChecksum, unsigned objCt, unsigned objIdCt, unsigned eventCt, unsigned evInstanceCt,
+                  unsigned stateHash);
     void Serialize(Serializer& ser) const;
     void Deserialize(Serializer& ser);
     /// Get a hash for this checksum
@@ -42,7 +45,7 @@ struct AsyncChecksum
 inline bool AsyncChecksum::operator==(const AsyncChecksum& rhs) const
 {
     return randChecksum == rhs.randChecksum && objCt == rhs.objCt && objIdCt == rhs.objIdCt && eventCt == rhs.eventCt
-           && evInstanceCt == rhs.evInstanceCt;
+           && evInstanceCt == rhs.evInstanceCt && stateHash == rhs.stateHash;
 }
 
 inline bool AsyncChecksum::operator!=(const AsyncChecksum& rhs) const
@@ -0,0 +1,69 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "AsyncSaveWriter.h"
+#include "Savegame.h"
+#include <chrono>
+#include <exception>
+
+AsyncSaveWriter::AsyncSaveWriter() : progress(0) {}
+
+AsyncSaveWriter::~AsyncSaveWriter()
+{
+    Wait();
+}
+
+void AsyncSaveWriter::Start(std::unique_ptr<Savegame> save, const boost::filesystem::path& filepath,
+                            const std::string& mapName)
+{
+    Wait();
+    progress = 0;
+    // The savegame is owned by the task. Shared pointer as the lambda must be copyable
+    std::shared_ptr<Savegame> sharedSave(std::move(save));
+    pendingResult = std::async(std::launch::async, [this, sharedSave, filepath, mapName]() {
+        Result result{filepath, false, ""};
+        try
+        {
+            result.success = sharedSave->Save(filepath, mapName, [this](unsigned percent) { progress = percent; });
+            if(!result.success)
+                result.errorMsg = "Could not write to " + filepath.string();
+        } catch(const std::exception& e)
+        {
+            result.errorMsg = e.what();
+        }
+        progress = 100;
+        return result;
+    });
+}
+
+bool AsyncSaveWriter::IsBusy() const
+{
+    return pendingResult.valid() && pendingResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+boost::optional<AsyncSaveWriter::Result> AsyncSaveWriter::FetchResult()
+{
+    if(!pendingResult.valid() || IsBusy())
+        return boost::none;
+    return pendingResult.get();
+}
+
+void AsyncSaveWriter::Wait()
+{
+    if(pendingResult.valid())
+        pendingResult.wait();
+}
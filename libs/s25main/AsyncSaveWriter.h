@@ -0,0 +1,60 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <string>
+
+class Savegame;
+
+/// Writes savegames to disk on a background thread, so the game loop does not stall while the file is written.
+/// Saving is split into 2 phases: The snapshot of the game is taken on the game thread into the Savegame
+/// which is then passed to this class to be written in the background.
+class AsyncSaveWriter
+{
+public:
+    struct Result
+    {
+        boost::filesystem::path filepath;
+        bool success;
+        std::string errorMsg;
+    };
+
+    AsyncSaveWriter();
+    /// Waits for a save in progress
+    ~AsyncSaveWriter();
+
+    /// Start writing the savegame. If another save is still in progress, this waits for it first
+    void Start(std::unique_ptr<Savegame> save, const boost::filesystem::path& filepath, const std::string& mapName);
+    /// Return true if a save is currently being written
+    bool IsBusy() const;
+    /// Progress of the current save in percent
+    unsigned GetProgress() const { return progress; }
+    /// Return the result of the last save if it finished and was not fetched yet
+    boost::optional<Result> FetchResult();
+    /// Block until the current save (if any) is written. The result can then be fetched
+    void Wait();
+
+private:
+    std::future<Result> pendingResult;
+    std::atomic<unsigned> progress;
+};
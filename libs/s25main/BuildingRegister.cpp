@@ -57,6 +57,8 @@ void BuildingRegister::Deserialize(SerializedGameData& sgd)
         sgd.PopObjectContainer(military_buildings, GO_Type::NobMilitary);
     } else if(sgd.GetGameDataVersion() >= 2)
         Deserialize2(sgd);
+    productivitiesValid_ = false;
+    wareClientsValid_ = false;
 }
 
 void BuildingRegister::Deserialize2(SerializedGameData& sgd)
@@ -66,6 +68,8 @@ void BuildingRegister::Deserialize2(SerializedGameData& sgd)
         sgd.PopObjectContainer(buildings[BuildingType(i)], GO_Type::NobUsual);
     sgd.PopObjectContainer(building_sites, GO_Type::Buildingsite);
     sgd.PopObjectContainer(military_buildings, GO_Type::NobMilitary);
+    productivitiesValid_ = false;
+    wareClientsValid_ = false;
 }
 
 void BuildingRegister::Add(noBuildingSite* building_site)
@@ -94,6 +98,8 @@ void BuildingRegister::Add(noBuilding* bld, BuildingType bldType)
     {
         RTTR_Assert(!helpers::contains(buildings[bldType], bld));
         buildings[bldType].push_back(static_cast<nobUsual*>(bld));
+        AddProductivity(*static_cast<nobUsual*>(bld), 1);
+        UpdateWareDemand(*static_cast<nobUsual*>(bld));
     }
     if(bldType == BuildingType::HarborBuilding)
     {
@@ -116,6 +122,8 @@ void BuildingRegister::Remove(noBuilding* bld, BuildingType bldType)
     {
         RTTR_Assert(helpers::contains(buildings[bldType], bld));
         buildings[bldType].remove(static_cast<nobUsual*>(bld));
+        AddProductivity(*static_cast<nobUsual*>(bld), -1);
+        RemoveWareClient(*static_cast<nobUsual*>(bld));
     }
     if(bldType == BuildingType::HarborBuilding)
     {
@@ -177,19 +185,113 @@ unsigned BuildingRegister::CalcAverageProductivity(BuildingType bldType) const
 
 unsigned short BuildingRegister::CalcAverageProductivity() const
 {
-    unsigned totalProductivity = 0;
-    unsigned numBlds = 0;
+    if(!productivitiesValid_)
+        RecalcTotalProductivity();
+    if(numProducers_ == 0)
+        return 0;
+    return totalProductivity_ / numProducers_;
+}
+
+void BuildingRegister::ProductivityChanged(BuildingType bldType, unsigned short oldProductivity,
+                                           unsigned short newProductivity)
+{
+    if(!productivitiesValid_ || !BLD_WORK_DESC[bldType].producedWare)
+        return;
+    RTTR_Assert(totalProductivity_ >= oldProductivity);
+    totalProductivity_ = totalProductivity_ - oldProductivity + newProductivity;
+}
+
+void BuildingRegister::RecalcTotalProductivity() const
+{
+    totalProductivity_ = 0;
+    numProducers_ = 0;
     for(const auto bldType : helpers::enumRange<BuildingType>())
     {
         if(!BLD_WORK_DESC[bldType].producedWare)
             continue;
 
         for(const nobUsual* bld : GetBuildings(bldType))
-            totalProductivity += bld->GetProductivity();
+            totalProductivity_ += bld->GetProductivity();
 
-        numBlds += GetBuildings(bldType).size();
+        numProducers_ += GetBuildings(bldType).size();
+    }
+    productivitiesValid_ = true;
+}
+
+void BuildingRegister::AddProductivity(const nobUsual& bld, int sign)
+{
+    if(!productivitiesValid_ || !BLD_WORK_DESC[bld.GetBuildingType()].producedWare)
+        return;
+    if(sign > 0)
+    {
+        totalProductivity_ += bld.GetProductivity();
+        ++numProducers_;
+    } else
+    {
+        RTTR_Assert(totalProductivity_ >= bld.GetProductivity() && numProducers_ > 0);
+        totalProductivity_ -= bld.GetProductivity();
+        --numProducers_;
+    }
+}
+
+const std::vector<nobUsual*>& BuildingRegister::GetWareClients(const GoodType ware) const
+{
+    if(!wareClientsValid_)
+        RecalcWareClients();
+    return wareClients_[ware];
+}
+
+void BuildingRegister::UpdateWareDemand(nobUsual& bld)
+{
+    if(!wareClientsValid_)
+        return;
+    RTTR_Assert(helpers::contains(buildings[bld.GetBuildingType()], &bld));
+    for(const GoodType ware : BLD_WORK_DESC[bld.GetBuildingType()].waresNeeded)
+    {
+        std::vector<nobUsual*>& clients = wareClients_[ware];
+        const bool isNeeded = bld.CalcDistributionPoints(nullptr, ware) != 0;
+        const auto it = helpers::find(clients, &bld);
+        if(isNeeded && it == clients.end())
+            clients.push_back(&bld);
+        else if(!isNeeded && it != clients.end())
+        {
+            // Order does not matter, so swap with the last one to avoid moving all elements
+            *it = clients.back();
+            clients.pop_back();
+        }
+    }
+}
+
+void BuildingRegister::RecalcWareClients() const
+{
+    for(auto& clients : wareClients_)
+        clients.clear();
+    for(const auto bldType : helpers::enumRange<BuildingType>())
+    {
+        for(nobUsual* bld : buildings[bldType])
+        {
+            for(const GoodType ware : BLD_WORK_DESC[bldType].waresNeeded)
+            {
+                if(bld->CalcDistributionPoints(nullptr, ware) != 0)
+                    wareClients_[ware].push_back(bld);
+            }
+        }
+    }
+    wareClientsValid_ = true;
+}
+
+void BuildingRegister::RemoveWareClient(nobUsual& bld)
+{
+    if(!wareClientsValid_)
+        return;
+    for(const GoodType ware : BLD_WORK_DESC[bld.GetBuildingType()].waresNeeded)
+    {
+        std::vector<nobUsual*>& clients = wareClients_[ware];
+        const auto it = helpers::find(clients, &bld);
+        if(it != clients.end())
+        {
+            *it = clients.back();
+            clients.pop_back();
+        }
     }
-    if(numBlds == 0)
-        return 0;
-    return totalProductivity / numBlds;
 }
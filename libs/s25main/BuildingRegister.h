@@ -17,7 +17,9 @@
 
 #pragma once
 
+#include "helpers/EnumArray.h"
 #include "gameTypes/BuildingCount.h"
+#include "gameTypes/GoodTypes.h"
 #include <list>
 #include <vector>
 
@@ -58,6 +60,12 @@ public:
     unsigned CalcAverageProductivity(BuildingType bldType) const;
     /// Calculate the average productivity for all buildings
     unsigned short CalcAverageProductivity() const;
+    /// Must be called when the productivity of a registered building changed
+    void ProductivityChanged(BuildingType bldType, unsigned short oldProductivity, unsigned short newProductivity);
+    /// Return all usual buildings which currently need wares of the given type (in no particular order)
+    const std::vector<nobUsual*>& GetWareClients(GoodType ware) const;
+    /// Must be called when the wares needed by a registered building might have changed
+    void UpdateWareDemand(nobUsual& bld);
 
 private:
     std::list<noBuildingSite*> building_sites;
@@ -66,4 +74,17 @@ private:
     std::list<nobMilitary*> military_buildings;
     std::list<nobHarborBuilding*> harbors;
     std::list<nobBaseWarehouse*> warehouses;
+    /// Sum of the productivities and number of the buildings producing wares to avoid iterating over all buildings.
+    /// Recalculated on first use after loading as the buildings might not be fully loaded during deserialization
+    mutable unsigned totalProductivity_ = 0, numProducers_ = 0;
+    mutable bool productivitiesValid_ = true;
+
+    /// Usual buildings needing each ware type. Also recalculated on first use after loading
+    mutable helpers::EnumArray<std::vector<nobUsual*>, GoodType> wareClients_;
+    mutable bool wareClientsValid_ = true;
+
+    void RecalcTotalProductivity() const;
+    void AddProductivity(const nobUsual& bld, int sign);
+    void RecalcWareClients() const;
+    void RemoveWareClient(nobUsual& bld);
 };
@@ -293,10 +293,9 @@ bool DebugInfo::SendReplay()
         if(!rpl || !rpl->IsRecording())
             return true;
 
+        rpl->Flush();
         BinaryFile& f = rpl->GetFile();
 
-        f.Flush();
-
         if(!SendString("Replay"))
             return false;
         if(SendFile(f))
@@ -22,6 +22,42 @@
 #include "helpers/containerUtils.h"
 #include "s25util/Log.h"
 #include <mygettext/mygettext.h>
+#include <algorithm>
+
+void EventManager::EventList::push_back(const GameEvent* ev)
+{
+    RTTR_Assert(!ev->prevInList && !ev->nextInList);
+    ev->prevInList = last_;
+    if(last_)
+        last_->nextInList = ev;
+    else
+        first_ = ev;
+    last_ = ev;
+}
+
+void EventManager::EventList::erase(const GameEvent* ev)
+{
+    if(ev->prevInList)
+        ev->prevInList->nextInList = ev->nextInList;
+    else
+    {
+        RTTR_Assert(first_ == ev);
+        first_ = ev->nextInList;
+    }
+    if(ev->nextInList)
+        ev->nextInList->prevInList = ev->prevInList;
+    else
+    {
+        RTTR_Assert(last_ == ev);
+        last_ = ev->prevInList;
+    }
+    ev->prevInList = ev->nextInList = nullptr;
+}
+
+bool EventManager::EventList::contains(const GameEvent* ev) const
+{
+    return ev->prevInList ? ev->prevInList->nextInList == ev : first_ == ev;
+}
 
 EventManager::EventManager(unsigned startGF)
     : numActiveEvents(0), eventInstanceCtr(1), currentGF(startGF), curActiveEvent(nullptr)
@@ -32,18 +68,33 @@ EventManager::~EventManager()
     Clear();
 }
 
+template<class T_Func>
+void EventManager::ForEachEventList(T_Func&& func) const
+{
+    for(const EventList& events : gfEvents)
+        func(events);
+    for(const EventList& events : blockEvents)
+        func(events);
+    for(const auto& it : farEvents)
+        func(it.second);
+}
+
 void EventManager::Clear()
 {
-    for(auto& event : events)
-    {
-        for(const GameEvent* ev : event.second)
+    ForEachEventList([this](const EventList& events) {
+        const GameEvent* ev = events.front();
+        while(ev)
         {
+            const GameEvent* nextEv = ev->nextInList;
             delete ev;
             RTTR_Assert(numActiveEvents > 0u);
             numActiveEvents--;
+            ev = nextEv;
         }
-    }
-    events.clear();
+    });
+    gfEvents.fill(EventList());
+    blockEvents.fill(EventList());
+    farEvents.clear();
     RTTR_Assert(numActiveEvents == 0u);
 
     for(auto& it : killList)
@@ -60,11 +111,21 @@ void EventManager::Clear()
     eventInstanceCtr = 1u;
 }
 
+EventManager::EventList& EventManager::GetEventList(unsigned targetGF)
+{
+    RTTR_Assert(targetGF >= currentGF);
+    if(targetGF / numSlotsPerLevel == currentGF / numSlotsPerLevel)
+        return gfEvents[targetGF % numSlotsPerLevel];
+    if(targetGF / numGFsPerSuperblock == currentGF / numGFsPerSuperblock)
+        return blockEvents[(targetGF / numSlotsPerLevel) % numSlotsPerLevel];
+    return farEvents[targetGF];
+}
+
 const GameEvent* EventManager::AddEventToQueue(const GameEvent* event)
 {
     // Should be in the future!
     RTTR_Assert(event->GetTargetGF() > currentGF);
-    events[event->GetTargetGF()].push_back(event);
+    GetEventList(event->GetTargetGF()).push_back(event);
     ++numActiveEvents;
     return event;
 }
@@ -97,10 +158,87 @@ void EventManager::ExecuteNextGF()
 {
     currentGF++;
 
+    CascadeEvents();
     ExecuteCurrentEvents();
     DestroyCurrentObjects();
 }
 
+void EventManager::RescheduleEvents(EventList& events)
+{
+    while(!events.empty())
+    {
+        const GameEvent* ev = events.front();
+        events.erase(ev);
+        EventList& newEvents = GetEventList(ev->GetTargetGF());
+        RTTR_Assert(&newEvents != &events);
+        newEvents.push_back(ev);
+    }
+}
+
+void EventManager::CascadeEvents()
+{
+    if(currentGF % numSlotsPerLevel != 0u)
+        return;
+    // Order is important: Events of the new superblock must be in the wheel before the new block is filled
+    if(currentGF % numGFsPerSuperblock == 0u)
+    {
+        const unsigned superblock = currentGF / numGFsPerSuperblock;
+        for(auto it = farEvents.begin(); it != farEvents.end() && it->first / numGFsPerSuperblock == superblock;
+            it = farEvents.erase(it))
+        {
+            RescheduleEvents(it->second);
+        }
+    }
+    RescheduleEvents(blockEvents[(currentGF / numSlotsPerLevel) % numSlotsPerLevel]);
+}
+
+void EventManager::SkipToGF(unsigned gf)
+{
+    RTTR_Assert(gf >= currentGF);
+    RTTR_Assert(!curActiveEvent);
+    // Same block -> No events need to be moved
+    if(gf / numSlotsPerLevel == currentGF / numSlotsPerLevel || numActiveEvents == 0u)
+    {
+        RTTR_Assert(numActiveEvents == 0u || GetNextEventGF() >= gf);
+        currentGF = gf;
+        return;
+    }
+    const std::vector<const GameEvent*> allEvents = GetEvents();
+    RTTR_Assert(allEvents.front()->GetTargetGF() >= gf);
+    for(const GameEvent* ev : allEvents)
+        ev->prevInList = ev->nextInList = nullptr;
+    gfEvents.fill(EventList());
+    blockEvents.fill(EventList());
+    farEvents.clear();
+    currentGF = gf;
+    for(const GameEvent* ev : allEvents)
+        GetEventList(ev->GetTargetGF()).push_back(ev);
+}
+
+unsigned EventManager::GetNextEventGF() const
+{
+    const unsigned curBlock = currentGF / numSlotsPerLevel;
+    for(unsigned gf = currentGF; gf / numSlotsPerLevel == curBlock; ++gf)
+    {
+        if(!gfEvents[gf % numSlotsPerLevel].empty())
+            return gf;
+    }
+    // Blocks of the current superblock. Each contains events of multiple GFs
+    for(unsigned block = curBlock + 1u; block % numSlotsPerLevel != 0u; ++block)
+    {
+        const EventList& events = blockEvents[block % numSlotsPerLevel];
+        if(events.empty())
+            continue;
+        unsigned nextGF = events.front()->GetTargetGF();
+        for(const GameEvent* ev = events.front(); ev; ev = ev->nextInList)
+            nextGF = std::min(nextGF, ev->GetTargetGF());
+        return nextGF;
+    }
+    if(!farEvents.empty())
+        return farEvents.begin()->first;
+    return 0;
+}
+
 void EventManager::DestroyCurrentObjects()
 {
     // Remove all objects
@@ -120,44 +258,39 @@ void EventManager::DestroyCurrentObjects()
 std::vector<const GameEvent*> EventManager::GetEvents() const
 {
     std::vector<const GameEvent*> nextEv;
-    for(const auto& event : events)
-        nextEv.insert(nextEv.end(), event.second.begin(), event.second.end());
+    nextEv.reserve(numActiveEvents);
+    ForEachEventList([&nextEv](const EventList& events) {
+        for(const GameEvent* ev = events.front(); ev; ev = ev->nextInList)
+            nextEv.push_back(ev);
+    });
+    // All events of a GF are in the same list in the order they were added, so a stable sort yields execution order
+    std::stable_sort(nextEv.begin(), nextEv.end(), [](const GameEvent* lhs, const GameEvent* rhs) {
+        return lhs->GetTargetGF() < rhs->GetTargetGF();
+    });
     return nextEv;
 }
 
 void EventManager::ExecuteCurrentEvents()
 {
-    if(events.empty())
-        return;
-    // Get list of events to be executed next
-    auto itCurEvents = events.begin();
-
-    RTTR_Assert(itCurEvents->first >= currentGF);
-
-    if(itCurEvents->first == currentGF)
-        ExecuteEvents(itCurEvents);
-}
-
-void EventManager::ExecuteEvents(const EventMap::iterator& itEvents)
-{
-    EventList& curEvents = itEvents->second;
-    // We have to allow 2 cases:
-    // 1) Adding of events to current GF -> std::list allows this without invalidating any iterators
-    // 2) Checking for events -> Remove all deleted events so only valid ones are in the list
-    for(auto e_it = curEvents.begin(); e_it != curEvents.end(); e_it = curEvents.erase(e_it))
+    EventList& curEvents = gfEvents[currentGF % numSlotsPerLevel];
+    // Events of the current GF may be removed while executing (Event A can cause Event B in the same GF to be removed)
+    // but none can be added. As the active event cannot be removed it stays at the front until it is done.
+    while(!curEvents.empty())
     {
-        const GameEvent* ev = *e_it;
+        const GameEvent* ev = curEvents.front();
+        RTTR_Assert(ev->GetTargetGF() == currentGF);
         RTTR_Assert(ev->obj);
         RTTR_Assert(ev->obj->GetObjId() <= GameObject::GetObjIDCounter());
 
         curActiveEvent = ev;
         ev->obj->HandleEvent(ev->id);
+        RTTR_Assert(curEvents.front() == ev);
+        curEvents.erase(ev);
 
         delete ev;
         --numActiveEvents;
     }
     curActiveEvent = nullptr;
-    events.erase(itEvents);
 }
 
 void EventManager::Serialize(SerializedGameData& sgd) const
@@ -196,30 +329,24 @@ void EventManager::Deserialize(SerializedGameData& sgd)
         boost::format eventCtError(_("Event count mismatch. Read events: %1%. Expected: %2%.\n"));
         throw SerializedGameData::Error((eventCtError % numActiveEvents % numEvents).str());
     }
-    for(const auto& it : events)
+    for(const GameEvent* ev : GetEvents())
     {
-        for(const GameEvent* ev : it.second)
+        if(ev->GetInstanceId() >= eventInstanceCtr)
         {
-            if(ev->GetInstanceId() >= eventInstanceCtr)
-            {
-                boost::format eventIdError(_("Invalid event instance id. Found: %1%. Expected less than %2%.\n"));
-                throw SerializedGameData::Error((eventIdError % ev->GetInstanceId() % eventInstanceCtr).str());
-            }
+            boost::format eventIdError(_("Invalid event instance id. Found: %1%. Expected less than %2%.\n"));
+            throw SerializedGameData::Error((eventIdError % ev->GetInstanceId() % eventInstanceCtr).str());
         }
     }
 }
 
 bool EventManager::ObjectHasEvents(const GameObject& obj)
 {
-    for(auto& event : events)
-    {
-        for(const GameEvent* ev : event.second)
-        {
-            if(ev->obj == &obj)
-                return true;
-        }
-    }
-    return false;
+    bool found = false;
+    ForEachEventList([&found, &obj](const EventList& events) {
+        for(const GameEvent* ev = events.front(); ev && !found; ev = ev->nextInList)
+            found = ev->obj == &obj;
+    });
+    return found;
 }
 
 bool EventManager::IsObjectInKillList(const GameObject& obj)
@@ -246,31 +373,40 @@ void EventManager::RemoveEvent(const GameEvent*& ep)
 void EventManager::RemoveEventFromQueue(const GameEvent& event)
 {
     RTTR_Assert(curActiveEvent != &event);
-    auto itEventsAtTime = events.find(event.GetTargetGF());
-    if(itEventsAtTime != events.end())
+    const unsigned targetGF = event.GetTargetGF();
+    if(targetGF < currentGF)
     {
-        EventList& eventsAtTime = itEventsAtTime->second;
-        auto e_it = helpers::find(eventsAtTime, &event);
-        if(e_it != eventsAtTime.end())
-        {
-            eventsAtTime.erase(e_it);
-            --numActiveEvents;
-            RTTR_Assert(!helpers::contains(eventsAtTime, &event)); // Event existed multiple times?
-        } else
+        RTTR_Assert(false);
+        LOG.write("Bug detected: GF of event to be removed did not exist");
+        return;
+    }
+    EventList* eventsAtTime;
+    auto itFarEvents = farEvents.end();
+    if(targetGF / numGFsPerSuperblock != currentGF / numGFsPerSuperblock)
+    {
+        itFarEvents = farEvents.find(targetGF);
+        if(itFarEvents == farEvents.end())
         {
             RTTR_Assert(false);
-            LOG.write("Bug detected: Event to be removed did not exist");
+            LOG.write("Bug detected: GF of event to be removed did not exist");
+            return;
         }
+        eventsAtTime = &itFarEvents->second;
+    } else
+        eventsAtTime = &GetEventList(targetGF);
 
-        // Note: Removing this is possible, as it cannot be the currently processed list
-        //       because there is always the curActiveEvent left, which cannot be removed (check above)
-        if(eventsAtTime.empty())
-            events.erase(itEventsAtTime);
+    if(eventsAtTime->contains(&event))
+    {
+        eventsAtTime->erase(&event);
+        --numActiveEvents;
     } else
     {
         RTTR_Assert(false);
-        LOG.write("Bug detected: GF of event to be removed did not exist");
+        LOG.write("Bug detected: Event to be removed did not exist");
     }
+
+    if(itFarEvents != farEvents.end() && itFarEvents->second.empty())
+        farEvents.erase(itFarEvents);
 }
 
 void EventManager::AddToKillList(GameObject* obj)
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <array>
 #include <list>
 #include <map>
 #include <vector>
@@ -65,25 +66,57 @@ public:
     bool IsObjectInKillList(const GameObject& obj);
 
 protected:
-    // Use list to allow removing of events while iterating (Event A can cause Event B in the same GF to be removed)
-    using EventList = std::list<const GameEvent*>;
-    using EventMap = std::map<unsigned, EventList>;
+    /// Intrusive list of events scheduled for the same slot. Allows O(1) removal and keeps insertion order
+    class EventList
+    {
+        const GameEvent* first_ = nullptr;
+        const GameEvent* last_ = nullptr;
+
+    public:
+        bool empty() const { return first_ == nullptr; }
+        const GameEvent* front() const { return first_; }
+        void push_back(const GameEvent* ev);
+        void erase(const GameEvent* ev);
+        /// Check if the event is linked into this list (only valid for events not linked into another list)
+        bool contains(const GameEvent* ev) const;
+    };
+    /// Events are stored in a 2 level timing wheel: Level 0 has 1 slot per GF for all events in the same block of
+    /// numSlotsPerLevel GFs as the current GF. Level 1 has 1 slot per block for all events in the same superblock of
+    /// numSlotsPerLevel^2 GFs. Later events are kept in a map and moved into the wheel when their superblock starts.
+    /// Events of the same GF are always in the same list so they are executed in the order they were added.
+    static constexpr unsigned numSlotsPerLevel = 256;
+    static constexpr unsigned numGFsPerSuperblock = numSlotsPerLevel * numSlotsPerLevel;
+    using EventWheel = std::array<EventList, numSlotsPerLevel>;
+    using FarEventMap = std::map<unsigned, EventList>;
     // Use list to allow adding events while iterating (Destroying 1 object may lead to destruction of another)
     using GameObjList = std::list<GameObject*>;
     unsigned numActiveEvents;
     /// Instances created. Must be != 0
     unsigned eventInstanceCtr;
     unsigned currentGF;
-    EventMap events;      /// Mapping of GF to Events to be executed in this GF
-    GameObjList killList; /// Objects that will be killed after current GF
+    EventWheel gfEvents;    /// Level 0: Events of the current block by GF
+    EventWheel blockEvents; /// Level 1: Events of the current superblock by block
+    FarEventMap farEvents;  /// Events after the current superblock by GF
+    GameObjList killList;   /// Objects that will be killed after current GF
     const GameEvent* curActiveEvent;
 
     const GameEvent* AddEventToQueue(const GameEvent* event);
     void RemoveEventFromQueue(const GameEvent& event);
+    /// Return the list the event with the given target GF belongs to (based on the current GF)
+    EventList& GetEventList(unsigned targetGF);
+    /// Move all events of the given list to the list they belong to now, keeping their order
+    void RescheduleEvents(EventList& events);
+    /// Move events from the upper levels to the lower levels when the current GF starts a new block
+    void CascadeEvents();
+    /// Set the current GF to the given value which must not be after the next event. SLOW!
+    void SkipToGF(unsigned gf);
+    /// Return the GF of the next event to be executed or 0 if there are no events
+    unsigned GetNextEventGF() const;
+    /// Call the function for each list of events (in no particular order)
+    template<class T_Func>
+    void ForEachEventList(T_Func&& func) const;
     /// Execute all events of the current GF
     void ExecuteCurrentEvents();
-    /// Execute the events from the given iterator
-    void ExecuteEvents(const EventMap::iterator& itEvents);
     /// Destroy all objects in the kill list
     void DestroyCurrentObjects();
     /// Get all events in the order they will be processed
@@ -22,8 +22,10 @@
 #include "addons/AddonEconomyModeGameLength.h"
 #include "addons/const_addons.h"
 #include "ai/AIPlayer.h"
+#include "helpers/ThreadPool.h"
 #include "lua/LuaInterfaceGame.h"
 #include "network/GameClient.h"
+#include "pathfinding/ThreadPathFinders.h"
 #include "gameData/GameConsts.h"
 #include <boost/optional.hpp>
 
@@ -104,6 +106,41 @@ void Game::RunGF()
         CheckObjective();
 }
 
+void Game::RunAIs(unsigned gf, bool gfisnwf)
+{
+    if(!aiThreadPool_ || aiPlayers_.size() < 2u)
+    {
+        for(AIPlayer& ai : aiPlayers_)
+            ai.RunGF(gf, gfisnwf);
+        return;
+    }
+    // The AIs only read the world and collect their commands and chat messages, so they can run concurrently.
+    // Path finding uses search state in the path finders and road nodes, so give each thread its own path finders
+    if(aiPathFinders_.empty())
+    {
+        for(unsigned i = 0; i < aiThreadPool_->getNumThreads(); i++)
+            aiPathFinders_.push_back(std::make_unique<ThreadPathFinders>(world_));
+    } else
+    {
+        // The road networks might have changed since the last run
+        for(auto& pathFinders : aiPathFinders_)
+            pathFinders->Update();
+    }
+    aiThreadPool_->run(aiPlayers_.size(), [this, gf, gfisnwf](unsigned aiIdx, unsigned threadIdx) {
+        ThreadPathFinders::Scope pathFinderScope(*aiPathFinders_[threadIdx]);
+        aiPlayers_[aiIdx].RunGF(gf, gfisnwf);
+    });
+}
+
+void Game::SetNumAIThreads(unsigned numThreads)
+{
+    aiPathFinders_.clear();
+    if(numThreads <= 1u)
+        aiThreadPool_.reset();
+    else
+        aiThreadPool_ = std::make_unique<helpers::ThreadPool>(numThreads);
+}
+
 void Game::StatisticStep()
 {
     for(unsigned i = 0; i < world_.GetNumPlayers(); ++i)
@@ -21,8 +21,13 @@
 #include "world/GameWorld.h"
 #include <boost/ptr_container/ptr_vector.hpp>
 #include <memory>
+#include <vector>
 
 class AIPlayer;
+class ThreadPathFinders;
+namespace helpers {
+class ThreadPool;
+}
 
 /// Holds all data for a running game
 class Game
@@ -39,7 +44,13 @@ public:
 
     /// Does the remaining initializations for starting the game
     void Start(bool startFromSave);
+    /// Mark a game restored from a snapshot of a running game as started without executing the start logic again
+    void MarkStarted() { started_ = true; }
     void RunGF();
+    /// Let all AI players do their work for the current GF. This does not change the world
+    void RunAIs(unsigned gf, bool gfisnwf);
+    /// Set the number of threads used to run the AIs. 0 or 1 runs them sequentially on the game thread
+    void SetNumAIThreads(unsigned numThreads);
     bool IsStarted() const { return started_; }
     bool IsGameFinished() const { return finished_; }
     AIPlayer* GetAIPlayer(unsigned id);
@@ -51,4 +62,8 @@ private:
     /// Check if the objective was reached (if set)
     void CheckObjective();
     bool started_, finished_;
+    /// Threads for running the AIs, if enabled
+    std::unique_ptr<helpers::ThreadPool> aiThreadPool_;
+    /// Path finders for each thread of the pool
+    std::vector<std::unique_ptr<ThreadPathFinders>> aiPathFinders_;
 };
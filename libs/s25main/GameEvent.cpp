@@ -18,6 +18,17 @@
 #include "GameEvent.h"
 #include "GameObject.h"
 #include "SerializedGameData.h"
+#include "helpers/ObjectPool.h"
+#include <new>
+
+namespace {
+helpers::ObjectPool<GameEvent>& getEventPool()
+{
+    // Never destroyed: Events might still be freed during static destruction (e.g. by singletons)
+    static auto* pool = new helpers::ObjectPool<GameEvent>;
+    return *pool;
+}
+} // namespace
 
 GameEvent::GameEvent(unsigned instanceId, GameObject* obj, unsigned startGF, unsigned length, unsigned id)
     : instanceId(instanceId), obj(obj), startGF(startGF), length(length), id(id)
@@ -40,3 +51,19 @@ void GameEvent::Serialize(SerializedGameData& sgd) const
     sgd.PushUnsignedInt(length);
     sgd.PushUnsignedInt(id);
 }
+
+void* GameEvent::operator new(std::size_t size)
+{
+    // Derived classes would be bigger than the pooled slots
+    if(size != sizeof(GameEvent))
+        return ::operator new(size);
+    return getEventPool().allocate();
+}
+
+void GameEvent::operator delete(void* ptr, std::size_t size) noexcept
+{
+    if(size != sizeof(GameEvent))
+        ::operator delete(ptr);
+    else
+        getEventPool().deallocate(ptr);
+}
@@ -17,12 +17,20 @@
 
 #pragma once
 
+#include <cstddef>
+
 class GameObject;
 class SerializedGameData;
 
 class GameEvent
 {
+    friend class EventManager;
+
     const unsigned instanceId; /// unique ID
+    /// Neighbours in the list of events scheduled for the same slot. Only managed by the EventManager
+    mutable const GameEvent* prevInList = nullptr;
+    mutable const GameEvent* nextInList = nullptr;
+
 public:
     /// Object that will handle this event
     GameObject* obj;
@@ -37,6 +45,10 @@ public:
     GameEvent(SerializedGameData& sgd, unsigned instanceId);
     void Serialize(SerializedGameData& sgd) const;
 
+    /// Events are created and destroyed at a very high rate, so they are allocated from a pool
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size) noexcept;
+
     /// Return GF at which this event will be executed
     unsigned GetTargetGF() const { return startGF + length; }
     unsigned GetInstanceId() const { return instanceId; }
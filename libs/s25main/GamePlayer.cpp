@@ -29,6 +29,7 @@
 #include "buildings/nobHarborBuilding.h"
 #include "buildings/nobMilitary.h"
 #include "buildings/nobUsual.h"
+#include "enum_cast.hpp"
 #include "figures/nofCarrier.h"
 #include "figures/nofFlagWorker.h"
 #include "helpers/containerUtils.h"
@@ -42,6 +43,7 @@
 #include "variant.h"
 #include "world/GameWorldGame.h"
 #include "world/TradeRoute.h"
+#include "world/WorldStateHash.h"
 #include "nodeObjs/noFlag.h"
 #include "nodeObjs/noShip.h"
 #include "gameTypes/BuildingCount.h"
@@ -56,6 +58,7 @@
 #include "gameData/ShieldConsts.h"
 #include "gameData/ToolConsts.h"
 #include "s25util/Log.h"
+#include <algorithm>
 #include <limits>
 
 GamePlayer::GamePlayer(unsigned playerId, const PlayerInfo& playerInfo, GameWorldGame& gwg)
@@ -72,12 +75,9 @@ GamePlayer::GamePlayer(unsigned playerId, const PlayerInfo& playerInfo, GameWorl
 
     // Inventur nullen
     global_inventory.clear();
+    inventoryHash = 0;
 
     // Statistiken mit 0en füllen
-    memset(&statistic[StatisticTime::T15Minutes], 0, sizeof(statistic[StatisticTime::T15Minutes]));
-    memset(&statistic[StatisticTime::T1Hour], 0, sizeof(statistic[StatisticTime::T1Hour]));
-    memset(&statistic[StatisticTime::T4Hours], 0, sizeof(statistic[StatisticTime::T4Hours]));
-    memset(&statistic[StatisticTime::T16Hours], 0, sizeof(statistic[StatisticTime::T16Hours]));
     memset(&statisticCurrentData, 0, sizeof(statisticCurrentData));
     memset(&statisticCurrentMerchandiseData, 0, sizeof(statisticCurrentMerchandiseData));
 
@@ -235,21 +235,7 @@ void GamePlayer::Serialize(SerializedGameData& sgd) const
         sgd.PushUnsignedInt(global_inventory[i]);
 
     // für Statistik
-    for(const auto i : helpers::enumRange<StatisticTime>())
-    {
-        // normale Statistik
-        for(const auto j : helpers::enumRange<StatisticType>())
-            for(unsigned k = 0; k < NUM_STAT_STEPS; ++k)
-                sgd.PushUnsignedInt(statistic[i].data[j][k]);
-
-        // Warenstatistik
-        for(unsigned j = 0; j < NUM_STAT_MERCHANDISE_TYPES; ++j)
-            for(unsigned k = 0; k < NUM_STAT_STEPS; ++k)
-                sgd.PushUnsignedShort(statistic[i].merchandiseData[j][k]);
-
-        sgd.PushUnsignedShort(statistic[i].currentIndex);
-        sgd.PushUnsignedShort(statistic[i].counter);
-    }
+    statisticSeries.Serialize(sgd);
     for(const auto i : helpers::enumRange<StatisticType>())
         sgd.PushUnsignedInt(statisticCurrentData[i]);
 
@@ -345,30 +331,21 @@ void GamePlayer::Deserialize(SerializedGameData& sgd)
         global_inventory[i] = sgd.PopUnsignedInt();
     for(const auto i : helpers::enumRange<Job>())
         global_inventory[i] = sgd.PopUnsignedInt();
+    RecalcInventoryHash();
 
     // Visuelle Einstellungen festlegen
 
     // für Statistik
-    for(const auto i : helpers::enumRange<StatisticTime>())
-    {
-        // normale Statistik
-        for(const auto j : helpers::enumRange<StatisticType>())
-            for(unsigned k = 0; k < NUM_STAT_STEPS; ++k)
-                statistic[i].data[j][k] = sgd.PopUnsignedInt();
-
-        // Warenstatistik
-        for(unsigned j = 0; j < NUM_STAT_MERCHANDISE_TYPES; ++j)
-            for(unsigned k = 0; k < NUM_STAT_STEPS; ++k)
-                statistic[i].merchandiseData[j][k] = sgd.PopUnsignedShort();
-
-        statistic[i].currentIndex = sgd.PopUnsignedShort();
-        statistic[i].counter = sgd.PopUnsignedShort();
-    }
+    if(sgd.GetGameDataVersion() < 7)
+        DeserializeLegacyStatistics(sgd);
+    else
+        statisticSeries.Deserialize(sgd);
     for(const auto i : helpers::enumRange<StatisticType>())
         statisticCurrentData[i] = sgd.PopUnsignedInt();
 
     for(unsigned i = 0; i < NUM_STAT_MERCHANDISE_TYPES; ++i)
         statisticCurrentMerchandiseData[i] = sgd.PopUnsignedShort();
+    RecalcInventoryStatistics();
 
     // Deserialize Pacts:
     for(unsigned i = 0; i < MAX_PLAYERS; ++i)
@@ -986,27 +963,16 @@ RoadSegment* GamePlayer::FindRoadForDonkey(noRoadNode* start, noRoadNode** goal)
     return best_road;
 }
 
-struct ClientForWare
+bool GamePlayer::ClientForWare::operator<(const ClientForWare& b) const
 {
-    noBaseBuilding* bld;
-    unsigned estimate; // points minus half the optimal distance
-    unsigned points;
-
-    ClientForWare(noBaseBuilding* bld, unsigned estimate, unsigned points)
-        : bld(bld), estimate(estimate), points(points)
-    {}
-
-    bool operator<(const ClientForWare& b) const
-    {
-        // use estimate, points and object id (as tie breaker) for sorting
-        if(estimate != b.estimate)
-            return estimate > b.estimate;
-        else if(points != b.points)
-            return points > b.points;
-        else
-            return bld->GetObjId() > b.bld->GetObjId();
-    }
-};
+    // use estimate, points and object id (as tie breaker) for sorting
+    if(estimate != b.estimate)
+        return estimate > b.estimate;
+    else if(points != b.points)
+        return points > b.points;
+    else
+        return bld->GetObjId() > b.bld->GetObjId();
+}
 
 noBaseBuilding* GamePlayer::FindClientForWare(Ware* ware)
 {
@@ -1020,7 +986,8 @@ noBaseBuilding* GamePlayer::FindClientForWare(Ware* ware)
     Distribution& wareDistribution =
       (gt == GoodType::Bread || gt == GoodType::Meat) ? distribution[GoodType::Fish] : distribution[gt];
 
-    std::vector<ClientForWare> possibleClients;
+    std::vector<ClientForWare>& possibleClients = wareClientCandidates_;
+    possibleClients.clear();
 
     noRoadNode* start = ware->GetLocation();
 
@@ -1039,6 +1006,7 @@ noBaseBuilding* GamePlayer::FindClientForWare(Ware* ware)
         }
     }
 
+    helpers::EnumArray<bool, BuildingType> isClientBld{};
     for(const auto bldType : wareDistribution.client_buildings)
     {
         // BuildingType::Headquarters sind Baustellen!!, da HQs ja sowieso nicht gebaut werden können
@@ -1056,43 +1024,48 @@ noBaseBuilding* GamePlayer::FindClientForWare(Ware* ware)
                 possibleClients.push_back(ClientForWare(bldSite, points > distance ? points - distance : 0, points));
             }
         } else
-        {
-            // Für übrige Gebäude
-            for(nobUsual* bld : buildings.GetBuildings(bldType))
-            {
-                unsigned points = bld->CalcDistributionPoints(ware->GetLocation(), gt);
-                if(!points)
-                    continue; // Ware not needed
+            isClientBld[bldType] = true;
+    }
 
-                if(!wareDistribution.goals.empty())
-                {
-                    if(bld->GetBuildingType()
-                       == static_cast<BuildingType>(wareDistribution.goals[wareDistribution.selected_goal]))
-                        points += 300;
-                    else if(points >= 300) // avoid overflows (async!)
-                        points -= 300;
-                    else
-                        points = 0;
-                }
+    // Für übrige Gebäude: Only those which currently need the ware. The order does not matter as the list is sorted
+    for(nobUsual* bld : buildings.GetWareClients(gt))
+    {
+        if(!isClientBld[bld->GetBuildingType()])
+            continue;
+        unsigned points = bld->CalcDistributionPoints(ware->GetLocation(), gt);
+        RTTR_Assert(points); // Only buildings needing the ware are registered
 
-                unsigned distance = gwg.CalcDistance(start->GetPos(), bld->GetPos()) / 2;
-                possibleClients.push_back(ClientForWare(bld, points > distance ? points - distance : 0, points));
-            }
+        if(!wareDistribution.goals.empty())
+        {
+            if(bld->GetBuildingType()
+               == static_cast<BuildingType>(wareDistribution.goals[wareDistribution.selected_goal]))
+                points += 300;
+            else if(points >= 300) // avoid overflows (async!)
+                points -= 300;
+            else
+                points = 0;
         }
+
+        unsigned distance = gwg.CalcDistance(start->GetPos(), bld->GetPos()) / 2;
+        possibleClients.push_back(ClientForWare(bld, points > distance ? points - distance : 0, points));
     }
 
-    // sort our clients, highest score first
-    std::sort(possibleClients.begin(), possibleClients.end());
+    // Order our clients, highest score first. Usually only the first few are checked, so use a heap to only sort
+    // those. The order is the same as with sorting as the object id makes it unique
+    const auto isWorseClient = [](const ClientForWare& lhs, const ClientForWare& rhs) { return rhs < lhs; };
+    std::make_heap(possibleClients.begin(), possibleClients.end(), isWorseClient);
 
     noBaseBuilding* lastBld = nullptr;
     noBaseBuilding* bestBld = nullptr;
     unsigned best_points = 0;
-    for(auto& possibleClient : possibleClients)
+    for(auto itEnd = possibleClients.end(); itEnd != possibleClients.begin(); --itEnd)
     {
+        std::pop_heap(possibleClients.begin(), itEnd, isWorseClient);
+        const ClientForWare& possibleClient = *(itEnd - 1);
         unsigned path_length;
 
         // If our estimate is worse (or equal) best_points, the real value cannot be better.
-        // As our list is sorted, further entries cannot be better either, so stop searching.
+        // As we check them in order, further entries cannot be better either, so stop searching.
         if(possibleClient.estimate <= best_points)
             break;
 
@@ -1444,6 +1417,36 @@ void GamePlayer::Surrender()
         gwg.GetGameInterface()->GI_PlayerDefeated(GetPlayerId());
 }
 
+void GamePlayer::DeserializeLegacyStatistics(SerializedGameData& sgd)
+{
+    // Only fixed size ring buffers were stored. Use the 15 minute one as the history which loses older values
+    StatisticTimeSeries::Values values;
+    helpers::EnumArray<std::array<unsigned, NUM_STAT_STEPS>, StatisticType> data;
+    std::array<StatisticTimeSeries::MerchandiseValues, NUM_STAT_STEPS> merchandiseData;
+    statisticSeries.Clear();
+    for(const auto i : helpers::enumRange<StatisticTime>())
+    {
+        for(const auto j : helpers::enumRange<StatisticType>())
+            for(unsigned k = 0; k < NUM_STAT_STEPS; ++k)
+                data[j][k] = sgd.PopUnsignedInt();
+        for(unsigned j = 0; j < NUM_STAT_MERCHANDISE_TYPES; ++j)
+            for(unsigned k = 0; k < NUM_STAT_STEPS; ++k)
+                merchandiseData[k][j] = sgd.PopUnsignedShort();
+        const unsigned currentIndex = sgd.PopUnsignedShort();
+        sgd.PopUnsignedShort(); // Counter
+        if(i != StatisticTime::T15Minutes)
+            continue;
+        // Oldest entry is the one after the current one
+        for(unsigned k = 1; k <= NUM_STAT_STEPS; ++k)
+        {
+            const unsigned idx = (currentIndex + k) % NUM_STAT_STEPS;
+            for(const auto j : helpers::enumRange<StatisticType>())
+                values[j] = data[j][idx];
+            statisticSeries.AddStep(values, merchandiseData[idx]);
+        }
+    }
+}
+
 void GamePlayer::SetStatisticValue(StatisticType type, unsigned value)
 {
     statisticCurrentData[type] = value;
@@ -1498,23 +1501,7 @@ void GamePlayer::IncreaseMerchandiseStatistic(GoodType type)
 /// Calculates current statistics
 void GamePlayer::CalcStatistics()
 {
-    // Waren aus der Inventur zählen
-    statisticCurrentData[StatisticType::Merchandise] = 0;
-    for(const auto i : helpers::enumRange<GoodType>())
-        statisticCurrentData[StatisticType::Merchandise] += global_inventory[i];
-
-    // Bevölkerung aus der Inventur zählen
-    statisticCurrentData[StatisticType::Inhabitants] = 0;
-    for(const auto i : helpers::enumRange<Job>())
-        statisticCurrentData[StatisticType::Inhabitants] += global_inventory[i];
-
-    // Militär aus der Inventur zählen
-    statisticCurrentData[StatisticType::Military] =
-      global_inventory.people[Job::Private] + global_inventory.people[Job::PrivateFirstClass] * 2
-      + global_inventory.people[Job::Sergeant] * 3 + global_inventory.people[Job::Officer] * 4
-      + global_inventory.people[Job::General] * 5;
-
-    // Produktivität berechnen
+    // Merchandise, inhabitants and military are updated with the inventory
     statisticCurrentData[StatisticType::Productivity] = buildings.CalcAverageProductivity();
 
     // Total points for tournament games
@@ -1526,56 +1513,50 @@ void GamePlayer::StatisticStep()
 {
     CalcStatistics();
 
-    // 15-min-Statistik ein Feld weiterschieben
+    StatisticTimeSeries::Values values;
     for(const auto i : helpers::enumRange<StatisticType>())
-    {
-        statistic[StatisticTime::T15Minutes].data[i][incrStatIndex(statistic[StatisticTime::T15Minutes].currentIndex)] =
-          statisticCurrentData[i];
-    }
+        values[i] = statisticCurrentData[i];
+    StatisticTimeSeries::MerchandiseValues merchandise;
     for(unsigned i = 0; i < NUM_STAT_MERCHANDISE_TYPES; ++i)
-    {
-        statistic[StatisticTime::T15Minutes]
-          .merchandiseData[i][incrStatIndex(statistic[StatisticTime::T15Minutes].currentIndex)] =
-          statisticCurrentMerchandiseData[i];
-    }
-    statistic[StatisticTime::T15Minutes].currentIndex =
-      incrStatIndex(statistic[StatisticTime::T15Minutes].currentIndex);
+        merchandise[i] = static_cast<uint16_t>(std::min(statisticCurrentMerchandiseData[i], 0xFFFF));
+    statisticSeries.AddStep(values, merchandise);
 
-    statistic[StatisticTime::T15Minutes].counter++;
-
-    // Prüfen ob 4mal 15-min-Statistik weitergeschoben wurde, wenn ja: 1-h-Statistik weiterschieben
-    // und aktuellen Wert der 15min-Statistik benutzen
-    // gleiches für die 4h und 16h Statistik
-    for(const auto t : helpers::enumRange<StatisticTime>())
-    {
-        if(t == StatisticTime(helpers::MaxEnumValue_v<StatisticTime>))
-            break;
-        const auto nextT = StatisticTime(rttr::enum_cast(t) + 1);
-        if(statistic[t].counter == 4)
-        {
-            statistic[t].counter = 0;
-            for(const auto i : helpers::enumRange<StatisticType>())
-            {
-                statistic[nextT].data[i][incrStatIndex(statistic[nextT].currentIndex)] = statisticCurrentData[i];
-            }
+    // Warenstatistikzähler nullen
+    statisticCurrentMerchandiseData.fill(0);
+}
 
-            // Summe für den Zeitraum berechnen (immer 4 Zeitschritte der jeweils kleineren Statistik)
-            for(unsigned i = 0; i < NUM_STAT_MERCHANDISE_TYPES; ++i)
-            {
-                statistic[nextT].merchandiseData[i][incrStatIndex(statistic[nextT].currentIndex)] =
-                  statisticCurrentMerchandiseData[i]
-                  + statistic[t].merchandiseData[i][decrStatIndex(statistic[t].currentIndex, 1)]
-                  + statistic[t].merchandiseData[i][decrStatIndex(statistic[t].currentIndex, 2)]
-                  + statistic[t].merchandiseData[i][decrStatIndex(statistic[t].currentIndex, 3)];
-            }
+namespace {
+/// Number of statistic steps in one sample of the given time. Each time is 4 times as long as the previous one
+unsigned getStepsPerSample(StatisticTime time)
+{
+    return 1u << (2u * rttr::enum_cast(time));
+}
+} // namespace
 
-            statistic[nextT].currentIndex = incrStatIndex(statistic[nextT].currentIndex);
-            statistic[nextT].counter++;
-        }
+GamePlayer::Statistic GamePlayer::GetStatistic(StatisticTime time) const
+{
+    const unsigned stepsPerSample = getStepsPerSample(time);
+    Statistic result;
+    for(const auto i : helpers::enumRange<StatisticType>())
+    {
+        const std::vector<unsigned> values = statisticSeries.GetDownsampled(i, stepsPerSample, NUM_STAT_STEPS);
+        std::copy(values.begin(), values.end(), result.data[i].begin());
     }
+    for(unsigned i = 0; i < NUM_STAT_MERCHANDISE_TYPES; ++i)
+    {
+        const std::vector<unsigned> values =
+          statisticSeries.GetMerchandiseDownsampled(i, stepsPerSample, NUM_STAT_STEPS);
+        for(unsigned j = 0; j < NUM_STAT_STEPS; ++j)
+            result.merchandiseData[i][j] = static_cast<uint16_t>(std::min<unsigned>(values[j], 0xFFFF));
+    }
+    // Values are in chronological order
+    result.currentIndex = NUM_STAT_STEPS - 1;
+    return result;
+}
 
-    // Warenstatistikzähler nullen
-    statisticCurrentMerchandiseData.fill(0);
+std::vector<unsigned> GamePlayer::GetStatisticValues(StatisticType type, StatisticTime time) const
+{
+    return statisticSeries.GetDownsampled(type, getStepsPerSample(time), NUM_STAT_STEPS);
 }
 
 GamePlayer::Pact::Pact(SerializedGameData& sgd)
@@ -1805,12 +1786,77 @@ bool GamePlayer::IsWareDependent(Ware* ware)
 
 void GamePlayer::IncreaseInventoryWare(const GoodType ware, const unsigned count)
 {
-    global_inventory.Add(ConvertShields(ware), count);
+    const GoodType realWare = ConvertShields(ware);
+    UpdateInventoryHash(realWare, global_inventory[realWare], global_inventory[realWare] + count);
+    UpdateInventoryStatistics(realWare, static_cast<int>(count));
+    global_inventory.Add(realWare, count);
 }
 
 void GamePlayer::DecreaseInventoryWare(const GoodType ware, const unsigned count)
 {
-    global_inventory.Remove(ConvertShields(ware), count);
+    const GoodType realWare = ConvertShields(ware);
+    UpdateInventoryHash(realWare, global_inventory[realWare], global_inventory[realWare] - count);
+    UpdateInventoryStatistics(realWare, -static_cast<int>(count));
+    global_inventory.Remove(realWare, count);
+}
+
+void GamePlayer::IncreaseInventoryJob(const Job job, const unsigned count)
+{
+    UpdateInventoryHash(job, global_inventory[job], global_inventory[job] + count);
+    UpdateInventoryStatistics(job, static_cast<int>(count));
+    global_inventory.Add(job, count);
+}
+
+void GamePlayer::DecreaseInventoryJob(const Job job, const unsigned count)
+{
+    UpdateInventoryHash(job, global_inventory[job], global_inventory[job] - count);
+    UpdateInventoryStatistics(job, -static_cast<int>(count));
+    global_inventory.Remove(job, count);
+}
+
+void GamePlayer::UpdateInventoryHash(const GoodType ware, const unsigned oldCount, const unsigned newCount)
+{
+    const unsigned key = rttr::enum_cast(ware);
+    inventoryHash ^= WorldStateHash::CalcEntryHash(key, oldCount) ^ WorldStateHash::CalcEntryHash(key, newCount);
+}
+
+void GamePlayer::UpdateInventoryHash(const Job job, const unsigned oldCount, const unsigned newCount)
+{
+    // Jobs come after the wares
+    const unsigned key = helpers::NumEnumValues_v<GoodType> + rttr::enum_cast(job);
+    inventoryHash ^= WorldStateHash::CalcEntryHash(key, oldCount) ^ WorldStateHash::CalcEntryHash(key, newCount);
+}
+
+void GamePlayer::RecalcInventoryHash()
+{
+    inventoryHash = 0;
+    for(const auto i : helpers::enumRange<GoodType>())
+        UpdateInventoryHash(i, 0, global_inventory[i]);
+    for(const auto i : helpers::enumRange<Job>())
+        UpdateInventoryHash(i, 0, global_inventory[i]);
+}
+
+void GamePlayer::UpdateInventoryStatistics(GoodType /*ware*/, const int change)
+{
+    statisticCurrentData[StatisticType::Merchandise] += change;
+}
+
+void GamePlayer::UpdateInventoryStatistics(const Job job, const int change)
+{
+    statisticCurrentData[StatisticType::Inhabitants] += change;
+    if(helpers::contains(SOLDIER_JOBS, job))
+        statisticCurrentData[StatisticType::Military] += change * static_cast<int>(getSoldierRank(job) + 1);
+}
+
+void GamePlayer::RecalcInventoryStatistics()
+{
+    statisticCurrentData[StatisticType::Merchandise] = 0;
+    statisticCurrentData[StatisticType::Inhabitants] = 0;
+    statisticCurrentData[StatisticType::Military] = 0;
+    for(const auto i : helpers::enumRange<GoodType>())
+        UpdateInventoryStatistics(i, static_cast<int>(global_inventory[i]));
+    for(const auto i : helpers::enumRange<Job>())
+        UpdateInventoryStatistics(i, static_cast<int>(global_inventory[i]));
 }
 
 /// Registriert ein Schiff beim Einwohnermeldeamt
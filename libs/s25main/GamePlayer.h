@@ -19,6 +19,7 @@
 
 #include "BuildingRegister.h"
 #include "GamePlayerInfo.h"
+#include "StatisticTimeSeries.h"
 #include "helpers/EnumArray.h"
 #include "helpers/MultiArray.h"
 #include "gameTypes/BuildingType.h"
@@ -75,8 +76,6 @@ public:
         helpers::MultiArray<uint16_t, NUM_STAT_MERCHANDISE_TYPES, NUM_STAT_STEPS> merchandiseData;
         // Index, der gerade 'vorne' (rechts im Statistikfenster) ist
         uint16_t currentIndex;
-        // Counter, bei jedem vierten Update jeweils Daten zu den längerfristigen Statistiken kopieren
-        uint16_t counter;
     };
 
     // Informationen über die Verteilung
@@ -109,6 +108,13 @@ public:
     void AddBuildingSite(noBuildingSite* bldSite);
     void RemoveBuildingSite(noBuildingSite* bldSite);
     const BuildingRegister& GetBuildingRegister() const { return buildings; }
+    void BuildingProductivityChanged(BuildingType bldType, unsigned short oldProductivity,
+                                     unsigned short newProductivity)
+    {
+        buildings.ProductivityChanged(bldType, oldProductivity, newProductivity);
+    }
+    /// Must be called when the wares needed by the building might have changed
+    void WareDemandChanged(nobUsual& bld) { buildings.UpdateWareDemand(bld); }
 
     /// Notify that a new road connection exists (not only an existing road splitted)
     void NewRoadConnection(RoadSegment* rs);
@@ -191,11 +197,13 @@ public:
     /// Fügt Waren zur Inventur hinzu
     void IncreaseInventoryWare(GoodType ware, unsigned count);
     void DecreaseInventoryWare(GoodType ware, unsigned count);
-    void IncreaseInventoryJob(const Job job, unsigned count) { global_inventory.Add(job, count); }
-    void DecreaseInventoryJob(const Job job, unsigned count) { global_inventory.Remove(job, count); }
+    void IncreaseInventoryJob(Job job, unsigned count);
+    void DecreaseInventoryJob(Job job, unsigned count);
 
     /// Gibt Inventory-Settings zurück
     const Inventory& GetInventory() const { return global_inventory; }
+    /// Return a hash of the inventory which is updated on every change
+    unsigned GetInventoryHash() const { return inventoryHash; }
 
     /// Setzt neue Militäreinstellungen
     void ChangeMilitarySettings(const MilitarySettings& military_settings);
@@ -332,8 +340,13 @@ public:
     void CalcStatistics();
     void StatisticStep();
 
-    const Statistic& GetStatistic(StatisticTime time) const { return statistic[time]; };
+    /// Get the last NUM_STAT_STEPS values of the statistic downsampled to the given time
+    Statistic GetStatistic(StatisticTime time) const;
+    /// Get the last NUM_STAT_STEPS values of a single statistic downsampled to the given time, oldest first
+    std::vector<unsigned> GetStatisticValues(StatisticType type, StatisticTime time) const;
     unsigned GetStatisticCurrentValue(StatisticType idx) const { return statisticCurrentData[idx]; }
+    /// Values of all statistic steps of the game
+    const StatisticTimeSeries& GetStatisticTimeSeries() const { return statisticSeries; }
 
     // Testet ob Notfallprogramm aktiviert werden muss und tut dies dann
     void TestForEmergencyProgramm();
@@ -378,8 +391,24 @@ private:
     /// List which tells if a defender should be send to an attacker
     std::vector<bool> shouldSendDefenderList;
 
+    struct ClientForWare
+    {
+        noBaseBuilding* bld;
+        unsigned estimate; // points minus half the optimal distance
+        unsigned points;
+
+        ClientForWare(noBaseBuilding* bld, unsigned estimate, unsigned points)
+            : bld(bld), estimate(estimate), points(points)
+        {}
+
+        bool operator<(const ClientForWare& b) const;
+    };
+    /// Buffer for the candidates of FindClientForWare to avoid allocations
+    std::vector<ClientForWare> wareClientCandidates_;
+
     /// Inventur
     Inventory global_inventory;
+    unsigned inventoryHash;
 
     /// Koordinaten des HQs des Spielers
     MapPoint hqPos;
@@ -419,7 +448,7 @@ private:
     std::array<helpers::EnumArray<Pact, PactType>, MAX_PLAYERS> pacts;
 
     // Statistikdaten
-    helpers::EnumArray<Statistic, StatisticTime> statistic;
+    StatisticTimeSeries statisticSeries;
 
     // Die Statistikwerte die 'aktuell' gemessen werden
     helpers::EnumArray<int, StatisticType> statisticCurrentData;
@@ -431,6 +460,16 @@ private:
     void LoadStandardToolSettings();
     void LoadStandardMilitarySettings();
     void LoadStandardDistribution();
+    /// Change the count of a ware or job in the inventory hash
+    void UpdateInventoryHash(GoodType ware, unsigned oldCount, unsigned newCount);
+    void UpdateInventoryHash(Job job, unsigned oldCount, unsigned newCount);
+    void RecalcInventoryHash();
+    /// Update the statistics derived from the inventory when count of the ware/job changed by the given amount
+    void UpdateInventoryStatistics(GoodType ware, int change);
+    void UpdateInventoryStatistics(Job job, int change);
+    void RecalcInventoryStatistics();
+    /// Read the statistics of savegames storing only the last values of each time
+    void DeserializeLegacyStatistics(SerializedGameData& sgd);
     /// Bündnis (real, d.h. spielentscheidend) abschließen
     void MakePact(PactType pt, unsigned char other_player, unsigned duration);
     /// Called after a pact was changed(added/removed) in both players
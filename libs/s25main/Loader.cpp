@@ -45,6 +45,7 @@
 #include "gameData/JobConsts.h"
 #include "gameData/MilitaryConsts.h"
 #include "gameData/NationConsts.h"
+#include "gameData/WorldDescription.h"
 #include "libsiedler2/ArchivItem_Font.h"
 #include "libsiedler2/ArchivItem_Palette.h"
 #include "libsiedler2/ArchivItem_PaletteAnimation.h"
@@ -61,6 +62,7 @@
 #include <boost/filesystem.hpp>
 #include <boost/range/adaptor/map.hpp>
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstdio>
 #include <iomanip>
@@ -357,6 +359,36 @@ void Loader::LoadDummyGUIFiles()
     }
 }
 
+void Loader::LoadDummyMapFiles(const WorldDescription& desc)
+{
+    const libsiedler2::ArchivItem_Palette* palette = GetPaletteN("pal5");
+    const auto addTexture = [this, palette](const std::string& texturePath, unsigned archiveSize) {
+        libsiedler2::Archiv& archive = files_[ResourceId::make(bfs::path(texturePath))].archive;
+        if(archive.size() < archiveSize)
+            archive.alloc_inc(archiveSize - archive.size());
+        if(archive[0])
+            return;
+        // Big enough for all textures of the original files
+        auto bmp = std::make_unique<glArchivItem_Bitmap_Raw>();
+        libsiedler2::PixelBufferPaletted buffer(256, 256);
+        bmp->create(buffer, palette);
+        archive.set(0, std::move(bmp));
+    };
+    for(DescIdx<TerrainDesc> i(0); i.value < desc.terrain.size(); i.value++)
+    {
+        const TerrainDesc& cur = desc.get(i);
+        // Leave room for the (missing) palette animation so the renderer falls back to a static texture
+        addTexture(cur.texturePath, std::max(1, cur.palAnimIdx + 1));
+    }
+    for(DescIdx<EdgeDesc> i(0); i.value < desc.edges.size(); i.value++)
+        addTexture(desc.get(i).texturePath, 1);
+    for(DescIdx<LandscapeDesc> i(0); i.value < desc.landscapes.size(); i.value++)
+    {
+        for(const RoadTextureDesc& roadTex : desc.get(i).roadTexDesc)
+            addTexture(roadTex.texturePath, 1);
+    }
+}
+
 /**
  *  Load files required during a game
  *
@@ -376,13 +408,18 @@ bool Loader::LoadFilesAtGame(const std::string& mapGfxPath, bool isWinterGFX, co
                                       res::boot_z,   res::mis0bobs, res::mis1bobs, res::mis2bobs,
                                       res::mis3bobs, res::mis4bobs, res::mis5bobs};
 
-    const libsiedler2::ArchivItem_Palette* pal5 = GetPaletteN("pal5");
-
-    if(!LoadFiles(files) || !Load(ResourceId("map_new"), pal5))
+    // Resolve all files first, so they can be decoded in parallel
+    FilesToLoad filesToLoad;
+    for(const std::string& curFile : files)
+    {
+        if(!AddFileToLoad(filesToLoad, config_.ExpandPath(curFile)))
+            return false;
+    }
+    if(!AddFileToLoad(filesToLoad, ResourceId("map_new")))
         return false;
 
-    // Load nation building and icon graphics
-    nation_gfx = nationIcons_ = {};
+    // Nation building and icon graphics
+    helpers::EnumArray<std::pair<bfs::path, bfs::path>, Nation> nationFilePaths;
     const std::string natPrefix = isWinterGFX ? "W" : "";
     for(Nation nation : nations)
     {
@@ -392,56 +429,57 @@ bool Loader::LoadFilesAtGame(const std::string& mapGfxPath, bool isWinterGFX, co
         const auto shortName = s25util::toUpper(std::string(NationNames[nation], 0, 3));
         const bfs::path buildingsFilePath = nationFolder / (natPrefix + shortName + "_Z.LST");
         const bfs::path iconsFilePath = nationFolder / (shortName + "_ICON.LST");
-        if(!Load(buildingsFilePath, pal5) || !Load(iconsFilePath, pal5))
+        if(!AddFileToLoad(filesToLoad, buildingsFilePath) || !AddFileToLoad(filesToLoad, iconsFilePath))
             return false;
-        nation_gfx[nation] = &files_[ResourceId::make(buildingsFilePath)].archive;
-        nationIcons_[nation] = &files_[ResourceId::make(iconsFilePath)].archive;
+        nationFilePaths[nation] = std::make_pair(buildingsFilePath, iconsFilePath);
     }
 
     // TODO: Move to addon folder and make it overwrite existing file
-    if(!LoadResources({"charburner", "charburner_bobs"}))
+    if(!AddFileToLoad(filesToLoad, ResourceId("charburner"))
+       || !AddFileToLoad(filesToLoad, ResourceId("charburner_bobs")))
         return false;
 
     const bfs::path mapGFXFile = config_.ExpandPath(mapGfxPath);
-    if(!Load(mapGFXFile, pal5))
+    if(!AddFileToLoad(filesToLoad, mapGFXFile))
+        return false;
+
+    if(!LoadParallel(filesToLoad, GetPaletteN("pal5")))
         return false;
+
+    nation_gfx = nationIcons_ = {};
+    for(Nation nation : nations)
+    {
+        nation_gfx[nation] = &files_[ResourceId::make(nationFilePaths[nation].first)].archive;
+        nationIcons_[nation] = &files_[ResourceId::make(nationFilePaths[nation].second)].archive;
+    }
     map_gfx = &GetArchive(ResourceId::make(mapGFXFile));
 
     isWinterGFX_ = isWinterGFX;
+    enabledAddons_ = enabledAddons;
 
     return true;
 }
 
 bool Loader::LoadFiles(const std::vector<std::string>& files)
 {
-    const libsiedler2::ArchivItem_Palette* pal5 = GetPaletteN("pal5");
-    // load the files
+    FilesToLoad filesToLoad;
     for(const std::string& curFile : files)
     {
-        const bfs::path filePath = config_.ExpandPath(curFile);
-        if(!Load(filePath, pal5))
-        {
-            logger_.write(_("Failed to load %s\n")) % filePath;
+        if(!AddFileToLoad(filesToLoad, config_.ExpandPath(curFile)))
             return false;
-        }
     }
-
-    return true;
+    return LoadParallel(filesToLoad, GetPaletteN("pal5"));
 }
 
 bool Loader::LoadResources(const std::vector<ResourceId>& resources)
 {
-    const libsiedler2::ArchivItem_Palette* pal5 = GetPaletteN("pal5");
+    FilesToLoad filesToLoad;
     for(const ResourceId& curResource : resources)
     {
-        if(!Load(curResource, pal5))
-        {
-            logger_.write(_("Failed to load %s\n")) % curResource;
+        if(!AddFileToLoad(filesToLoad, curResource))
             return false;
-        }
     }
-
-    return true;
+    return LoadParallel(filesToLoad, GetPaletteN("pal5"));
 }
 
 void Loader::fillCaches()
@@ -851,8 +889,18 @@ void Loader::fillCaches()
 
     if(SETTINGS.video.shared_textures)
     {
-        // generate mega texture
-        stp->pack();
+        // Reuse the mega texture of the last run if the inputs did not change. Otherwise generate and cache it
+        const bfs::path cacheFolder = config_.ExpandPath(s25::folders::textureCache);
+        const bfs::path cacheFilepath = cacheFolder / "textures.dat";
+        const uint64_t cacheKey = CalcTextureCacheKey();
+        if(stp->loadCache(cacheFilepath, cacheKey))
+            logger_.write(_("Using cached textures from %1%\n")) % cacheFilepath;
+        else
+        {
+            boost::system::error_code ec;
+            bfs::create_directories(cacheFolder, ec);
+            stp->packAndSave(cacheFilepath, cacheKey);
+        }
     } else
         stp.reset();
 }
@@ -972,6 +1020,105 @@ bool Loader::LoadImpl(const T& resIdOrPath, const libsiedler2::ArchivItem_Palett
     return true;
 }
 
+template<typename T>
+bool Loader::AddFileToLoad(FilesToLoad& files, const T& resIdOrPath)
+{
+    ResolvedFile resolvedFile = archiveLocator_->resolve(resIdOrPath);
+    if(!resolvedFile)
+    {
+        logger_.write(_("Failed to resolve resource %1%\n")) % resIdOrPath;
+        return false;
+    }
+    files.emplace_back(ResourceId::make(resIdOrPath), std::move(resolvedFile));
+    return true;
+}
+
+bool Loader::LoadParallel(const FilesToLoad& files, const libsiedler2::ArchivItem_Palette* palette)
+{
+    // Do we really need to reload or can we reused the loaded version?
+    std::vector<FileEntry*> entries;
+    std::vector<ResolvedFile> filesToLoad;
+    for(const auto& file : files)
+    {
+        FileEntry& entry = files_[file.first];
+        if(entry.resolvedFile != file.second && !helpers::contains(entries, &entry))
+        {
+            entries.push_back(&entry);
+            filesToLoad.push_back(file.second);
+        }
+    }
+    std::vector<libsiedler2::Archiv> archives;
+    try
+    {
+        archives = archiveLoader_->loadAll(filesToLoad, palette);
+    } catch(const LoadError&)
+    {
+        return false;
+    }
+    for(unsigned i = 0; i < entries.size(); i++)
+    {
+        entries[i]->archive = std::move(archives[i]);
+        // Update how we loaded this
+        entries[i]->resolvedFile = filesToLoad[i];
+        RTTR_Assert(!entries[i]->archive.empty());
+    }
+    return true;
+}
+
+/// Write the size and modification time of the file or all files in the directory
+static void writeFileStamp(std::ostream& s, const bfs::path& path)
+{
+    boost::system::error_code ec;
+    std::vector<bfs::path> filePaths;
+    if(bfs::is_directory(path, ec))
+    {
+        for(bfs::recursive_directory_iterator it(path, ec), end; !ec && it != end; it.increment(ec))
+        {
+            if(bfs::is_regular_file(it->status()))
+                filePaths.push_back(it->path());
+        }
+        std::sort(filePaths.begin(), filePaths.end());
+    } else
+        filePaths.push_back(path);
+    for(const bfs::path& filePath : filePaths)
+    {
+        s << '|' << filePath.string() << ':' << bfs::file_size(filePath, ec) << ':'
+          << bfs::last_write_time(filePath, ec);
+    }
+}
+
+uint64_t Loader::CalcTextureCacheKey() const
+{
+    // Identify the loaded files by their location, size and modification time as hashing their content would take
+    // about as long as packing the textures
+    std::ostringstream s;
+    s << isWinterGFX_;
+    for(const auto nation : helpers::EnumRange<Nation>{})
+        s << (nation_gfx[nation] ? '1' : '0');
+    for(const AddonId addon : enabledAddons_)
+        s << ',' << static_cast<unsigned>(addon);
+    // Only the archives whose bitmaps are packed, so other loaded files like the menu graphics don't change the key
+    const std::array<ResourceId, 7> packedFiles = {"boat",     "carrier", "charburner", "jobs",
+                                                   "mis0bobs", "pal5",    "rom_bobs"};
+    for(const auto& file : files_)
+    {
+        const libsiedler2::Archiv* archive = &file.second.archive;
+        if(archive != map_gfx && !helpers::contains(nation_gfx, archive) && !helpers::contains(packedFiles, file.first))
+            continue;
+        s << '\n' << file.first;
+        for(const bfs::path& path : file.second.resolvedFile)
+            writeFileStamp(s, path);
+    }
+    // 64 bit FNV-1a
+    uint64_t hash = 14695981039346656037u;
+    for(const unsigned char c : s.str())
+    {
+        hash ^= c;
+        hash *= 1099511628211u;
+    }
+    return hash;
+}
+
 bool Loader::Load(const bfs::path& path, const libsiedler2::ArchivItem_Palette* palette)
 {
     return LoadImpl(path, palette);
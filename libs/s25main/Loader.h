@@ -35,6 +35,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 class ArchiveLoader;
@@ -48,8 +49,10 @@ class glTexturePacker;
 class ITexture;
 class Log;
 class MusicItem;
+class ResolvedFile;
 class RttrConfig;
 class SoundEffectItem;
+struct WorldDescription;
 enum class AddonId;
 
 namespace libsiedler2 {
@@ -98,6 +101,9 @@ public:
 
     /// Creates archives with empty files for the GUI (for testing purposes)
     void LoadDummyGUIFiles();
+    /// Creates archives with empty textures for the terrain, edges and roads of the world (for testing purposes).
+    /// Requires the palettes from LoadDummyGUIFiles
+    void LoadDummyMapFiles(const WorldDescription& desc);
     /// Load a file and save it into the loader repo
     bool Load(const boost::filesystem::path& path, const libsiedler2::ArchivItem_Palette* palette = nullptr);
     bool Load(const ResourceId& resId, const libsiedler2::ArchivItem_Palette* palette = nullptr);
@@ -236,6 +242,15 @@ private:
 
     template<typename T>
     bool LoadImpl(const T& resIdOrPath, const libsiedler2::ArchivItem_Palette* palette);
+    /// Resource ids and the files they consist of
+    using FilesToLoad = std::vector<std::pair<ResourceId, ResolvedFile>>;
+    /// Resolve the file or resource and add it to the list
+    template<typename T>
+    bool AddFileToLoad(FilesToLoad& files, const T& resIdOrPath);
+    /// Load the files in parallel and save them into the loader repo. Files already loaded are reused
+    bool LoadParallel(const FilesToLoad& files, const libsiedler2::ArchivItem_Palette* palette);
+    /// Calculate the key identifying the input of the texture cache
+    uint64_t CalcTextureCacheKey() const;
 
     Log& logger_;
     const RttrConfig& config_;
@@ -245,6 +260,7 @@ private:
     std::vector<glFont> fonts;
 
     bool isWinterGFX_;
+    std::vector<AddonId> enabledAddons_;
     helpers::EnumArray<libsiedler2::Archiv*, Nation> nation_gfx;
     helpers::EnumArray<libsiedler2::Archiv*, Nation> nationIcons_;
     libsiedler2::Archiv* map_gfx;
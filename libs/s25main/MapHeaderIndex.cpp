@@ -0,0 +1,309 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "MapHeaderIndex.h"
+#include "helpers/containerUtils.h"
+#include "libsiedler2/Archiv.h"
+#include "libsiedler2/ArchivItem_Map.h"
+#include "libsiedler2/ArchivItem_Map_Header.h"
+#include "libsiedler2/ErrorCodes.h"
+#include "libsiedler2/prototypen.h"
+#include "s25util/BinaryFile.h"
+#include <boost/filesystem/operations.hpp>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace bfs = boost::filesystem;
+
+namespace {
+constexpr char indexSignature[] = "RTTRMAPIDX";
+constexpr unsigned indexSignatureLen = sizeof(indexSignature) - 1;
+constexpr uint16_t indexVersion = 1;
+/// Upper bound for the length of the long strings (paths and error messages) in the index
+constexpr unsigned maxLongStringLen = 4096;
+/// Minimum size of an entry in the index, i.e. with all strings empty
+constexpr unsigned minEntrySize = 4 + 8 + 8 + 1 + 4 + 1 + 1 + 1 + 2 + 2 + 1 + 1;
+
+void writeUInt64(BinaryFile& file, uint64_t value)
+{
+    file.WriteUnsignedInt(static_cast<uint32_t>(value >> 32));
+    file.WriteUnsignedInt(static_cast<uint32_t>(value));
+}
+
+uint64_t readUInt64(BinaryFile& file)
+{
+    const uint64_t value = file.ReadUnsignedInt();
+    return (value << 32) | file.ReadUnsignedInt();
+}
+
+/// Read a long string checking its length first, so a corrupt file can't trigger huge allocations
+std::string readLongString(BinaryFile& file, uint64_t fileSize)
+{
+    const unsigned pos = file.Tell();
+    const unsigned len = file.ReadUnsignedInt();
+    if(len > maxLongStringLen || len > fileSize - file.Tell())
+        throw std::runtime_error("Invalid string length");
+    file.Seek(pos, SEEK_SET);
+    return file.ReadLongString();
+}
+
+/// Get size and modification time of the file. Return false if it does not exist
+bool getFileStamp(const bfs::path& filePath, uint64_t& fileSize, std::time_t& lastWriteTime)
+{
+    boost::system::error_code ec;
+    fileSize = bfs::file_size(filePath, ec);
+    if(ec)
+        return false;
+    lastWriteTime = bfs::last_write_time(filePath, ec);
+    return !ec;
+}
+
+void readHeader(MapHeaderInfo& info)
+{
+    libsiedler2::Archiv archiv;
+    if(int ec = libsiedler2::loader::LoadMAP(info.filePath, archiv, true))
+    {
+        info.errorMsg = libsiedler2::getErrorString(ec);
+        return;
+    }
+    const auto* map = dynamic_cast<const libsiedler2::ArchivItem_Map*>(archiv[0]);
+    const auto* header = map ? dynamic_cast<const libsiedler2::ArchivItem_Map_Header*>(map->get(0)) : nullptr;
+    if(!header)
+    {
+        info.errorMsg = "Unexpected dynamic type of map";
+        return;
+    }
+    info.isValid = true;
+    info.name = header->getName();
+    info.author = header->getAuthor();
+    info.numPlayers = header->getNumPlayers();
+    info.width = header->getWidth();
+    info.height = header->getHeight();
+    info.gfxSet = header->getGfxSet();
+}
+} // namespace
+
+MapHeaderIndex::MapHeaderIndex() : isModified_(false), cancelScan_(false), isScanning_(false), numHeadersRead_(0) {}
+
+MapHeaderIndex::~MapHeaderIndex()
+{
+    CancelScan();
+}
+
+bool MapHeaderIndex::Load(const bfs::path& indexFilePath)
+{
+    boost::system::error_code ec;
+    if(!bfs::exists(indexFilePath, ec))
+        return false;
+    if(!LoadEntries(indexFilePath))
+    {
+        // Start with an empty index and replace the (broken or outdated) file on the next save
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.clear();
+        isModified_ = true;
+        return false;
+    }
+    return true;
+}
+
+bool MapHeaderIndex::LoadEntries(const bfs::path& indexFilePath)
+{
+    uint64_t fileSize;
+    std::time_t lastWriteTime;
+    BinaryFile file;
+    if(!getFileStamp(indexFilePath, fileSize, lastWriteTime) || !file.Open(indexFilePath, OFM_READ))
+        return false;
+    std::unordered_map<std::string, MapHeaderInfo> newEntries;
+    try
+    {
+        char signature[indexSignatureLen];
+        file.ReadRawData(signature, indexSignatureLen);
+        if(std::memcmp(signature, indexSignature, indexSignatureLen) != 0 || file.ReadUnsignedShort() != indexVersion)
+            return false;
+        const unsigned numEntries = file.ReadUnsignedInt();
+        if(numEntries > (fileSize - file.Tell()) / minEntrySize)
+            return false;
+        for(unsigned i = 0; i < numEntries; i++)
+        {
+            MapHeaderInfo info;
+            info.filePath = readLongString(file, fileSize);
+            info.fileSize = readUInt64(file);
+            info.lastWriteTime = static_cast<std::time_t>(static_cast<int64_t>(readUInt64(file)));
+            info.isValid = file.ReadUnsignedChar() != 0;
+            info.errorMsg = readLongString(file, fileSize);
+            info.name = file.ReadShortString();
+            info.author = file.ReadShortString();
+            info.numPlayers = file.ReadUnsignedChar();
+            info.width = file.ReadUnsignedShort();
+            info.height = file.ReadUnsignedShort();
+            info.gfxSet = file.ReadUnsignedChar();
+            info.hasLua = file.ReadUnsignedChar() != 0;
+            const std::string key = info.filePath.string();
+            newEntries[key] = std::move(info);
+        }
+    } catch(const std::exception&)
+    {
+        // Read errors as well as allocation failures caused by a corrupt file
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_ = std::move(newEntries);
+    isModified_ = false;
+    return true;
+}
+
+bool MapHeaderIndex::Save(const bfs::path& indexFilePath)
+{
+    boost::system::error_code ec;
+    bfs::create_directories(indexFilePath.parent_path(), ec);
+    BinaryFile file;
+    if(!file.Open(indexFilePath, OFM_WRITE))
+        return false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    file.WriteRawData(indexSignature, indexSignatureLen);
+    file.WriteUnsignedShort(indexVersion);
+    file.WriteUnsignedInt(entries_.size());
+    for(const auto& entry : entries_)
+    {
+        const MapHeaderInfo& info = entry.second;
+        file.WriteLongString(info.filePath.string());
+        writeUInt64(file, info.fileSize);
+        writeUInt64(file, static_cast<uint64_t>(static_cast<int64_t>(info.lastWriteTime)));
+        file.WriteUnsignedChar(info.isValid ? 1 : 0);
+        file.WriteLongString(info.errorMsg);
+        file.WriteShortString(info.name);
+        file.WriteShortString(info.author);
+        file.WriteUnsignedChar(info.numPlayers);
+        file.WriteUnsignedShort(info.width);
+        file.WriteUnsignedShort(info.height);
+        file.WriteUnsignedChar(info.gfxSet);
+        file.WriteUnsignedChar(info.hasLua ? 1 : 0);
+    }
+    isModified_ = false;
+    return true;
+}
+
+bool MapHeaderIndex::IsModified() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return isModified_;
+}
+
+MapHeaderInfo MapHeaderIndex::Get(const bfs::path& filePath)
+{
+    MapHeaderInfo info;
+    info.filePath = filePath;
+    if(!getFileStamp(filePath, info.fileSize, info.lastWriteTime))
+    {
+        info.errorMsg = "File not found";
+        return info;
+    }
+    // The script can be added or removed independently of the map, so always check it
+    boost::system::error_code ec;
+    info.hasLua = bfs::is_regular_file(bfs::path(filePath).replace_extension("lua"), ec);
+    const std::string key = filePath.string();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto it = entries_.find(key);
+        if(it != entries_.end() && it->second.fileSize == info.fileSize
+           && it->second.lastWriteTime == info.lastWriteTime)
+        {
+            if(it->second.hasLua != info.hasLua)
+            {
+                it->second.hasLua = info.hasLua;
+                isModified_ = true;
+            }
+            return it->second;
+        }
+    }
+    // Read without holding the lock as this is the slow part
+    readHeader(info);
+    ++numHeadersRead_;
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[key] = info;
+    isModified_ = true;
+    return info;
+}
+
+void MapHeaderIndex::Invalidate(const bfs::path& filePath)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if(entries_.erase(filePath.string()))
+        isModified_ = true;
+}
+
+void MapHeaderIndex::StartScan(std::vector<bfs::path> files)
+{
+    CancelScan();
+    cancelScan_ = false;
+    isScanning_ = true;
+    scanThread_ = std::thread([this, files = std::move(files)]() { Scan(files); });
+}
+
+void MapHeaderIndex::CancelScan()
+{
+    cancelScan_ = true;
+    if(scanThread_.joinable())
+        scanThread_.join();
+    isScanning_ = false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    results_.clear();
+}
+
+std::vector<MapHeaderInfo> MapHeaderIndex::FetchResults()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<MapHeaderInfo> result;
+    std::swap(result, results_);
+    return result;
+}
+
+void MapHeaderIndex::Scan(const std::vector<bfs::path>& files)
+{
+    // Forget about maps which were removed from the scanned folders
+    {
+        std::set<bfs::path> folders;
+        std::unordered_set<std::string> filePaths;
+        for(const bfs::path& file : files)
+        {
+            folders.insert(file.parent_path());
+            filePaths.insert(file.string());
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        for(auto it = entries_.begin(); it != entries_.end();)
+        {
+            if(!helpers::contains(filePaths, it->first)
+               && helpers::contains(folders, it->second.filePath.parent_path()))
+            {
+                it = entries_.erase(it);
+                isModified_ = true;
+            } else
+                ++it;
+        }
+    }
+    for(const bfs::path& file : files)
+    {
+        if(cancelScan_)
+            break;
+        MapHeaderInfo info = Get(file);
+        std::lock_guard<std::mutex> lock(mutex_);
+        results_.push_back(std::move(info));
+    }
+    isScanning_ = false;
+}
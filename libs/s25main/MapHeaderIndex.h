@@ -0,0 +1,97 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <boost/filesystem/path.hpp>
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/// Header information of a map file as shown in the map selection
+struct MapHeaderInfo
+{
+    boost::filesystem::path filePath;
+    /// Size and modification time of the file when the header was read
+    uint64_t fileSize = 0;
+    std::time_t lastWriteTime = 0;
+    /// False if the header could not be read, errorMsg contains the reason then
+    bool isValid = false;
+    std::string errorMsg;
+    /// Name and author as stored in the map (not converted to UTF-8)
+    std::string name, author;
+    uint8_t numPlayers = 0;
+    uint16_t width = 0, height = 0;
+    uint8_t gfxSet = 0;
+    /// True if there is a lua script for the map
+    bool hasLua = false;
+};
+
+/// Index of map headers which can be stored on disk so the headers of unchanged maps do not need to be read again.
+/// The headers of a list of maps can be read in a background thread from which the results can be fetched
+/// incrementally.
+class MapHeaderIndex
+{
+public:
+    MapHeaderIndex();
+    /// Cancels a running scan
+    ~MapHeaderIndex();
+
+    /// Replace the entries by the ones stored in the given file. Return false if it could not be read.
+    /// An existing but invalid file clears the index and is replaced on the next save
+    bool Load(const boost::filesystem::path& indexFilePath);
+    bool Save(const boost::filesystem::path& indexFilePath);
+    /// Return true if entries were added or updated since loading or saving
+    bool IsModified() const;
+
+    /// Return the header info of the given file, reading it if the indexed entry is missing or outdated
+    MapHeaderInfo Get(const boost::filesystem::path& filePath);
+    /// Remove the entry of the given file so it is read on the next access
+    void Invalidate(const boost::filesystem::path& filePath);
+
+    /// Start getting the header infos of the given files in the background. A running scan is cancelled first.
+    /// Entries of files from the same folders which are not in the list are removed.
+    void StartScan(std::vector<boost::filesystem::path> files);
+    void CancelScan();
+    /// Return true while the scan is running. Results might still be pending when this returns false
+    bool IsScanning() const { return isScanning_; }
+    /// Return the header infos of the scan which were not fetched yet in order of the files passed
+    std::vector<MapHeaderInfo> FetchResults();
+
+    /// Number of headers which were read from map files instead of the index
+    unsigned GetNumHeadersRead() const { return numHeadersRead_; }
+
+private:
+    /// Read the entries of the index file and replace the current ones on success
+    bool LoadEntries(const boost::filesystem::path& indexFilePath);
+    void Scan(const std::vector<boost::filesystem::path>& files);
+
+    mutable std::mutex mutex_;
+    /// Entries by the path of the map file
+    std::unordered_map<std::string, MapHeaderInfo> entries_;
+    bool isModified_;
+    std::vector<MapHeaderInfo> results_;
+    std::thread scanThread_;
+    std::atomic<bool> cancelScan_;
+    std::atomic<bool> isScanning_;
+    std::atomic<unsigned> numHeadersRead_;
+};
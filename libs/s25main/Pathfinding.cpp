@@ -40,6 +40,12 @@ helpers::OptionalEnum<Direction> GameWorldBase::FindHumanPath(const MapPoint sta
         return boost::none;
 }
 
+bool GameWorldBase::DoesHumanPathExist(const MapPoint start, const MapPoint dest, const unsigned maxLength,
+                                       unsigned* length) const
+{
+    return GetFreePathFinder().DoesPathExist(start, dest, maxLength, length, PathConditionHuman(*this));
+}
+
 /// Wegfindung für Menschen im Straßennetz
 RoadPathDirection GameWorldGame::FindHumanPathOnRoads(const noRoadNode& start, const noRoadNode& goal, unsigned* length,
                                                       MapPoint* firstPt, const RoadSegment* const forbidden)
@@ -80,6 +86,9 @@ bool GameWorldBase::FindShipPathToHarbor(const MapPoint start, unsigned harborId
     }
     // Add a few fields reserve
     maxDistance += 6;
+    // Ships at a harbor use the precalculated routes
+    if(GetHarborRoutes().HasRoutesFrom(start))
+        return GetHarborRoutes().FindRoute(start, GetCoastalPoint(harborId, seaId), maxDistance, route, length);
     return FindShipPath(start, GetCoastalPoint(harborId, seaId), maxDistance, route, length);
 }
 
@@ -17,11 +17,74 @@
 
 #include "Replay.h"
 #include "Savegame.h"
+#include "compression/CompressionCodec.h"
 #include "network/PlayerGameCommands.h"
 #include "gameTypes/MapInfo.h"
 #include <boost/filesystem.hpp>
+#include <array>
 #include <memory>
 #include <mygettext/mygettext.h>
+#include <stdexcept>
+
+namespace {
+/// Tags preceding the blocks and the index in the file
+constexpr uint8_t blockTag = 1;
+constexpr uint8_t indexTag = 2;
+/// The file ends with the position of the index followed by this
+constexpr std::array<char, 4> indexMagic = {'R', 'I', 'D', 'X'};
+constexpr unsigned indexTrailerSize = 4 + indexMagic.size();
+/// A block is written when it reaches this size or spans this many GFs. Limits the loss if the game crashes
+constexpr unsigned maxBlockSize = 64 * 1024;
+constexpr unsigned maxBlockGFs = 1000;
+
+void pushDelta(Serializer& ser, unsigned value, unsigned prevValue)
+{
+    // Zigzag encoding, so small negative differences are small too
+    const auto diff = static_cast<uint32_t>(value - prevValue);
+    const uint32_t sign = (diff >> 31) ? ~0u : 0u;
+    ser.PushVarSize((diff << 1) ^ sign);
+}
+
+unsigned popDelta(Serializer& ser, unsigned prevValue)
+{
+    const uint32_t value = ser.PopVarSize();
+    return prevValue + ((value >> 1) ^ (0u - (value & 1u)));
+}
+
+void pushChecksum(Serializer& ser, const AsyncChecksum& checksum, const AsyncChecksum& prev)
+{
+    pushDelta(ser, checksum.randChecksum, prev.randChecksum);
+    pushDelta(ser, checksum.objCt, prev.objCt);
+    pushDelta(ser, checksum.objIdCt, prev.objIdCt);
+    pushDelta(ser, checksum.eventCt, prev.eventCt);
+    pushDelta(ser, checksum.evInstanceCt, prev.evInstanceCt);
+    pushDelta(ser, checksum.stateHash, prev.stateHash);
+}
+
+/// Read the checksum of versions without the world state hash
+AsyncChecksum popChecksumWithoutStateHash(Serializer& ser)
+{
+    AsyncChecksum checksum;
+    checksum.randChecksum = ser.PopUnsignedInt();
+    checksum.objCt = ser.PopUnsignedInt();
+    checksum.objIdCt = ser.PopUnsignedInt();
+    checksum.eventCt = ser.PopUnsignedInt();
+    checksum.evInstanceCt = ser.PopUnsignedInt();
+    return checksum;
+}
+
+AsyncChecksum popChecksum(Serializer& ser, const AsyncChecksum& prev)
+{
+    AsyncChecksum checksum;
+    checksum.randChecksum = popDelta(ser, prev.randChecksum);
+    checksum.objCt = popDelta(ser, prev.objCt);
+    checksum.objIdCt = popDelta(ser, prev.objIdCt);
+    checksum.eventCt = popDelta(ser, prev.eventCt);
+    checksum.evInstanceCt = popDelta(ser, prev.evInstanceCt);
+    checksum.stateHash = popDelta(ser, prev.stateHash);
+    return checksum;
+}
+} // namespace
 
 std::string Replay::GetSignature() const
 {
@@ -31,12 +94,24 @@ std::string Replay::GetSignature() const
 uint16_t Replay::GetVersion() const
 {
     /// Version des Replay-Formates
+    // Changelog:
+    // 7: Checksums of the game commands contain the world state hash
+    // 8: Embedded map data starts with a compression header (raw bzip2 data is still readable)
+    // 9: Commands stored in compressed blocks followed by an index (old command format is still readable)
+    return 9;
+}
+
+uint16_t Replay::GetMinVersion() const
+{
     return 6;
 }
 
 //////////////////////////////////////////////////////////////////////////
 
-Replay::Replay() : random_init(0), isRecording(false), lastGF_(0), last_gf_file_pos(0), mapType_(MapType::OldMap) {}
+Replay::Replay()
+    : random_init(0), isRecording(false), lastGF_(0), last_gf_file_pos(0), mapType_(MapType::OldMap), cmdStreamPos_(0),
+      curCmdPos_(0), curBlockInfo_(), nextBlockIdx_(0), nextCmdIdx_(0), prevGF_(0)
+{}
 
 Replay::~Replay()
 {
@@ -45,12 +120,17 @@ Replay::~Replay()
 
 void Replay::Close()
 {
-    file.Close();
+    StopRecording();
     ClearPlayers();
 }
 
 void Replay::StopRecording()
 {
+    if(IsRecording())
+    {
+        WriteBlock();
+        WriteBlockIndex();
+    }
     file.Close();
     isRecording = false;
 }
@@ -68,6 +148,9 @@ bool Replay::StartRecording(const boost::filesystem::path& filepath, const MapIn
     /// End-GF (erstmal nur 0, wird dann im Spiel immer geupdatet)
     lastGF_ = 0;
     mapType_ = mapInfo.type;
+    blocks_.clear();
+    curBlock_.Clear();
+    curBlockInfo_ = BlockInfo();
 
     // Write header
     WriteAllHeaderData(file, mapInfo.title);
@@ -104,6 +187,7 @@ bool Replay::StartRecording(const boost::filesystem::path& filepath, const MapIn
             break;
         case MapType::Savegame: mapInfo.savegame->Save(file, GetMapName()); break;
     }
+    cmdStreamPos_ = file.Tell();
     // Alles sofort reinschreiben
     file.Flush();
 
@@ -187,6 +271,15 @@ bool Replay::LoadGameData(MapInfo& mapInfo)
                 }
                 break;
         }
+        cmdStreamPos_ = curCmdPos_ = file.Tell();
+        blocks_.clear();
+        curBlock_.Clear();
+        nextBlockIdx_ = nextCmdIdx_ = 0;
+        if(HasBlocks())
+        {
+            ReadBlockIndex();
+            file.Seek(cmdStreamPos_, SEEK_SET);
+        }
     } catch(std::runtime_error& e)
     {
         lastErrorMsg = e.what();
@@ -201,15 +294,10 @@ void Replay::AddChatCommand(unsigned gf, uint8_t player, ChatDestination dest, c
     if(!file.IsValid())
         return;
 
-    file.WriteUnsignedInt(gf);
-
-    file.WriteUnsignedChar(static_cast<uint8_t>(ReplayCommand::Chat));
-    file.WriteUnsignedChar(player);
-    file.WriteUnsignedChar(static_cast<uint8_t>(dest));
-    file.WriteLongString(str);
-
-    // Sofort rein damit
-    file.Flush();
+    StartCommand(gf, ReplayCommand::Chat);
+    curBlock_.PushUnsignedChar(player);
+    curBlock_.PushUnsignedChar(static_cast<uint8_t>(dest));
+    curBlock_.PushLongString(str);
 }
 
 void Replay::AddGameCommand(unsigned gf, uint8_t player, const PlayerGameCommands& cmds)
@@ -218,21 +306,170 @@ void Replay::AddGameCommand(unsigned gf, uint8_t player, const PlayerGameCommand
     if(!file.IsValid())
         return;
 
-    file.WriteUnsignedInt(gf);
+    StartCommand(gf, ReplayCommand::Game);
+    curBlock_.PushUnsignedChar(player);
+    // The checksum is the same for all players in a GF and changes slowly otherwise
+    pushChecksum(curBlock_, cmds.checksum, prevChecksum_);
+    prevChecksum_ = cmds.checksum;
+    curBlock_.PushVarSize(static_cast<unsigned>(cmds.gcs.size()));
+    for(const gc::GameCommandPtr& gc : cmds.gcs)
+        gc->Serialize(curBlock_);
+}
 
-    file.WriteUnsignedChar(static_cast<uint8_t>(ReplayCommand::Game));
-    Serializer ser;
-    ser.PushUnsignedChar(player);
-    cmds.Serialize(ser);
-    ser.WriteToFile(file);
+void Replay::StartCommand(unsigned gf, ReplayCommand type)
+{
+    if(curBlockInfo_.numCommands > 0u
+       && (gf < prevGF_ || gf - curBlockInfo_.firstGF >= maxBlockGFs || curBlock_.GetLength() >= maxBlockSize))
+        WriteBlock();
+    if(curBlockInfo_.numCommands == 0u)
+    {
+        // Blocks are decoded independently
+        curBlockInfo_.firstGF = prevGF_ = gf;
+        prevChecksum_ = AsyncChecksum();
+    }
+    curBlock_.PushVarSize(gf - prevGF_);
+    curBlock_.PushUnsignedChar(static_cast<uint8_t>(type));
+    prevGF_ = curBlockInfo_.lastGF = gf;
+    curBlockInfo_.numCommands++;
+}
+
+void Replay::Flush()
+{
+    if(!IsRecording())
+        return;
+    WriteBlock();
+    file.Flush();
+}
 
-    // Sofort rein damit
+void Replay::WriteBlock()
+{
+    if(curBlockInfo_.numCommands == 0u)
+        return;
+    const std::vector<char> compressedData = compressWithHeader(
+      reinterpret_cast<const char*>(curBlock_.GetData()), curBlock_.GetLength(), CompressionCodec::GetFastCodec());
+    curBlockInfo_.filePos = file.Tell();
+    file.WriteUnsignedChar(blockTag);
+    file.WriteUnsignedInt(curBlockInfo_.firstGF);
+    file.WriteUnsignedInt(curBlockInfo_.lastGF);
+    file.WriteUnsignedInt(curBlockInfo_.numCommands);
+    file.WriteUnsignedInt(curBlock_.GetLength());
+    file.WriteUnsignedInt(compressedData.size());
+    file.WriteRawData(compressedData.data(), compressedData.size());
     file.Flush();
+    blocks_.push_back(curBlockInfo_);
+    curBlockInfo_ = BlockInfo();
+    curBlock_.Clear();
+}
+
+void Replay::WriteBlockIndex()
+{
+    const unsigned indexPos = file.Tell();
+    file.WriteUnsignedChar(indexTag);
+    file.WriteUnsignedInt(blocks_.size());
+    for(const BlockInfo& block : blocks_)
+    {
+        file.WriteUnsignedInt(block.firstGF);
+        file.WriteUnsignedInt(block.lastGF);
+        file.WriteUnsignedInt(block.numCommands);
+        file.WriteUnsignedInt(block.filePos);
+    }
+    file.WriteUnsignedInt(indexPos);
+    file.WriteRawData(indexMagic.data(), indexMagic.size());
+    file.Flush();
+}
+
+void Replay::ReadBlockIndex()
+{
+    blocks_.clear();
+    file.Seek(0, SEEK_END);
+    const unsigned fileSize = file.Tell();
+    if(fileSize >= cmdStreamPos_ + indexTrailerSize)
+    {
+        file.Seek(fileSize - indexTrailerSize, SEEK_SET);
+        const unsigned indexPos = file.ReadUnsignedInt();
+        std::array<char, indexMagic.size()> magic;
+        file.ReadRawData(magic.data(), magic.size());
+        if(magic == indexMagic && indexPos >= cmdStreamPos_ && indexPos < fileSize - indexTrailerSize)
+        {
+            file.Seek(indexPos, SEEK_SET);
+            if(file.ReadUnsignedChar() == indexTag)
+            {
+                const unsigned numBlocks = file.ReadUnsignedInt();
+                if(numBlocks > (fileSize - indexPos) / 16u)
+                    throw std::runtime_error(_("Invalid replay index"));
+                blocks_.resize(numBlocks);
+                for(BlockInfo& block : blocks_)
+                {
+                    block.firstGF = file.ReadUnsignedInt();
+                    block.lastGF = file.ReadUnsignedInt();
+                    block.numCommands = file.ReadUnsignedInt();
+                    block.filePos = file.ReadUnsignedInt();
+                }
+                return;
+            }
+        }
+    }
+    // No index, e.g. because the game crashed. Scan the block headers and ignore a truncated last block
+    file.Seek(cmdStreamPos_, SEEK_SET);
+    try
+    {
+        while(file.Tell() < fileSize && file.ReadUnsignedChar() == blockTag)
+        {
+            BlockInfo block;
+            block.filePos = file.Tell() - 1u;
+            block.firstGF = file.ReadUnsignedInt();
+            block.lastGF = file.ReadUnsignedInt();
+            block.numCommands = file.ReadUnsignedInt();
+            file.ReadUnsignedInt(); // Uncompressed size
+            const unsigned compressedSize = file.ReadUnsignedInt();
+            if(compressedSize > fileSize - file.Tell())
+                break;
+            file.Seek(compressedSize, SEEK_CUR);
+            blocks_.push_back(block);
+        }
+    } catch(std::runtime_error&)
+    {}
+}
+
+void Replay::LoadBlock(unsigned idx)
+{
+    const BlockInfo& block = blocks_[idx];
+    file.Seek(block.filePos, SEEK_SET);
+    if(file.ReadUnsignedChar() != blockTag)
+        throw std::runtime_error(_("Invalid replay block"));
+    file.Seek(3 * sizeof(uint32_t), SEEK_CUR); // GFs and number of commands
+    std::vector<char> data(file.ReadUnsignedInt());
+    std::vector<char> compressedData(file.ReadUnsignedInt());
+    file.ReadRawData(compressedData.data(), compressedData.size());
+    decompressWithHeader(compressedData.data(), compressedData.size(), data.data(), data.size());
+    curBlock_.Clear();
+    curBlock_.PushRawData(data.data(), data.size());
+    prevGF_ = block.firstGF;
+    prevChecksum_ = AsyncChecksum();
+    nextBlockIdx_ = idx + 1u;
 }
 
 bool Replay::ReadGF(unsigned* gf)
 {
     RTTR_Assert(IsReplaying());
+    if(HasBlocks())
+    {
+        curCmdPos_ = nextCmdIdx_;
+        while(curBlock_.GetBytesLeft() == 0u)
+        {
+            if(nextBlockIdx_ >= blocks_.size())
+            {
+                *gf = 0xFFFFFFFF;
+                return false;
+            }
+            LoadBlock(nextBlockIdx_);
+        }
+        prevGF_ += curBlock_.PopVarSize();
+        *gf = prevGF_;
+        nextCmdIdx_++;
+        return true;
+    }
+    curCmdPos_ = file.Tell();
     try
     {
         *gf = file.ReadUnsignedInt();
@@ -250,12 +487,21 @@ ReplayCommand Replay::ReadRCType()
 {
     RTTR_Assert(IsReplaying());
     // Type auslesen
+    if(HasBlocks())
+        return ReplayCommand(curBlock_.PopUnsignedChar());
     return ReplayCommand(file.ReadUnsignedChar());
 }
 
 void Replay::ReadChatCommand(uint8_t& player, uint8_t& dest, std::string& str)
 {
     RTTR_Assert(IsReplaying());
+    if(HasBlocks())
+    {
+        player = curBlock_.PopUnsignedChar();
+        dest = curBlock_.PopUnsignedChar();
+        str = curBlock_.PopLongString();
+        return;
+    }
     player = file.ReadUnsignedChar();
     dest = file.ReadUnsignedChar();
     str = file.ReadLongString();
@@ -264,10 +510,97 @@ void Replay::ReadChatCommand(uint8_t& player, uint8_t& dest, std::string& str)
 void Replay::ReadGameCommand(uint8_t& player, PlayerGameCommands& cmds)
 {
     RTTR_Assert(IsReplaying());
+    if(HasBlocks())
+    {
+        player = curBlock_.PopUnsignedChar();
+        cmds.checksum = prevChecksum_ = popChecksum(curBlock_, prevChecksum_);
+        cmds.gcs.resize(curBlock_.PopVarSize());
+        for(gc::GameCommandPtr& gc : cmds.gcs)
+            gc = gc::GameCommand::Deserialize(curBlock_);
+        return;
+    }
     Serializer ser;
     ser.ReadFromFile(file);
     player = ser.PopUnsignedChar();
-    cmds.Deserialize(ser);
+    if(HasStateHash())
+    {
+        cmds.Deserialize(ser);
+        return;
+    }
+    cmds.checksum = popChecksumWithoutStateHash(ser);
+    cmds.gcs.resize(ser.PopUnsignedInt());
+    for(gc::GameCommandPtr& gc : cmds.gcs)
+        gc = gc::GameCommand::Deserialize(ser);
+}
+
+void Replay::SkipCommand(ReplayCommand rc)
+{
+    uint8_t player, dest;
+    if(rc == ReplayCommand::Chat)
+    {
+        std::string str;
+        ReadChatCommand(player, dest, str);
+    } else if(rc == ReplayCommand::Game)
+    {
+        PlayerGameCommands cmds;
+        ReadGameCommand(player, cmds);
+    }
+}
+
+unsigned Replay::GetFirstCommandIdx(unsigned blockIdx) const
+{
+    unsigned result = 0;
+    for(unsigned i = 0; i < blockIdx; i++)
+        result += blocks_[i].numCommands;
+    return result;
+}
+
+unsigned Replay::GetNumCommands() const
+{
+    return GetFirstCommandIdx(blocks_.size());
+}
+
+void Replay::SeekToCommand(unsigned cmdPos)
+{
+    RTTR_Assert(IsReplaying());
+    if(!HasBlocks())
+    {
+        file.Seek(cmdPos, SEEK_SET);
+        return;
+    }
+    unsigned blockIdx = 0, firstCmdIdx = 0;
+    for(; blockIdx < blocks_.size() && firstCmdIdx + blocks_[blockIdx].numCommands <= cmdPos; blockIdx++)
+        firstCmdIdx += blocks_[blockIdx].numCommands;
+    nextCmdIdx_ = firstCmdIdx;
+    if(blockIdx == blocks_.size())
+    {
+        // At the end
+        curBlock_.Clear();
+        nextBlockIdx_ = blockIdx;
+        return;
+    }
+    LoadBlock(blockIdx);
+    unsigned gf;
+    while(nextCmdIdx_ < cmdPos && ReadGF(&gf))
+        SkipCommand(ReadRCType());
+}
+
+void Replay::SeekToGF(unsigned gf)
+{
+    RTTR_Assert(IsReplaying());
+    if(HasBlocks())
+    {
+        // Start at the first block containing commands at or after the GF
+        unsigned blockIdx = 0;
+        while(blockIdx < blocks_.size() && blocks_[blockIdx].lastGF < gf)
+            blockIdx++;
+        SeekToCommand(GetFirstCommandIdx(blockIdx));
+    } else
+        SeekToCommand(cmdStreamPos_);
+    unsigned curGF;
+    while(ReadGF(&curGF) && curGF < gf)
+        SkipCommand(ReadRCType());
+    SeekToCommand(GetCommandPos());
 }
 
 void Replay::UpdateLastGF(unsigned last_gf)
@@ -17,11 +17,14 @@
 
 #pragma once
 
+#include "AsyncChecksum.h"
 #include "SavedFile.h"
 #include "gameTypes/ChatDestination.h"
 #include "gameTypes/MapType.h"
 #include "s25util/BinaryFile.h"
+#include "s25util/Serializer.h"
 #include <string>
+#include <vector>
 
 class MapInfo;
 struct PlayerGameCommands;
@@ -39,9 +42,21 @@ enum class ReplayCommand
 ///     File header (version etc.), record time, map name, player names, length (last GF), savegame header (if
 ///     applicable)
 /// All game relevant data is stored afterwards
+/// Since version 9 the commands are stored in compressed blocks with GFs and checksums delta encoded.
+/// An index of all blocks is appended when recording stops, older versions are read sequentially.
 class Replay : public SavedFile
 {
 public:
+    /// Block of commands in the file
+    struct BlockInfo
+    {
+        /// GF of the first and last command in the block
+        unsigned firstGF, lastGF;
+        unsigned numCommands;
+        /// Position of the block in the file
+        unsigned filePos;
+    };
+
     Replay();
     ~Replay() override;
 
@@ -49,6 +64,7 @@ public:
 
     std::string GetSignature() const override;
     uint16_t GetVersion() const override;
+    uint16_t GetMinVersion() const override;
 
     /// Beginnt die Save-Datei und schreibt den Header
     bool StartRecording(const boost::filesystem::path& filepath, const MapInfo& mapInfo);
@@ -69,6 +85,9 @@ public:
     /// Fügt ein Spiel-Kommando hinzu (schreibt)
     void AddGameCommand(unsigned gf, uint8_t player, const PlayerGameCommands& cmds);
 
+    /// Write all pending commands to the file
+    void Flush();
+
     /// Liest RC-Type aus, liefert false, wenn das Replay zu Ende ist
     bool ReadGF(unsigned* gf);
     /// RC-Type aus, liefert false
@@ -77,6 +96,23 @@ public:
     void ReadChatCommand(uint8_t& player, uint8_t& dest, std::string& str);
     void ReadGameCommand(uint8_t& player, PlayerGameCommands& cmds);
 
+    /// Return the position of the command whose GF was read last, to be used with SeekToCommand
+    unsigned GetCommandPos() const { return curCmdPos_; }
+    /// Continue reading at the given command. ReadGF has to be called next
+    void SeekToCommand(unsigned cmdPos);
+    /// Continue reading at the first command with a GF of at least the given one. ReadGF has to be called next.
+    /// Uses the block index if the format has one, otherwise all previous commands are skipped
+    void SeekToGF(unsigned gf);
+
+    /// Return true if the commands are stored in blocks, i.e. the block functions below can be used
+    bool HasBlocks() const { return GetFileVersion() >= firstBlockVersion; }
+    /// Blocks in the replay, available after LoadGameData
+    const std::vector<BlockInfo>& GetBlocks() const { return blocks_; }
+    /// Number of commands in the replay according to the block index
+    unsigned GetNumCommands() const;
+    /// Return true if the checksums of the game commands contain the world state hash
+    bool HasStateHash() const { return GetFileVersion() >= firstStateHashVersion; }
+
     /// Aktualisiert den End-GF, schreibt ihn in die Replaydatei (nur beim Spielen bzw. Schreiben verwenden!)
     void UpdateLastGF(unsigned last_gf);
 
@@ -87,6 +123,25 @@ public:
     unsigned random_init;
 
 protected:
+    /// First version with the world state hash in the checksums
+    static constexpr uint16_t firstStateHashVersion = 7;
+    /// First version storing the commands in blocks
+    static constexpr uint16_t firstBlockVersion = 9;
+
+    uint16_t GetFileVersion() const { return isRecording ? GetVersion() : fileVersion; }
+    /// Add the GF and type of a command to the current block, starting a new one if required
+    void StartCommand(unsigned gf, ReplayCommand type);
+    void WriteBlock();
+    void WriteBlockIndex();
+    /// Read the block index or rebuild it by scanning the blocks if the replay was not closed properly
+    void ReadBlockIndex();
+    /// Load the block with the given index as the current block
+    void LoadBlock(unsigned idx);
+    /// Skip the rest of the command whose type has been read
+    void SkipCommand(ReplayCommand rc);
+    /// Return the index of the first command in the given block
+    unsigned GetFirstCommandIdx(unsigned blockIdx) const;
+
     BinaryFile file;
     bool isRecording;
     /// End-GF
@@ -94,4 +149,21 @@ protected:
     /// Position des End-GF in der Datei
     unsigned last_gf_file_pos;
     MapType mapType_;
+    /// Position of the first command in the file
+    unsigned cmdStreamPos_;
+    /// Position of the command whose GF was read last
+    unsigned curCmdPos_;
+
+    std::vector<BlockInfo> blocks_;
+    /// Commands of the current block. Not yet written when recording, decompressed when replaying
+    Serializer curBlock_;
+    /// Block being filled when recording
+    BlockInfo curBlockInfo_;
+    /// Index of the block to load when the current one is exhausted during replaying
+    unsigned nextBlockIdx_;
+    /// Index of the next command to read when replaying blocks
+    unsigned nextCmdIdx_;
+    /// Values of the previous command in the current block used for delta encoding
+    unsigned prevGF_;
+    AsyncChecksum prevChecksum_;
 };
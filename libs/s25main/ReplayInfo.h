@@ -18,12 +18,14 @@
 #pragma once
 
 #include "Replay.h"
+#include "ReplayKeyframes.h"
 #include <boost/filesystem/path.hpp>
+#include <memory>
 #include <string>
 
 struct ReplayInfo
 {
-    ReplayInfo() : async(0), end(false), next_gf(0), all_visible(false) {}
+    ReplayInfo() : async(0), end(false), next_gf(0), all_visible(false), seekTargetGF(0) {}
 
     /// Replaydatei
     Replay replay;
@@ -35,4 +37,8 @@ struct ReplayInfo
     unsigned next_gf;
     /// Alles sichtbar (FoW deaktiviert)
     bool all_visible;
+    /// Snapshots for seeking (only when playing)
+    std::unique_ptr<ReplayKeyframes> keyframes;
+    /// GF to jump to after loading a keyframe (0 if none)
+    unsigned seekTargetGF;
 };
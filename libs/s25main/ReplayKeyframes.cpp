@@ -0,0 +1,123 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "ReplayKeyframes.h"
+#include "EventManager.h"
+#include "Game.h"
+#include "SerializedGameData.h"
+#include "helpers/toString.h"
+#include "s25util/BinaryFile.h"
+#include "s25util/Log.h"
+#include <boost/filesystem/operations.hpp>
+#include <mygettext/mygettext.h>
+
+namespace bfs = boost::filesystem;
+
+ReplayKeyframes::ReplayKeyframes(unsigned interval, size_t maxMemorySize, boost::filesystem::path cacheDir)
+    : interval_(interval), maxMemorySize_(maxMemorySize), memorySize_(0)
+{
+    RTTR_Assert(interval_ > 0);
+    // Use a unique sub directory so multiple instances don't interfere
+    if(!cacheDir.empty())
+        cacheDir_ = cacheDir / bfs::unique_path("%%%%-%%%%-%%%%");
+}
+
+ReplayKeyframes::~ReplayKeyframes()
+{
+    if(!cacheDir_.empty())
+    {
+        boost::system::error_code ec;
+        bfs::remove_all(cacheDir_, ec);
+    }
+}
+
+bool ReplayKeyframes::IsKeyframeDue(unsigned gf) const
+{
+    // Always have a keyframe at the start
+    if(keyframes_.empty())
+        return true;
+    if(gf % interval_ != 0 || keyframes_.count(gf))
+        return false;
+    return memorySize_ < maxMemorySize_ || !cacheDir_.empty();
+}
+
+void ReplayKeyframes::Add(const std::shared_ptr<Game>& game, unsigned replayFilePos, unsigned nextReplayGF)
+{
+    SerializedGameData sgd;
+    sgd.MakeSnapshot(game);
+
+    Entry entry;
+    entry.keyframe = Keyframe{game->em_->GetCurrentGF(), replayFilePos, nextReplayGF, RANDOM.GetCurrentState()};
+    entry.dataSize = sgd.GetLength();
+
+    if(memorySize_ + entry.dataSize > maxMemorySize_ && !keyframes_.empty())
+    {
+        if(cacheDir_.empty())
+            return;
+        entry.filePath = GetCacheFilePath(entry.keyframe.gf);
+        boost::system::error_code ec;
+        bfs::create_directories(cacheDir_, ec);
+        BinaryFile file;
+        if(ec || !file.Open(entry.filePath, OFM_WRITE))
+        {
+            LOG.write(_("Could not write replay keyframe to %1%\n")) % entry.filePath;
+            return;
+        }
+        file.WriteRawData(sgd.GetData(), entry.dataSize);
+    } else
+    {
+        entry.data.assign(sgd.GetData(), sgd.GetData() + entry.dataSize);
+        memorySize_ += entry.dataSize;
+    }
+    keyframes_[entry.keyframe.gf] = std::move(entry);
+}
+
+const ReplayKeyframes::Keyframe* ReplayKeyframes::Find(unsigned gf) const
+{
+    auto it = keyframes_.upper_bound(gf);
+    if(it == keyframes_.begin())
+        return nullptr;
+    return &(--it)->second.keyframe;
+}
+
+void ReplayKeyframes::Restore(const Keyframe& keyframe, const std::shared_ptr<Game>& game,
+                              ILocalGameState& localGameState) const
+{
+    const auto it = keyframes_.find(keyframe.gf);
+    RTTR_Assert(it != keyframes_.end());
+    const Entry& entry = it->second;
+
+    SerializedGameData sgd;
+    if(entry.filePath.empty())
+        sgd.PushRawData(entry.data.data(), entry.dataSize);
+    else
+    {
+        BinaryFile file;
+        if(!file.Open(entry.filePath, OFM_READ))
+            throw SerializedGameData::Error(_("Could not read replay keyframe from ") + entry.filePath.string());
+        std::vector<char> data(entry.dataSize);
+        file.ReadRawData(data.data(), data.size());
+        sgd.PushRawData(data.data(), data.size());
+    }
+    sgd.ReadSnapshot(game, localGameState);
+    RANDOM.ResetState(keyframe.rngState);
+}
+
+boost::filesystem::path ReplayKeyframes::GetCacheFilePath(unsigned gf) const
+{
+    return cacheDir_ / ("keyframe_" + helpers::toString(gf) + ".dat");
+}
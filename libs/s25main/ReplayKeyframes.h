@@ -0,0 +1,86 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "random/Random.h"
+#include <boost/filesystem/path.hpp>
+#include <map>
+#include <memory>
+#include <vector>
+
+class Game;
+class ILocalGameState;
+
+/// Periodic snapshots of the game state while playing a replay, indexed by GF.
+/// Used to seek in a replay by restoring the nearest earlier snapshot and only simulating the remaining GFs.
+/// Snapshots are kept in memory up to a given size. Further ones are written to a cache directory if one is given.
+class ReplayKeyframes
+{
+public:
+    struct Keyframe
+    {
+        /// GF at which the snapshot was taken (before executing the commands of that GF)
+        unsigned gf;
+        /// Position of the next command in the replay (see Replay::GetCommandPos)
+        unsigned replayFilePos;
+        /// GF of the next command in the replay
+        unsigned nextReplayGF;
+        /// State of the RNG (not part of the snapshot)
+        UsedPRNG rngState;
+    };
+
+    static constexpr unsigned defaultInterval = 5000;
+    static constexpr size_t defaultMaxMemorySize = 512u * 1024u * 1024u;
+
+    explicit ReplayKeyframes(unsigned interval = defaultInterval, size_t maxMemorySize = defaultMaxMemorySize,
+                             boost::filesystem::path cacheDir = boost::filesystem::path());
+    ~ReplayKeyframes();
+
+    unsigned GetInterval() const { return interval_; }
+    /// Return true if a keyframe should be created at the given GF
+    bool IsKeyframeDue(unsigned gf) const;
+    /// Create a keyframe from the current state of the game. Throws SerializedGameData::Error on failure
+    void Add(const std::shared_ptr<Game>& game, unsigned replayFilePos, unsigned nextReplayGF);
+    /// Return the last keyframe at or before the given GF or nullptr if there is none
+    const Keyframe* Find(unsigned gf) const;
+    /// Load the state of the keyframe into the freshly created game and reset the RNG.
+    /// Throws SerializedGameData::Error on failure
+    void Restore(const Keyframe& keyframe, const std::shared_ptr<Game>& game, ILocalGameState& localGameState) const;
+
+    size_t GetNumKeyframes() const { return keyframes_.size(); }
+    /// Size of all snapshots held in memory in bytes
+    size_t GetMemorySize() const { return memorySize_; }
+
+private:
+    struct Entry
+    {
+        Keyframe keyframe;
+        /// Serialized game data. Empty if stored in a file
+        std::vector<char> data;
+        boost::filesystem::path filePath;
+        size_t dataSize;
+    };
+
+    boost::filesystem::path GetCacheFilePath(unsigned gf) const;
+
+    unsigned interval_;
+    size_t maxMemorySize_, memorySize_;
+    /// Directory used for the keyframes of this instance (empty if none)
+    boost::filesystem::path cacheDir_;
+    std::map<unsigned, Entry> keyframes_;
+};
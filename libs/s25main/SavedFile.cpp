@@ -26,7 +26,7 @@
 #include <mygettext/mygettext.h>
 #include <stdexcept>
 
-SavedFile::SavedFile() : saveTime_(0)
+SavedFile::SavedFile() : fileVersion(0), saveTime_(0)
 {
     const std::string rev = RTTR_Version::GetRevision();
     std::copy(rev.begin(), rev.begin() + revision.size(), revision.begin());
@@ -80,15 +80,16 @@ bool SavedFile::ReadFileHeader(BinaryFile& file)
 
         // Version überprüfen
         uint16_t read_version = file.ReadUnsignedShort();
-        if(read_version != GetVersion())
+        if(read_version < GetMinVersion() || read_version > GetVersion())
         {
             boost::format fmt = boost::format(
-              (read_version < GetVersion()) ?
+              (read_version < GetMinVersion()) ?
                 _("File has an old version and cannot be used (version: %1%, expected: %2%)!") :
                 _("File was created with more recent program and cannot be used (version: %1%, expected: %2%)!"));
             lastErrorMsg = (fmt % read_version % GetVersion()).str();
             return false;
         }
+        fileVersion = read_version;
     } catch(std::runtime_error& e)
     {
         lastErrorMsg = e.what();
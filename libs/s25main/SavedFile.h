@@ -37,6 +37,8 @@ public:
     virtual std::string GetSignature() const = 0;
     /// Return the file format version
     virtual uint16_t GetVersion() const = 0;
+    /// Return the oldest file format version which can still be read
+    virtual uint16_t GetMinVersion() const { return GetVersion(); }
 
     /// Schreibt Signatur und Version der Datei
     void WriteFileHeader(BinaryFile& file) const;
@@ -78,6 +80,8 @@ public:
 protected:
     /// Last error message during loading
     std::string lastErrorMsg;
+    /// Format version of the file read last, 0 if none was read
+    uint16_t fileVersion;
 
 private:
     std::vector<BasePlayerInfo> players;
@@ -17,6 +17,15 @@
 
 #include "Savegame.h"
 #include "s25util/BinaryFile.h"
+#include <mygettext/mygettext.h>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+namespace {
+/// Upper bound for the size of the uncompressed game data, far above the size of the biggest maps
+constexpr unsigned maxGameDataSize = 1024u * 1024u * 1024u;
+} // namespace
 
 std::string Savegame::GetSignature() const
 {
@@ -25,30 +34,38 @@ std::string Savegame::GetSignature() const
 
 uint16_t Savegame::GetVersion() const
 {
-    // Note: If you increase the version, reset currentGameDataVersion in SerializedGameData.cpp (see note there)
+    // Note: If you increase the min version, reset currentGameDataVersion in SerializedGameData.cpp (see note there)
     // Note2: Also remove the workaround for the team in BasePlayerInfo
-    return 4; // SaveGameVersion -- Updater signature, do NOT remove
+    // Changelog:
+    // 5: Compressed game data
+    return 5; // SaveGameVersion -- Updater signature, do NOT remove
+}
+
+uint16_t Savegame::GetMinVersion() const
+{
+    return 4;
 }
 
 //////////////////////////////////////////////////////////////////////////
 
-Savegame::Savegame() : start_gf(0) {}
+Savegame::Savegame() : start_gf(0), codec(CompressionCodec::GetFastCodec()) {}
 
 Savegame::~Savegame() = default;
 
-bool Savegame::Save(const boost::filesystem::path& filepath, const std::string& mapName)
+bool Savegame::Save(const boost::filesystem::path& filepath, const std::string& mapName,
+                    const ProgressCallback& onProgress)
 {
     BinaryFile file;
 
-    return file.Open(filepath, OFM_WRITE) && Save(file, mapName);
+    return file.Open(filepath, OFM_WRITE) && Save(file, mapName, onProgress);
 }
 
-bool Savegame::Save(BinaryFile& file, const std::string& mapName)
+bool Savegame::Save(BinaryFile& file, const std::string& mapName, const ProgressCallback& onProgress)
 {
     WriteAllHeaderData(file, mapName);
     WritePlayerData(file);
     WriteGGS(file);
-    WriteGameData(file);
+    WriteGameData(file, onProgress);
 
     return true;
 }
@@ -102,13 +119,52 @@ bool Savegame::ReadExtHeader(BinaryFile& file)
     return true;
 }
 
-void Savegame::WriteGameData(BinaryFile& file)
+void Savegame::WriteGameData(BinaryFile& file, const ProgressCallback& onProgress)
 {
-    sgd.WriteToFile(file);
+    if(onProgress)
+        onProgress(0);
+    const std::vector<char> compressedData =
+      compressWithHeader(reinterpret_cast<const char*>(sgd.GetData()), sgd.GetLength(), codec);
+    file.WriteUnsignedInt(sgd.GetLength());
+    file.WriteUnsignedInt(compressedData.size());
+    if(!onProgress)
+    {
+        file.WriteRawData(compressedData.data(), compressedData.size());
+        return;
+    }
+    // Write in chunks to be able to report the progress. Compressing is accounted as the first half
+    constexpr unsigned chunkSize = 1024 * 1024;
+    const auto length = static_cast<unsigned>(compressedData.size());
+    onProgress(50);
+    for(unsigned offset = 0; offset < length; offset += chunkSize)
+    {
+        file.WriteRawData(compressedData.data() + offset, std::min(chunkSize, length - offset));
+        onProgress(50u + static_cast<unsigned>(uint64_t(std::min(offset + chunkSize, length)) * 50u / length));
+    }
+    onProgress(100);
 }
 
 bool Savegame::ReadGameData(BinaryFile& file)
 {
-    sgd.ReadFromFile(file);
+    if(fileVersion < 5)
+    {
+        sgd.ReadFromFile(file);
+        return true;
+    }
+    const unsigned length = file.ReadUnsignedInt();
+    const unsigned compressedLength = file.ReadUnsignedInt();
+    // Validate the sizes before allocating, so corrupt files are reported instead of exhausting the memory
+    const unsigned dataPos = file.Tell();
+    file.Seek(0, SEEK_END);
+    const unsigned fileSize = file.Tell();
+    file.Seek(dataPos, SEEK_SET);
+    if(compressedLength > fileSize - dataPos || length > maxGameDataSize)
+        throw std::runtime_error(_("Invalid size of the game data"));
+    std::vector<char> compressedData(compressedLength);
+    file.ReadRawData(compressedData.data(), compressedData.size());
+    std::vector<char> data(length);
+    decompressWithHeader(compressedData.data(), compressedData.size(), data.data(), data.size());
+    sgd.Clear();
+    sgd.PushRawData(data.data(), data.size());
     return true;
 }
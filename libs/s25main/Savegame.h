@@ -19,7 +19,9 @@
 
 #include "SavedFile.h"
 #include "SerializedGameData.h"
+#include "compression/CompressionCodec.h"
 #include <boost/filesystem/path.hpp>
+#include <functional>
 
 class BinaryFile;
 
@@ -38,10 +40,15 @@ public:
 
     std::string GetSignature() const override;
     uint16_t GetVersion() const override;
+    uint16_t GetMinVersion() const override;
+
+    /// Called with the percentage of the game data written so far
+    using ProgressCallback = std::function<void(unsigned percent)>;
 
     /// Schreibst Savegame oder Teile davon
-    bool Save(const boost::filesystem::path& filepath, const std::string& mapName);
-    bool Save(BinaryFile& file, const std::string& mapName);
+    bool Save(const boost::filesystem::path& filepath, const std::string& mapName,
+              const ProgressCallback& onProgress = nullptr);
+    bool Save(BinaryFile& file, const std::string& mapName, const ProgressCallback& onProgress = nullptr);
 
     /// Lädt Savegame oder Teile davon
     bool Load(const boost::filesystem::path& filePath, SaveGameDataToLoad what);
@@ -54,8 +61,10 @@ public:
     unsigned start_gf;
     /// Serialisierte Spieldaten
     SerializedGameData sgd;
+    /// Codec used to compress the game data when saving
+    CodecId codec;
 
 protected:
-    void WriteGameData(BinaryFile& file);
+    void WriteGameData(BinaryFile& file, const ProgressCallback& onProgress);
     bool ReadGameData(BinaryFile& file);
 };
@@ -68,7 +68,6 @@
 #include "figures/nofWarehouseWorker.h"
 #include "figures/nofWellguy.h"
 #include "figures/nofWoodcutter.h"
-#include "helpers/containerUtils.h"
 #include "helpers/format.hpp"
 #include "helpers/toString.h"
 #include "world/GameWorld.h"
@@ -103,7 +102,8 @@
 /// 5: Make RoadPathDirection contiguous and use optional for ware in nofBuildingWorker
 /// 6: Make TradeDirection contiguous, Serialize only nobUsuals in BuildingRegister::buildings,
 ///    include water and fish in geologists resourceFound
-static const unsigned currentGameDataVersion = 6;
+/// 7: Store all statistic steps of the players instead of fixed size buffers per time
+static const unsigned currentGameDataVersion = 7;
 // clang-format on
 
 GameObject* SerializedGameData::Create_GameObject(const GO_Type got, const unsigned obj_id)
@@ -231,6 +231,8 @@ void SerializedGameData::MakeSnapshot(const std::shared_ptr<Game>& game)
     // Anzahl Objekte reinschreiben (used for safety checks only)
     expectedNumObjects = GameObject::GetNumObjs();
     PushUnsignedInt(expectedNumObjects);
+    writtenObjIds.reset(GameObject::GetObjIDCounter());
+    writtenEventIds.reset(writeEm->GetEventInstanceCtr());
 
     // World and objects
     gw.Serialize(*this);
@@ -272,6 +274,7 @@ void SerializedGameData::ReadSnapshot(const std::shared_ptr<Game>& game, ILocalG
     em = &gw.GetEvMgr();
 
     expectedNumObjects = PopUnsignedInt();
+    readObjects.reserve(expectedNumObjects);
 
     gw.Deserialize(game, localGameState, *this);
     em->Deserialize(*this);
@@ -487,16 +490,18 @@ SerializedGameData::Error SerializedGameData::makeOutOfRange(unsigned value, uns
 void SerializedGameData::AddObject(GameObject* go)
 {
     RTTR_Assert(isReading);
-    RTTR_Assert(!readObjects[go->GetObjId()]); // Do not call this multiple times per GameObject
-    readObjects[go->GetObjId()] = go;
+    GameObject*& readObj = readObjects[go->GetObjId()];
+    RTTR_Assert(!readObj); // Do not call this multiple times per GameObject
+    readObj = go;
     RTTR_Assert(readObjects.size() < expectedNumObjects);
 }
 
 unsigned SerializedGameData::AddEvent(unsigned instanceId, GameEvent* ev)
 {
     RTTR_Assert(isReading);
-    RTTR_Assert(!readEvents[instanceId]); // Do not call this multiple times per GameObject
-    readEvents[instanceId] = ev;
+    GameEvent*& readEv = readEvents[instanceId];
+    RTTR_Assert(!readEv); // Do not call this multiple times per GameEvent
+    readEv = ev;
     return instanceId;
 }
 
@@ -504,14 +509,14 @@ bool SerializedGameData::IsObjectSerialized(unsigned obj_id) const
 {
     RTTR_Assert(!isReading);
     RTTR_Assert(obj_id <= GameObject::GetObjIDCounter());
-    return helpers::contains(writtenObjIds, obj_id);
+    return writtenObjIds.contains(obj_id);
 }
 
 bool SerializedGameData::IsEventSerialized(unsigned evInstanceid) const
 {
     RTTR_Assert(!isReading);
     RTTR_Assert(evInstanceid < writeEm->GetEventInstanceCtr());
-    return helpers::contains(writtenEventIds, evInstanceid);
+    return writtenEventIds.contains(evInstanceid);
 }
 
 GameObject* SerializedGameData::GetReadGameObject(const unsigned obj_id) const
@@ -29,11 +29,11 @@
 #include "s25util/Serializer.h"
 #include "s25util/warningSuppression.h"
 #include <limits>
-#include <map>
 #include <memory>
-#include <set>
 #include <stdexcept>
 #include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 class GameObject;
 class EventManager;
@@ -175,12 +175,46 @@ private:
     /// Version of the game data that is read. Gets set to the current version for writing
     unsigned gameDataVersion;
 
+    /// Set of ids stored as a bitmap indexed by the id.
+    /// Object and event ids are handed out sequentially, so this is much faster and smaller than a tree or hash set
+    class IdSet
+    {
+    public:
+        /// Clear the set and reserve space for ids up to maxId
+        void reset(unsigned maxId)
+        {
+            contained_.assign(maxId + 1u, false);
+            size_ = 0;
+        }
+        void clear()
+        {
+            contained_.clear();
+            size_ = 0;
+        }
+        bool contains(unsigned id) const { return id < contained_.size() && contained_[id]; }
+        void insert(unsigned id)
+        {
+            if(id >= contained_.size())
+                contained_.resize(id + 1u, false);
+            if(!contained_[id])
+            {
+                contained_[id] = true;
+                ++size_;
+            }
+        }
+        unsigned size() const { return size_; }
+
+    private:
+        std::vector<bool> contained_;
+        unsigned size_ = 0;
+    };
+
     /// Stores the ids of all written objects (-> only valid during writing)
-    std::set<unsigned> writtenObjIds;
-    std::set<unsigned> writtenEventIds;
+    IdSet writtenObjIds;
+    IdSet writtenEventIds;
     /// Maps already read object ids to GameObjects (-> only valid during reading)
-    std::map<unsigned, GameObject*> readObjects;
-    std::map<unsigned, GameEvent*> readEvents;
+    std::unordered_map<unsigned, GameObject*> readObjects;
+    std::unordered_map<unsigned, GameEvent*> readEvents;
 
     /// Expected number of objects to be read/written
     unsigned expectedNumObjects;
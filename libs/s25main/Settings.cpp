@@ -68,6 +68,7 @@ void Settings::LoadDefaults()
     global.use_upnp = 2;
     global.smartCursor = true;
     global.debugMode = false;
+    global.parallelAI = false;
     // }
 
     // video
@@ -196,6 +197,7 @@ void Settings::Load()
         global.use_upnp = iniGlobal->getValueI("use_upnp");
         global.smartCursor = (iniGlobal->getValue("smartCursor").empty() || iniGlobal->getValueI("smartCursor") != 0);
         global.debugMode = (iniGlobal->getValueI("debugMode") != 0);
+        global.parallelAI = (iniGlobal->getValueI("parallelAI") != 0);
 
         // };
 
@@ -339,6 +341,7 @@ void Settings::Save()
     iniGlobal->setValue("use_upnp", global.use_upnp);
     iniGlobal->setValue("smartCursor", global.smartCursor ? 1 : 0);
     iniGlobal->setValue("debugMode", global.debugMode ? 1 : 0);
+    iniGlobal->setValue("parallelAI", global.parallelAI ? 1 : 0);
     // };
 
     // video
@@ -53,6 +53,8 @@ public:
         unsigned use_upnp;
         bool smartCursor;
         bool debugMode;
+        /// Run the AI players on multiple threads
+        bool parallelAI;
     } global;
 
     struct
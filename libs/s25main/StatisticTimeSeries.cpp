@@ -0,0 +1,133 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "StatisticTimeSeries.h"
+#include "SerializedGameData.h"
+#include "helpers/EnumRange.h"
+#include <ostream>
+
+namespace {
+const helpers::EnumArray<const char*, StatisticType> STAT_NAMES = {
+  {"country", "buildings", "inhabitants", "merchandise", "military", "gold", "productivity", "vanquished",
+   "tournament"}};
+const std::array<const char*, NUM_STAT_MERCHANDISE_TYPES> MERCHANDISE_NAMES = {
+  {"wood", "boards", "stones", "food", "water", "beer", "coal", "ironOre", "goldOre", "iron", "coins", "tools",
+   "weapons", "boats"}};
+} // namespace
+
+void StatisticTimeSeries::Clear()
+{
+    for(auto& column : values_)
+        column.clear();
+    for(auto& column : merchandise_)
+        column.clear();
+}
+
+void StatisticTimeSeries::AddStep(const Values& values, const MerchandiseValues& merchandise)
+{
+    for(const auto i : helpers::enumRange<StatisticType>())
+        values_[i].push_back(values[i]);
+    for(unsigned i = 0; i < NUM_STAT_MERCHANDISE_TYPES; ++i)
+        merchandise_[i].push_back(merchandise[i]);
+}
+
+void StatisticTimeSeries::GetSampleRange(unsigned stepsPerSample, unsigned numSamples, unsigned& firstSample,
+                                         unsigned& numEmpty) const
+{
+    RTTR_Assert(stepsPerSample > 0);
+    const unsigned numCompleteSamples = GetNumSteps() / stepsPerSample;
+    if(numCompleteSamples >= numSamples)
+    {
+        firstSample = numCompleteSamples - numSamples;
+        numEmpty = 0;
+    } else
+    {
+        firstSample = 0;
+        numEmpty = numSamples - numCompleteSamples;
+    }
+}
+
+std::vector<unsigned> StatisticTimeSeries::GetDownsampled(StatisticType type, unsigned stepsPerSample,
+                                                          unsigned numSamples) const
+{
+    unsigned firstSample, numEmpty;
+    GetSampleRange(stepsPerSample, numSamples, firstSample, numEmpty);
+    std::vector<unsigned> result(numEmpty, 0u);
+    result.reserve(numSamples);
+    const std::vector<unsigned>& column = values_[type];
+    for(unsigned sample = firstSample; result.size() < numSamples; ++sample)
+        result.push_back(column[(sample + 1) * stepsPerSample - 1]);
+    return result;
+}
+
+std::vector<unsigned> StatisticTimeSeries::GetMerchandiseDownsampled(unsigned merchType, unsigned stepsPerSample,
+                                                                     unsigned numSamples) const
+{
+    unsigned firstSample, numEmpty;
+    GetSampleRange(stepsPerSample, numSamples, firstSample, numEmpty);
+    std::vector<unsigned> result(numEmpty, 0u);
+    result.reserve(numSamples);
+    const std::vector<uint16_t>& column = merchandise_[merchType];
+    for(unsigned sample = firstSample; result.size() < numSamples; ++sample)
+    {
+        const auto itStart = column.begin() + sample * stepsPerSample;
+        unsigned sum = 0;
+        for(auto it = itStart; it != itStart + stepsPerSample; ++it)
+            sum += *it;
+        result.push_back(sum);
+    }
+    return result;
+}
+
+void StatisticTimeSeries::Serialize(SerializedGameData& sgd) const
+{
+    for(const auto& column : values_)
+        sgd.PushContainer(column);
+    for(const auto& column : merchandise_)
+        sgd.PushContainer(column);
+}
+
+void StatisticTimeSeries::Deserialize(SerializedGameData& sgd)
+{
+    for(auto& column : values_)
+        sgd.PopContainer(column);
+    for(auto& column : merchandise_)
+        sgd.PopContainer(column);
+}
+
+void StatisticTimeSeries::WriteCSVHeader(std::ostream& out, const std::string& prefixColumns)
+{
+    out << prefixColumns << "step";
+    for(const char* name : STAT_NAMES)
+        out << ',' << name;
+    for(const char* name : MERCHANDISE_NAMES)
+        out << ",merchandise_" << name;
+    out << '\n';
+}
+
+void StatisticTimeSeries::WriteCSV(std::ostream& out, const std::string& prefix) const
+{
+    for(unsigned step = 0; step < GetNumSteps(); ++step)
+    {
+        out << prefix << step;
+        for(const auto& column : values_)
+            out << ',' << column[step];
+        for(const auto& column : merchandise_)
+            out << ',' << column[step];
+        out << '\n';
+    }
+}
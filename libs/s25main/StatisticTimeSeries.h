@@ -0,0 +1,69 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "helpers/EnumArray.h"
+#include "gameTypes/StatisticTypes.h"
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+class SerializedGameData;
+
+/// Statistic values of a player for every statistic step of the game.
+/// Stored column-wise (one array per statistic) so single statistics can be read and downsampled efficiently
+class StatisticTimeSeries
+{
+public:
+    using Values = helpers::EnumArray<unsigned, StatisticType>;
+    using MerchandiseValues = std::array<uint16_t, NUM_STAT_MERCHANDISE_TYPES>;
+
+    void Clear();
+    /// Append the values of one statistic step
+    void AddStep(const Values& values, const MerchandiseValues& merchandise);
+
+    unsigned GetNumSteps() const { return static_cast<unsigned>(values_[StatisticType::Country].size()); }
+    unsigned GetValue(StatisticType type, unsigned step) const { return values_[type][step]; }
+    uint16_t GetMerchandise(unsigned merchType, unsigned step) const { return merchandise_[merchType][step]; }
+
+    /// Return the last numSamples samples consisting of stepsPerSample steps each, oldest first.
+    /// Only complete samples are used, missing samples at the start of the game are 0.
+    /// The value of a sample is the value of its last step
+    std::vector<unsigned> GetDownsampled(StatisticType type, unsigned stepsPerSample, unsigned numSamples) const;
+    /// Same as GetDownsampled but the value of a sample is the sum over its steps
+    std::vector<unsigned> GetMerchandiseDownsampled(unsigned merchType, unsigned stepsPerSample,
+                                                    unsigned numSamples) const;
+
+    void Serialize(SerializedGameData& sgd) const;
+    void Deserialize(SerializedGameData& sgd);
+
+    /// Write the column names of WriteCSV. prefixColumns is written in front and should end with a separator
+    static void WriteCSVHeader(std::ostream& out, const std::string& prefixColumns = "");
+    /// Write one line per step with all values. prefix is written at the start of each line
+    void WriteCSV(std::ostream& out, const std::string& prefix = "") const;
+
+private:
+    helpers::EnumArray<std::vector<unsigned>, StatisticType> values_;
+    std::array<std::vector<uint16_t>, NUM_STAT_MERCHANDISE_TYPES> merchandise_;
+
+    /// Get the index of the first sample to use and the number of leading empty samples
+    void GetSampleRange(unsigned stepsPerSample, unsigned numSamples, unsigned& firstSample,
+                        unsigned& numEmpty) const;
+};
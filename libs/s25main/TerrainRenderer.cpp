@@ -21,6 +21,7 @@
 #include "Settings.h"
 #include "drivers/VideoDriverWrapper.h"
 #include "helpers/EnumArray.h"
+#include "helpers/ThreadPool.h"
 #include "helpers/containerUtils.h"
 #include "network/GameClient.h"
 #include "ogl/glArchivItem_Bitmap.h"
@@ -35,8 +36,10 @@
 #include "s25util/dynamicUniqueCast.h"
 #include <glad/glad.h>
 #include <boost/range/adaptor/indexed.hpp>
+#include <algorithm>
 #include <cstdlib>
 #include <set>
+#include <thread>
 
 /* Terrain rendering works like that:
  * Every point is associated with 2 triangles:
@@ -54,14 +57,47 @@
  *
  * Drawing then binds a texture and draws all adjacent vertices with the same texture in one call by
  * providing an index and a count into the above arrays.
+ *
+ * Generating the data is done in passes (vertices, border vertices, triangles) as each pass uses the results of the
+ * previous one for the neighbouring points. Within a pass each point only writes its own entries, so the map rows are
+ * split into bands which are processed in parallel on big maps.
+ * Changes at runtime (altitude, visibility) only mark the affected points. They are updated in one go and uploaded
+ * with as few VBO updates as possible when ApplyPendingChanges is called before drawing.
  */
 
+namespace {
+/// Minimum number of map rows to use multiple threads
+constexpr unsigned minRowsForThreads = 64;
+/// Number of bands per thread to balance different workloads of the rows
+constexpr unsigned bandsPerThread = 4;
+/// Elements closer than this are uploaded in one VBO update
+constexpr unsigned maxUploadGap = 32;
+
+/// Upload the elements at the given (sorted) indices to the VBO, combining close ones
+template<typename T>
+void uploadElements(ogl::VBO<T>& vbo, const std::vector<T>& data, const std::vector<unsigned>& sortedIndices)
+{
+    if(!vbo.isValid() || sortedIndices.empty())
+        return;
+    auto it = sortedIndices.begin();
+    while(it != sortedIndices.end())
+    {
+        const unsigned first = *it;
+        unsigned last = first;
+        while(++it != sortedIndices.end() && *it <= last + maxUploadGap)
+            last = *it;
+        vbo.update(&data[first], last - first + 1, first);
+    }
+    vbo.unbind();
+}
+} // namespace
+
 glArchivItem_Bitmap* new_clone(const glArchivItem_Bitmap& bmp)
 {
     return dynamic_cast<glArchivItem_Bitmap*>(bmp.clone());
 }
 
-TerrainRenderer::TerrainRenderer() : size_(0, 0) {}
+TerrainRenderer::TerrainRenderer() : size_(0, 0), multiThreaded_(true) {}
 TerrainRenderer::~TerrainRenderer() = default;
 
 static constexpr unsigned getFlatIndex(DescIdx<LandscapeDesc> ls, LandRoadType road)
@@ -203,19 +239,40 @@ void TerrainRenderer::LoadTextures(const WorldDescription& desc)
     }
 }
 
+template<class T_Func>
+void TerrainRenderer::ForEachPt(const T_Func& func)
+{
+    const auto processRows = [this, &func](unsigned firstRow, unsigned endRow) {
+        for(MapPoint pt(0, firstRow); pt.y < endRow; ++pt.y)
+        {
+            for(pt.x = 0; pt.x < size_.x; ++pt.x)
+                func(pt);
+        }
+    };
+    if(!multiThreaded_ || size_.y < minRowsForThreads || std::thread::hardware_concurrency() < 2u)
+    {
+        processRows(0, size_.y);
+        return;
+    }
+    if(!threadPool_)
+        threadPool_ = std::make_unique<helpers::ThreadPool>();
+    const unsigned numBands = std::min<unsigned>(size_.y, threadPool_->getNumThreads() * bandsPerThread);
+    threadPool_->run(numBands, [this, numBands, &processRows](unsigned bandIdx, unsigned) {
+        processRows(size_.y * bandIdx / numBands, size_.y * (bandIdx + 1) / numBands);
+    });
+}
+
 void TerrainRenderer::GenerateVertices(const GameWorldViewer& gwv)
 {
     // Terrain generieren
-    RTTR_FOREACH_PT(MapPoint, size_)
-    {
+    ForEachPt([this, &gwv](const MapPoint pt) {
         UpdateVertexPos(pt, gwv);
         UpdateVertexColor(pt, gwv);
         LoadVertexTerrain(pt, gwv);
-    }
+    });
 
     // Ränder generieren
-    RTTR_FOREACH_PT(MapPoint, size_)
-        UpdateBorderVertex(pt);
+    ForEachPt([this](const MapPoint pt) { UpdateBorderVertex(pt); });
 }
 
 void TerrainRenderer::UpdateVertexPos(const MapPoint pt, const GameWorldViewer& gwv)
@@ -279,6 +336,9 @@ void TerrainRenderer::Init(const MapExtent& size)
     vertices.resize(size_.x * size_.y);
     terrain.resize(vertices.size());
     borders.resize(size_.x * size_.y);
+    dirtyFlags_.clear();
+    dirtyFlags_.resize(vertices.size());
+    dirtyPts_.clear();
 
     gl_vertices.clear();
     gl_texcoords.clear();
@@ -340,21 +400,15 @@ void TerrainRenderer::GenerateOpenGL(const GameWorldViewer& gwv)
     gl_texcoords.resize(numTriangles);
     gl_colors.resize(numTriangles);
 
-    // Normales Terrain erzeugen
-    RTTR_FOREACH_PT(MapPoint, size_)
-    {
+    // Normales Terrain und Ränder erzeugen
+    ForEachPt([this](const MapPoint pt) {
         UpdateTrianglePos(pt, false);
         UpdateTriangleColor(pt, false);
         UpdateTriangleTerrain(pt, false);
-    }
-
-    // Ränder erzeugen
-    RTTR_FOREACH_PT(MapPoint, size_)
-    {
         UpdateBorderTrianglePos(pt, false);
         UpdateBorderTriangleColor(pt, false);
         UpdateBorderTriangleTerrain(pt, false);
-    }
+    });
 
     if(SETTINGS.video.vbo)
     {
@@ -1049,89 +1103,140 @@ void TerrainRenderer::DrawWays(const PreparedRoads& sorted_roads) const
     // Note: No glDisableClientState as we did not enable it
 }
 
-void TerrainRenderer::AltitudeChanged(const MapPoint pt, const GameWorldViewer& gwv)
+void TerrainRenderer::MarkDirty(const MapPoint pt, uint8_t flags)
 {
-    // den selbst sowieso die Punkte darum updaten, da sich bei letzteren die Schattierung geändert haben könnte
-    UpdateVertexPos(pt, gwv);
-    UpdateVertexColor(pt, gwv);
+    uint8_t& curFlags = dirtyFlags_[GetVertexIdx(pt)];
+    if(!curFlags)
+        dirtyPts_.push_back(pt);
+    curFlags |= flags;
+}
 
+void TerrainRenderer::AltitudeChanged(const MapPoint pt)
+{
+    if(vertices.empty())
+        return;
+    // Die Schattierung der Punkte drumherum könnte sich auch geändert haben
+    MarkDirty(pt, DIRTY_VERTEX_POS | DIRTY_VERTEX_COLOR);
     for(const auto dir : helpers::EnumRange<Direction>{})
-        UpdateVertexColor(gwv.GetNeighbour(pt, dir), gwv);
+        MarkDirty(GetNeighbour(pt, dir), DIRTY_VERTEX_COLOR);
+}
 
-    // und für die Ränder
-    UpdateBorderVertex(pt);
+void TerrainRenderer::VisibilityChanged(const MapPoint pt)
+{
+    /// Noch kein Terrain gebaut? abbrechen
+    if(vertices.empty())
+        return;
 
+    MarkDirty(pt, DIRTY_VERTEX_COLOR);
     for(const auto dir : helpers::EnumRange<Direction>{})
-        UpdateBorderVertex(gwv.GetNeighbour(pt, dir));
+        MarkDirty(GetNeighbour(pt, dir), DIRTY_VERTEX_COLOR);
+}
 
-    // den selbst sowieso die Punkte darum updaten, da sich bei letzteren die Schattierung geändert haben könnte
-    UpdateTrianglePos(pt, true);
-    UpdateTriangleColor(pt, true);
+void TerrainRenderer::VisibilityChanged(const std::vector<MapPoint>& pts)
+{
+    for(const MapPoint pt : pts)
+        VisibilityChanged(pt);
+}
 
-    for(const auto dir : helpers::EnumRange<Direction>{})
+void TerrainRenderer::ApplyPendingChanges(const GameWorldViewer& gwv)
+{
+    if(dirtyPts_.empty())
+        return;
+
+    const auto numChangedPts = static_cast<unsigned>(dirtyPts_.size());
+    for(unsigned i = 0; i < numChangedPts; i++)
     {
-        UpdateTrianglePos(gwv.GetNeighbour(pt, dir), true);
-        UpdateTriangleColor(gwv.GetNeighbour(pt, dir), true);
+        const MapPoint pt = dirtyPts_[i];
+        const uint8_t flags = dirtyFlags_[GetVertexIdx(pt)];
+        if(flags & DIRTY_VERTEX_POS)
+            UpdateVertexPos(pt, gwv);
+        if(flags & DIRTY_VERTEX_COLOR)
+            UpdateVertexColor(pt, gwv);
     }
 
-    // Auch im zweiten Kreis drumherum die Dreiecke neu berechnen, da die durch die Schattenänderung der umliegenden
-    // Punkte auch geändert werden könnten
-    for(unsigned i = 0; i < 12; ++i)
-        UpdateTriangleColor(gwv.GetWorld().GetNeighbour2(pt, i), true);
-
-    // und für die Ränder
-    UpdateBorderTrianglePos(pt, true);
-    UpdateBorderTriangleColor(pt, true);
-
-    for(const auto dir : helpers::EnumRange<Direction>{})
+    // Border vertices and triangles use the data of their neighbours, so mark the points around the changed ones.
+    // The triangles use the border vertices of the neighbours too, which requires a second ring around the changes.
+    const auto getTriangleFlags = [](uint8_t flags) -> uint8_t {
+        return ((flags & DIRTY_VERTEX_POS) ? DIRTY_TRIANGLE_POS : 0)
+               | ((flags & (DIRTY_VERTEX_POS | DIRTY_VERTEX_COLOR)) ? DIRTY_TRIANGLE_COLOR : 0);
+    };
+    for(unsigned i = 0; i < numChangedPts; i++)
     {
-        UpdateBorderTrianglePos(gwv.GetNeighbour(pt, dir), true);
-        UpdateBorderTriangleColor(gwv.GetNeighbour(pt, dir), true);
+        const MapPoint pt = dirtyPts_[i];
+        const uint8_t flags = DIRTY_BORDER_VERTEX | getTriangleFlags(dirtyFlags_[GetVertexIdx(pt)]);
+        MarkDirty(pt, flags);
+        for(const auto dir : helpers::EnumRange<Direction>{})
+            MarkDirty(GetNeighbour(pt, dir), flags);
+    }
+    const auto numBorderPts = static_cast<unsigned>(dirtyPts_.size());
+    for(unsigned i = 0; i < numBorderPts; i++)
+    {
+        const MapPoint pt = dirtyPts_[i];
+        const uint8_t flags = getTriangleFlags(dirtyFlags_[GetVertexIdx(pt)])
+                              | (dirtyFlags_[GetVertexIdx(pt)] & (DIRTY_TRIANGLE_POS | DIRTY_TRIANGLE_COLOR));
+        for(const auto dir : helpers::EnumRange<Direction>{})
+            MarkDirty(GetNeighbour(pt, dir), flags);
     }
 
-    for(unsigned i = 0; i < 12; ++i)
-        UpdateBorderTriangleColor(gwv.GetWorld().GetNeighbour2(pt, i), true);
-}
-
-void TerrainRenderer::VisibilityChanged(const MapPoint pt, const GameWorldViewer& gwv)
-{
-    /// Noch kein Terrain gebaut? abbrechen
-    if(vertices.empty())
-        return;
-
-    UpdateVertexColor(pt, gwv);
-    for(const auto dir : helpers::EnumRange<Direction>{})
-        UpdateVertexColor(gwv.GetNeighbour(pt, dir), gwv);
-
-    // und für die Ränder
-    UpdateBorderVertex(pt);
-    for(const auto dir : helpers::EnumRange<Direction>{})
-        UpdateBorderVertex(gwv.GetNeighbour(pt, dir));
+    for(unsigned i = 0; i < numBorderPts; i++)
+        UpdateBorderVertex(dirtyPts_[i]);
 
-    // den selbst sowieso die Punkte darum updaten, da sich bei letzteren die Schattierung geändert haben könnte
-    UpdateTriangleColor(pt, true);
-    for(const auto dir : helpers::EnumRange<Direction>{})
-        UpdateTriangleColor(gwv.GetNeighbour(pt, dir), true);
+    // Sort the points so the updated triangles form ranges which can be uploaded at once
+    std::sort(dirtyPts_.begin(), dirtyPts_.end(),
+              [this](const MapPoint lhs, const MapPoint rhs) { return GetVertexIdx(lhs) < GetVertexIdx(rhs); });
+    std::vector<unsigned> posTriangles, colorTriangles;
+    for(const MapPoint pt : dirtyPts_)
+    {
+        const unsigned idx = GetVertexIdx(pt);
+        const uint8_t flags = dirtyFlags_[idx];
+        dirtyFlags_[idx] = 0;
+        if(flags & DIRTY_TRIANGLE_POS)
+        {
+            UpdateTrianglePos(pt, false);
+            UpdateBorderTrianglePos(pt, false);
+        }
+        if(flags & DIRTY_TRIANGLE_COLOR)
+        {
+            UpdateTriangleColor(pt, false);
+            UpdateBorderTriangleColor(pt, false);
+        }
+        // Collect the triangles of the point: 2 regular ones and the borders
+        std::array<unsigned, 8> triangles;
+        unsigned numTriangles = 0;
+        triangles[numTriangles++] = GetTriangleIdx(pt);
+        triangles[numTriangles++] = GetTriangleIdx(pt) + 1;
+        const Borders& border = borders[idx];
+        for(unsigned char i = 0; i < 2; ++i)
+        {
+            if(border.left_right[i])
+                triangles[numTriangles++] = border.left_right_offset[i];
+            if(border.right_left[i])
+                triangles[numTriangles++] = border.right_left_offset[i];
+            if(border.top_down[i])
+                triangles[numTriangles++] = border.top_down_offset[i];
+        }
+        if(flags & DIRTY_TRIANGLE_POS)
+            posTriangles.insert(posTriangles.end(), triangles.begin(), triangles.begin() + numTriangles);
+        if(flags & DIRTY_TRIANGLE_COLOR)
+            colorTriangles.insert(colorTriangles.end(), triangles.begin(), triangles.begin() + numTriangles);
+    }
+    dirtyPts_.clear();
 
-    // und für die Ränder
-    UpdateBorderTriangleColor(pt, true);
-    for(const auto dir : helpers::EnumRange<Direction>{})
-        UpdateBorderTriangleColor(gwv.GetNeighbour(pt, dir), true);
+    // Border triangles are stored after all regular ones
+    std::sort(posTriangles.begin(), posTriangles.end());
+    std::sort(colorTriangles.begin(), colorTriangles.end());
+    uploadElements(vbo_vertices, gl_vertices, posTriangles);
+    uploadElements(vbo_colors, gl_colors, colorTriangles);
 }
 
 void TerrainRenderer::UpdateAllColors(const GameWorldViewer& gwv)
 {
-    RTTR_FOREACH_PT(MapPoint, size_)
-        UpdateVertexColor(pt, gwv);
-
-    RTTR_FOREACH_PT(MapPoint, size_)
-        UpdateBorderVertex(pt);
-
-    RTTR_FOREACH_PT(MapPoint, size_)
+    ForEachPt([this, &gwv](const MapPoint pt) { UpdateVertexColor(pt, gwv); });
+    ForEachPt([this](const MapPoint pt) { UpdateBorderVertex(pt); });
+    ForEachPt([this](const MapPoint pt) {
         UpdateTriangleColor(pt, false);
-
-    RTTR_FOREACH_PT(MapPoint, size_)
         UpdateBorderTriangleColor(pt, false);
+    });
 
     if(vbo_colors.isValid())
     {
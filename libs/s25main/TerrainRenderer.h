@@ -26,11 +26,15 @@
 #include <boost/noncopyable.hpp>
 #include <boost/ptr_container/ptr_vector.hpp>
 #include <array>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
 class GameWorldViewer;
 class glArchivItem_Bitmap;
+namespace helpers {
+class ThreadPool;
+}
 struct TerrainDesc;
 struct WorldDescription;
 
@@ -41,6 +45,14 @@ class TerrainRenderer : private boost::noncopyable
 {
 public:
     using PointF = Point<float>;
+    struct Color
+    {
+        float r;
+        float g;
+        float b;
+    };
+    using Triangle = std::array<PointF, 3>;
+    using ColorTriangle = std::array<Color, 3>;
 
     TerrainRenderer();
     ~TerrainRenderer();
@@ -62,14 +74,28 @@ public:
     /// GetNodePos(pt)
     PointF GetNeighbourVertexPos(MapPoint pt, Direction dir) const;
 
-    /// Callback function for altitude changes
-    void AltitudeChanged(MapPoint pt, const GameWorldViewer& gwv);
-    /// Callback function for visibility changes
-    void VisibilityChanged(MapPoint pt, const GameWorldViewer& gwv);
+    /// Callback function for altitude changes. Applied with the next call to ApplyPendingChanges
+    void AltitudeChanged(MapPoint pt);
+    /// Callback function for visibility changes. Applied with the next call to ApplyPendingChanges
+    void VisibilityChanged(MapPoint pt);
+    /// Callback function for visibility changes of many points at once
+    void VisibilityChanged(const std::vector<MapPoint>& pts);
+    /// Update the data of all points changed since the last call and upload them.
+    /// Should be called once per frame before drawing
+    void ApplyPendingChanges(const GameWorldViewer& gwv);
+    bool HasPendingChanges() const { return !dirtyPts_.empty(); }
 
     /// Recalculates all colors on the map
     void UpdateAllColors(const GameWorldViewer& gwv);
 
+    /// Use multiple threads to generate the data of big maps (enabled by default)
+    void SetMultiThreaded(bool enable) { multiThreaded_ = enable; }
+
+    /// Generated triangle data as uploaded to the VBOs
+    const std::vector<Triangle>& GetTrianglePositions() const { return gl_vertices; }
+    const std::vector<Triangle>& GetTriangleTexCoords() const { return gl_texcoords; }
+    const std::vector<ColorTriangle>& GetTriangleColors() const { return gl_colors; }
+
 private:
     struct MapTile
     {
@@ -106,16 +132,6 @@ private:
         std::array<float, 2> borderColor;
     };
 
-    struct Color
-    {
-        float r;
-        float g;
-        float b;
-    };
-
-    using Triangle = std::array<PointF, 3>;
-    using ColorTriangle = std::array<Color, 3>;
-
     struct Borders
     {
         std::array<unsigned char, 2> left_right;
@@ -134,6 +150,16 @@ private:
 
     using PreparedRoads = std::vector<std::vector<PreparedRoad>>;
 
+    /// What needs to be updated for a point
+    enum DirtyFlags : uint8_t
+    {
+        DIRTY_VERTEX_POS = 1 << 0,
+        DIRTY_VERTEX_COLOR = 1 << 1,
+        DIRTY_BORDER_VERTEX = 1 << 2,
+        DIRTY_TRIANGLE_POS = 1 << 3,
+        DIRTY_TRIANGLE_COLOR = 1 << 4
+    };
+
     /// Size of the map
     MapExtent size_;
     /// Map sized array of vertex related data
@@ -157,6 +183,15 @@ private:
     /// Flat 2D array: [Landscape][RoadType]
     std::vector<BmpPtr> roadTextures;
 
+    /// Map sized array of DirtyFlags
+    std::vector<uint8_t> dirtyFlags_;
+    /// Points with dirty flags set
+    std::vector<MapPoint> dirtyPts_;
+
+    bool multiThreaded_;
+    /// Threads used to process row bands of the map in parallel. Created on first use
+    std::unique_ptr<helpers::ThreadPool> threadPool_;
+
     /// Returns the index of a vertex. Used to access vertices and borders
     unsigned GetVertexIdx(const MapPoint pt) const
     {
@@ -173,6 +208,11 @@ private:
 
     void LoadTextures(const WorldDescription& desc);
 
+    /// Call func(pt) for each point of the map. The rows are split into bands processed in parallel for big maps
+    template<class T_Func>
+    void ForEachPt(const T_Func& func);
+    void MarkDirty(MapPoint pt, uint8_t flags);
+
     /// Creates and initializes (map-)vertices for the viewer
     void GenerateVertices(const GameWorldViewer& gwv);
     /// Updates (map-)vertex attributes
@@ -16,34 +16,68 @@
 // along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
 
 #include "TradePathCache.h"
-#include "EventManager.h"
 #include "GamePlayer.h"
+#include "helpers/containerUtils.h"
 #include "world/GameWorldGame.h"
 #include "gameData/GameConsts.h"
+#include <iterator>
+#include <limits>
+#include <unordered_set>
+
+constexpr unsigned TradePathCache::DEFAULT_MAX_ENTRIES_PER_PLAYER;
+
+uint64_t TradePathCache::MakeKey(const MapPoint& start, const MapPoint& goal)
+{
+    static_assert(sizeof(MapCoord) * 2 <= sizeof(uint32_t), "Key too small");
+    const auto toInt = [](const MapPoint& pt) { return (static_cast<uint32_t>(pt.y) << 16) | pt.x; };
+    const uint32_t startVal = toInt(start);
+    const uint32_t goalVal = toInt(goal);
+    // A path can be used in both directions
+    if(startVal < goalVal)
+        return (static_cast<uint64_t>(startVal) << 32) | goalVal;
+    else
+        return (static_cast<uint64_t>(goalVal) << 32) | startVal;
+}
+
+void TradePathCache::Clear()
+{
+    shards.clear();
+    stats = Stats();
+}
+
+TradePathCache::Shard& TradePathCache::GetShard(const unsigned char player)
+{
+    if(player >= shards.size())
+        shards.resize(player + 1u);
+    return shards[player];
+}
 
 bool TradePathCache::PathExists(const GameWorldGame& gwg, const MapPoint& start, const MapPoint& goal,
                                 const unsigned char player)
 {
     RTTR_Assert(start != goal);
 
-    unsigned entryIdx = FindEntry(gwg, start, goal, player);
-    if(entryIdx < curSize)
+    EntryList::iterator entry;
+    const unsigned shardIdx = FindEntry(gwg, MakeKey(start, goal), player, entry);
+    if(shardIdx < shards.size())
     {
         // Found an entry --> Check if the route is still valid
         MapPoint checkedGoal;
-        if(gwg.CheckTradeRoute(pathes[entryIdx].path.start, pathes[entryIdx].path.route, 0, player, &checkedGoal))
+        if(gwg.CheckTradeRoute(entry->start, entry->route, 0, player, &checkedGoal))
         {
             RTTR_Assert(checkedGoal == start || checkedGoal == goal);
-            pathes[entryIdx].lastUse = gwg.GetEvMgr().GetCurrentGF();
+            EntryList& entries = shards[shardIdx].entries;
+            entries.splice(entries.begin(), entries, entry);
+            stats.hits++;
             return true;
         } else
         {
             // TradePath is now invalid -> remove it
-            curSize--;
-            if(entryIdx != curSize)
-                pathes[entryIdx] = pathes[curSize];
+            RemoveEntry(shardIdx, entry);
+            stats.invalidations++;
         }
     }
+    stats.misses++;
 
     TradePath path;
     if(!gwg.FindTradePath(start, goal, player, std::numeric_limits<unsigned>::max(), false, &path.route))
@@ -56,52 +90,119 @@ bool TradePathCache::PathExists(const GameWorldGame& gwg, const MapPoint& start,
     return true;
 }
 
-unsigned TradePathCache::FindEntry(const GameWorldGame& gwg, const MapPoint& start, const MapPoint& goal,
-                                   const unsigned char player) const
+unsigned TradePathCache::FindEntry(const GameWorldGame& gwg, const uint64_t key, const unsigned char player,
+                                   EntryList::iterator& entry) const
 {
     const GamePlayer& thisPlayer = gwg.GetPlayer(player);
+    const auto findInShard = [this, key, &entry](const unsigned shardIdx) {
+        const Shard& shard = shards[shardIdx];
+        const auto it = shard.index.find(key);
+        if(it == shard.index.end())
+            return false;
+        entry = it->second;
+        return true;
+    };
 
-    for(unsigned i = 0; i < curSize; i++)
+    // Prefer our own paths, but allies paths are usable too
+    if(player < shards.size() && findInShard(player))
+        return player;
+    for(unsigned i = 0; i < shards.size(); i++)
     {
-        const Entry& pathEntry = pathes[i];
-        if(pathEntry.path.start != start && pathEntry.path.goal != start)
-            continue;
-        if(pathEntry.path.goal != goal && pathEntry.path.start != goal)
-            continue;
-        if(!thisPlayer.IsAlly(pathEntry.player))
-            continue;
-        return i;
+        if(i != player && thisPlayer.IsAlly(i) && findInShard(i))
+            return i;
     }
-    return curSize;
+    return shards.size();
+}
+
+void TradePathCache::RemoveEntry(const unsigned shardIdx, const EntryList::iterator entry)
+{
+    Shard& shard = shards[shardIdx];
+    shard.index.erase(MakeKey(entry->start, entry->goal));
+    shard.entries.erase(entry);
 }
 
 void TradePathCache::AddEntry(const GameWorldGame& gwg, const TradePath& path, const unsigned char player)
 {
-    // Find the idx of the new entry
-    // First look for an existing entry
-    unsigned idx = FindEntry(gwg, path.start, path.goal, player);
-    if(idx >= curSize)
+    if(maxEntriesPerPlayer == 0)
+        return;
+
+    const uint64_t key = MakeKey(path.start, path.goal);
+    // Replace an existing entry
+    EntryList::iterator entry;
+    const unsigned shardIdx = FindEntry(gwg, key, player, entry);
+    if(shardIdx < shards.size())
+        RemoveEntry(shardIdx, entry);
+
+    Shard& shard = GetShard(player);
+    if(shard.entries.size() >= maxEntriesPerPlayer)
     {
-        // None found --> Find a new spot
-        if(curSize < pathes.size())
-            idx = curSize++; // We got space left --> append
-        else
+        // No space left --> Replace least recently used
+        RemoveEntry(player, std::prev(shard.entries.end()));
+        stats.evictions++;
+    }
+    shard.entries.push_front(path);
+    shard.index[key] = shard.entries.begin();
+}
+
+void TradePathCache::OnOwnersChanged(const GameWorldGame& gwg, const std::vector<MapPoint>& pts)
+{
+    if(pts.empty() || GetNumEntries() == 0)
+        return;
+
+    std::unordered_set<unsigned> changedIdxs;
+    for(const MapPoint& pt : pts)
+        changedIdxs.insert(gwg.GetIdx(pt));
+
+    for(unsigned shardIdx = 0; shardIdx < shards.size(); shardIdx++)
+    {
+        const GamePlayer& player = gwg.GetPlayer(shardIdx);
+        // Same condition as used for the path search
+        const auto isUsable = [&gwg, &player](const MapPoint& pt) {
+            const unsigned char owner = gwg.GetNode(pt).owner;
+            return owner == 0 || player.IsAlly(owner - 1);
+        };
+        EntryList& entries = shards[shardIdx].entries;
+        for(auto it = entries.begin(); it != entries.end();)
         {
-            // No space left --> Replace oldest
-            idx = 0;
-            unsigned minLastUse = pathes[0].lastUse;
-            for(unsigned i = 1; i < curSize; i++)
+            bool isValid = true;
+            MapPoint curPt = it->start;
+            for(const Direction dir : it->route)
             {
-                if(pathes[i].lastUse < minLastUse)
+                curPt = gwg.GetNeighbour(curPt, dir);
+                if(helpers::contains(changedIdxs, gwg.GetIdx(curPt)) && !isUsable(curPt))
                 {
-                    minLastUse = pathes[i].lastUse;
-                    idx = i;
+                    isValid = false;
+                    break;
                 }
             }
+            if(isValid)
+                ++it;
+            else
+            {
+                RemoveEntry(shardIdx, it++);
+                stats.invalidations++;
+            }
+        }
+    }
+}
+
+void TradePathCache::SetMaxEntriesPerPlayer(const unsigned maxEntries)
+{
+    maxEntriesPerPlayer = maxEntries;
+    for(unsigned shardIdx = 0; shardIdx < shards.size(); shardIdx++)
+    {
+        while(shards[shardIdx].entries.size() > maxEntriesPerPlayer)
+        {
+            RemoveEntry(shardIdx, std::prev(shards[shardIdx].entries.end()));
+            stats.evictions++;
         }
     }
+}
 
-    pathes[idx].player = player;
-    pathes[idx].lastUse = gwg.GetEvMgr().GetCurrentGF();
-    pathes[idx].path = path;
+unsigned TradePathCache::GetNumEntries() const
+{
+    unsigned result = 0;
+    for(const Shard& shard : shards)
+        result += shard.entries.size();
+    return result;
 }
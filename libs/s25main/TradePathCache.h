@@ -19,29 +19,70 @@
 
 #include "world/TradePath.h"
 #include "s25util/Singleton.h"
-#include <array>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
 
 class GameWorldGame;
 
+/// Caches trade paths between 2 points so PathExists can be answered without a new path search.
+/// Each player has its own LRU list of at most maxEntriesPerPlayer paths, paths are shared with allies
 class TradePathCache : public Singleton<TradePathCache>
 {
-    struct Entry
+public:
+    struct Stats
+    {
+        /// Lookups answered by a still valid cached path
+        unsigned hits = 0;
+        /// Lookups which required a path search
+        unsigned misses = 0;
+        /// Paths removed to make room for newer ones
+        unsigned evictions = 0;
+        /// Paths removed because they became unusable
+        unsigned invalidations = 0;
+    };
+
+    static constexpr unsigned DEFAULT_MAX_ENTRIES_PER_PLAYER = 32;
+
+private:
+    using EntryList = std::list<TradePath>;
+    struct Shard
     {
-        unsigned char player;
-        unsigned lastUse;
-        TradePath path;
+        /// Most recently used path first
+        EntryList entries;
+        /// Key (see MakeKey) to entry
+        std::unordered_map<uint64_t, EntryList::iterator> index;
     };
 
-    std::array<Entry, 10> pathes; //-V730_NOINIT
-    unsigned curSize;
+    /// Shards by player, resized on demand
+    std::vector<Shard> shards;
+    unsigned maxEntriesPerPlayer;
+    Stats stats;
 
-    unsigned FindEntry(const GameWorldGame& gwg, const MapPoint& start, const MapPoint& goal,
-                       unsigned char player) const;
+    /// Return the key for a path between both points independent of the direction
+    static uint64_t MakeKey(const MapPoint& start, const MapPoint& goal);
+    /// Find the path between start and goal usable by the player. Returns the owner of the path or
+    /// shards.size() if none found
+    unsigned FindEntry(const GameWorldGame& gwg, uint64_t key, unsigned char player,
+                       EntryList::iterator& entry) const;
+    void RemoveEntry(unsigned shardIdx, EntryList::iterator entry);
+    Shard& GetShard(unsigned char player);
 
 public:
-    TradePathCache() : curSize(0) {}
+    TradePathCache() : maxEntriesPerPlayer(DEFAULT_MAX_ENTRIES_PER_PLAYER) {}
 
-    void Clear() { curSize = 0; }
+    /// Remove all paths and reset the statistics
+    void Clear();
     bool PathExists(const GameWorldGame& gwg, const MapPoint& start, const MapPoint& goal, unsigned char player);
     void AddEntry(const GameWorldGame& gwg, const TradePath& path, unsigned char player);
+    /// Remove all paths which are no longer usable by their player because the owner of one of the points changed
+    void OnOwnersChanged(const GameWorldGame& gwg, const std::vector<MapPoint>& pts);
+
+    /// Set the maximum number of paths stored per player. Evicts the least recently used paths if required
+    void SetMaxEntriesPerPlayer(unsigned maxEntries);
+    unsigned GetMaxEntriesPerPlayer() const { return maxEntriesPerPlayer; }
+    /// Return the number of paths stored for all players
+    unsigned GetNumEntries() const;
+    const Stats& GetStats() const { return stats; }
 };
@@ -19,6 +19,8 @@
 
 #include "AIInterface.h"
 #include "GameCommand.h"
+#include <string>
+#include <vector>
 
 class GameWorldBase;
 class GamePlayer;
@@ -49,6 +51,14 @@ public:
         return tmp;
     }
 
+    /// Get the chat messages sent by the AI and mark them as processed
+    std::vector<std::string> FetchChatMessages()
+    {
+        std::vector<std::string> tmp;
+        std::swap(tmp, chatMsgs);
+        return tmp;
+    }
+
     // access to ais CommandFactory
     const AIInterface& getAIInterface() const { return aii; }
     AIInterface& getAIInterface() { return aii; }
@@ -64,8 +74,13 @@ public:
     const GlobalGameSettings& ggs;
 
 protected:
+    /// Send a chat message to all players. It is queued so the AI can run on any thread
+    void Chat(std::string message) { chatMsgs.emplace_back(std::move(message)); }
+
     /// Queue der GameCommands, die noch bearbeitet werden müssen
     std::vector<gc::GameCommandPtr> gcs;
+    /// Chat messages not yet sent
+    std::vector<std::string> chatMsgs;
     /// Stärke der KI
     const AI::Level level;
     /// Abstrahiertes Interfaces, leitet Befehle weiter an
@@ -20,6 +20,7 @@
 #include "BuildingPlanner.h"
 #include "FindWhConditions.h"
 #include "GamePlayer.h"
+#include "GlobalGameSettings.h"
 #include "Jobs.h"
 #include "RttrForeachPt.h"
 #include "addons/const_addons.h"
@@ -31,8 +32,7 @@
 #include "buildings/nobUsual.h"
 #include "helpers/MaxEnumValue.h"
 #include "helpers/containerUtils.h"
-#include "network/GameClient.h"
-#include "network/GameMessages.h"
+#include "mygettext/mygettext.h"
 #include "notifications/BuildingNote.h"
 #include "notifications/ExpeditionNote.h"
 #include "notifications/NodeNote.h"
@@ -40,6 +40,7 @@
 #include "notifications/RoadNote.h"
 #include "notifications/ShipNote.h"
 #include "pathfinding/PathConditionRoad.h"
+#include "random/Random.h"
 #include "nodeObjs/noAnimal.h"
 #include "nodeObjs/noFlag.h"
 #include "nodeObjs/noShip.h"
@@ -51,7 +52,6 @@
 #include <algorithm>
 #include <array>
 #include <memory>
-#include <random>
 #include <stdexcept>
 #include <type_traits>
 
@@ -175,7 +175,8 @@ static auto createResourceMaps(const AIInterface& aii, const AIMap& aiMap)
 AIPlayerJH::AIPlayerJH(const unsigned char playerId, const GameWorldBase& gwb, const AI::Level level)
     : AIPlayer(playerId, gwb, level), UpgradeBldPos(MapPoint::Invalid()), resourceMaps(createResourceMaps(aii, aiMap)),
       isInitGfCompleted(false), defeated(player.IsDefeated()), bldPlanner(std::make_unique<BuildingPlanner>(*this)),
-      construction(std::make_unique<AIConstruction>(*this))
+      construction(std::make_unique<AIConstruction>(*this)),
+      rng((static_cast<uint64_t>(RANDOM.GetChecksum()) << 32) ^ ((playerId + 1u) * 0x9E3779B97F4A7C15u))
 {
     InitNodes();
     InitResourceMaps();
@@ -358,7 +359,7 @@ void AIPlayerJH::PlanNewBuildings(const unsigned gf)
         DistributeGoodsByBlocking(GoodType::Boards, 30);
         DistributeGoodsByBlocking(GoodType::Stones, 50);
         // go to the picked random warehouse and try to build around it
-        int randomStore = rand() % (storehouses.size());
+        int randomStore = GetRandom(storehouses.size());
         auto it = storehouses.begin();
         std::advance(it, randomStore);
         const MapPoint whPos = (*it)->GetPos();
@@ -379,7 +380,7 @@ void AIPlayerJH::PlanNewBuildings(const unsigned gf)
     const std::list<nobMilitary*>& militaryBuildings = aii.GetMilitaryBuildings();
     if(militaryBuildings.empty())
         return;
-    int randomMiliBld = rand() % militaryBuildings.size();
+    int randomMiliBld = GetRandom(militaryBuildings.size());
     auto it2 = militaryBuildings.begin();
     std::advance(it2, randomMiliBld);
     MapPoint bldPos = (*it2)->GetPos();
@@ -417,6 +418,12 @@ unsigned AIPlayerJH::GetNumJobs() const
     return eventManager.GetEventNum() + construction->GetBuildJobNum() + construction->GetConnectJobNum();
 }
 
+unsigned AIPlayerJH::GetRandom(unsigned maxExcl)
+{
+    RTTR_Assert(maxExcl > 0u);
+    return static_cast<unsigned>(rng() % maxExcl);
+}
+
 /// returns the warehouse closest to the upgradebuilding or if it cant find a way the first warehouse and if there is no
 /// warehouse left null
 nobBaseWarehouse* AIPlayerJH::GetUpgradeBuildingWarehouse()
@@ -1229,7 +1236,7 @@ void AIPlayerJH::HandleExpedition(const noShip* ship)
         aii.FoundColony(ship);
     else
     {
-        const unsigned offset = rand() % helpers::MaxEnumValue_v<ShipDirection>;
+        const unsigned offset = GetRandom(helpers::MaxEnumValue_v<ShipDirection>);
         for(auto dir : helpers::EnumRange<ShipDirection>{})
         {
             dir = ShipDirection((rttr::enum_cast(dir) + offset) % helpers::MaxEnumValue_v<ShipDirection>);
@@ -1276,9 +1283,7 @@ void AIPlayerJH::HandleTreeChopped(const MapPoint pt)
 
     UpdateNodesAround(pt, 3);
 
-    int random = rand();
-
-    if(random % 2 == 0)
+    if(GetRandom(2) == 0)
         AddMilitaryBuildJob(pt);
     else // if (random % 12 == 0)
         AddBuildJob(BuildingType::Woodcutter, pt);
@@ -1469,11 +1474,6 @@ void AIPlayerJH::MilUpgradeOptim()
     }
 }
 
-void AIPlayerJH::Chat(const std::string& message)
-{
-    GAMECLIENT.GetMainPlayer().sendMsgAsync(new GameMessage_Chat(playerId, ChatDestination::All, message));
-}
-
 bool AIPlayerJH::HasFrontierBuildings()
 {
     for(const nobMilitary* milBld : aii.GetMilitaryBuildings())
@@ -1550,7 +1550,7 @@ void AIPlayerJH::TryToAttack()
         // We skip the current building with a probability of limit/numMilBlds
         // -> For twice the number of blds as the limit we will most likely skip every 2nd building
         // This way we check roughly (at most) limit buildings but avoid any preference for one building over an other
-        if(rand() % numMilBlds > limit)
+        if(GetRandom(numMilBlds) > limit)
             continue;
 
         if(milBld->GetFrontierDistance() == FrontierDistance::Far) // inland building? -> skip it
@@ -1582,8 +1582,7 @@ void AIPlayerJH::TryToAttack()
     }
 
     // shuffle everything but headquarters and harbors without any troops in them
-    std::shuffle(potentialTargets.begin() + hq_or_harbor_without_soldiers, potentialTargets.end(),
-                 std::mt19937(std::random_device()()));
+    std::shuffle(potentialTargets.begin() + hq_or_harbor_without_soldiers, potentialTargets.end(), rng);
 
     // check for each potential attacking target the number of available attacking soldiers
     for(const nobBaseMilitary* target : potentialTargets)
@@ -1696,11 +1695,10 @@ void AIPlayerJH::TrySeaAttack()
             // \n",gwb.GetHarborPoint(i).x,gwb.GetHarborPoint(i).y);
         }
     }
-    auto prng = std::mt19937(std::random_device()());
     // any undefendedTargets? -> pick one by random
     if(!undefendedTargets.empty())
     {
-        std::shuffle(undefendedTargets.begin(), undefendedTargets.end(), prng);
+        std::shuffle(undefendedTargets.begin(), undefendedTargets.end(), rng);
         for(const nobBaseMilitary* targetMilBld : undefendedTargets)
         {
             std::vector<GameWorldBase::PotentialSeaAttacker> attackers =
@@ -1716,12 +1714,13 @@ void AIPlayerJH::TrySeaAttack()
     unsigned limit = 15;
     unsigned skip = 0;
     if(searcharoundharborspots.size() > 15)
-        skip = std::max<int>(rand() % (searcharoundharborspots.size() / 15 + 1) * 15, 1) - 1;
+        skip = std::max<int>(GetRandom(searcharoundharborspots.size() / 15 + 1) * 15, 1) - 1;
+    sortedMilitaryBlds buildings;
     for(unsigned i = skip; i < searcharoundharborspots.size() && limit > 0; i++)
     {
         limit--;
         // now add all military buildings around the harborspot to our list of potential targets
-        sortedMilitaryBlds buildings = gwb.LookForMilitaryBuildings(gwb.GetHarborPoint(searcharoundharborspots[i]), 2);
+        gwb.LookForMilitaryBuildings(gwb.GetHarborPoint(searcharoundharborspots[i]), 2, buildings);
         for(const nobBaseMilitary* milBld : buildings)
         {
             if(aii.IsPlayerAttackable(milBld->GetPlayer()) && aii.IsVisible(milBld->GetPos()))
@@ -1753,7 +1752,7 @@ void AIPlayerJH::TrySeaAttack()
     // random
     if(!undefendedTargets.empty())
     {
-        std::shuffle(undefendedTargets.begin(), undefendedTargets.end(), prng);
+        std::shuffle(undefendedTargets.begin(), undefendedTargets.end(), rng);
         for(const nobBaseMilitary* targetMilBld : undefendedTargets)
         {
             std::vector<GameWorldBase::PotentialSeaAttacker> attackers =
@@ -1765,7 +1764,7 @@ void AIPlayerJH::TrySeaAttack()
             }
         }
     }
-    std::shuffle(potentialTargets.begin(), potentialTargets.end(), prng);
+    std::shuffle(potentialTargets.begin(), potentialTargets.end(), rng);
     for(const nobBaseMilitary* ship : potentialTargets)
     {
         // TODO: decide if it is worth attacking the target and not just "possible"
@@ -2028,7 +2027,7 @@ bool AIPlayerJH::HuntablesinRange(const MapPoint pt, unsigned min)
             // Gibts hier was bewegliches?
             if(gwb.GetFigures(p2).empty())
                 continue;
-            const std::list<noBase*>& figures = gwb.GetFigures(p2);
+            const FigureList& figures = gwb.GetFigures(p2);
             // Dann nach Tieren suchen
             for(const noBase* fig : figures)
             {
@@ -2038,7 +2037,7 @@ bool AIPlayerJH::HuntablesinRange(const MapPoint pt, unsigned min)
                     if(!static_cast<const noAnimal*>(fig)->CanHunted())
                         continue;
                     // Und komme ich hin?
-                    if(gwb.FindHumanPath(pt, static_cast<const noAnimal*>(fig)->GetPos(), maxrange))
+                    if(gwb.DoesHumanPathExist(pt, static_cast<const noAnimal*>(fig)->GetPos(), maxrange))
                     // Dann nehmen wir es
                     {
                         if(++huntablecount >= min)
@@ -2151,7 +2150,7 @@ bool AIPlayerJH::ValidTreeinRange(const MapPoint pt)
                     // not already getting cut down or a freaking pineapple thingy?
                     if(!gwb.GetNode(t2).reserved && gwb.GetSpecObj<noTree>(t2)->ProducesWood())
                     {
-                        if(gwb.FindHumanPath(pt, t2, 20))
+                        if(gwb.DoesHumanPathExist(pt, t2, 20))
                             return true;
                     }
                 }
@@ -2175,7 +2174,7 @@ bool AIPlayerJH::ValidStoneinRange(const MapPoint pt)
                 // point has tree & path is available?
                 if(gwb.GetNO(t2)->GetType() == NodalObjectType::Granite)
                 {
-                    if(gwb.FindHumanPath(pt, t2, 20))
+                    if(gwb.DoesHumanPathExist(pt, t2, 20))
                         return true;
                 }
             }
@@ -2340,7 +2339,7 @@ bool AIPlayerJH::ValidFishInRange(const MapPoint pt)
                     // try to find a path to a neighboring node on the coast
                     for(const auto j : helpers::EnumRange<Direction>{})
                     {
-                        if(gwb.FindHumanPath(pt, gwb.GetNeighbour(t2, j), 10))
+                        if(gwb.DoesHumanPathExist(pt, gwb.GetNeighbour(t2, j), 10))
                             return true;
                     }
                 }
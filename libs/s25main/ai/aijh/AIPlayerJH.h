@@ -22,6 +22,7 @@
 #include "ai/aijh/AIMap.h"
 #include "ai/aijh/AIResourceMap.h"
 #include "helpers/OptionalEnum.h"
+#include "random/XorShift.h"
 #include "gameTypes/MapCoordinates.h"
 #include <boost/container/static_vector.hpp>
 #include <list>
@@ -59,6 +60,8 @@ public:
     const BuildingPlanner& GetBldPlanner() const { return *bldPlanner; }
     const AIJob* GetCurrentJob() const { return currentJob.get(); }
     unsigned GetNumJobs() const;
+    /// Return a random value in [0, maxExcl) from the RNG of this AI
+    unsigned GetRandom(unsigned maxExcl);
 
     void RunGF(unsigned gf, bool gfisnwf) override;
 
@@ -176,8 +179,6 @@ public:
     void HandleNewColonyFounded(MapPoint pt);
     /// Lost land to another player
     void HandleLostLand(MapPoint pt);
-    /// Sends a chat messsage to all players
-    void Chat(const std::string& message);
     /// check expeditions (order new / cancel)
     void CheckExpeditions();
     /// if we have 1 complete forester but less than 1 military building and less than 2 buildingsites stop production
@@ -252,6 +253,9 @@ private:
 
     Subscription subBuilding, subExpedition, subResource, subRoad, subShip, subBQ;
     std::vector<MapPoint> nodesWithOutdatedBQ;
+    /// RNG of this AI, seeded from the game RNG and the player id.
+    /// Not shared with other AIs so the decisions don't depend on the order the AIs run in
+    XorShift rng;
 };
 
 } // namespace AIJH
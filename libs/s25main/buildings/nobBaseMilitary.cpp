@@ -167,7 +167,7 @@ nofAttacker* nobBaseMilitary::FindAggressor(nofAggressiveDefender* defender)
         if(gwg->CalcDistance(attackerPos, defenderPos) <= 5)
         {
             // Check it further (e.g. if they have to walk around a river...)
-            if(gwg->FindHumanPath(attackerPos, defenderPos, 5))
+            if(gwg->DoesHumanPathExist(attackerPos, defenderPos, 5))
             {
                 aggressor->LetsFight(defender);
                 return aggressor;
@@ -227,7 +227,7 @@ MapPoint nobBaseMilitary::FindAnAttackerPlace(unsigned short& ret_radius, nofAtt
 
         unsigned length = 0;
         // Gültiger Weg gefunden
-        if(gwg->FindHumanPath(soldierPos, node.first, 100, false, &length))
+        if(gwg->DoesHumanPathExist(soldierPos, node.first, 100, &length))
         {
             // Kürzer als bisher kürzester Weg? --> Dann nehmen wir diesen Punkt (vorerst)
             if(length < min_length)
@@ -309,7 +309,7 @@ void nobBaseMilitary::CheckArrestedAttackers()
         {
             // Und kommt er überhaupt zur Flagge (könnte ja in der 2. Reihe stehen, sodass die
             // vor ihm ihn den Weg versperren)?
-            if(gwg->FindHumanPath(aggressor->GetPos(), gwg->GetNeighbour(pos, Direction::SouthEast), 5, false))
+            if(gwg->DoesHumanPathExist(aggressor->GetPos(), gwg->GetNeighbour(pos, Direction::SouthEast), 5))
             {
                 // dann kann der zur Flagge gehen
                 aggressor->AttackFlag();
@@ -330,7 +330,7 @@ bool nobBaseMilitary::SendSuccessor(const MapPoint pt, const unsigned short radi
             if(aggressor->GetRadius() > radius)
             {
                 // Und findet er einen zu diesem Punkt?
-                if(gwg->FindHumanPath(aggressor->GetPos(), pt, 50, false))
+                if(gwg->DoesHumanPathExist(aggressor->GetPos(), pt, 50))
                 {
                     // dann soll er dorthin gehen
                     aggressor->StartSucceeding(pt, radius);
@@ -19,6 +19,7 @@
 
 #include "buildings/noBuilding.h"
 #include <boost/container/flat_set.hpp>
+#include <boost/container/small_vector.hpp>
 #include <list>
 
 class nofSoldier;
@@ -153,5 +154,8 @@ protected:
     void AddLeavingFigure(noFigure* fig);
 };
 
-class sortedMilitaryBlds : public boost::container::flat_set<nobBaseMilitary*, nobBaseMilitary::Comparer>
+/// Military buildings sorted by age. Results of range queries are usually small, so they are stored inline
+class sortedMilitaryBlds :
+    public boost::container::flat_set<nobBaseMilitary*, nobBaseMilitary::Comparer,
+                                      boost::container::small_vector<nobBaseMilitary*, 16>>
 {};
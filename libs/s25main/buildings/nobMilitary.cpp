@@ -823,7 +823,7 @@ unsigned nobMilitary::GetNumSoldiersForAttack(const MapPoint dest) const
     }
 
     // und auch der Weg zu Fuß darf dann nicht so weit sein, wenn das alles bestanden ist, können wir ihn nehmen..
-    if(soldiers_count && gwg->FindHumanPath(pos, dest, MAX_ATTACKING_RUN_DISTANCE))
+    if(soldiers_count && gwg->DoesHumanPathExist(pos, dest, MAX_ATTACKING_RUN_DISTANCE))
         // Soldaten davon nehmen
         return soldiers_count;
     else
@@ -968,7 +968,7 @@ void nobMilitary::Capture(const unsigned char new_owner)
     std::array<MapPoint, 2> coords = {pos, gwg->GetNeighbour(pos, Direction::SouthEast)};
     for(const auto& coord : coords)
     {
-        const std::list<noBase*>& figures = gwg->GetFigures(coord);
+        const FigureList& figures = gwg->GetFigures(coord);
         for(auto* figure : figures)
         {
             if(figure->GetType() == NodalObjectType::Figure)
@@ -1048,7 +1048,7 @@ void nobMilitary::NeedOccupyingTroops()
                 continue;
             // Und kommt er überhaupt zur Flagge (könnte ja in der 2. Reihe stehen, sodass die vor ihm ihn den Weg
             // versperren)?
-            if(gwg->FindHumanPath(aggressor->GetPos(), gwg->GetNeighbour(pos, Direction::SouthEast), 10, false))
+            if(gwg->DoesHumanPathExist(aggressor->GetPos(), gwg->GetNeighbour(pos, Direction::SouthEast), 10))
             {
                 // Dann is das der bisher beste
                 best_attacker = aggressor;
@@ -1344,7 +1344,7 @@ void nobMilitary::CallNextFarAwayCapturer(nofAttacker* attacker)
             continue;
         RTTR_Assert(far_away_capturer->GetPos() != flagPos); // Impossible. This should be the current attacker
         unsigned length;
-        if(!gwg->FindHumanPath(far_away_capturer->GetPos(), flagPos, MAX_FAR_AWAY_CAPTURING_DISTANCE, false, &length))
+        if(!gwg->DoesHumanPathExist(far_away_capturer->GetPos(), flagPos, MAX_FAR_AWAY_CAPTURING_DISTANCE, &length))
             continue;
         if(length < minLength)
         {
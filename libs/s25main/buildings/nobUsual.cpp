@@ -254,14 +254,15 @@ void nobUsual::HandleEvent(const unsigned id)
     {
         const unsigned short current_productivity = CalcProductivity();
         // Sum over all last productivities and current (as start value)
-        productivity = std::accumulate(last_productivities.begin(), last_productivities.end(), current_productivity);
+        const unsigned sumProductivities =
+          std::accumulate(last_productivities.begin(), last_productivities.end(), unsigned(current_productivity));
         // Produktivität "verrücken"
         for(unsigned short i = last_productivities.size() - 1; i >= 1; --i)
             last_productivities[i] = last_productivities[i - 1];
         last_productivities[0] = current_productivity;
 
         // Durschnitt ausrechnen der letzten Produktivitäten PLUS der aktuellen!
-        productivity /= (last_productivities.size() + 1);
+        SetProductivity(static_cast<unsigned short>(sumProductivities / (last_productivities.size() + 1)));
 
         // Event für nächste Abrechnung
         productivity_ev = GetEvMgr().AddEvent(this, 400, 1);
@@ -335,6 +336,7 @@ void nobUsual::WareLost(Ware* ware)
         {
             RTTR_Assert(helpers::contains(ordered_wares[i], ware));
             ordered_wares[i].remove(ware);
+            gwg->GetPlayer(player).WareDemandChanged(*this);
             break;
         }
     }
@@ -427,6 +429,7 @@ void nobUsual::ConsumeWares()
         RTTR_Assert(numWares[wareIdxToUse] != 0);
         // Bestand verringern
         --numWares[wareIdxToUse];
+        owner.WareDemandChanged(*this);
         // Inventur entsprechend verringern
         owner.DecreaseInventoryWare(workDesc.waresNeeded[wareIdxToUse], 1);
 
@@ -488,6 +491,7 @@ void nobUsual::TakeWare(Ware* ware)
         {
             RTTR_Assert(!helpers::contains(ordered_wares[i], ware));
             ordered_wares[i].push_back(ware);
+            gwg->GetPlayer(player).WareDemandChanged(*this);
             return;
         }
     }
@@ -505,6 +509,7 @@ void nobUsual::SetProductionEnabled(const bool enabled)
         return;
     // Umstellen
     disable_production = !enabled;
+    gwg->GetPlayer(player).WareDemandChanged(*this);
     // Wenn das von einem fremden Spieler umgestellt wurde (oder vom Replay), muss auch das visuelle umgestellt werden
     if(GAMECLIENT.GetPlayerId() != player || GAMECLIENT.IsReplayModeOn())
         disable_production_virtual = disable_production;
@@ -534,7 +539,7 @@ void nobUsual::OnOutOfResources()
     if(outOfRessourcesMsgSent)
         return;
     outOfRessourcesMsgSent = true;
-    productivity = 0;
+    SetProductivity(0);
     std::fill(last_productivities.begin(), last_productivities.end(), 0);
 
     const char* error;
@@ -597,3 +602,9 @@ unsigned short nobUsual::CalcProductivity()
 
     return curProductivity;
 }
+
+void nobUsual::SetProductivity(const unsigned short newProductivity)
+{
+    gwg->GetPlayer(player).BuildingProductivityChanged(bldType_, productivity, newProductivity);
+    productivity = newProductivity;
+}
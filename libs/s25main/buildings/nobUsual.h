@@ -144,4 +144,6 @@ public:
 private:
     /// Calculates the productivity and resets the counter
     unsigned short CalcProductivity();
+    /// Set the productivity and update the statistics of the owner
+    void SetProductivity(unsigned short newProductivity);
 };
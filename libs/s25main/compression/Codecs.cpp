@@ -0,0 +1,280 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "compression/Codecs.h"
+#include "helpers/format.hpp"
+#include <bzlib.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#if RTTR_HAS_ZSTD
+#    include <zstd.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+// Store
+//////////////////////////////////////////////////////////////////////////
+
+void StoreCodec::Compress(const char* src, size_t srcLen, std::vector<char>& dst, int /*level*/) const
+{
+    dst.insert(dst.end(), src, src + srcLen);
+}
+
+void StoreCodec::Decompress(const char* src, size_t srcLen, char* dst, size_t dstLen) const
+{
+    if(srcLen != dstLen)
+        throw CompressionError(helpers::format("Stored data has size %1% instead of %2%", srcLen, dstLen));
+    std::copy(src, src + srcLen, dst);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// BZip2
+//////////////////////////////////////////////////////////////////////////
+
+void BZip2Codec::Compress(const char* src, size_t srcLen, std::vector<char>& dst, int level) const
+{
+    if(srcLen > std::numeric_limits<unsigned>::max() / 2)
+        throw CompressionError("Data too big for bzip2");
+    if(level <= 0 || level > 9)
+        level = 9;
+    const size_t oldSize = dst.size();
+    // Buffer should be at most 1% bigger + 600 Bytes according to docu
+    unsigned compressedLen = static_cast<unsigned>(srcLen + srcLen / 100 + 600);
+    dst.resize(oldSize + compressedLen);
+    // bzip2 rejects null pointers which we might get for empty data
+    char dummy = 0;
+    if(srcLen == 0u)
+        src = &dummy;
+    // bzip2 does not modify the input but takes a non-const pointer
+    int err = BZ2_bzBuffToBuffCompress(&dst[oldSize], &compressedLen, const_cast<char*>(src),
+                                       static_cast<unsigned>(srcLen), level, 0, 250);
+    if(err != BZ_OK)
+        throw CompressionError(helpers::format("BZ2_bzBuffToBuffCompress failed with code %1%", err));
+    dst.resize(oldSize + compressedLen);
+}
+
+void BZip2Codec::Decompress(const char* src, size_t srcLen, char* dst, size_t dstLen) const
+{
+    char dummy = 0;
+    if(dstLen == 0u)
+        dst = &dummy;
+    unsigned outLength = static_cast<unsigned>(dstLen);
+    int err =
+      BZ2_bzBuffToBuffDecompress(dst, &outLength, const_cast<char*>(src), static_cast<unsigned>(srcLen), 0, 0);
+    if(err != BZ_OK)
+        throw CompressionError(helpers::format("BZ2_bzBuffToBuffDecompress failed with code %1%", err));
+    if(outLength != dstLen)
+    {
+        throw CompressionError(
+          helpers::format("Length mismatch after decompressing. Expected: %1%, got %2%", dstLen, outLength));
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// LZ4
+// Implements the LZ4 block format (https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md):
+// Sequences of a token (4 bits literal length, 4 bits match length - 4), optional additional literal length bytes,
+// the literals, a 2 byte little endian offset and optional additional match length bytes.
+// The last sequence only has literals.
+//////////////////////////////////////////////////////////////////////////
+
+namespace {
+namespace lz4 {
+    constexpr size_t minMatch = 4;
+    /// The last 5 bytes are always literals
+    constexpr size_t lastLiterals = 5;
+    /// The last match must start at least 12 bytes before the end
+    constexpr size_t mfLimit = 12;
+    constexpr size_t maxOffset = 65535;
+    constexpr unsigned hashLog = 16;
+    constexpr unsigned lengthMask = 15;
+
+    uint32_t read32(const uint8_t* ptr)
+    {
+        uint32_t value;
+        std::memcpy(&value, ptr, sizeof(value));
+        return value;
+    }
+
+    unsigned hash(uint32_t sequence)
+    {
+        return (sequence * 2654435761u) >> (32 - hashLog);
+    }
+
+    void writeLength(std::vector<char>& dst, size_t length)
+    {
+        for(; length >= 255u; length -= 255u)
+            dst.push_back(static_cast<char>(255));
+        dst.push_back(static_cast<char>(length));
+    }
+
+    void writeLiterals(std::vector<char>& dst, const uint8_t* literals, size_t numLiterals, uint8_t token)
+    {
+        token |= static_cast<uint8_t>(std::min<size_t>(numLiterals, lengthMask) << 4);
+        dst.push_back(static_cast<char>(token));
+        if(numLiterals >= lengthMask)
+            writeLength(dst, numLiterals - lengthMask);
+        dst.insert(dst.end(), literals, literals + numLiterals);
+    }
+
+    size_t readLength(const uint8_t* src, size_t srcLen, size_t& pos)
+    {
+        size_t length = 0;
+        uint8_t curByte;
+        do
+        {
+            if(pos >= srcLen)
+                throw CompressionError("Truncated LZ4 data");
+            curByte = src[pos++];
+            length += curByte;
+        } while(curByte == 255u);
+        return length;
+    }
+} // namespace lz4
+} // namespace
+
+void LZ4Codec::Compress(const char* srcChars, size_t srcLen, std::vector<char>& dst, int /*level*/) const
+{
+    using namespace lz4;
+    const auto* src = reinterpret_cast<const uint8_t*>(srcChars);
+    dst.reserve(dst.size() + srcLen + srcLen / 255u + 16u);
+
+    size_t anchor = 0;
+    if(srcLen > mfLimit)
+    {
+        // Position of the last match candidates
+        std::vector<uint32_t> hashTable(1u << hashLog, 0u);
+        const size_t matchLimit = srcLen - lastLiterals;
+        size_t pos = 0;
+        while(pos + mfLimit <= srcLen)
+        {
+            const uint32_t sequence = read32(src + pos);
+            uint32_t& hashEntry = hashTable[hash(sequence)];
+            size_t ref = hashEntry;
+            hashEntry = static_cast<uint32_t>(pos);
+            if(ref >= pos || pos - ref > maxOffset || read32(src + ref) != sequence)
+            {
+                ++pos;
+                continue;
+            }
+            // Extend the match backwards into the pending literals
+            size_t matchStart = pos;
+            while(matchStart > anchor && ref > 0u && src[matchStart - 1] == src[ref - 1])
+            {
+                --matchStart;
+                --ref;
+            }
+            // And forward
+            size_t matchEnd = pos + minMatch;
+            size_t refEnd = ref + (matchEnd - matchStart);
+            while(matchEnd < matchLimit && src[matchEnd] == src[refEnd])
+            {
+                ++matchEnd;
+                ++refEnd;
+            }
+
+            const size_t matchLength = matchEnd - matchStart - minMatch;
+            writeLiterals(dst, src + anchor, matchStart - anchor,
+                          static_cast<uint8_t>(std::min<size_t>(matchLength, lengthMask)));
+            const size_t offset = matchStart - ref;
+            dst.push_back(static_cast<char>(offset & 0xFF));
+            dst.push_back(static_cast<char>(offset >> 8));
+            if(matchLength >= lengthMask)
+                writeLength(dst, matchLength - lengthMask);
+            anchor = pos = matchEnd;
+        }
+    }
+    writeLiterals(dst, src + anchor, srcLen - anchor, 0);
+}
+
+void LZ4Codec::Decompress(const char* srcChars, size_t srcLen, char* dst, size_t dstLen) const
+{
+    using namespace lz4;
+    const auto* src = reinterpret_cast<const uint8_t*>(srcChars);
+    size_t srcPos = 0, dstPos = 0;
+    while(true)
+    {
+        if(srcPos >= srcLen)
+            throw CompressionError("Truncated LZ4 data");
+        const uint8_t token = src[srcPos++];
+        size_t numLiterals = token >> 4;
+        if(numLiterals == lengthMask)
+            numLiterals += readLength(src, srcLen, srcPos);
+        if(numLiterals > srcLen - srcPos || numLiterals > dstLen - dstPos)
+            throw CompressionError("Invalid literal length in LZ4 data");
+        std::copy(srcChars + srcPos, srcChars + srcPos + numLiterals, dst + dstPos);
+        srcPos += numLiterals;
+        dstPos += numLiterals;
+        // Last sequence has no match
+        if(srcPos == srcLen)
+            break;
+
+        if(srcLen - srcPos < 2u)
+            throw CompressionError("Truncated LZ4 data");
+        const size_t offset = src[srcPos] | (src[srcPos + 1] << 8);
+        srcPos += 2;
+        if(offset == 0u || offset > dstPos)
+            throw CompressionError("Invalid offset in LZ4 data");
+        size_t matchLength = token & lengthMask;
+        if(matchLength == lengthMask)
+            matchLength += readLength(src, srcLen, srcPos);
+        matchLength += minMatch;
+        if(matchLength > dstLen - dstPos)
+            throw CompressionError("Invalid match length in LZ4 data");
+        // Source and destination may overlap which repeats the pattern
+        const char* matchSrc = dst + dstPos - offset;
+        for(size_t i = 0; i < matchLength; i++)
+            dst[dstPos + i] = matchSrc[i];
+        dstPos += matchLength;
+    }
+    if(dstPos != dstLen)
+    {
+        throw CompressionError(
+          helpers::format("Length mismatch after decompressing. Expected: %1%, got %2%", dstLen, dstPos));
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Zstd
+//////////////////////////////////////////////////////////////////////////
+
+#if RTTR_HAS_ZSTD
+void ZstdCodec::Compress(const char* src, size_t srcLen, std::vector<char>& dst, int level) const
+{
+    if(level <= 0)
+        level = 3;
+    level = std::min(level, ZSTD_maxCLevel());
+    const size_t oldSize = dst.size();
+    dst.resize(oldSize + ZSTD_compressBound(srcLen));
+    const size_t compressedLen = ZSTD_compress(&dst[oldSize], dst.size() - oldSize, src, srcLen, level);
+    if(ZSTD_isError(compressedLen))
+        throw CompressionError(std::string("ZSTD_compress failed: ") + ZSTD_getErrorName(compressedLen));
+    dst.resize(oldSize + compressedLen);
+}
+
+void ZstdCodec::Decompress(const char* src, size_t srcLen, char* dst, size_t dstLen) const
+{
+    const size_t outLength = ZSTD_decompress(dst, dstLen, src, srcLen);
+    if(ZSTD_isError(outLength))
+        throw CompressionError(std::string("ZSTD_decompress failed: ") + ZSTD_getErrorName(outLength));
+    if(outLength != dstLen)
+    {
+        throw CompressionError(
+          helpers::format("Length mismatch after decompressing. Expected: %1%, got %2%", dstLen, outLength));
+    }
+}
+#endif
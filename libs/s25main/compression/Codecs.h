@@ -0,0 +1,62 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "compression/CompressionCodec.h"
+
+/// Does not compress at all
+class StoreCodec : public CompressionCodec
+{
+public:
+    CodecId GetId() const override { return CodecId::Store; }
+    const char* GetName() const override { return "store"; }
+    void Compress(const char* src, size_t srcLen, std::vector<char>& dst, int level) const override;
+    void Decompress(const char* src, size_t srcLen, char* dst, size_t dstLen) const override;
+};
+
+/// Slow but with a good ratio. Levels 1-9, default 9
+class BZip2Codec : public CompressionCodec
+{
+public:
+    CodecId GetId() const override { return CodecId::BZip2; }
+    const char* GetName() const override { return "bzip2"; }
+    void Compress(const char* src, size_t srcLen, std::vector<char>& dst, int level) const override;
+    void Decompress(const char* src, size_t srcLen, char* dst, size_t dstLen) const override;
+};
+
+/// Very fast compression using the LZ4 block format. The level is ignored
+class LZ4Codec : public CompressionCodec
+{
+public:
+    CodecId GetId() const override { return CodecId::LZ4; }
+    const char* GetName() const override { return "lz4"; }
+    void Compress(const char* src, size_t srcLen, std::vector<char>& dst, int level) const override;
+    void Decompress(const char* src, size_t srcLen, char* dst, size_t dstLen) const override;
+};
+
+#if RTTR_HAS_ZSTD
+/// Fast with a ratio similar to bzip2 on high levels. Levels 1-22, default 3
+class ZstdCodec : public CompressionCodec
+{
+public:
+    CodecId GetId() const override { return CodecId::Zstd; }
+    const char* GetName() const override { return "zstd"; }
+    void Compress(const char* src, size_t srcLen, std::vector<char>& dst, int level) const override;
+    void Decompress(const char* src, size_t srcLen, char* dst, size_t dstLen) const override;
+};
+#endif
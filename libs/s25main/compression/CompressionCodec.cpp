@@ -0,0 +1,105 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "compression/CompressionCodec.h"
+#include "compression/Codecs.h"
+#include "helpers/format.hpp"
+#include <algorithm>
+#include <array>
+
+namespace {
+/// Magic bytes of the header written by compressWithHeader
+constexpr std::array<char, 4> headerMagic = {'R', 'T', 'T', 'C'};
+constexpr uint8_t headerVersion = 1;
+constexpr size_t headerSize = headerMagic.size() + 2;
+
+bool hasHeader(const char* src, size_t srcLen)
+{
+    return srcLen >= headerSize && std::equal(headerMagic.begin(), headerMagic.end(), src);
+}
+
+const CompressionCodec& getCodecOrThrow(CodecId id)
+{
+    const CompressionCodec* codec = CompressionCodec::Get(id);
+    if(!codec)
+        throw CompressionError(helpers::format("Compression codec %1% is not available", static_cast<unsigned>(id)));
+    return *codec;
+}
+} // namespace
+
+const CompressionCodec* CompressionCodec::Get(CodecId id)
+{
+    static const StoreCodec store;
+    static const BZip2Codec bzip2;
+    static const LZ4Codec lz4;
+#if RTTR_HAS_ZSTD
+    static const ZstdCodec zstd;
+#endif
+    switch(id)
+    {
+        case CodecId::Store: return &store;
+        case CodecId::BZip2: return &bzip2;
+        case CodecId::LZ4: return &lz4;
+#if RTTR_HAS_ZSTD
+        case CodecId::Zstd: return &zstd;
+#endif
+        default: break;
+    }
+    return nullptr;
+}
+
+std::vector<const CompressionCodec*> CompressionCodec::GetAll()
+{
+    std::vector<const CompressionCodec*> result;
+    for(CodecId id : {CodecId::Store, CodecId::BZip2, CodecId::LZ4, CodecId::Zstd})
+    {
+        if(const CompressionCodec* codec = Get(id))
+            result.push_back(codec);
+    }
+    return result;
+}
+
+std::vector<char> compressWithHeader(const char* src, size_t srcLen, CodecId codec, int level)
+{
+    std::vector<char> result(headerMagic.begin(), headerMagic.end());
+    result.push_back(static_cast<char>(headerVersion));
+    result.push_back(static_cast<char>(codec));
+    getCodecOrThrow(codec).Compress(src, srcLen, result, level);
+    return result;
+}
+
+CodecId getCompressedCodec(const char* src, size_t srcLen)
+{
+    // Data without header is always raw bzip2
+    if(!hasHeader(src, srcLen))
+        return CodecId::BZip2;
+    const auto version = static_cast<uint8_t>(src[headerMagic.size()]);
+    if(version != headerVersion)
+        throw CompressionError(helpers::format("Unsupported compression header version %1%", unsigned(version)));
+    return static_cast<CodecId>(src[headerMagic.size() + 1]);
+}
+
+void decompressWithHeader(const char* src, size_t srcLen, char* dst, size_t dstLen)
+{
+    const CodecId codec = getCompressedCodec(src, srcLen);
+    if(hasHeader(src, srcLen))
+    {
+        src += headerSize;
+        srcLen -= headerSize;
+    }
+    getCodecOrThrow(codec).Decompress(src, srcLen, dst, dstLen);
+}
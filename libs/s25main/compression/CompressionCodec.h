@@ -0,0 +1,74 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/// Identifies a compression algorithm. Stored in files, so do not change the values
+enum class CodecId : uint8_t
+{
+    /// Uncompressed
+    Store = 0,
+    BZip2 = 1,
+    LZ4 = 2,
+    /// Only available if the build found the zstd library
+    Zstd = 3
+};
+
+/// Thrown if data could not be (de)compressed
+class CompressionError : public std::runtime_error
+{
+public:
+    explicit CompressionError(const std::string& msg) : std::runtime_error(msg) {}
+};
+
+/// Interface of a compression algorithm working on complete buffers
+class CompressionCodec
+{
+public:
+    virtual ~CompressionCodec() = default;
+
+    virtual CodecId GetId() const = 0;
+    virtual const char* GetName() const = 0;
+    /// Compress srcLen bytes from src and append them to dst.
+    /// The meaning of level depends on the codec, 0 uses the default level
+    virtual void Compress(const char* src, size_t srcLen, std::vector<char>& dst, int level) const = 0;
+    /// Decompress srcLen bytes from src to dst which must have exactly dstLen bytes when decompressed
+    virtual void Decompress(const char* src, size_t srcLen, char* dst, size_t dstLen) const = 0;
+
+    /// Return the codec with the given id or nullptr if it is not available in this build
+    static const CompressionCodec* Get(CodecId id);
+    /// Return all codecs available in this build
+    static std::vector<const CompressionCodec*> GetAll();
+    /// Fast codec with a reasonable ratio, e.g. for autosaves
+    static CodecId GetFastCodec() { return CodecId::LZ4; }
+    /// Codec with a high ratio which can be decompressed by every build, e.g. for network transfer
+    static CodecId GetHighRatioCodec() { return CodecId::BZip2; }
+};
+
+/// Compress the data prepending a header which records the codec used
+std::vector<char> compressWithHeader(const char* src, size_t srcLen, CodecId codec, int level = 0);
+/// Decompress data compressed by compressWithHeader or raw bzip2 data (format used before the header was added).
+/// Throws a CompressionError on failure
+void decompressWithHeader(const char* src, size_t srcLen, char* dst, size_t dstLen);
+/// Return the codec used for the compressed data
+CodecId getCompressedCodec(const char* src, size_t srcLen);
@@ -33,6 +33,8 @@
 #include "lua/GameDataLoader.h"
 #include "ogl/FontStyle.h"
 #include "ogl/IRenderer.h"
+#include "ogl/SpriteBatch.h"
+#include "ogl/glFont.h"
 #include "random/Random.h"
 #include "world/GameWorld.h"
 #include "world/GameWorldView.h"
@@ -56,6 +58,8 @@ enum
 }
 
 static const unsigned numTestFrames = 500u;
+/// Every n-th text of the text benchmark changes each frame
+static const int changingTextInterval = 10;
 
 struct dskBenchmark::GameView
 {
@@ -128,8 +132,20 @@ void dskBenchmark::Msg_PaintAfter()
     {
         RoadBuildState roadState;
         roadState.mode = RoadBuildMode::Disabled;
+        gameView_->viewer.ApplyTerrainChanges();
         gameView_->view.Draw(roadState, MapPoint::Invalid(), false);
     }
+    if(curTest_ == Benchmark::Text)
+    {
+        // Some texts like counters change while most stay the same
+        const std::string frameStr = helpers::toString(frameCtr_.getCurNumFrames());
+        for(int i = 0; i < numInstances_; i += changingTextInterval)
+        {
+            // The amount of instances might have been changed during the test
+            if(auto* txt = GetCtrl<ctrlText>(ID_first + i))
+                txt->SetText(helpers::toString(i) + ": " + frameStr);
+        }
+    }
     if(curTest_ != Benchmark::None)
     {
         if(frameCtr_.getCurNumFrames() + 1u >= numTestFrames)
@@ -165,6 +181,8 @@ void dskBenchmark::startTest(Benchmark test)
             std::uniform_int_distribution<unsigned> distrMove(10, 25);
             DrawPoint pt(0, 0);
             const glFont* fnt = NormalFont;
+            for(const auto fontSize : helpers::enumRange<FontSize>())
+                LOADER.GetFont(fontSize)->ResetCacheStats();
             for(int i = 0; i < numInstances_; i++)
             {
                 std::string txt = createRandString(distr(rng), charset, seed);
@@ -291,6 +309,25 @@ void dskBenchmark::finishTest()
     LOG.write("Benchmark #%1% took %2%. -> %3%m/frame\n") % rttr::enum_cast(curTest_)
       % duration_cast<duration<float>>(frameCtr_.getCurIntervalLength())
       % duration_cast<milliseconds>(frameCtr_.getCurIntervalLength() / frameCtr_.getCurNumFrames());
+    if(gameView_)
+    {
+        const SpriteBatch::Stats& stats = gameView_->view.GetSpriteBatch().GetLastStats();
+        LOG.write("Map objects: %1% sprites, %2% draw calls, %3% vertices per frame\n") % stats.numSprites
+          % stats.numDrawCalls % stats.numVertices;
+    }
+    if(curTest_ == Benchmark::Text)
+    {
+        glFont::CacheStats stats;
+        for(const auto fontSize : helpers::enumRange<FontSize>())
+        {
+            const glFont::CacheStats& fontStats = LOADER.GetFont(fontSize)->GetCacheStats();
+            stats.numHits += fontStats.numHits;
+            stats.numMisses += fontStats.numMisses;
+        }
+        const unsigned numTexts = stats.numHits + stats.numMisses;
+        LOG.write("Text: %1% texts drawn, %2%%% served from the glyph run cache\n") % numTexts
+          % (numTexts ? stats.numHits * 100u / numTexts : 0u);
+    }
     if(testDurations_[curTest_] == milliseconds::zero())
         testDurations_[curTest_] = duration_cast<milliseconds>(frameCtr_.getCurIntervalLength());
     else
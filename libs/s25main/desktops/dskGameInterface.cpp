@@ -36,6 +36,7 @@
 #include "controls/ctrlText.h"
 #include "driver/MouseCoords.h"
 #include "drivers/VideoDriverWrapper.h"
+#include "dskReplaySeek.h"
 #include "helpers/format.hpp"
 #include "helpers/strUtils.h"
 #include "helpers/toString.h"
@@ -338,6 +339,13 @@ void dskGameInterface::Msg_PaintAfter()
 
     NormalFont->Draw(DrawPoint(30, 1), nwf_string.data(), FontStyle{}, COLOR_YELLOW);
 
+    // Autosaves are written in the background
+    if(const boost::optional<unsigned> saveProgress = GAMECLIENT.GetSaveProgress())
+    {
+        NormalFont->Draw(DrawPoint(30, 1 + NormalFont->getHeight()),
+                         helpers::format(_("Saving game... %1%%%"), *saveProgress), FontStyle{}, COLOR_YELLOW);
+    }
+
     // Replaydateianzeige in der linken unteren Ecke
     if(GAMECLIENT.IsReplayModeOn())
         NormalFont->Draw(DrawPoint(0, VIDEODRIVER.GetRenderSize().y), GAMECLIENT.GetReplayFilename().string(),
@@ -917,6 +925,7 @@ void dskGameInterface::Run()
     unsigned water_percent;
     // Draw mouse only if not on window
     bool drawMouse = WINDOWMANAGER.FindWindowAtPos(VIDEODRIVER.GetMousePos()) == nullptr;
+    worldViewer.ApplyTerrainChanges();
     gwv.Draw(road, actionwindow != nullptr ? actionwindow->GetSelectedPt() : MapPoint::Invalid(), drawMouse,
              &water_percent);
 
@@ -1157,6 +1166,11 @@ void dskGameInterface::CI_ReplayEndReached(const std::string& msg)
     messenger.AddMessage("", 0, ChatDestination::System, msg, COLOR_BLUE);
 }
 
+void dskGameInterface::CI_ReplayKeyframeRequired()
+{
+    WINDOWMANAGER.Switch(std::make_unique<dskReplaySeek>());
+}
+
 void dskGameInterface::CI_GamePaused()
 {
     messenger.AddMessage(_("SYSTEM"), COLOR_GREY, ChatDestination::System, _("Game was paused."));
@@ -71,6 +71,7 @@ public:
     void CI_Async(const std::string& checksums_list) override;
     void CI_ReplayAsync(const std::string& msg) override;
     void CI_ReplayEndReached(const std::string& msg) override;
+    void CI_ReplayKeyframeRequired() override;
     void CI_GamePaused() override;
     void CI_GameResumed() override;
     void CI_Error(ClientError ce) override;
@@ -0,0 +1,79 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "dskReplaySeek.h"
+#include "Loader.h"
+#include "WindowManager.h"
+#include "controls/ctrlTimer.h"
+#include "dskGameLoader.h"
+#include "dskSinglePlayer.h"
+#include "files.h"
+#include "ingameWindows/iwMsgbox.h"
+#include "network/GameClient.h"
+#include "mygettext/mygettext.h"
+#include "ogl/FontStyle.h"
+#include <memory>
+
+using namespace std::chrono_literals;
+
+dskReplaySeek::dskReplaySeek() : Desktop(LOADER.GetImageN(ResourceId(LOAD_SCREENS[rand() % LOAD_SCREENS.size()]), 0))
+{
+    WINDOWMANAGER.SetCursor(Cursor::None);
+    AddText(0, DrawPoint(800 / 2, 600 - 50), _("Jumping to the requested GF..."), COLOR_YELLOW, FontStyle::CENTER,
+            LargeFont);
+    GAMECLIENT.SetInterface(this);
+}
+
+dskReplaySeek::~dskReplaySeek()
+{
+    WINDOWMANAGER.SetCursor();
+    GAMECLIENT.RemoveInterface(this);
+}
+
+void dskReplaySeek::SetActive(bool activate)
+{
+    Desktop::SetActive(activate);
+    if(activate && !GetCtrl<ctrlTimer>(1))
+        AddTimer(1, 1ms);
+}
+
+void dskReplaySeek::Msg_Timer(const unsigned ctrl_id)
+{
+    GetCtrl<ctrlTimer>(ctrl_id)->Stop();
+    // Let the text be drawn once before loading. The previous desktop is gone at this point.
+    if(ctrl_id == 1)
+        AddTimer(2, 1ms);
+    else
+        GAMECLIENT.LoadReplayKeyframe();
+}
+
+void dskReplaySeek::CI_GameLoading(const std::shared_ptr<Game>& game)
+{
+    WINDOWMANAGER.Switch(std::make_unique<dskGameLoader>(game));
+}
+
+void dskReplaySeek::CI_Error(const ClientError ce)
+{
+    WINDOWMANAGER.Show(std::make_unique<iwMsgbox>(_("Error"), ClientErrorToStr(ce), this, MsgboxButton::Ok,
+                                                  MsgboxIcon::ExclamationRed, 0));
+}
+
+void dskReplaySeek::Msg_MsgBoxResult(const unsigned /*msgbox_id*/, const MsgboxResult /*mbr*/)
+{
+    GAMECLIENT.Stop();
+    WINDOWMANAGER.Switch(std::make_unique<dskSinglePlayer>());
+}
@@ -0,0 +1,40 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Desktop.h"
+#include "network/ClientInterface.h"
+#include <memory>
+
+/// Shown while the game of a replay is replaced by one loaded from a keyframe.
+/// It makes sure the old game is no longer in use by the GUI before the keyframe is loaded.
+class dskReplaySeek : public Desktop, public ClientInterface
+{
+public:
+    dskReplaySeek();
+    ~dskReplaySeek() override;
+
+    void SetActive(bool activate) override;
+
+    void CI_GameLoading(const std::shared_ptr<Game>& game) override;
+    void CI_Error(ClientError ce) override;
+
+private:
+    void Msg_Timer(unsigned ctrl_id) override;
+    void Msg_MsgBoxResult(unsigned msgbox_id, MsgboxResult mbr) override;
+};
@@ -18,6 +18,7 @@
 #include "dskSelectMap.h"
 #include "ListDir.h"
 #include "Loader.h"
+#include "MapHeaderIndex.h"
 #include "RttrConfig.h"
 #include "RttrLobbyClient.hpp"
 #include "WindowManager.h"
@@ -68,8 +69,11 @@ namespace bfs = boost::filesystem;
  *  @param[in] pass Server-Passwort
  */
 dskSelectMap::dskSelectMap(CreateServerInfo csi)
-    : Desktop(LOADER.GetImageN("setup015", 0)), csi(std::move(csi)), mapGenThread(nullptr), waitWnd(nullptr)
+    : Desktop(LOADER.GetImageN("setup015", 0)), csi(std::move(csi)), mapGenThread(nullptr), waitWnd(nullptr),
+      mapIndex(std::make_unique<MapHeaderIndex>()), isFillingTable(false), numNewBrokenMaps(0)
 {
+    mapIndex->Load(RTTRCONFIG.ExpandPath(s25::files::mapIndex));
+
     WorldDescription desc;
     GameDataLoader gdLoader(desc);
     if(!gdLoader.Load())
@@ -150,6 +154,9 @@ dskSelectMap::~dskSelectMap()
 {
     // if(mapGenThread)
     //    mapGenThread->join();
+    mapIndex->CancelScan();
+    if(mapIndex->IsModified())
+        mapIndex->Save(RTTRCONFIG.ExpandPath(s25::files::mapIndex));
     LOBBYCLIENT.RemoveListener(this);
     GAMECLIENT.RemoveInterface(this);
 }
@@ -167,25 +174,25 @@ void dskSelectMap::Msg_OptionGroupChange(const unsigned /*ctrl_id*/, unsigned se
                                                     s25::folders::mapsRttr, s25::folders::mapsOther,
                                                     s25::folders::mapsSea, s25::folders::mapsPlayed}};
 
-    const size_t numFaultyMapsPrior = brokenMapPaths.size();
     const bfs::path mapPath = RTTRCONFIG.ExpandPath(ids[selection]);
-    FillTable(ListDir(mapPath, "swd"));
-    FillTable(ListDir(mapPath, "wld"));
+    std::vector<bfs::path> files;
+    const auto addFiles = [&files](const bfs::path& path) {
+        for(const char* extension : {"swd", "wld"})
+        {
+            const std::vector<bfs::path> curFiles = ListDir(path, extension);
+            files.insert(files.end(), curFiles.begin(), curFiles.end());
+        }
+    };
+    addFiles(mapPath);
     // For own maps (WORLDS folder) also use the one in the installation folder as S2 does
     if(mapPath.filename() == "WORLDS")
-    {
-        const bfs::path worldsPath = RTTRCONFIG.ExpandPath("WORLDS");
-        FillTable(ListDir(worldsPath, "swd"));
-        FillTable(ListDir(worldsPath, "wld"));
-    }
+        addFiles(RTTRCONFIG.ExpandPath("WORLDS"));
 
-    if(brokenMapPaths.size() > numFaultyMapsPrior)
-    {
-        std::string errorTxt = helpers::format(_("%1% map(s) could not be loaded. Check the log for details"),
-                                               brokenMapPaths.size() - numFaultyMapsPrior);
-        WINDOWMANAGER.Show(
-          std::make_unique<iwMsgbox>(_("Error"), errorTxt, this, MsgboxButton::Ok, MsgboxIcon::ExclamationRed, 1));
-    }
+    // The headers are read in the background and added to the table in FillTable as they become available
+    numNewBrokenMaps = 0;
+    pendingSelectionPath.clear();
+    isFillingTable = true;
+    mapIndex->StartScan(std::move(files));
 
     // Dann noch sortieren
     table->SortRows(0, TableSortDir::Ascending);
@@ -218,6 +225,11 @@ void dskSelectMap::Msg_TableSelectItem(const unsigned ctrl_id, const boost::opti
     if(ctrl_id != 1)
         return;
 
+    ctrlTable& table = *GetCtrl<ctrlTable>(1);
+    // Adding rows while filling the table can move the selected map. Don't reload the preview then
+    if(selection && !previewMapPath.empty() && table.GetItemText(*selection, 5) == previewMapPath)
+        return;
+
     ctrlPreviewMinimap& preview = *GetCtrl<ctrlPreviewMinimap>(11);
     ctrlText& txtMapName = *GetCtrl<ctrlText>(12);
     ctrlText& txtMapPath = *GetCtrl<ctrlText>(13);
@@ -226,11 +238,11 @@ void dskSelectMap::Msg_TableSelectItem(const unsigned ctrl_id, const boost::opti
     txtMapName.SetText("");
     txtMapPath.SetText("");
     btContinue.SetEnabled(false);
+    previewMapPath.clear();
 
     // is the selection valid?
     if(selection)
     {
-        ctrlTable& table = *GetCtrl<ctrlTable>(1);
         const std::string& path = table.GetItemText(*selection, 5);
         if(!path.empty())
         {
@@ -242,6 +254,7 @@ void dskSelectMap::Msg_TableSelectItem(const unsigned ctrl_id, const boost::opti
                 txtMapName.SetText(s25util::ansiToUTF8(map->getHeader().getName()));
                 txtMapPath.SetText(path);
                 btContinue.SetEnabled(true);
+                previewMapPath = path;
             } catch(const std::runtime_error& e)
             {
                 const std::string errorTxt = helpers::format(_("Could not load map:\n%1%\n%2%"), path, e.what());
@@ -334,21 +347,30 @@ void dskSelectMap::CreateRandomMap()
 
 void dskSelectMap::OnMapCreated(const boost::filesystem::path& mapPath)
 {
+    // The file might have been overwritten within the resolution of the modification time
+    mapIndex->Invalidate(mapPath);
+
     // select the "played maps" entry
     auto* optionGroup = GetCtrl<ctrlOptionGroup>(10);
     optionGroup->SetSelection(8, true);
 
-    // search for the random map entry and select it in the table
+    // select the random map entry in the table as soon as it is added
+    pendingSelectionPath = mapPath.string();
+}
+
+bool dskSelectMap::SelectMap(const std::string& mapPath)
+{
     auto* table = GetCtrl<ctrlTable>(1);
-    const auto& mapPathString = mapPath.string();
-    for(int i = 0; i < table->GetNumRows(); i++)
+    for(unsigned i = 0; i < table->GetNumRows(); i++)
     {
-        if(table->GetItemText(i, 5) == mapPathString)
+        if(table->GetItemText(i, 5) == mapPath)
         {
-            table->SetSelection(i);
-            break;
+            if(table->GetSelection() != i)
+                table->SetSelection(i);
+            return true;
         }
     }
+    return false;
 }
 
 /// Startet das Spiel mit einer bestimmten Auswahl in der Tabelle
@@ -442,40 +464,68 @@ void dskSelectMap::Draw_()
         newRandMapPath.clear();
         randMapGenError.clear();
     }
+    FillTable();
     Desktop::Draw_();
 }
 
-void dskSelectMap::FillTable(const std::vector<bfs::path>& files)
+void dskSelectMap::FillTable()
 {
-    auto* table = GetCtrl<ctrlTable>(1);
+    // Check before fetching the results, so none are missed when the scan finishes in between
+    const bool isScanFinished = !mapIndex->IsScanning();
+    const std::vector<MapHeaderInfo> maps = mapIndex->FetchResults();
+    if(!maps.empty())
+    {
+        auto* table = GetCtrl<ctrlTable>(1);
+        const boost::optional<unsigned> selection = table->GetSelection();
+        const std::string selectedPath = selection ? table->GetItemText(*selection, 5) : "";
 
-    for(const bfs::path& filePath : files)
+        for(const MapHeaderInfo& info : maps)
+            AddMapToTable(info);
+
+        const int sortColumn = table->GetSortColumn();
+        table->SortRows(sortColumn >= 0 ? sortColumn : 0, table->GetSortDirection());
+
+        if(!pendingSelectionPath.empty())
+        {
+            if(SelectMap(pendingSelectionPath))
+                pendingSelectionPath.clear();
+        } else if(!selectedPath.empty())
+            SelectMap(selectedPath);
+    }
+
+    if(isFillingTable && isScanFinished)
     {
-        if(helpers::contains(brokenMapPaths, filePath))
-            continue;
-        // Karteninformationen laden
-        libsiedler2::Archiv map;
-        if(int ec = libsiedler2::loader::LoadMAP(filePath, map, true))
+        isFillingTable = false;
+        if(numNewBrokenMaps > 0)
         {
-            LOG.write(_("Failed to load map %1%: %2%\n")) % filePath % libsiedler2::getErrorString(ec);
-            brokenMapPaths.insert(filePath);
-            continue;
+            std::string errorTxt = helpers::format(_("%1% map(s) could not be loaded. Check the log for details"),
+                                                   numNewBrokenMaps);
+            WINDOWMANAGER.Show(
+              std::make_unique<iwMsgbox>(_("Error"), errorTxt, this, MsgboxButton::Ok, MsgboxIcon::ExclamationRed, 1));
         }
+    }
+}
 
-        const libsiedler2::ArchivItem_Map_Header& header = checkedCast<const glArchivItem_Map*>(map[0])->getHeader();
-
-        const bfs::path luaFilepath = bfs::path(filePath).replace_extension("lua");
-        const bool hasLua = bfs::is_regular_file(luaFilepath);
+void dskSelectMap::AddMapToTable(const MapHeaderInfo& info)
+{
+    if(helpers::contains(brokenMapPaths, info.filePath))
+        return;
+    if(!info.isValid)
+    {
+        LOG.write(_("Failed to load map %1%: %2%\n")) % info.filePath % info.errorMsg;
+        brokenMapPaths.insert(info.filePath);
+        numNewBrokenMaps++;
+        return;
+    }
 
-        // Und Zeilen vorbereiten
-        std::string players = (boost::format(_("%d Player")) % static_cast<unsigned>(header.getNumPlayers())).str();
-        std::string size = helpers::toString(header.getWidth()) + "x" + helpers::toString(header.getHeight());
+    // Und Zeilen vorbereiten
+    std::string players = (boost::format(_("%d Player")) % static_cast<unsigned>(info.numPlayers)).str();
+    std::string size = helpers::toString(info.width) + "x" + helpers::toString(info.height);
 
-        std::string name = s25util::ansiToUTF8(header.getName());
-        if(hasLua)
-            name += " (*)";
-        std::string author = s25util::ansiToUTF8(header.getAuthor());
+    std::string name = s25util::ansiToUTF8(info.name);
+    if(info.hasLua)
+        name += " (*)";
+    std::string author = s25util::ansiToUTF8(info.author);
 
-        table->AddRow({name, author, players, landscapeNames[header.getGfxSet()], size, filePath.string()});
-    }
+    GetCtrl<ctrlTable>(1)->AddRow({name, author, players, landscapeNames[info.gfxSet], size, info.filePath.string()});
 }
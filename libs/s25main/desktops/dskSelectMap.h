@@ -23,6 +23,7 @@
 #include "network/CreateServerInfo.h"
 #include "liblobby/LobbyInterface.h"
 #include <boost/filesystem/path.hpp>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -30,6 +31,8 @@
 namespace boost {
 class thread;
 }
+class MapHeaderIndex;
+struct MapHeaderInfo;
 
 class dskSelectMap final : public Desktop, public ClientInterface, public LobbyInterface
 {
@@ -40,7 +43,9 @@ public:
 private:
     void Draw_() override;
 
-    void FillTable(const std::vector<boost::filesystem::path>& files);
+    /// Add the maps read by the map index so far to the table
+    void FillTable();
+    void AddMapToTable(const MapHeaderInfo& info);
 
     void Msg_OptionGroupChange(unsigned ctrl_id, unsigned selection) override;
     void Msg_ButtonClick(unsigned ctrl_id) override;
@@ -69,6 +74,8 @@ private:
     void CreateRandomMap();
 
     void OnMapCreated(const boost::filesystem::path& mapPath);
+    /// Select the row of the given map. Return false if it is not in the table
+    bool SelectMap(const std::string& mapPath);
 
     CreateServerInfo csi;
     rttr::mapGenerator::MapSettings rndMapSettings;
@@ -80,4 +87,14 @@ private:
     std::map<uint8_t, std::string> landscapeNames;
     /// Maps that we already know are broken
     std::set<boost::filesystem::path> brokenMapPaths;
+    /// Cached headers of the maps, read in the background
+    std::unique_ptr<MapHeaderIndex> mapIndex;
+    /// True while the maps of the selected category are still added to the table
+    bool isFillingTable;
+    /// Number of broken maps found while filling the table
+    unsigned numNewBrokenMaps;
+    /// Map to select as soon as it is added to the table
+    std::string pendingSelectionPath;
+    /// Path of the map shown in the preview
+    std::string previewMapPath;
 };
@@ -575,7 +575,7 @@ void noFigure::Wander()
             if(way < best_way)
             {
                 // Are we at that flag or is there a path to it?
-                if(way == 0 || gwg->FindHumanPath(pos, flag->GetPos(), wander_radius, false, &way))
+                if(way == 0 || gwg->DoesHumanPathExist(pos, flag->GetPos(), wander_radius, &way))
                 {
                     // gucken, ob ein Weg zu einem Warenhaus führt
                     if(gwg->GetPlayer(player).FindWarehouse(*flag, FW::AcceptsFigure(job_), true, false))
@@ -186,7 +186,7 @@ void nofActiveSoldier::ExpelEnemies()
     std::vector<noFigure*> figures;
 
     // At the position of the soldier
-    const std::list<noBase*>& fieldFigures = gwg->GetFigures(pos);
+    const FigureList& fieldFigures = gwg->GetFigures(pos);
     for(auto* fieldFigure : fieldFigures)
     {
         if(fieldFigure->GetType() == NodalObjectType::Figure)
@@ -196,7 +196,7 @@ void nofActiveSoldier::ExpelEnemies()
     // And around this point
     for(const auto dir : helpers::EnumRange<Direction>{})
     {
-        const std::list<noBase*>& fieldFigures = gwg->GetFigures(gwg->GetNeighbour(pos, dir));
+        const FigureList& fieldFigures = gwg->GetFigures(gwg->GetNeighbour(pos, dir));
         for(auto* fieldFigure : fieldFigures)
         {
             // Normal settler?
@@ -467,9 +467,9 @@ bool nofActiveSoldier::GetFightSpotNear(nofActiveSoldier* other, MapPoint* fight
     const auto isGoodFightingSpot = [gwg = this->gwg, pos = this->pos, other](const auto& pt) {
         // Did we find a good spot?
         return gwg->ValidPointForFighting(pt, true, nullptr)
-               && (pos == pt || gwg->FindHumanPath(pos, pt, MEET_FOR_FIGHT_DISTANCE * 2, false, nullptr))
+               && (pos == pt || gwg->DoesHumanPathExist(pos, pt, MEET_FOR_FIGHT_DISTANCE * 2))
                && (other->GetPos() == pt
-                   || gwg->FindHumanPath(other->GetPos(), pt, MEET_FOR_FIGHT_DISTANCE * 2, false, nullptr));
+                   || gwg->DoesHumanPathExist(other->GetPos(), pt, MEET_FOR_FIGHT_DISTANCE * 2));
     };
     const std::vector<MapPoint> pts =
       gwg->GetPointsInRadius<1>(middle, MEET_FOR_FIGHT_DISTANCE, Identity<MapPoint>(), isGoodFightingSpot, true);
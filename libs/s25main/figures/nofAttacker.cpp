@@ -165,7 +165,7 @@ void nofAttacker::Walked()
 
             nofDefender* defender = nullptr;
             // Look for defenders at this position
-            const std::list<noBase*>& figures = gwg->GetFigures(goalFlagPos);
+            const FigureList& figures = gwg->GetFigures(goalFlagPos);
             for(auto* figure : figures)
             {
                 if(figure->GetGOT() == GO_Type::NofDefender)
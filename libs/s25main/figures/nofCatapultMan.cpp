@@ -127,7 +127,7 @@ void nofCatapultMan::HandleDerivedEvent(const unsigned /*id*/)
                    && gwg->GetPlayer(player).IsAttackable(building->GetPlayer()))
                 {
                     // Was nicht im Nebel liegt und auch schon besetzt wurde (nicht neu gebaut)?
-                    if(gwg->GetNode(building->GetPos()).fow[player].visibility == Visibility::Visible
+                    if(gwg->GetFoWNode(building->GetPos(), player).visibility == Visibility::Visible
                        && !static_cast<nobMilitary*>(building)->IsNewBuilt())
                     {
                         // Entfernung ausrechnen
@@ -210,7 +210,7 @@ bool nofFarmhand::IsPointAvailable(const MapPoint pt) const
     if(GetPointQuality(pt) != PointQuality::NotPossible)
     {
         // Gucken, ob ein Weg hinführt
-        return gwg->FindHumanPath(this->pos, pt, 20) != boost::none;
+        return gwg->DoesHumanPathExist(this->pos, pt, 20);
     } else
         return false;
 }
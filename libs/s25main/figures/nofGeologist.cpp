@@ -359,7 +359,7 @@ void nofGeologist::LookForNewNodes()
 
 bool nofGeologist::IsValidTargetNode(const MapPoint pt) const
 {
-    return (IsNodeGood(pt) && !gwg->GetNode(pt).reserved && (pos == pt || gwg->FindHumanPath(pos, pt, 20)));
+    return (IsNodeGood(pt) && !gwg->GetNode(pt).reserved && (pos == pt || gwg->DoesHumanPathExist(pos, pt, 20)));
 }
 
 helpers::OptionalEnum<Direction> nofGeologist::GetNextNode()
@@ -155,7 +155,7 @@ void nofHunter::TryStartHunting()
         for(curPos.x = pos.x - SQUARE_SIZE; curPos.x <= pos.x + SQUARE_SIZE; ++curPos.x)
         {
             MapPoint curMapPos = gwg->MakeMapPoint(curPos);
-            const std::list<noBase*>& figures = gwg->GetFigures(curMapPos);
+            const FigureList& figures = gwg->GetFigures(curMapPos);
 
             // nach Tieren suchen
             for(auto* figure : figures)
@@ -167,7 +167,7 @@ void nofHunter::TryStartHunting()
                     continue;
 
                 // Und komme ich hin?
-                if(gwg->FindHumanPath(pos, static_cast<noAnimal*>(figure)->GetPos(), MAX_HUNTING_DISTANCE))
+                if(gwg->DoesHumanPathExist(pos, static_cast<noAnimal*>(figure)->GetPos(), MAX_HUNTING_DISTANCE))
                 {
                     // Dann nehmen wir es
                     available_animals.push_back(static_cast<noAnimal*>(figure));
@@ -222,7 +222,7 @@ void nofHunter::WalkedDerived()
 bool nofHunter::IsShootingPointGood(const MapPoint pt)
 {
     // Punkt muss betretbar sein und man muss ihn erreichen können
-    return PathConditionHuman(*gwg).IsNodeOk(pt) && gwg->FindHumanPath(this->pos, pt, 6) != boost::none;
+    return PathConditionHuman(*gwg).IsNodeOk(pt) && gwg->DoesHumanPathExist(this->pos, pt, 6);
 }
 
 void nofHunter::HandleStateChasing()
@@ -269,7 +269,7 @@ void nofHunter::HandleStateChasing()
             }
 
             MapPoint curShootingPos = gwg->MakeMapPoint(animalPos + delta);
-            if(curShootingPos == pos || gwg->FindHumanPath(pos, curShootingPos, 6))
+            if(curShootingPos == pos || gwg->DoesHumanPathExist(pos, curShootingPos, 6))
             {
                 shootingPos = curShootingPos;
                 // Richtung, in die geschossen wird, bestimmen (natürlich die entgegengesetzte nehmen)
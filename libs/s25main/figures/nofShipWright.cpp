@@ -87,7 +87,7 @@ void nofShipWright::HandleDerivedEvent(const unsigned /*id*/)
                         // Platz noch nicht reserviert und gehört das Schiff auch mir?
                         if(!gwg->GetNode(pos).reserved && static_cast<noShipBuildingSite*>(obj)->GetPlayer() == player)
                         {
-                            if(gwg->FindHumanPath(flagPos, pt, SHIPWRIGHT_WALKING_DISTANCE))
+                            if(gwg->DoesHumanPathExist(flagPos, pt, SHIPWRIGHT_WALKING_DISTANCE))
                                 available_points.push_back(pt);
                         }
                     }
@@ -99,7 +99,7 @@ void nofShipWright::HandleDerivedEvent(const unsigned /*id*/)
                     for(const auto& pt : possiblePts)
                     {
                         // Dieser Punkt geeignet?
-                        if(IsPointGood(pt) && gwg->FindHumanPath(flagPos, pt, SHIPWRIGHT_WALKING_DISTANCE))
+                        if(IsPointGood(pt) && gwg->DoesHumanPathExist(flagPos, pt, SHIPWRIGHT_WALKING_DISTANCE))
                             available_points.push_back(pt);
                     }
                 }
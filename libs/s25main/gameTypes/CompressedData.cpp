@@ -19,10 +19,19 @@
 #include "FileChecksum.h"
 #include "s25util/Log.h"
 #include <boost/nowide/fstream.hpp>
-#include <bzlib.h>
-#include <cmath>
 #include <memory>
 
+void CompressedData::Compress(const char* src, unsigned len, CodecId codec, int level)
+{
+    data = compressWithHeader(src, len, codec, level);
+    length = len;
+}
+
+void CompressedData::Decompress(char* dst) const
+{
+    decompressWithHeader(data.data(), data.size(), dst, length);
+}
+
 bool CompressedData::DecompressToFile(const boost::filesystem::path& filePath, unsigned* checksum)
 {
     boost::nowide::ofstream file(filePath, std::ios::binary);
@@ -35,18 +44,12 @@ bool CompressedData::DecompressToFile(const boost::filesystem::path& filePath, u
 
     auto uncompressedData = std::unique_ptr<char[]>(new char[length]);
 
-    unsigned outLength = length;
-
-    int err = BZ2_bzBuffToBuffDecompress(uncompressedData.get(), &outLength, &data[0], data.size(), 0, 0);
-    if(err != BZ_OK)
+    try
     {
-        LOG.write("FATAL ERROR: BZ2_bzBuffToBuffDecompress failed with code %d\n") % err;
-        return false;
-    }
-
-    if(outLength != length)
+        Decompress(uncompressedData.get());
+    } catch(const CompressionError& e)
     {
-        LOG.write("FATAL ERROR: Length mismatch after decompressing. Expected: %u, got %u\n") % length % outLength;
+        LOG.write("FATAL ERROR: Decompressing data for %s failed: %s\n") % filePath % e.what();
         return false;
     }
 
@@ -62,30 +65,28 @@ bool CompressedData::DecompressToFile(const boost::filesystem::path& filePath, u
     return true;
 }
 
-bool CompressedData::CompressFromFile(const boost::filesystem::path& filePath, unsigned* checksum /* = nullptr */)
+bool CompressedData::CompressFromFile(const boost::filesystem::path& filePath, unsigned* checksum, CodecId codec)
 {
     boost::nowide::ifstream file(filePath, std::ios::binary | std::ios::ate);
-    length = static_cast<unsigned>(file.tellg());
-    data.resize(static_cast<int>(std::ceil(length * 1.1))
-                + 600); // Buffer should be at most 1% bigger + 600 Bytes according to docu
+    const auto fileLength = static_cast<unsigned>(file.tellg());
     file.seekg(0);
 
-    auto uncompressedData = std::unique_ptr<char[]>(new char[length]);
+    auto uncompressedData = std::unique_ptr<char[]>(new char[fileLength]);
 
-    if(!file.read(uncompressedData.get(), length))
+    if(!file.read(uncompressedData.get(), fileLength))
     {
         LOG.write("Could not read from %s\n") % filePath;
         return false;
     }
 
-    unsigned compressedLen = data.size();
-    int err = BZ2_bzBuffToBuffCompress(&data[0], &compressedLen, uncompressedData.get(), length, 9, 0, 250);
-    if(err != BZ_OK)
+    try
+    {
+        Compress(uncompressedData.get(), fileLength, codec);
+    } catch(const CompressionError& e)
     {
-        LOG.write("FATAL ERROR: BZ2_bzBuffToBuffCompress failed with error: %d\n") % err;
+        LOG.write("FATAL ERROR: Compressing %s failed: %s\n") % filePath % e.what();
         return false;
     }
-    data.resize(compressedLen);
 
     if(checksum)
         *checksum = CalcChecksumOfBuffer(uncompressedData.get(), length);
@@ -17,11 +17,13 @@
 
 #pragma once
 
+#include "compression/CompressionCodec.h"
 #include <boost/filesystem/path.hpp>
 #include <string>
 #include <vector>
 
-/// Holds compressed data
+/// Holds compressed data.
+/// The data starts with a header identifying the codec or is raw bzip2 data (used by older versions)
 struct CompressedData
 {
     CompressedData() : length(0) {}
@@ -30,8 +32,16 @@ struct CompressedData
         length = 0;
         data.clear();
     }
+    /// Compress the given data replacing the current content. Throws a CompressionError on failure
+    void Compress(const char* src, unsigned len, CodecId codec = CompressionCodec::GetHighRatioCodec(), int level = 0);
+    /// Decompress into dst which must hold at least length bytes. Throws a CompressionError on failure
+    void Decompress(char* dst) const;
+    /// Return the codec used to compress the data
+    CodecId GetCodec() const { return getCompressedCodec(data.data(), data.size()); }
+
     bool DecompressToFile(const boost::filesystem::path& filePath, unsigned* checksum = nullptr);
-    bool CompressFromFile(const boost::filesystem::path& filePath, unsigned* checksum = nullptr);
+    bool CompressFromFile(const boost::filesystem::path& filePath, unsigned* checksum = nullptr,
+                          CodecId codec = CompressionCodec::GetHighRatioCodec());
 
     /// Uncompressed length
     unsigned length;
@@ -30,7 +30,8 @@ MapNode::MapNode()
     std::fill(boundary_stones.begin(), boundary_stones.end(), 0);
 }
 
-void MapNode::Serialize(SerializedGameData& sgd, const unsigned numPlayers, const WorldDescription& desc) const
+void MapNode::Serialize(SerializedGameData& sgd, const WorldDescription& desc, const std::vector<const FoWNode*>& fow,
+                        const FigureList& figures) const
 {
     for(PointRoad road : roads)
         sgd.PushEnum<uint8_t>(road);
@@ -45,17 +46,17 @@ void MapNode::Serialize(SerializedGameData& sgd, const unsigned numPlayers, cons
     for(unsigned char boundary_stone : boundary_stones)
         sgd.PushUnsignedChar(boundary_stone);
     sgd.PushEnum<uint8_t>(bq);
-    RTTR_Assert(numPlayers <= fow.size());
-    for(unsigned z = 0; z < numPlayers; ++z)
-        fow[z].Serialize(sgd);
+    for(const FoWNode* fowNode : fow)
+        fowNode->Serialize(sgd);
     sgd.PushObject(obj, false);
     sgd.PushObjectContainer(figures, false);
     sgd.PushUnsignedShort(seaId);
     sgd.PushUnsignedInt(harborId);
 }
 
-void MapNode::Deserialize(SerializedGameData& sgd, const unsigned numPlayers, const WorldDescription& desc,
-                          const std::vector<DescIdx<TerrainDesc>>& landscapeTerrains)
+void MapNode::Deserialize(SerializedGameData& sgd, const WorldDescription& desc,
+                          const std::vector<DescIdx<TerrainDesc>>& landscapeTerrains, const std::vector<FoWNode*>& fow,
+                          FigureList& figures)
 {
     for(PointRoad& road : roads)
         road = sgd.Pop<PointRoad>();
@@ -85,9 +86,8 @@ void MapNode::Deserialize(SerializedGameData& sgd, const unsigned numPlayers, co
     for(uint8_t& boundary_stone : boundary_stones)
         boundary_stone = sgd.PopUnsignedChar();
     bq = sgd.Pop<BuildingQuality>();
-    RTTR_Assert(numPlayers <= fow.size());
-    for(unsigned z = 0; z < numPlayers; ++z)
-        fow[z].Deserialize(sgd);
+    for(FoWNode* fowNode : fow)
+        fowNode->Deserialize(sgd);
     obj = sgd.PopObject<noBase>(GO_Type::Unknown);
     sgd.PopObjectContainer(figures, GO_Type::Unknown);
     seaId = sgd.PopUnsignedShort();
@@ -20,12 +20,10 @@
 #include "Resource.h"
 #include "helpers/EnumArray.h"
 #include "gameTypes/BuildingQuality.h"
+#include "gameTypes/FigureList.h"
 #include "gameTypes/FoWNode.h"
 #include "gameTypes/MapTypes.h"
 #include "gameData/DescIdx.h"
-#include "gameData/MaxPlayers.h"
-#include <array>
-#include <list>
 #include <vector>
 
 class noBase;
@@ -34,6 +32,7 @@ struct TerrainDesc;
 struct WorldDescription;
 
 /// Eigenschaften von einem Punkt auf der Map
+/// Contains only the frequently used data. FoW and figures are stored in separate planes by the world
 struct MapNode
 {
     /// Roads from this point: E, SE, SW
@@ -53,8 +52,6 @@ struct MapNode
     unsigned char owner;
     BoundaryStones boundary_stones;
     BuildingQuality bq;
-    /// How the players see the point in FoW
-    std::array<FoWNode, MAX_PLAYERS> fow;
 
     /// To which sea this belongs to (0=None)
     unsigned short seaId;
@@ -63,11 +60,12 @@ struct MapNode
 
     /// Objekt, welches sich dort befindet
     noBase* obj;
-    /// Figures or fights on this node
-    std::list<noBase*> figures;
 
     MapNode();
-    void Serialize(SerializedGameData& sgd, unsigned numPlayers, const WorldDescription& desc) const;
-    void Deserialize(SerializedGameData& sgd, unsigned numPlayers, const WorldDescription& desc,
-                     const std::vector<DescIdx<TerrainDesc>>& landscapeTerrains);
+    /// Serialize the node together with the FoW nodes of all players and the figures on it
+    void Serialize(SerializedGameData& sgd, const WorldDescription& desc, const std::vector<const FoWNode*>& fow,
+                   const FigureList& figures) const;
+    void Deserialize(SerializedGameData& sgd, const WorldDescription& desc,
+                     const std::vector<DescIdx<TerrainDesc>>& landscapeTerrains, const std::vector<FoWNode*>& fow,
+                     FigureList& figures);
 };
@@ -51,18 +51,5 @@ static constexpr auto maxEnumValue(StatisticTime)
     return StatisticTime::T16Hours;
 }
 
-/// Anzahl der Statistikschritte, die gespeichert werden
+/// Number of statistic steps shown in the statistic windows
 const unsigned NUM_STAT_STEPS = 30;
-
-inline unsigned short incrStatIndex(unsigned short i)
-{
-    return (i == NUM_STAT_STEPS - 1) ? 0 : ++i;
-}
-inline unsigned short decrStatIndex(unsigned short i)
-{
-    return (i == 0) ? NUM_STAT_STEPS - 1 : --i;
-}
-inline unsigned short decrStatIndex(unsigned short i, unsigned short amount)
-{
-    return (i < amount) ? NUM_STAT_STEPS - (amount - i) - 1 : i - amount;
-}
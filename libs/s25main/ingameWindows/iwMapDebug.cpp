@@ -20,9 +20,11 @@
 #include "Loader.h"
 #include "PointOutput.h"
 #include "RttrForeachPt.h"
+#include "TradePathCache.h"
 #include "ai/aijh/AIPlayerJH.h"
 #include "controls/ctrlCheck.h"
 #include "controls/ctrlComboBox.h"
+#include "controls/ctrlText.h"
 #include "controls/ctrlTimer.h"
 #include "helpers/toString.h"
 #include "notifications/NodeNote.h"
@@ -34,6 +36,7 @@
 #include "gameTypes/GameTypesOutput.h"
 #include "gameTypes/TextureColor.h"
 #include "gameData/const_gui_ids.h"
+#include "s25util/colors.h"
 #include <boost/nowide/iostream.hpp>
 #include <chrono>
 
@@ -46,6 +49,7 @@ enum
     ID_cbCheckEventForPlayer,
     ID_lblCheckEvents,
     ID_tmrCheckEvents,
+    ID_txtTradePathCache,
 };
 }
 
@@ -157,7 +161,7 @@ using namespace std::chrono_literals;
 static const std::array<std::chrono::milliseconds, 6> BQ_CHECK_INTERVALS = {10s, 1s, 500ms, 250ms, 100ms, 50ms};
 
 iwMapDebug::iwMapDebug(GameWorldView& gwv, bool allowCheating)
-    : IngameWindow(CGI_MAP_DEBUG, IngameWindow::posLastOrCenter, Extent(230, 135), _("Map Debug"),
+    : IngameWindow(CGI_MAP_DEBUG, IngameWindow::posLastOrCenter, Extent(230, 160), _("Map Debug"),
                    LOADER.GetImageN("resource", 41)),
       gwv(gwv), printer(std::make_unique<DebugPrinter>(gwv.GetWorld()))
 {
@@ -202,6 +206,7 @@ iwMapDebug::iwMapDebug(GameWorldView& gwv, bool allowCheating)
         players->SetSelection(0);
         printer->showDataIdx = data->GetSelection().get();
         printer->playerIdx = players->GetSelection().get();
+        AddText(ID_txtTradePathCache, DrawPoint(15, 130), "", COLOR_YELLOW, FontStyle{}, NormalFont);
     } else
     {
         printer->showDataIdx = 0;
@@ -209,6 +214,7 @@ iwMapDebug::iwMapDebug(GameWorldView& gwv, bool allowCheating)
         Extent iwSize = GetIwSize();
         iwSize.y -= 40 + 10;
         SetIwSize(iwSize);
+        AddText(ID_txtTradePathCache, DrawPoint(15, 80), "", COLOR_YELLOW, FontStyle{}, NormalFont);
     }
 
     printer->showCoords = cbShowCoords->GetCheck();
@@ -219,6 +225,18 @@ iwMapDebug::~iwMapDebug()
     gwv.RemoveDrawNodeCallback(printer.get());
 }
 
+void iwMapDebug::Msg_PaintBefore()
+{
+    IngameWindow::Msg_PaintBefore();
+    const TradePathCache& tradePathCache = TradePathCache::inst();
+    const TradePathCache::Stats& stats = tradePathCache.GetStats();
+    GetCtrl<ctrlText>(ID_txtTradePathCache)
+      ->SetText((boost::format(_("Trade paths: %1% (%2% hits, %3% misses, %4% evicted, %5% invalidated)"))
+                 % tradePathCache.GetNumEntries() % stats.hits % stats.misses % stats.evictions
+                 % stats.invalidations)
+                  .str());
+}
+
 void iwMapDebug::Msg_ComboSelectItem(const unsigned ctrl_id, const unsigned select)
 {
     if(ctrl_id == ID_cbShowWhat)
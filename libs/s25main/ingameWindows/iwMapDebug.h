@@ -32,6 +32,7 @@ private:
     class DebugPrinter;
     class EventChecker;
 
+    void Msg_PaintBefore() override;
     void Msg_ComboSelectItem(unsigned ctrl_id, unsigned select) override;
     void Msg_CheckboxChange(unsigned ctrl_id, bool checked) override;
     void Msg_Timer(unsigned ctrl_id) override;
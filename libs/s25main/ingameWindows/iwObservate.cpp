@@ -103,7 +103,7 @@ void iwObservate::Msg_ButtonClick(const unsigned ctrl_id)
                         if(view->GetViewer().GetVisibility(curPt) != Visibility::Visible)
                             continue;
 
-                        const std::list<noBase*>& figures = view->GetWorld().GetFigures(curPt);
+                        const FigureList& figures = view->GetWorld().GetFigures(curPt);
 
                         for(const noBase* obj : figures)
                         {
@@ -223,7 +223,7 @@ bool iwObservate::MoveToFollowedObj(const MapPoint ptToCheck)
 {
     if(view->GetViewer().GetVisibility(ptToCheck) != Visibility::Visible)
         return false;
-    const std::list<noBase*>& curObjs = view->GetWorld().GetFigures(ptToCheck);
+    const FigureList& curObjs = view->GetWorld().GetFigures(ptToCheck);
     for(const noBase* obj : curObjs)
     {
         if(obj->GetObjId() == followMovableId)
@@ -31,6 +31,8 @@
 #include "world/GameWorldBase.h"
 #include "world/GameWorldViewer.h"
 #include "gameData/const_gui_ids.h"
+#include <algorithm>
+#include <vector>
 
 iwStatistics::iwStatistics(const GameWorldViewer& gwv)
     : IngameWindow(CGI_STATISTICS, IngameWindow::posLastOrCenter, Extent(252, 336), _("Statistics"),
@@ -293,30 +295,23 @@ void iwStatistics::DrawStatistic(StatisticType type)
     const Extent size(180, 80);
     const int stepX = size.x / NUM_STAT_STEPS;
 
-    unsigned short currentIndex;
     unsigned max = 1;
     unsigned min = 65000;
 
-    // Maximal- und Minimalwert suchen
+    // Only get the shown statistic of the active players, oldest value first
     const GameWorldBase& world = gwv.GetWorld();
+    std::vector<std::vector<unsigned>> values(world.GetNumPlayers());
+    // Maximal- und Minimalwert suchen
     for(unsigned p = 0; p < world.GetNumPlayers(); ++p)
     {
         if(!activePlayers[p])
             continue;
-        const GamePlayer::Statistic& stat = world.GetPlayer(p).GetStatistic(currentTime);
-
-        currentIndex = stat.currentIndex;
-        for(unsigned i = 0; i < NUM_STAT_STEPS; ++i)
+        values[p] = world.GetPlayer(p).GetStatisticValues(type, currentTime);
+        for(const unsigned value : values[p])
         {
-            if(max < stat.data[type][(currentIndex >= i) ? (currentIndex - i) : (NUM_STAT_STEPS - i + currentIndex)])
-            {
-                max = stat.data[type][(currentIndex >= i) ? (currentIndex - i) : (NUM_STAT_STEPS - i + currentIndex)];
-            }
-            if(SETTINGS.ingame.scale_statistics //-V807
-               && min > stat.data[type][(currentIndex >= i) ? (currentIndex - i) : (NUM_STAT_STEPS - i + currentIndex)])
-            {
-                min = stat.data[type][(currentIndex >= i) ? (currentIndex - i) : (NUM_STAT_STEPS - i + currentIndex)];
-            }
+            max = std::max(max, value);
+            if(SETTINGS.ingame.scale_statistics)
+                min = std::min(min, value);
         }
     }
 
@@ -338,14 +333,11 @@ void iwStatistics::DrawStatistic(StatisticType type)
     {
         if(!activePlayers[p])
             continue;
-        const GamePlayer::Statistic& stat = world.GetPlayer(p).GetStatistic(currentTime);
-
-        currentIndex = stat.currentIndex;
+        // Draw from the newest to the oldest value
         for(unsigned i = 0; i < NUM_STAT_STEPS; ++i)
         {
             DrawPoint curPos = topLeft + DrawPoint((NUM_STAT_STEPS - i) * stepX, size.y);
-            unsigned curStatVal =
-              stat.data[type][(currentIndex >= i) ? (currentIndex - i) : (NUM_STAT_STEPS - i + currentIndex)];
+            const unsigned curStatVal = values[p][NUM_STAT_STEPS - 1 - i];
             if(SETTINGS.ingame.scale_statistics)
                 curPos.y -= ((curStatVal - min) * size.y) / (max - min);
             else
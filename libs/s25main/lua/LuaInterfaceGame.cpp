@@ -18,9 +18,11 @@
 #include "LuaInterfaceGame.h"
 #include "EventManager.h"
 #include "Game.h"
+#include "Timer.h"
 #include "WindowManager.h"
 #include "ai/AIInterface.h"
 #include "ai/AIPlayer.h"
+#include "helpers/EnumRange.h"
 #include "ingameWindows/iwMissionStatement.h"
 #include "lua/LuaHelpers.h"
 #include "lua/LuaPlayer.h"
@@ -31,6 +33,19 @@
 #include "s25util/Serializer.h"
 #include "s25util/strAlgos.h"
 
+namespace {
+/// Adds the time of its lifetime to the callback stats
+class ScopedCallbackTimer
+{
+    LuaCallbackStats& stats_;
+    const Timer timer_;
+
+public:
+    explicit ScopedCallbackTimer(LuaCallbackStats& stats) : stats_(stats), timer_(true) { ++stats_.numCalls; }
+    ~ScopedCallbackTimer() { stats_.time += timer_.getElapsed(); }
+};
+} // namespace
+
 LuaInterfaceGame::LuaInterfaceGame(const std::weak_ptr<Game>& gameInstance, ILocalGameState& localGameState)
     : LuaInterfaceGameBase(localGameState), localGameState(localGameState), gw(gameInstance.lock()->world_),
       game(gameInstance)
@@ -182,6 +197,15 @@ LuaInterfaceGame::LuaInterfaceGame(const std::weak_ptr<Game>& gameInstance, ILoc
     LuaWorld::Register(lua);
 
     lua["rttr"] = this;
+
+    // Assignments to new globals go through __newindex, so by keeping the callbacks out of the global table we see
+    // every change of them and don't need to look them up for each event
+    callbackTable_ = lua.newTable();
+    kaguya::LuaTable metatable = lua.newTable();
+    metatable["__index"] = callbackTable_;
+    metatable["__newindex"] = kaguya::function(
+      [this](kaguya::LuaTable globals, kaguya::LuaRef key, kaguya::LuaRef value) { SetGlobal(globals, key, value); });
+    lua.globalTable().setMetatable(metatable);
 }
 
 LuaInterfaceGame::~LuaInterfaceGame() = default;
@@ -216,13 +240,65 @@ void LuaInterfaceGame::Register(kaguya::State& state)
                                         .addFunction("PopString", &Serializer::PopString));
 }
 
+const char* LuaInterfaceGame::GetCallbackName(LuaCallback callback)
+{
+    switch(callback)
+    {
+        case LuaCallback::OnSave: return "onSave";
+        case LuaCallback::OnLoad: return "onLoad";
+        case LuaCallback::OnStart: return "onStart";
+        case LuaCallback::OnGameFrame: return "onGameFrame";
+        case LuaCallback::OnExplored: return "onExplored";
+        case LuaCallback::OnExploredBatch: return "onExploredBatch";
+        case LuaCallback::OnOccupied: return "onOccupied";
+        case LuaCallback::OnOccupiedBatch: return "onOccupiedBatch";
+        case LuaCallback::OnResourceFound: return "onResourceFound";
+        case LuaCallback::OnCancelPactRequest: return "onCancelPactRequest";
+        case LuaCallback::OnSuggestPact: return "onSuggestPact";
+        case LuaCallback::OnPactCanceled: return "onPactCanceled";
+        case LuaCallback::OnPactCreated: return "onPactCreated";
+    }
+    return "";
+}
+
+void LuaInterfaceGame::SetGlobal(kaguya::LuaTable globals, kaguya::LuaRef key, kaguya::LuaRef value)
+{
+    if(key.type() == LUA_TSTRING)
+    {
+        const std::string name = key.get<std::string>();
+        for(const auto callback : helpers::EnumRange<LuaCallback>{})
+        {
+            if(name != GetCallbackName(callback))
+                continue;
+            callbackTable_.setRawField(name, value);
+            CallbackHandle& handle = callbacks_[callback];
+            handle.isSet = value.type() == LUA_TFUNCTION;
+            handle.func = handle.isSet ? value : kaguya::LuaRef();
+            return;
+        }
+    }
+    globals.setRawField(key, value);
+}
+
+template<typename T_Result, typename... T_Args>
+T_Result LuaInterfaceGame::Call(LuaCallback callback, T_Args&&... args)
+{
+    CallbackHandle& handle = callbacks_[callback];
+    RTTR_Assert(handle.isSet);
+    // Copy the function as the script might replace it during the call
+    const kaguya::LuaRef func = handle.func;
+    const ScopedCallbackTimer timer(handle.stats);
+    return func.call<T_Result>(std::forward<T_Args>(args)...);
+}
+
 bool LuaInterfaceGame::Serialize(Serializer& luaSaveState)
 {
-    kaguya::LuaRef save = lua["onSave"];
-    if(save.type() == LUA_TFUNCTION)
+    // Don't flush the batched events here: Saving is local to this client, so the callbacks would run at a different
+    // time than for the other clients. They are delivered at the end of the next GF instead
+    if(HasCallback(LuaCallback::OnSave))
     {
         clearErrorOccured();
-        if(save.call<bool>(kaguya::standard::ref(luaSaveState)) && !hasErrorOccurred())
+        if(Call<bool>(LuaCallback::OnSave, kaguya::standard::ref(luaSaveState)) && !hasErrorOccurred())
             return true;
         else
         {
@@ -235,11 +311,10 @@ bool LuaInterfaceGame::Serialize(Serializer& luaSaveState)
 
 bool LuaInterfaceGame::Deserialize(Serializer& luaSaveState)
 {
-    kaguya::LuaRef load = lua["onLoad"];
-    if(load.type() == LUA_TFUNCTION)
+    if(HasCallback(LuaCallback::OnLoad))
     {
         clearErrorOccured();
-        return load.call<bool>(kaguya::standard::ref(luaSaveState)) && !hasErrorOccurred();
+        return Call<bool>(LuaCallback::OnLoad, kaguya::standard::ref(luaSaveState)) && !hasErrorOccurred();
     } else
         return true;
 }
@@ -328,56 +403,123 @@ LuaWorld LuaInterfaceGame::GetWorld()
 
 void LuaInterfaceGame::EventExplored(unsigned player, const MapPoint pt, unsigned char owner)
 {
-    kaguya::LuaRef onExplored = lua["onExplored"];
-    if(onExplored.type() == LUA_TFUNCTION)
+    if(HasCallback(LuaCallback::OnExploredBatch))
     {
-        if(owner == 0)
-        {
-            // No owner? Pass nil value to Lua.
-            onExplored.call<void>(player, pt.x, pt.y, kaguya::NilValue());
-        } else
-        {
-            // Adapt owner to be comparable with the player index
-            onExplored.call<void>(player, pt.x, pt.y, owner - 1);
-        }
+        if(exploredBatch_.size() <= player)
+            exploredBatch_.resize(player + 1);
+        exploredBatch_[player].emplace_back(pt, owner);
+    } else
+        CallOnExplored(player, pt, owner);
+}
+
+void LuaInterfaceGame::CallOnExplored(unsigned player, const MapPoint pt, unsigned char owner)
+{
+    if(!HasCallback(LuaCallback::OnExplored))
+        return;
+    if(owner == 0)
+    {
+        // No owner? Pass nil value to Lua.
+        Call<void>(LuaCallback::OnExplored, player, pt.x, pt.y, kaguya::NilValue());
+    } else
+    {
+        // Adapt owner to be comparable with the player index
+        Call<void>(LuaCallback::OnExplored, player, pt.x, pt.y, owner - 1);
     }
 }
 
 void LuaInterfaceGame::EventOccupied(unsigned player, const MapPoint pt)
 {
-    kaguya::LuaRef onOccupied = lua["onOccupied"];
-    if(onOccupied.type() == LUA_TFUNCTION)
-        onOccupied.call<void>(player, pt.x, pt.y);
+    if(HasCallback(LuaCallback::OnOccupiedBatch))
+    {
+        if(occupiedBatch_.size() <= player)
+            occupiedBatch_.resize(player + 1);
+        occupiedBatch_[player].push_back(pt);
+    } else if(HasCallback(LuaCallback::OnOccupied))
+        Call<void>(LuaCallback::OnOccupied, player, pt.x, pt.y);
+}
+
+void LuaInterfaceGame::FlushBatchedEvents()
+{
+    // Take the events out first as the callbacks may cause new ones which are then delivered with the next flush
+    for(unsigned player = 0; player < exploredBatch_.size(); player++)
+    {
+        std::vector<std::pair<MapPoint, unsigned char>> pts;
+        std::swap(pts, exploredBatch_[player]);
+        if(pts.empty())
+            continue;
+        if(!HasCallback(LuaCallback::OnExploredBatch))
+        {
+            // The script removed the batch callback after the events were collected
+            for(const auto& ptAndOwner : pts)
+                CallOnExplored(player, ptAndOwner.first, ptAndOwner.second);
+            continue;
+        }
+        kaguya::LuaTable luaPts = lua.newTable(static_cast<int>(pts.size()), 0);
+        for(unsigned i = 0; i < pts.size(); i++)
+        {
+            kaguya::LuaTable luaPt = lua.newTable(3, 0);
+            luaPt[1] = pts[i].first.x;
+            luaPt[2] = pts[i].first.y;
+            // No owner is nil, otherwise adapt it to be comparable with the player index
+            if(pts[i].second != 0)
+                luaPt[3] = pts[i].second - 1;
+            luaPts[i + 1] = luaPt;
+        }
+        Call<void>(LuaCallback::OnExploredBatch, player, luaPts);
+    }
+    for(unsigned player = 0; player < occupiedBatch_.size(); player++)
+    {
+        std::vector<MapPoint> pts;
+        std::swap(pts, occupiedBatch_[player]);
+        if(pts.empty())
+            continue;
+        if(!HasCallback(LuaCallback::OnOccupiedBatch))
+        {
+            if(HasCallback(LuaCallback::OnOccupied))
+            {
+                for(const MapPoint& pt : pts)
+                    Call<void>(LuaCallback::OnOccupied, player, pt.x, pt.y);
+            }
+            continue;
+        }
+        kaguya::LuaTable luaPts = lua.newTable(static_cast<int>(pts.size()), 0);
+        for(unsigned i = 0; i < pts.size(); i++)
+        {
+            kaguya::LuaTable luaPt = lua.newTable(2, 0);
+            luaPt[1] = pts[i].x;
+            luaPt[2] = pts[i].y;
+            luaPts[i + 1] = luaPt;
+        }
+        Call<void>(LuaCallback::OnOccupiedBatch, player, luaPts);
+    }
 }
 
 void LuaInterfaceGame::EventStart(bool isFirstStart)
 {
-    kaguya::LuaRef onStart = lua["onStart"];
-    if(onStart.type() == LUA_TFUNCTION)
-        onStart.call<void>(isFirstStart);
+    if(HasCallback(LuaCallback::OnStart))
+        Call<void>(LuaCallback::OnStart, isFirstStart);
 }
 
 void LuaInterfaceGame::EventGameFrame(unsigned nr)
 {
-    kaguya::LuaRef onGameFrame = lua["onGameFrame"];
-    if(onGameFrame.type() == LUA_TFUNCTION)
-        onGameFrame.call<void>(nr);
+    if(HasCallback(LuaCallback::OnGameFrame))
+        Call<void>(LuaCallback::OnGameFrame, nr);
+    // End of the GF for the script, so this is the same for all clients
+    FlushBatchedEvents();
 }
 
 void LuaInterfaceGame::EventResourceFound(unsigned char player, const MapPoint pt, ResourceType type,
                                           unsigned char quantity)
 {
-    kaguya::LuaRef onResourceFound = lua["onResourceFound"];
-    if(onResourceFound.type() == LUA_TFUNCTION)
-        onResourceFound.call<void>(player, pt.x, pt.y, type, quantity);
+    if(HasCallback(LuaCallback::OnResourceFound))
+        Call<void>(LuaCallback::OnResourceFound, player, pt.x, pt.y, type, quantity);
 }
 
 bool LuaInterfaceGame::EventCancelPactRequest(PactType pt, unsigned char canceledByPlayerId,
                                               unsigned char targetPlayerId)
 {
-    kaguya::LuaRef onPactCancel = lua["onCancelPactRequest"];
-    if(onPactCancel.type() == LUA_TFUNCTION)
-        return onPactCancel.call<bool>(pt, canceledByPlayerId, targetPlayerId);
+    if(HasCallback(LuaCallback::OnCancelPactRequest))
+        return Call<bool>(LuaCallback::OnCancelPactRequest, pt, canceledByPlayerId, targetPlayerId);
     return true; // always accept pact cancel if there is no handler
 }
 
@@ -390,11 +532,11 @@ void LuaInterfaceGame::EventSuggestPact(const PactType pt, unsigned char suggest
     AIPlayer* ai = gameInst->GetAIPlayer(targetPlayerId);
     if(ai != nullptr)
     {
-        kaguya::LuaRef onPactCancel = lua["onSuggestPact"];
-        if(onPactCancel.type() == LUA_TFUNCTION)
+        if(HasCallback(LuaCallback::OnSuggestPact))
         {
             AIInterface& aii = ai->getAIInterface();
-            auto luaResult = onPactCancel.call<bool>(pt, suggestedByPlayerId, targetPlayerId, duration);
+            auto luaResult =
+              Call<bool>(LuaCallback::OnSuggestPact, pt, suggestedByPlayerId, targetPlayerId, duration);
             if(luaResult)
                 aii.AcceptPact(gw.GetEvMgr().GetCurrentGF(), pt, suggestedByPlayerId);
             else
@@ -406,19 +548,17 @@ void LuaInterfaceGame::EventSuggestPact(const PactType pt, unsigned char suggest
 void LuaInterfaceGame::EventPactCanceled(const PactType pt, unsigned char canceledByPlayerId,
                                          unsigned char targetPlayerId)
 {
-    kaguya::LuaRef onPactCanceled = lua["onPactCanceled"];
-    if(onPactCanceled.type() == LUA_TFUNCTION)
+    if(HasCallback(LuaCallback::OnPactCanceled))
     {
-        onPactCanceled.call<void>(pt, canceledByPlayerId, targetPlayerId);
+        Call<void>(LuaCallback::OnPactCanceled, pt, canceledByPlayerId, targetPlayerId);
     }
 }
 
 void LuaInterfaceGame::EventPactCreated(const PactType pt, unsigned char suggestedByPlayerId,
                                         unsigned char targetPlayerId, const unsigned duration)
 {
-    kaguya::LuaRef onPactCreated = lua["onPactCreated"];
-    if(onPactCreated.type() == LUA_TFUNCTION)
+    if(HasCallback(LuaCallback::OnPactCreated))
     {
-        onPactCreated.call<void>(pt, suggestedByPlayerId, targetPlayerId, duration);
+        Call<void>(LuaCallback::OnPactCreated, pt, suggestedByPlayerId, targetPlayerId, duration);
     }
 }
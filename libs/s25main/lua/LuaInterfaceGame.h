@@ -18,10 +18,14 @@
 #pragma once
 
 #include "LuaInterfaceGameBase.h"
+#include "helpers/EnumArray.h"
 #include "gameTypes/MapCoordinates.h"
 #include "gameTypes/PactTypes.h"
+#include <chrono>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 class GameWorldGame;
 class LuaPlayer;
@@ -30,6 +34,35 @@ class Serializer;
 class Game;
 enum class ResourceType : uint8_t;
 
+/// Functions the script can implement to get notified about events
+enum class LuaCallback
+{
+    OnSave,
+    OnLoad,
+    OnStart,
+    OnGameFrame,
+    OnExplored,
+    OnExploredBatch,
+    OnOccupied,
+    OnOccupiedBatch,
+    OnResourceFound,
+    OnCancelPactRequest,
+    OnSuggestPact,
+    OnPactCanceled,
+    OnPactCreated
+};
+constexpr auto maxEnumValue(LuaCallback)
+{
+    return LuaCallback::OnPactCreated;
+}
+
+struct LuaCallbackStats
+{
+    unsigned numCalls = 0;
+    /// Time spent in the Lua function
+    std::chrono::nanoseconds time = std::chrono::nanoseconds::zero();
+};
+
 class LuaInterfaceGame : public LuaInterfaceGameBase
 {
 public:
@@ -56,6 +89,13 @@ public:
     // called if pact was created
     void EventPactCreated(PactType pt, unsigned char suggestedByPlayerId, unsigned char targetPlayerId,
                           unsigned duration);
+    /// Call the batch callbacks with the events collected since the last call. Done at the end of each GF.
+    /// If the script removed a batch callback meanwhile, the events are passed to the single event callback
+    void FlushBatchedEvents();
+
+    /// Name of the callback as defined in the script
+    static const char* GetCallbackName(LuaCallback callback);
+    const LuaCallbackStats& GetCallbackStats(LuaCallback callback) const { return callbacks_[callback].stats; }
     // Callable from Lua
     void ClearResources();
     unsigned GetGF() const;
@@ -71,9 +111,31 @@ public:
     void PostMessageWithLocation(int playerIdx, const std::string& msg, int x, int y);
 
 private:
+    struct CallbackHandle
+    {
+        /// Function set by the script, only valid if isSet is true
+        kaguya::LuaRef func;
+        bool isSet = false;
+        LuaCallbackStats stats;
+    };
+
     ILocalGameState& localGameState;
     GameWorldGame& gw;
     std::weak_ptr<Game> game;
+    /// Callbacks are kept in this table instead of the global table, so we get notified when the script changes them
+    kaguya::LuaTable callbackTable_;
+    helpers::EnumArray<CallbackHandle, LuaCallback> callbacks_;
+    /// Events collected per player for the batch callbacks. Explored points with their owner
+    std::vector<std::vector<std::pair<MapPoint, unsigned char>>> exploredBatch_;
+    std::vector<std::vector<MapPoint>> occupiedBatch_;
+
     LuaPlayer GetPlayer(int playerIdx);
     LuaWorld GetWorld();
+    /// Handler for assignments to new global variables
+    void SetGlobal(kaguya::LuaTable globals, kaguya::LuaRef key, kaguya::LuaRef value);
+    bool HasCallback(LuaCallback callback) const { return callbacks_[callback].isSet; }
+    /// Call onExplored if the script defines it
+    void CallOnExplored(unsigned player, MapPoint pt, unsigned char owner);
+    template<typename T_Result, typename... T_Args>
+    T_Result Call(LuaCallback callback, T_Args&&... args);
 };
@@ -16,9 +16,65 @@
 // along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
 
 #include "mapGenerator/Algorithms.h"
+#include "helpers/ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
 
 namespace rttr { namespace mapGenerator {
 
+    namespace {
+        /// Minimum number of nodes worth distributing to multiple threads
+        constexpr unsigned minNodesPerChunk = 4096;
+
+        std::atomic<bool> multiThreaded(true);
+
+        helpers::ThreadPool& GetThreadPool()
+        {
+            static helpers::ThreadPool threadPool;
+            return threadPool;
+        }
+
+        unsigned GetNumThreads()
+        {
+            static const unsigned numThreads = std::max(1u, std::thread::hardware_concurrency());
+            return numThreads;
+        }
+    } // namespace
+
+    void SetMultiThreaded(bool enable)
+    {
+        multiThreaded = enable;
+    }
+
+    unsigned GetNumChunks(unsigned numElements, unsigned nodesPerElement)
+    {
+        const uint64_t numNodes = static_cast<uint64_t>(numElements) * nodesPerElement;
+        if(!multiThreaded || numNodes < 2u * minNodesPerChunk || GetNumThreads() == 1u)
+        {
+            return 1u;
+        }
+        // Use a few chunks per thread to balance the load
+        const auto maxChunks = static_cast<unsigned>(std::min<uint64_t>(numElements, numNodes / minNodesPerChunk));
+        return std::min(maxChunks, GetNumThreads() * 4u);
+    }
+
+    void ParallelFor(unsigned numElements, unsigned numChunks,
+                     const std::function<void(unsigned chunkIdx, unsigned begin, unsigned end)>& func)
+    {
+        if(numChunks <= 1u)
+        {
+            func(0, 0, numElements);
+            return;
+        }
+        GetThreadPool().run(numChunks, [numElements, numChunks, &func](unsigned chunkIdx, unsigned) {
+            const auto begin = static_cast<unsigned>(static_cast<uint64_t>(numElements) * chunkIdx / numChunks);
+            const auto end = static_cast<unsigned>(static_cast<uint64_t>(numElements) * (chunkIdx + 1u) / numChunks);
+            func(chunkIdx, begin, end);
+        });
+    }
+
     void UpdateDistances(NodeMapBase<unsigned>& distances, std::queue<MapPoint>& queue)
     {
         while(!queue.empty())
@@ -45,4 +101,64 @@ namespace rttr { namespace mapGenerator {
         }
     }
 
+    void UpdateDistances(NodeMapBase<unsigned>& distances, std::vector<MapPoint> sources)
+    {
+        const unsigned numNodes = prodOfComponents(distances.GetSize());
+        if(GetNumChunks(numNodes) == 1u)
+        {
+            std::queue<MapPoint> queue(std::deque<MapPoint>(sources.begin(), sources.end()));
+            UpdateDistances(distances, queue);
+            return;
+        }
+
+        // Breadth-first search level by level: All points of the frontier have the same distance, so any point reached
+        // first from the frontier gets the next distance no matter which thread gets there first.
+        // Points which are not searched (distance != -1) only keep the minimum distance of their neighbors + 1.
+        std::unique_ptr<std::atomic<unsigned>[]> atomicDistances(new std::atomic<unsigned>[numNodes]);
+        for(unsigned i = 0; i < numNodes; ++i)
+        {
+            atomicDistances[i].store(distances[i], std::memory_order_relaxed);
+        }
+
+        std::vector<MapPoint> frontier = std::move(sources);
+        std::vector<std::vector<MapPoint>> chunkFrontiers;
+        for(unsigned currentDistance = 0; !frontier.empty(); ++currentDistance)
+        {
+            const unsigned newDistance = currentDistance + 1;
+            const unsigned numElements = static_cast<unsigned>(frontier.size());
+            const unsigned numChunks = GetNumChunks(numElements, 6);
+            chunkFrontiers.resize(numChunks);
+            ParallelFor(numElements, numChunks, [&](unsigned chunkIdx, unsigned begin, unsigned end) {
+                auto& nextFrontier = chunkFrontiers[chunkIdx];
+                for(unsigned i = begin; i < end; ++i)
+                {
+                    for(const MapPoint& neighbor : distances.GetNeighbours(frontier[i]))
+                    {
+                        auto& distance = atomicDistances[distances.GetIdx(neighbor)];
+                        unsigned oldDistance = unsigned(-1);
+                        if(distance.compare_exchange_strong(oldDistance, newDistance, std::memory_order_relaxed))
+                        {
+                            nextFrontier.push_back(neighbor);
+                            continue;
+                        }
+                        while(oldDistance > newDistance
+                              && !distance.compare_exchange_weak(oldDistance, newDistance, std::memory_order_relaxed))
+                        {}
+                    }
+                }
+            });
+            frontier.clear();
+            for(auto& nextFrontier : chunkFrontiers)
+            {
+                frontier.insert(frontier.end(), nextFrontier.begin(), nextFrontier.end());
+                nextFrontier.clear();
+            }
+        }
+
+        for(unsigned i = 0; i < numNodes; ++i)
+        {
+            distances[i] = atomicDistances[i].load(std::memory_order_relaxed);
+        }
+    }
+
 }} // namespace rttr::mapGenerator
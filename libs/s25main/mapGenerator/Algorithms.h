@@ -21,10 +21,14 @@
 #include "mapGenerator/NodeMapUtilities.h"
 #include "world/NodeMapBase.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <functional>
 #include <queue>
 #include <set>
 #include <stdexcept>
+#include <vector>
 
 namespace rttr { namespace mapGenerator {
 
@@ -40,6 +44,41 @@ namespace rttr { namespace mapGenerator {
         return joined;
     }
 
+    /// Use multiple threads for the data-parallel algorithms on big maps (enabled by default).
+    /// The results do not depend on this setting.
+    void SetMultiThreaded(bool enable);
+
+    /**
+     * Number of chunks to split [0, numElements) into for ParallelFor. Small inputs are not split at all as the
+     * overhead of distributing them to the worker threads would dominate.
+     *
+     * @param numElements number of elements to process
+     * @param nodesPerElement number of map nodes touched per element to estimate the amount of work
+     */
+    unsigned GetNumChunks(unsigned numElements, unsigned nodesPerElement = 1);
+
+    /**
+     * Splits [0, numElements) into the specified number of consecutive chunks (see GetNumChunks) and calls
+     * func(chunkIdx, begin, end) for each of them. The chunks are processed concurrently on a thread pool shared by
+     * all map generator algorithms, so func must only write to data owned by its chunk.
+     */
+    void ParallelFor(unsigned numElements, unsigned numChunks,
+                     const std::function<void(unsigned chunkIdx, unsigned begin, unsigned end)>& func);
+
+    /**
+     * Calls func(y) for each row of a map of the specified size. Rows are processed concurrently, see ParallelFor.
+     */
+    template<typename T_Func>
+    void ForEachRow(const MapExtent& size, T_Func&& func)
+    {
+        ParallelFor(size.y, GetNumChunks(size.y, size.x), [&func](unsigned, unsigned begin, unsigned end) {
+            for(unsigned y = begin; y < end; ++y)
+            {
+                func(static_cast<MapCoord>(y));
+            }
+        });
+    }
+
     /**
      * Smoothes the specified nodes with a smoothing kernel of the specified extent (radius).
      *
@@ -51,23 +90,25 @@ namespace rttr { namespace mapGenerator {
     void Smooth(unsigned iterations, unsigned radius, NodeMapBase<T>& nodes)
     {
         const MapExtent& size = nodes.GetSize();
-        std::vector<std::vector<MapPoint>> neighbors(size.x * size.y);
 
-        RTTR_FOREACH_PT(MapPoint, size)
-        {
-            neighbors[nodes.GetIdx(pt)] = nodes.GetPointsInRadius(pt, radius);
-        }
+        // The kernel only depends on the row of a point: All points of a row have the neighbors of the first point of
+        // the row shifted along the x-axis. So only store those instead of the neighbors of every single point.
+        std::vector<std::vector<MapPoint>> rowNeighbors(size.y);
+        ForEachRow(size, [&](MapCoord y) { rowNeighbors[y] = nodes.GetPointsInRadius(MapPoint(0, y), radius); });
 
+        // Note: The kernel is applied in place, i.e. each node already sees the smoothed values of the nodes before it.
+        // This makes the sweep inherently sequential, splitting it would change the result.
         for(unsigned i = 0; i < iterations; ++i)
         {
             RTTR_FOREACH_PT(MapPoint, size)
             {
                 int sum = static_cast<int>(nodes[pt]);
-                const auto& neighborPoints = neighbors[nodes.GetIdx(pt)];
+                const auto& neighborPoints = rowNeighbors[pt.y];
 
                 for(const MapPoint& p : neighborPoints)
                 {
-                    sum += static_cast<int>(nodes[p]);
+                    const unsigned x = p.x + pt.x;
+                    sum += static_cast<int>(nodes[MapPoint(x < size.x ? x : x - size.x, p.y)]);
                 }
 
                 nodes[pt] = static_cast<T>(round(static_cast<double>(sum) / (neighborPoints.size() + 1)));
@@ -95,14 +136,17 @@ namespace rttr { namespace mapGenerator {
         }
 
         auto scaledRange = maximum - minimum;
+        const MapExtent size = values.GetSize();
 
-        RTTR_FOREACH_PT(MapPoint, values.GetSize())
-        {
-            auto normalizer = static_cast<double>(values[pt] - actualMinimum) / actualRange;
-            auto offset = round(normalizer * scaledRange);
+        ForEachRow(size, [&](MapCoord y) {
+            for(MapPoint pt(0, y); pt.x < size.x; ++pt.x)
+            {
+                auto normalizer = static_cast<double>(values[pt] - actualMinimum) / actualRange;
+                auto offset = round(normalizer * scaledRange);
 
-            values[pt] = static_cast<T>(minimum + offset);
-        }
+                values[pt] = static_cast<T>(minimum + offset);
+            }
+        });
     }
 
     /**
@@ -159,6 +203,15 @@ namespace rttr { namespace mapGenerator {
      */
     void UpdateDistances(NodeMapBase<unsigned>& distances, std::queue<MapPoint>& queue);
 
+    /**
+     * Computes the distances from the specified sources which all must have a distance of 0. The result is the same as
+     * of UpdateDistances with all sources enqueued but large maps are processed level by level on multiple threads.
+     *
+     * @param distances distance map which is being updated
+     * @param sources points to compute the distances from
+     */
+    void UpdateDistances(NodeMapBase<unsigned>& distances, std::vector<MapPoint> sources);
+
     /**
      * Computes a map of distance values describing the distance of each grid position to the closest flagged point.
      *
@@ -170,17 +223,17 @@ namespace rttr { namespace mapGenerator {
     template<class T_Container>
     NodeMapBase<unsigned> DistancesTo(const T_Container& flaggedPoints, const MapExtent& size)
     {
-        std::queue<MapPoint> queue;
+        std::vector<MapPoint> sources;
         NodeMapBase<unsigned> distances;
         distances.Resize(size, unsigned(-1));
 
         for(const MapPoint& pt : flaggedPoints)
         {
             distances[pt] = 0;
-            queue.push(pt);
+            sources.push_back(pt);
         }
 
-        UpdateDistances(distances, queue);
+        UpdateDistances(distances, std::move(sources));
 
         return distances;
     }
@@ -207,7 +260,7 @@ namespace rttr { namespace mapGenerator {
     NodeMapBase<unsigned> Distances(const MapExtent& size, const T_Container& area, const unsigned defaultValue,
                                     T&& evaluator)
     {
-        std::queue<MapPoint> queue;
+        std::vector<MapPoint> sources;
         NodeMapBase<unsigned> distances;
         distances.Resize(size, defaultValue);
 
@@ -216,18 +269,100 @@ namespace rttr { namespace mapGenerator {
             if(evaluator(pt))
             {
                 distances[pt] = 0;
-                queue.push(pt);
+                sources.push_back(pt);
             } else
             {
                 distances[pt] = unsigned(-1);
             }
         }
 
-        UpdateDistances(distances, queue);
+        UpdateDistances(distances, std::move(sources));
 
         return distances;
     }
 
+    namespace detail {
+        /**
+         * Counts the values within [minimum, limit] for increasing limits without iterating over all values again.
+         * Small value ranges use a (concurrently computed) cumulative histogram, larger ones a sorted copy of the
+         * values.
+         */
+        template<typename T>
+        class ValueCounter
+        {
+        public:
+            /**
+             * @param numValues number of values
+             * @param getValue function returning the value for an index in [0, numValues), called concurrently
+             * @param minimum lower bound of the values to count
+             * @param maximum upper bound of the values to count
+             */
+            template<typename T_GetValue>
+            ValueCounter(unsigned numValues, T_GetValue&& getValue, T minimum, T maximum) : minimum_(minimum)
+            {
+                if(maximum < minimum)
+                {
+                    return;
+                }
+                const auto range = static_cast<uint64_t>(maximum - minimum) + 1u;
+                const unsigned numChunks = GetNumChunks(numValues);
+                // Keep the histograms of all chunks at most as large as the values
+                if(range * numChunks > numValues)
+                {
+                    for(unsigned i = 0; i < numValues; ++i)
+                    {
+                        const T value = getValue(i);
+                        if(value >= minimum && value <= maximum)
+                        {
+                            sortedValues_.push_back(value);
+                        }
+                    }
+                    std::sort(sortedValues_.begin(), sortedValues_.end());
+                    return;
+                }
+                std::vector<std::vector<unsigned>> chunkCounts(numChunks,
+                                                               std::vector<unsigned>(static_cast<size_t>(range)));
+                ParallelFor(numValues, numChunks, [&](unsigned chunkIdx, unsigned begin, unsigned end) {
+                    auto& counts = chunkCounts[chunkIdx];
+                    for(unsigned i = begin; i < end; ++i)
+                    {
+                        const T value = getValue(i);
+                        if(value >= minimum && value <= maximum)
+                        {
+                            ++counts[value - minimum];
+                        }
+                    }
+                });
+                cumulativeCounts_.resize(static_cast<size_t>(range));
+                unsigned total = 0;
+                for(unsigned i = 0; i < cumulativeCounts_.size(); ++i)
+                {
+                    for(const auto& counts : chunkCounts)
+                    {
+                        total += counts[i];
+                    }
+                    cumulativeCounts_[i] = total;
+                }
+            }
+
+            /// Number of values within [minimum, limit]. The limit must not exceed the maximum
+            unsigned CountUpTo(T limit) const
+            {
+                if(!cumulativeCounts_.empty())
+                {
+                    return cumulativeCounts_[limit - minimum_];
+                }
+                return static_cast<unsigned>(std::upper_bound(sortedValues_.begin(), sortedValues_.end(), limit)
+                                             - sortedValues_.begin());
+            }
+
+        private:
+            T minimum_;
+            std::vector<unsigned> cumulativeCounts_;
+            std::vector<T> sortedValues_;
+        };
+    } // namespace detail
+
     /**
      * Computes an upper limit for the specified values. The number of values between the specified minimum and the
      * computed limit is at least as high as the specified coverage of the map.
@@ -256,6 +391,10 @@ namespace rttr { namespace mapGenerator {
         const auto nodes = values.GetWidth() * values.GetHeight();
         const auto expectedNodes = static_cast<unsigned>(coverage * nodes);
 
+        const auto valuesBegin = values.begin();
+        const detail::ValueCounter<T> counter(
+          static_cast<unsigned>(nodes), [valuesBegin](unsigned idx) { return valuesBegin[idx]; }, minimum, maximum);
+
         unsigned currentNodes = 0;
         unsigned previousNodes = 0;
 
@@ -264,10 +403,7 @@ namespace rttr { namespace mapGenerator {
         while(currentNodes < expectedNodes && limit <= maximum)
         {
             previousNodes = currentNodes;
-            currentNodes =
-              static_cast<unsigned>(std::count_if(values.begin(), values.end(), [minimum, limit](const T value) {
-                  return value >= minimum && value <= limit;
-              }));
+            currentNodes = counter.CountUpTo(limit);
             limit++;
         }
 
@@ -308,6 +444,16 @@ namespace rttr { namespace mapGenerator {
         const auto nodes = area.empty() ? values.GetWidth() * values.GetHeight() : area.size();
         const auto expectedNodes = static_cast<unsigned>(coverage * nodes);
 
+        std::vector<T> areaValues;
+        areaValues.reserve(area.size());
+        for(const MapPoint& pt : area)
+        {
+            areaValues.push_back(values[pt]);
+        }
+        const detail::ValueCounter<T> counter(
+          static_cast<unsigned>(areaValues.size()), [&areaValues](unsigned idx) { return areaValues[idx]; }, minimum,
+          maximum);
+
         unsigned currentNodes = 0;
         unsigned previousNodes = 0;
 
@@ -316,10 +462,7 @@ namespace rttr { namespace mapGenerator {
         while(currentNodes < expectedNodes && limit <= maximum)
         {
             previousNodes = currentNodes;
-            currentNodes = static_cast<unsigned>(
-              std::count_if(area.begin(), area.end(), [&values, minimum, limit](const MapPoint& pt) {
-                  return values[pt] >= minimum && values[pt] <= limit;
-              }));
+            currentNodes = counter.CountUpTo(limit);
             limit++;
         }
 
@@ -97,7 +97,7 @@ namespace rttr { namespace mapGenerator {
         const MapExtent size = z_.GetSize();
         const auto& z = z_;
 
-        auto interpolateEdges = [&size, z](const Triangle& triangle) {
+        auto interpolateEdges = [&size, &z](const Triangle& triangle) {
             const auto& edges = GetTriangleEdges(triangle, size);
 
             // Assumptions:
@@ -106,17 +106,20 @@ namespace rttr { namespace mapGenerator {
             return static_cast<uint8_t>(std::ceil(static_cast<double>(z[edges[0]] + z[edges[1]] + z[edges[2]]) / 3));
         };
 
-        RTTR_FOREACH_PT(MapPoint, size)
-        {
-            if(textures_[pt].rsu.value == DescIdx<TerrainDesc>::INVALID)
-            {
-                textures_[pt].rsu = mapping[interpolateEdges(Triangle(true, pt))];
-            }
-            if(textures_[pt].lsd.value == DescIdx<TerrainDesc>::INVALID)
+        // Each point only writes its own triangles, so the rows can be textured concurrently
+        ForEachRow(size, [&](MapCoord y) {
+            for(MapPoint pt(0, y); pt.x < size.x; ++pt.x)
             {
-                textures_[pt].lsd = mapping[interpolateEdges(Triangle(false, pt))];
+                if(textures_[pt].rsu.value == DescIdx<TerrainDesc>::INVALID)
+                {
+                    textures_[pt].rsu = mapping[interpolateEdges(Triangle(true, pt))];
+                }
+                if(textures_[pt].lsd.value == DescIdx<TerrainDesc>::INVALID)
+                {
+                    textures_[pt].lsd = mapping[interpolateEdges(Triangle(false, pt))];
+                }
             }
-        }
+        });
     }
 
     void Texturizer::ApplyCoastTexturing(const std::vector<MapPoint>& coast, unsigned width)
@@ -64,6 +64,8 @@ public:
     virtual void CI_Async(const std::string& /*checksums_list*/) {}
     virtual void CI_ReplayAsync(const std::string& /*msg*/) {}
     virtual void CI_ReplayEndReached(const std::string& /*msg*/) {}
+    /// A replay keyframe needs to be loaded. The game must be released before calling GameClient::LoadReplayKeyframe
+    virtual void CI_ReplayKeyframeRequired() {}
     virtual void CI_GamePaused() {}
     virtual void CI_GameResumed() {}
 };
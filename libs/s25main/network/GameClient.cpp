@@ -66,6 +66,7 @@
 #include <boost/filesystem.hpp>
 #include <helpers/chronoIO.h>
 #include <memory>
+#include <thread>
 
 void GameClient::ClientConfig::Clear()
 {
@@ -187,6 +188,8 @@ void GameClient::Run()
     mainPlayer.sendMsgs(10);
 
     mainPlayer.executeMsgs(*this);
+
+    HandleSaveResult();
 }
 
 /**
@@ -279,6 +282,8 @@ void GameClient::StartGame(const unsigned random_init)
     game =
       std::make_shared<Game>(gameLobby->getSettings(), startGF,
                              std::vector<PlayerInfo>(gameLobby->getPlayers().begin(), gameLobby->getPlayers().end()));
+    if(SETTINGS.global.parallelAI)
+        game->SetNumAIThreads(std::thread::hardware_concurrency());
     if(!IsReplayModeOn())
     {
         for(unsigned id = 0; id < gameLobby->getNumPlayers(); id++)
@@ -372,6 +377,9 @@ void GameClient::GameLoaded()
 void GameClient::ExitGame()
 {
     RTTR_Assert(state == ClientState::Game || state == ClientState::Loaded || state == ClientState::Loading);
+    // Make sure the last save is completely written
+    saveWriter.Wait();
+    HandleSaveResult();
     game.reset();
     nwfInfo.reset();
     // Clear remaining commands
@@ -1178,7 +1186,10 @@ bool GameClient::OnGameMessage(const GameMessage_GetAsyncLog& /*msg*/)
     if(state != ClientState::Game)
         return true;
     std::string systemInfo = System::getCompilerName() + " @ " + System::getOSName();
-    mainPlayer.sendMsgAsync(new GameMessage_AsyncLog(systemInfo));
+    // Region hashes allow the server to find the part of the map that differs
+    const WorldStateHash& stateHash = game->world_.GetStateHash();
+    mainPlayer.sendMsgAsync(
+      new GameMessage_AsyncLog(systemInfo, stateHash.GetRegionHashes(), stateHash.GetNumRegions().x));
 
     // AsyncLog an den Server senden
 
@@ -1332,15 +1343,19 @@ void GameClient::HandleAutosave()
         else
             filename = mapinfo.title + " (" + _("Auto-Save") + ").sav";
 
-        SaveToFile(RTTRCONFIG.ExpandPath(s25::folders::save) / filename);
+        SaveToFile(RTTRCONFIG.ExpandPath(s25::folders::save) / filename, true);
     }
 }
 
 /// Führt notwendige Dinge für nächsten GF aus
 void GameClient::NextGF(bool wasNWF)
 {
+    game->RunAIs(GetGFNumber(), wasNWF);
     for(AIPlayer& ai : game->aiPlayers_)
-        ai.RunGF(GetGFNumber(), wasNWF);
+    {
+        for(const std::string& msg : ai.FetchChatMessages())
+            mainPlayer.sendMsgAsync(new GameMessage_Chat(ai.GetPlayerId(), ChatDestination::All, msg));
+    }
     game->RunGF();
 }
 
@@ -1412,6 +1427,9 @@ bool GameClient::StartReplay(const boost::filesystem::path& path)
         return false;
     }
     replayinfo->filename = replayinfo->replay.GetFile().getFilePath().filename();
+    replayinfo->keyframes = std::make_unique<ReplayKeyframes>(
+      ReplayKeyframes::defaultInterval, ReplayKeyframes::defaultMaxMemorySize,
+      RTTRCONFIG.ExpandPath(s25::folders::replayKeyframes));
 
     gameLobby = std::make_shared<GameLobby>(true, true, replayinfo->replay.GetNumPlayers());
 
@@ -1547,6 +1565,22 @@ void GameClient::ServerLost()
  */
 void GameClient::SkipGF(unsigned gf, GameWorldView& gwv)
 {
+    if(replayMode && !replayinfo->seekTargetGF)
+    {
+        // Use a keyframe when jumping backwards or when one is closer to the target than the current GF
+        const ReplayKeyframes::Keyframe* keyframe = replayinfo->keyframes->Find(gf);
+        if(keyframe && (gf < GetGFNumber() || keyframe->gf > GetGFNumber()))
+        {
+            // The keyframe can only be loaded when the current game is not used anymore (e.g. by the GUI)
+            // as all game objects are globally registered
+            SetPause(true);
+            replayinfo->seekTargetGF = gf;
+            if(ci)
+                ci->CI_ReplayKeyframeRequired();
+            return;
+        }
+    }
+
     if(gf <= GetGFNumber())
         return;
 
@@ -1593,6 +1627,57 @@ void GameClient::SkipGF(unsigned gf, GameWorldView& gwv)
     SetPause(true);
 }
 
+bool GameClient::LoadReplayKeyframe()
+{
+    RTTR_Assert(replayMode && replayinfo->seekTargetGF);
+    const unsigned targetGF = replayinfo->seekTargetGF;
+    replayinfo->seekTargetGF = 0;
+    const ReplayKeyframes::Keyframe* keyframe = replayinfo->keyframes->Find(targetGF);
+    RTTR_Assert(keyframe);
+
+    const unsigned start_ticks = VIDEODRIVER.GetTickCount();
+    std::vector<PlayerInfo> players;
+    for(unsigned i = 0; i < replayinfo->replay.GetNumPlayers(); ++i)
+        players.push_back(PlayerInfo(replayinfo->replay.GetPlayer(i)));
+
+    // Release the old game before creating the new one
+    ExitGame();
+    state = ClientState::Loading;
+    framesinfo.isPaused = true;
+    game = std::make_shared<Game>(replayinfo->replay.ggs, keyframe->gf, players);
+
+    if(ci)
+        ci->CI_GameLoading(game);
+
+    try
+    {
+        replayinfo->keyframes->Restore(*keyframe, game, *this);
+    } catch(SerializedGameData::Error& error)
+    {
+        LOG.write(_("Error when loading replay keyframe: %s\n")) % error.what();
+        OnError(ClientError::InvalidMap);
+        return false;
+    }
+    game->world_.InitAfterLoad();
+    game->MarkStarted();
+    ResetVisualSettings();
+
+    // Continue reading the replay from the keyframe on
+    replayinfo->replay.SeekToCommand(keyframe->replayFilePos);
+    replayinfo->replay.ReadGF(&replayinfo->next_gf);
+    RTTR_Assert(replayinfo->next_gf == keyframe->nextReplayGF);
+    replayinfo->end = false;
+    replayinfo->async = 0;
+
+    while(GetGFNumber() < targetGF && !replayinfo->end)
+        ExecuteGameFrame_Replay();
+
+    unsigned ticks = VIDEODRIVER.GetTickCount() - start_ticks;
+    LOG.write(_("Jumped to GF %1% using the keyframe at GF %2% (%3$.3g seconds)\n")) % GetGFNumber() % keyframe->gf
+      % (ticks / 1000.0);
+    return true;
+}
+
 void GameClient::SystemChat(const std::string& text)
 {
     SystemChat(text, GetPlayerId());
@@ -1604,39 +1689,67 @@ void GameClient::SystemChat(const std::string& text, unsigned char fromPlayerIdx
         ci->CI_Chat(fromPlayerIdx, ChatDestination::System, text);
 }
 
-bool GameClient::SaveToFile(const boost::filesystem::path& filepath)
+bool GameClient::SaveToFile(const boost::filesystem::path& filepath, bool inBackground)
 {
     mainPlayer.sendMsg(GameMessage_Chat(GetPlayerId(), ChatDestination::System, "Saving game..."));
 
-    // Mond malen
-    Position moonPos = VIDEODRIVER.GetMousePos();
-    moonPos.y -= 40;
-    LOADER.GetImageN("resource", 33)->DrawFull(moonPos);
-    VIDEODRIVER.SwapBuffers();
+    // Mond malen. Not for background saves, which must not interrupt the current frame
+    if(!inBackground)
+    {
+        Position moonPos = VIDEODRIVER.GetMousePos();
+        moonPos.y -= 40;
+        LOADER.GetImageN("resource", 33)->DrawFull(moonPos);
+        VIDEODRIVER.SwapBuffers();
+    }
+
+    // Report errors of a previous save before starting the next one
+    saveWriter.Wait();
+    HandleSaveResult();
 
-    Savegame save;
+    auto save = std::make_unique<Savegame>();
 
-    WritePlayerInfo(save);
+    WritePlayerInfo(*save);
 
     // GGS-Daten
-    save.ggs = game->ggs_;
+    save->ggs = game->ggs_;
 
-    save.start_gf = GetGFNumber();
+    save->start_gf = GetGFNumber();
 
     // Enable/Disable debugging of savegames
-    save.sgd.debugMode = SETTINGS.global.debugMode;
+    save->sgd.debugMode = SETTINGS.global.debugMode;
 
     try
     {
         // Spiel serialisieren
-        save.sgd.MakeSnapshot(game);
-        // Und alles speichern
-        return save.Save(filepath, mapinfo.title);
+        save->sgd.MakeSnapshot(game);
     } catch(std::exception& e)
     {
         SystemChat(std::string("Error during saving: ") + e.what());
         return false;
     }
+    // Writing the file does not need the game anymore, so it can be done in the background
+    saveWriter.Start(std::move(save), filepath, mapinfo.title);
+    if(inBackground)
+        return true;
+    saveWriter.Wait();
+    const boost::optional<AsyncSaveWriter::Result> result = saveWriter.FetchResult();
+    if(!result->success)
+        SystemChat(std::string("Error during saving: ") + result->errorMsg);
+    return result->success;
+}
+
+boost::optional<unsigned> GameClient::GetSaveProgress() const
+{
+    if(!saveWriter.IsBusy())
+        return boost::none;
+    return saveWriter.GetProgress();
+}
+
+void GameClient::HandleSaveResult()
+{
+    const boost::optional<AsyncSaveWriter::Result> result = saveWriter.FetchResult();
+    if(result && !result->success)
+        SystemChat(std::string("Error during saving: ") + result->errorMsg);
 }
 
 void GameClient::ResetVisualSettings()
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "AsyncSaveWriter.h"
 #include "ClientError.h"
 #include "FramesInfo.h"
 #include "GameCommand.h"
@@ -31,6 +32,7 @@
 #include "gameTypes/TeamTypes.h"
 #include "gameTypes/VisualSettings.h"
 #include "s25util/Singleton.h"
+#include <boost/optional.hpp>
 #include <memory>
 #include <vector>
 
@@ -160,7 +162,11 @@ public:
     /// Is tournament mode activated (0 if not)? Returns the durations of the tournament mode in gf otherwise
     unsigned GetTournamentModeDuration() const;
 
+    /// Jump to the given GF. In replays this can also jump backwards by loading a keyframe
     void SkipGF(unsigned gf, GameWorldView& gwv);
+    /// Load the replay keyframe requested by SkipGF and simulate up to the target GF.
+    /// The current game must not be used anymore by the GUI
+    bool LoadReplayKeyframe();
 
     /// Changes the player ingame (for replay or debugging)
     void ChangePlayerIngame(unsigned char playerId1, unsigned char playerId2);
@@ -169,8 +175,11 @@ public:
 
     /// Spiel pausiert?
     bool IsPaused() const { return framesinfo.isPaused; }
-    /// Schreibt Header der Save-Datei
-    bool SaveToFile(const boost::filesystem::path& filepath);
+    /// Saves the game. If inBackground is true only the snapshot is taken immediately and the file is written
+    /// on a background thread. Errors are then reported via the chat. Returns false if saving failed
+    bool SaveToFile(const boost::filesystem::path& filepath, bool inBackground = false);
+    /// Progress of the save currently written in percent or none if no save is in progress
+    boost::optional<unsigned> GetSaveProgress() const;
     /// Visuelle Einstellungen aus den richtigen ableiten
     void ResetVisualSettings();
     void SystemChat(const std::string& text) override;
@@ -194,6 +203,10 @@ private:
     /// Versucht einen neuen GameFrame auszuführen, falls die Zeit dafür gekommen ist
     void ExecuteGameFrame();
     void ExecuteGameFrame_Replay();
+    /// Report the result of a finished background save
+    void HandleSaveResult();
+    /// Store a keyframe of the current replay state if required
+    void AddReplayKeyframe();
     void ExecuteNWF();
     /// Filtert aus einem Network-Command-Paket alle Commands aus und führt sie aus, falls ein Spielerwechsel-Command
     /// dabei ist, füllt er die übergebenen IDs entsprechend aus
@@ -305,6 +318,9 @@ private:
 
     std::unique_ptr<ReplayInfo> replayinfo;
     bool replayMode;
+
+    /// Writes savegames in the background
+    AsyncSaveWriter saveWriter;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
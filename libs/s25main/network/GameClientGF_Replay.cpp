@@ -18,6 +18,7 @@
 #include "GameManager.h"
 #include "PlayerGameCommands.h"
 #include "ReplayInfo.h"
+#include "SerializedGameData.h"
 #include "helpers/format.hpp"
 #include "network/ClientInterface.h"
 #include "network/GameClient.h"
@@ -26,10 +27,15 @@
 void GameClient::ExecuteGameFrame_Replay()
 {
     AsyncChecksum checksum = AsyncChecksum::create(*game);
+    // Older replays don't contain the world state hash
+    if(!replayinfo->replay.HasStateHash())
+        checksum.stateHash = 0;
 
     const unsigned curGF = GetGFNumber();
     RTTR_Assert(replayinfo->next_gf >= curGF || curGF > replayinfo->replay.GetLastGF()); //-V807
 
+    AddReplayKeyframe();
+
     bool cmdsExecuted = false;
     // Execute all commands from the replay for the current GF
     while(replayinfo->next_gf == curGF)
@@ -124,3 +130,17 @@ void GameClient::ExecuteGameFrame_Replay()
             skiptogf = GetGFNumber();
     }
 }
+
+void GameClient::AddReplayKeyframe()
+{
+    const unsigned curGF = GetGFNumber();
+    if(!replayinfo->keyframes || !replayinfo->keyframes->IsKeyframeDue(curGF))
+        return;
+    try
+    {
+        replayinfo->keyframes->Add(game, replayinfo->replay.GetCommandPos(), replayinfo->next_gf);
+    } catch(SerializedGameData::Error& error)
+    {
+        LOG.write(_("Could not create replay keyframe at GF %1%: %2%\n")) % curGF % error.what();
+    }
+}
@@ -1067,11 +1067,16 @@ class GameMessage_AsyncLog : public GameMessage
 public:
     std::string addData;
     std::vector<RandomEntry> entries;
+    /// Hashes of the map regions (see WorldStateHash) and the number of regions per row, only in the first message
+    std::vector<unsigned> regionHashes;
+    unsigned numRegionsX = 0;
     bool last;
 
     GameMessage_AsyncLog() : GameMessage(NMS_ASYNC_LOG) {} //-V730
 
-    GameMessage_AsyncLog(std::string addData) : GameMessage(NMS_ASYNC_LOG), addData(std::move(addData)), last(false)
+    GameMessage_AsyncLog(std::string addData, std::vector<unsigned> regionHashes, unsigned numRegionsX)
+        : GameMessage(NMS_ASYNC_LOG), addData(std::move(addData)), regionHashes(std::move(regionHashes)),
+          numRegionsX(numRegionsX), last(false)
     {
         LOG.writeToFile(">>> NMS_SEND_ASYNC_LOG\n");
     }
@@ -1091,6 +1096,11 @@ public:
         for(const RandomEntry& entry : entries)
             entry.Serialize(ser);
 
+        ser.PushUnsignedInt(regionHashes.size());
+        for(const unsigned regionHash : regionHashes)
+            ser.PushUnsignedInt(regionHash);
+        ser.PushUnsignedInt(numRegionsX);
+
         ser.PushBool(last);
     }
 
@@ -1105,6 +1115,11 @@ public:
         for(RandomEntry& entry : entries)
             entry.Deserialize(ser);
 
+        regionHashes.resize(ser.PopUnsignedInt());
+        for(unsigned& regionHash : regionHashes)
+            regionHash = ser.PopUnsignedInt();
+        numRegionsX = ser.PopUnsignedInt();
+
         last = ser.PopBool();
     }
 
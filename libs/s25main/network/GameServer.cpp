@@ -34,6 +34,7 @@
 #include "network/GameMessages.h"
 #include "ogl/glArchivItem_Map.h"
 #include "random/randomIO.h"
+#include "world/WorldStateHash.h"
 #include "gameTypes/LanGameInfo.h"
 #include "gameTypes/TeamTypes.h"
 #include "gameData/GameConsts.h"
@@ -54,11 +55,13 @@
 #include <iomanip>
 #include <iterator>
 #include <mygettext/mygettext.h>
+#include <set>
 
 inline std::ostream& operator<<(std::ostream& os, const AsyncChecksum& checksum)
 {
     return os << "RandCS = " << checksum.randChecksum << ",\tobjects/ID = " << checksum.objCt << "/" << checksum.objIdCt
-              << ",\tevents/ID = " << checksum.eventCt << "/" << checksum.evInstanceCt;
+              << ",\tevents/ID = " << checksum.eventCt << "/" << checksum.evInstanceCt
+              << ",\tstate = " << checksum.stateHash;
 }
 
 struct GameServer::AsyncLog
@@ -68,6 +71,8 @@ struct GameServer::AsyncLog
     AsyncChecksum checksum;
     std::string addData;
     std::vector<RandomEntry> randEntries;
+    std::vector<unsigned> regionHashes;
+    unsigned numRegionsX = 0;
     AsyncLog(uint8_t playerId, AsyncChecksum checksum) : playerId(playerId), done(false), checksum(checksum) {}
 };
 
@@ -1318,6 +1323,11 @@ bool GameServer::OnGameMessage(const GameMessage_AsyncLog& msg)
         foundPlayer = true;
         log.addData += msg.addData;
         log.randEntries.insert(log.randEntries.end(), msg.entries.begin(), msg.entries.end());
+        if(!msg.regionHashes.empty())
+        {
+            log.regionHashes = msg.regionHashes;
+            log.numRegionsX = msg.numRegionsX;
+        }
         if(msg.last)
         {
             LOG.write(_("Received async logs from %1% (%2% entries).\n")) % unsigned(log.playerId)
@@ -1339,6 +1349,7 @@ bool GameServer::OnGameMessage(const GameMessage_AsyncLog& msg)
     }
 
     LOG.write(_("Async logs received completely.\n"));
+    LogAsyncRegions();
 
     const bfs::path asyncFilePath = SaveAsyncLog();
     if(!asyncFilePath.empty())
@@ -1594,6 +1605,33 @@ bfs::path GameServer::SaveAsyncLog()
     }
 }
 
+void GameServer::LogAsyncRegions()
+{
+    const AsyncLog& refLog = asyncLogs.front();
+    if(refLog.regionHashes.empty() || refLog.numRegionsX == 0)
+        return;
+    for(const AsyncLog& log : asyncLogs)
+    {
+        if(log.playerId == refLog.playerId)
+            continue;
+        if(log.regionHashes.size() != refLog.regionHashes.size())
+        {
+            LOG.write(_("Player %1% sent region hashes for a different map size.\n")) % unsigned(log.playerId);
+            continue;
+        }
+        for(unsigned i = 0; i < log.regionHashes.size(); i++)
+        {
+            if(log.regionHashes[i] == refLog.regionHashes[i])
+                continue;
+            const unsigned regionX = (i % refLog.numRegionsX) * WorldStateHash::REGION_SIZE;
+            const unsigned regionY = (i / refLog.numRegionsX) * WorldStateHash::REGION_SIZE;
+            LOG.write(_("Async at GF %1%: Map region at %2%/%3% (size %4%) differs between player %5% and %6%\n"))
+              % currentGF % regionX % regionY % WorldStateHash::REGION_SIZE % unsigned(log.playerId)
+              % unsigned(refLog.playerId);
+        }
+    }
+}
+
 void GameServer::SendAsyncLog(const bfs::path& asyncLogFilePath)
 {
     if(SETTINGS.global.submit_debug_data == 1
@@ -134,6 +134,8 @@ private:
 
     bool CheckForAsync();
     boost::filesystem::path SaveAsyncLog();
+    /// Log the map regions in which the world state of the players differs
+    void LogAsyncRegions();
     void SendAsyncLog(const boost::filesystem::path& asyncLogFilePath);
 
     void CheckAndKickLaggingPlayers();
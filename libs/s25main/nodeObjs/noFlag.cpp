@@ -29,6 +29,7 @@
 #include "network/GameClient.h"
 #include "ogl/glArchivItem_Bitmap.h"
 #include "ogl/glSmartBitmap.h"
+#include "pathfinding/RoadPathFinder.h"
 #include "world/GameWorldGame.h"
 #include "gameData/TerrainDesc.h"
 #include <algorithm>
@@ -333,7 +334,10 @@ void noFlag::Capture(const unsigned char new_owner)
         }
     }
 
+    // The node (and the building) move to the road network of the new owner
+    gwg->GetRoadPathFinder().InvalidateRoadGraph(*this);
     this->player = new_owner;
+    gwg->GetRoadPathFinder().InvalidateRoadGraph(*this);
 }
 
 /**
@@ -20,6 +20,8 @@
 #include "GamePlayer.h"
 #include "RoadSegment.h"
 #include "SerializedGameData.h"
+#include "pathfinding/RoadGraph.h"
+#include "pathfinding/RoadPathFinder.h"
 #include "world/GameWorldGame.h"
 #include "s25util/warningSuppression.h"
 
@@ -28,7 +30,7 @@ noRoadNode::noRoadNode(const NodalObjectType nop, const MapPoint pos, const unsi
 {
     for(const auto dir : helpers::EnumRange<Direction>{})
         routes[dir] = nullptr;
-    last_visit = 0;
+    roadGraphIdx = RoadGraph::INVALID_IDX;
 }
 
 noRoadNode::~noRoadNode() = default;
@@ -36,6 +38,7 @@ noRoadNode::~noRoadNode() = default;
 void noRoadNode::Destroy_noRoadNode()
 {
     DestroyAllRoads();
+    gwg->GetRoadPathFinder().InvalidateRoadGraph(*this);
     Destroy_noCoordBase();
 }
 
@@ -73,7 +76,7 @@ noRoadNode::noRoadNode(SerializedGameData& sgd, const unsigned obj_id)
         routes[dir] = sgd.PopObject<RoadSegment>(GO_Type::Roadsegment);
     }
 
-    last_visit = 0;
+    roadGraphIdx = RoadGraph::INVALID_IDX;
 }
 
 void noRoadNode::UpgradeRoad(const Direction dir) const
@@ -106,7 +109,7 @@ void noRoadNode::DestroyRoad(const Direction dir)
     {
         if(otherFlag->routes[z] == route)
         {
-            otherFlag->routes[z] = nullptr;
+            otherFlag->SetRoute(z, nullptr);
             break;
         }
     }
@@ -120,6 +123,13 @@ void noRoadNode::DestroyRoad(const Direction dir)
     gwg->GetPlayer(player).RoadDestroyed();
 }
 
+void noRoadNode::SetRoute(const Direction dir, RoadSegment* route)
+{
+    routes[dir] = route;
+    // Road network changed -> cached graph is outdated
+    gwg->GetRoadPathFinder().InvalidateRoadGraph(*this);
+}
+
 /// Vernichtet Alle Straße um diesen Knoten
 void noRoadNode::DestroyAllRoads()
 {
@@ -19,6 +19,7 @@
 
 #include "notifications/notifications.h"
 #include "gameTypes/MapCoordinates.h"
+#include <vector>
 
 struct PlayerNodeNote
 {
@@ -35,3 +36,22 @@ struct PlayerNodeNote
     const MapPoint pt;
     const unsigned player; // Player for which this node has changed
 };
+
+/// Same as PlayerNodeNote but for many nodes at once, e.g. when recalculating the visibility of an area
+struct PlayerNodesNote
+{
+    ENABLE_NOTIFICATION(PlayerNodesNote);
+
+    enum Type
+    {
+        Visibility // Nodes visibility has changed
+    };
+
+    PlayerNodesNote(Type type, std::vector<MapPoint> pts, unsigned player)
+        : type(type), pts(std::move(pts)), player(player)
+    {}
+
+    const Type type;
+    const std::vector<MapPoint> pts;
+    const unsigned player; // Player for which these nodes have changed
+};
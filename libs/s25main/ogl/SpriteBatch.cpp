@@ -0,0 +1,141 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "SpriteBatch.h"
+#include "drivers/VideoDriverWrapper.h"
+#include "s25util/colors.h"
+#include <glad/glad.h>
+#include <algorithm>
+
+namespace {
+/// How many groups are searched back for one with a matching texture
+constexpr unsigned maxGroupLookBack = 16;
+/// Groups with more sprites than this are only checked by their total bounds
+constexpr unsigned maxSpritesForExactCheck = 64;
+} // namespace
+
+SpriteBatch* SpriteBatch::activeBatch_ = nullptr;
+
+void SpriteBatch::Bounds::extend(const Bounds& other)
+{
+    min = elMin(min, other.min);
+    max = elMax(max, other.max);
+}
+
+SpriteBatch::~SpriteBatch()
+{
+    if(IsActive())
+        activeBatch_ = nullptr;
+}
+
+void SpriteBatch::Begin()
+{
+    RTTR_Assert(!activeBatch_);
+    RTTR_Assert(numGroups_ == 0);
+    activeBatch_ = this;
+    curStats_ = Stats();
+}
+
+void SpriteBatch::End()
+{
+    RTTR_Assert(IsActive());
+    Flush();
+    activeBatch_ = nullptr;
+    lastStats_ = curStats_;
+}
+
+void SpriteBatch::Add(unsigned texture, const Point<float>* vertices, const Point<float>* texCoords,
+                      const unsigned* colors, unsigned numQuads)
+{
+    RTTR_Assert(IsActive());
+    const unsigned numVertices = numQuads * 4u;
+    Bounds bounds{vertices[0], vertices[0]};
+    for(unsigned i = 1; i < numVertices; i++)
+        bounds.extend(Bounds{vertices[i], vertices[i]});
+
+    Group& group = getGroup(texture, bounds);
+    group.spriteBounds.push_back(bounds);
+    for(unsigned i = 0; i < numVertices; i++)
+    {
+        const unsigned color = colors[i / 4u];
+        Vertex vertex;
+        vertex.pos = vertices[i];
+        vertex.texCoord = texCoords[i];
+        vertex.r = GetRed(color);
+        vertex.g = GetGreen(color);
+        vertex.b = GetBlue(color);
+        vertex.a = GetAlpha(color);
+        group.vertices.push_back(vertex);
+    }
+    curStats_.numSprites++;
+    curStats_.numVertices += numVertices;
+}
+
+SpriteBatch::Group& SpriteBatch::getGroup(unsigned texture, const Bounds& bounds)
+{
+    // Search backwards for a group with the same texture. Appending to it draws the sprite earlier than everything
+    // submitted afterwards, which is only allowed if none of that overlaps the sprite
+    const unsigned lastCheckedGroup = numGroups_ > maxGroupLookBack ? numGroups_ - maxGroupLookBack : 0u;
+    for(unsigned i = numGroups_; i > lastCheckedGroup; i--)
+    {
+        Group& group = groups_[i - 1];
+        if(group.texture == texture)
+        {
+            group.bounds.extend(bounds);
+            return group;
+        }
+        if(!group.bounds.overlaps(bounds))
+            continue;
+        if(group.spriteBounds.size() > maxSpritesForExactCheck
+           || std::any_of(group.spriteBounds.begin(), group.spriteBounds.end(),
+                          [&bounds](const Bounds& spriteBounds) { return spriteBounds.overlaps(bounds); }))
+            break;
+    }
+    if(numGroups_ == groups_.size())
+        groups_.emplace_back();
+    Group& group = groups_[numGroups_++];
+    group.texture = texture;
+    group.bounds = bounds;
+    group.spriteBounds.clear();
+    group.vertices.clear();
+    return group;
+}
+
+void SpriteBatch::Flush()
+{
+    if(numGroups_ == 0)
+        return;
+    vertexBuffer_.clear();
+    for(unsigned i = 0; i < numGroups_; i++)
+        vertexBuffer_.insert(vertexBuffer_.end(), groups_[i].vertices.begin(), groups_[i].vertices.end());
+
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(Vertex), &vertexBuffer_[0].pos);
+    glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), &vertexBuffer_[0].texCoord);
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), &vertexBuffer_[0].r);
+    GLint first = 0;
+    for(unsigned i = 0; i < numGroups_; i++)
+    {
+        const auto numVertices = static_cast<GLsizei>(groups_[i].vertices.size());
+        VIDEODRIVER.BindTexture(groups_[i].texture);
+        glDrawArrays(GL_QUADS, first, numVertices);
+        first += numVertices;
+    }
+    glDisableClientState(GL_COLOR_ARRAY);
+    curStats_.numDrawCalls += numGroups_;
+    numGroups_ = 0;
+}
@@ -0,0 +1,102 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Point.h"
+#include <cstdint>
+#include <vector>
+
+/// Collects textured quads of one frame and submits them grouped by texture.
+/// Sprites with the same texture (e.g. the same page of the texture packer) are merged into one draw call
+/// as long as this does not change the result: A sprite is never moved in front of an earlier sprite it overlaps.
+/// While a batch is active, the bitmap draw functions add to it instead of drawing immediately.
+/// Anything else drawn during that time (fonts, primitives, ...) requires a call to Flush first.
+class SpriteBatch
+{
+public:
+    struct Vertex
+    {
+        Point<float> pos;
+        Point<float> texCoord;
+        uint8_t r, g, b, a;
+    };
+    /// Counters of one Begin/End pair
+    struct Stats
+    {
+        unsigned numSprites = 0;
+        unsigned numDrawCalls = 0;
+        unsigned numVertices = 0;
+    };
+
+    SpriteBatch() = default;
+    SpriteBatch(const SpriteBatch&) = delete;
+    SpriteBatch& operator=(const SpriteBatch&) = delete;
+    ~SpriteBatch();
+
+    /// Make this the active batch. Only 1 batch can be active at a time
+    void Begin();
+    /// Submit all pending sprites and deactivate the batch
+    void End();
+    /// Submit all pending sprites, e.g. before drawing something that is not batched
+    void Flush();
+    bool IsActive() const { return activeBatch_ == this; }
+
+    /// Add numQuads quads (4 vertices each) using the given texture. colors holds one color per quad
+    void Add(unsigned texture, const Point<float>* vertices, const Point<float>* texCoords, const unsigned* colors,
+             unsigned numQuads);
+
+    /// Stats of the last finished frame (Begin..End)
+    const Stats& GetLastStats() const { return lastStats_; }
+    /// Stats of the current frame so far
+    const Stats& GetCurrentStats() const { return curStats_; }
+
+    /// Return the currently active batch or nullptr if sprites should be drawn immediately
+    static SpriteBatch* GetActive() { return activeBatch_; }
+
+private:
+    struct Bounds
+    {
+        Point<float> min, max;
+        bool overlaps(const Bounds& other) const
+        {
+            return min.x < other.max.x && other.min.x < max.x && min.y < other.max.y && other.min.y < max.y;
+        }
+        void extend(const Bounds& other);
+    };
+    /// Consecutive sprites drawn with one texture
+    struct Group
+    {
+        unsigned texture;
+        Bounds bounds;
+        std::vector<Bounds> spriteBounds;
+        std::vector<Vertex> vertices;
+    };
+
+    static SpriteBatch* activeBatch_;
+
+    /// Groups of the pending sprites in submission order. Only the first numGroups_ are used,
+    /// the rest is kept to reuse the allocated memory
+    std::vector<Group> groups_;
+    unsigned numGroups_ = 0;
+    /// Combined vertices of all groups as passed to OpenGL
+    std::vector<Vertex> vertexBuffer_;
+    Stats curStats_, lastStats_;
+
+    /// Find the group the sprite can be appended to or create a new one
+    Group& getGroup(unsigned texture, const Bounds& bounds);
+};
@@ -17,6 +17,7 @@
 
 #include "glArchivItem_Bitmap.h"
 #include "Point.h"
+#include "SpriteBatch.h"
 #include "drivers/VideoDriverWrapper.h"
 #include "libsiedler2/PixelBufferBGRA.h"
 #include <glad/glad.h>
@@ -69,6 +70,12 @@ void glArchivItem_Bitmap::Draw(Rect dstArea, Rect srcArea, unsigned color /*= CO
     texCoords[0].y = texCoords[3].y = srcOrig.y;
     texCoords[1].y = texCoords[2].y = srcEndPt.y;
 
+    if(SpriteBatch* batch = SpriteBatch::GetActive())
+    {
+        batch->Add(GetTexture(), vertices.data(), texCoords.data(), &color, 1);
+        return;
+    }
+
     glVertexPointer(2, GL_FLOAT, 0, vertices.data());
     glTexCoordPointer(2, GL_FLOAT, 0, texCoords.data());
     VIDEODRIVER.BindTexture(GetTexture());
@@ -18,6 +18,7 @@
 #include "glArchivItem_Bitmap_Player.h"
 #include "Loader.h"
 #include "Point.h"
+#include "SpriteBatch.h"
 #include "drivers/VideoDriverWrapper.h"
 #include "libsiedler2/PixelBufferBGRA.h"
 #include <glad/glad.h>
@@ -96,6 +97,13 @@ void glArchivItem_Bitmap_Player::Draw(Rect dstArea, Rect srcArea, unsigned color
     texCoords[6].x += 0.5f;
     texCoords[7].x += 0.5f;
 
+    if(SpriteBatch* batch = SpriteBatch::GetActive())
+    {
+        const std::array<unsigned, 2> quadColors = {{color, player_color}};
+        batch->Add(GetTexture(), vertices.data(), texCoords.data(), quadColors.data(), 2);
+        return;
+    }
+
     std::array<GL_RGBAColor, 8> colors;
     colors[0].r = GetRed(color);
     colors[0].g = GetGreen(color);
@@ -29,6 +29,7 @@
 #include "s25util/utf8.h"
 #include <boost/algorithm/string.hpp>
 #include <boost/nowide/detail/utf.hpp>
+#include <algorithm>
 #include <cmath>
 #include <vector>
 
@@ -189,6 +190,92 @@ void glFont::Draw(DrawPoint pos, const std::string& text, FontStyle format, unsi
 {
     RTTR_Assert(s25util::isValidUTF8(text));
 
+    if(text.empty())
+        return;
+
+    // Get texture first as it might need to be created
+    glArchivItem_Bitmap& usedFont = format.is(FontStyle::NO_OUTLINE) ? *fontNoOutline : *fontWithOutline;
+    unsigned texture = usedFont.GetTexture();
+    if(!texture)
+        return;
+    const GlyphRun& run = GetGlyphRun(text, maxWidth, end, format.is(FontStyle::NO_OUTLINE), usedFont.GetTexSize());
+    if(run.vertices.vertices.empty())
+        return;
+
+    // Vertical alignment (assumes 1 line only!)
+    if(format.is(FontStyle::BOTTOM))
+        pos.y -= maxCharSize.y;
+    else if(format.is(FontStyle::VCENTER))
+        pos.y -= maxCharSize.y / 2;
+    // Horizontal alignment
+    if(format.is(FontStyle::RIGHT))
+        pos.x -= run.width;
+    else if(format.is(FontStyle::CENTER))
+        pos.x -= run.width / 2;
+
+    // The run is laid out at the origin, so only the vertices need to be moved
+    const GlPoint offset(pos);
+    texList.resize(run.vertices.vertices.size());
+    std::transform(run.vertices.vertices.begin(), run.vertices.vertices.end(), texList.begin(),
+                   [offset](const GlPoint& pt) { return pt + offset; });
+
+    glVertexPointer(2, GL_FLOAT, 0, &texList[0]);
+    glTexCoordPointer(2, GL_FLOAT, 0, &run.vertices.texCoords[0]);
+    VIDEODRIVER.BindTexture(texture);
+    glColor4ub(GetRed(color), GetGreen(color), GetBlue(color), GetAlpha(color));
+    glDrawArrays(GL_QUADS, 0, texList.size());
+}
+
+const glFont::GlyphRun& glFont::GetGlyphRun(const std::string& text, unsigned short maxWidth, const std::string& end,
+                                            bool noOutline, const Extent& texSize) const
+{
+    // The end is only used if the width is limited
+    static const std::string noEnd;
+    const std::string& usedEnd = (maxWidth == 0xFFFF) ? noEnd : end;
+    std::string key;
+    key.reserve(usedEnd.size() + text.size() + 9);
+    key += noOutline ? '1' : '0';
+    // The texture coordinates are normalized to the texture size, which might change when it is recreated
+    key += static_cast<char>(texSize.x >> 8);
+    key += static_cast<char>(texSize.x & 0xFF);
+    key += static_cast<char>(texSize.y >> 8);
+    key += static_cast<char>(texSize.y & 0xFF);
+    key += static_cast<char>(maxWidth >> 8);
+    key += static_cast<char>(maxWidth & 0xFF);
+    key += static_cast<char>(usedEnd.size() >> 8);
+    key += static_cast<char>(usedEnd.size() & 0xFF);
+    key += usedEnd;
+    key += text;
+
+    const auto itRun = glyphRunLookup_.find(key);
+    if(itRun != glyphRunLookup_.end())
+    {
+        ++cacheStats_.numHits;
+        glyphRuns_.splice(glyphRuns_.begin(), glyphRuns_, itRun->second);
+        return glyphRuns_.front();
+    }
+    ++cacheStats_.numMisses;
+
+    if(glyphRuns_.size() >= maxCachedGlyphRuns)
+    {
+        glyphRunLookup_.erase(glyphRuns_.back().key);
+        glyphRuns_.pop_back();
+    }
+    glyphRuns_.emplace_front();
+    GlyphRun& run = glyphRuns_.front();
+    LayoutText(run, text, maxWidth, usedEnd);
+    RTTR_Assert(run.vertices.texCoords.size() == run.vertices.vertices.size());
+    RTTR_Assert(run.vertices.texCoords.size() % 4u == 0);
+    const GlPoint glTexSize(texSize);
+    for(GlPoint& pt : run.vertices.texCoords)
+        pt /= glTexSize;
+    run.key = key;
+    glyphRunLookup_.emplace(std::move(key), glyphRuns_.begin());
+    return run;
+}
+
+void glFont::LayoutText(GlyphRun& run, const std::string& text, unsigned short maxWidth, const std::string& end) const
+{
     unsigned maxNumChars;
     unsigned short textWidth;
     bool drawEnd;
@@ -218,26 +305,14 @@ void glFont::Draw(DrawPoint pos, const std::string& text, FontStyle format, unsi
 
     if(maxNumChars == 0)
         return;
+    run.width = textWidth;
     const auto itEnd = text.cbegin() + maxNumChars;
 
-    // Vertical alignment (assumes 1 line only!)
-    if(format.is(FontStyle::BOTTOM))
-        pos.y -= maxCharSize.y;
-    else if(format.is(FontStyle::VCENTER))
-        pos.y -= maxCharSize.y / 2;
-    // Horizontal alignment
-    if(format.is(FontStyle::RIGHT))
-        pos.x -= textWidth;
-    else if(format.is(FontStyle::CENTER))
-        pos.x -= textWidth / 2;
-
-    texList.texCoords.clear();
-    texList.vertices.clear();
-
+    DrawPoint pos(0, 0);
     for(auto it = text.begin(); it != itEnd;)
     {
         const utf::code_point curChar = utf8::decode(it, itEnd);
-        DrawChar(curChar, texList, pos);
+        DrawChar(curChar, run.vertices, pos);
     }
 
     if(drawEnd)
@@ -245,29 +320,9 @@ void glFont::Draw(DrawPoint pos, const std::string& text, FontStyle format, unsi
         for(auto it = end.begin(); it != end.end();)
         {
             const utf::code_point curChar = utf8::decode(it, end.end());
-            DrawChar(curChar, texList, pos);
+            DrawChar(curChar, run.vertices, pos);
         }
     }
-
-    if(texList.vertices.empty())
-        return;
-
-    // Get texture first as it might need to be created
-    glArchivItem_Bitmap& usedFont = format.is(FontStyle::NO_OUTLINE) ? *fontNoOutline : *fontWithOutline;
-    unsigned texture = usedFont.GetTexture();
-    if(!texture)
-        return;
-    const GlPoint texSize(usedFont.GetTexSize());
-    RTTR_Assert(texList.texCoords.size() == texList.vertices.size());
-    RTTR_Assert(texList.texCoords.size() % 4u == 0);
-    for(GlPoint& pt : texList.texCoords)
-        pt /= texSize;
-
-    glVertexPointer(2, GL_FLOAT, 0, &texList.vertices[0]);
-    glTexCoordPointer(2, GL_FLOAT, 0, &texList.texCoords[0]);
-    VIDEODRIVER.BindTexture(texture);
-    glColor4ub(GetRed(color), GetGreen(color), GetBlue(color), GetAlpha(color));
-    glDrawArrays(GL_QUADS, 0, texList.vertices.size());
 }
 
 template<bool T_limitWidth>
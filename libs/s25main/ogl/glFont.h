@@ -23,10 +23,12 @@
 #include "ogl/glArchivItem_Bitmap.h"
 #include "s25util/colors.h"
 #include <glad/glad.h>
+#include <boost/container/flat_map.hpp>
 #include <array>
-#include <map>
+#include <list>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace libsiedler2 {
@@ -36,6 +38,12 @@ class ArchivItem_Font;
 class glFont
 {
 public:
+    struct CacheStats
+    {
+        unsigned numHits = 0;
+        unsigned numMisses = 0;
+    };
+
     glFont(const libsiedler2::ArchivItem_Font&);
 
     /// Draw the the text at the given position with format (alignment) and color.
@@ -81,6 +89,10 @@ public:
     /// liefert die Breite eines Zeichens
     unsigned CharWidth(char32_t c) const { return GetCharInfo(c).width; }
 
+    /// Return the statistics of the glyph run cache since the last reset
+    const CacheStats& GetCacheStats() const { return cacheStats_; }
+    void ResetCacheStats() const { cacheStats_ = CacheStats(); }
+
 private:
     struct CharInfo
     {
@@ -95,11 +107,24 @@ private:
         std::vector<GlPoint> texCoords;
         std::vector<GlPoint> vertices;
     };
+    /// Text laid out at the origin, ready to be drawn
+    struct GlyphRun
+    {
+        std::string key;
+        /// Width of the text including the end (if used)
+        unsigned short width = 0;
+        /// Texture coordinates are already normalized
+        VertexArrays vertices;
+    };
 
     void AddCharInfo(char32_t c, const CharInfo& info);
     /// liefert das Char-Info eines Zeichens
     const CharInfo& GetCharInfo(char32_t c) const;
     void DrawChar(char32_t curChar, VertexArrays& vertices, DrawPoint& curPos) const;
+    /// Return the cached glyph run of the text or lay it out
+    const GlyphRun& GetGlyphRun(const std::string& text, unsigned short maxWidth, const std::string& end,
+                                bool noOutline, const Extent& texSize) const;
+    void LayoutText(GlyphRun& run, const std::string& text, unsigned short maxWidth, const std::string& end) const;
 
     Extent maxCharSize; // How big each char is at most (aka dx,dy)
     std::unique_ptr<glArchivItem_Bitmap> fontNoOutline;
@@ -107,9 +132,17 @@ private:
 
     /// Holds ascii chars only. As most chars are ascii this is faster then accessing the map
     std::array<std::pair<bool, CharInfo>, 256> asciiMapping;
-    std::map<char32_t, CharInfo> utf8_mapping;
-    CharInfo placeHolder;         /// Placeholder if glyph is missing
-    mutable VertexArrays texList; /// Buffer to hold last textures. Used so memory reallocations are avoided
+    boost::container::flat_map<char32_t, CharInfo> utf8_mapping;
+    CharInfo placeHolder; /// Placeholder if glyph is missing
+    /// Buffer to hold the vertices of the last drawn text. Used so memory reallocations are avoided
+    mutable std::vector<GlPoint> texList;
+
+    /// Maximum number of glyph runs kept in the cache
+    static constexpr unsigned maxCachedGlyphRuns = 4096;
+    /// Recently drawn texts, most recently used first
+    mutable std::list<GlyphRun> glyphRuns_;
+    mutable std::unordered_map<std::string, std::list<GlyphRun>::iterator> glyphRunLookup_;
+    mutable CacheStats cacheStats_;
 
     /// Get width of the sequence defined by the begin/end pair of iterators
     template<bool T_unlimitedWidth>
@@ -17,6 +17,7 @@
 
 #include "glSmartBitmap.h"
 #include "Loader.h"
+#include "SpriteBatch.h"
 #include "drivers/VideoDriverWrapper.h"
 #include "ogl/glBitmapItem.h"
 #include "libsiedler2/ArchivItem_Bitmap.h"
@@ -311,6 +312,13 @@ void glSmartBitmap::drawPercent(DrawPoint drawPt, unsigned percent, unsigned col
     } else
         numQuads = 4;
 
+    if(SpriteBatch* batch = SpriteBatch::GetActive())
+    {
+        const std::array<unsigned, 2> quadColors = {{color, player_color}};
+        batch->Add(texture, vertices.data(), curTexCoords.data(), quadColors.data(), numQuads / 4);
+        return;
+    }
+
     glEnableClientState(GL_COLOR_ARRAY);
     glVertexPointer(2, GL_FLOAT, 0, vertices.data());
     glTexCoordPointer(2, GL_FLOAT, 0, curTexCoords.data());
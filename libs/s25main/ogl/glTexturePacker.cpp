@@ -16,16 +16,33 @@
 // along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
 
 #include "glTexturePacker.h"
+#include "compression/CompressionCodec.h"
 #include "drivers/VideoDriverWrapper.h"
 #include "ogl/glSmartBitmap.h"
 #include "ogl/glTexturePackerNode.h"
 #include "ogl/saveBitmap.h"
 #include "libsiedler2/PixelBufferBGRA.h"
+#include "s25util/BinaryFile.h"
 #include <glad/glad.h>
+#include <boost/filesystem/operations.hpp>
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <memory>
+#include <stdexcept>
 #include <utility>
 
+namespace {
+constexpr char cacheSignature[] = "RTTRTEXCACHE";
+constexpr unsigned cacheSignatureLen = sizeof(cacheSignature) - 1;
+/// Increase when the format of the cache or the way the textures are packed changes
+constexpr uint16_t cacheVersion = 1;
+/// Upper bound for the size of an atlas, bigger ones are from a corrupt file
+constexpr unsigned maxAtlasSize = 16384;
+/// Size of the texture index, the size and the texture coordinates of a bitmap in the cache
+constexpr unsigned cachedBitmapSize = 3 * sizeof(uint32_t) + sizeof(std::array<PointF, 8>);
+} // namespace
+
 static bool isSizeGreater(glSmartBitmap* a, glSmartBitmap* b)
 {
     const Extent sizeA = a->getRequiredTexSize();
@@ -33,7 +50,8 @@ static bool isSizeGreater(glSmartBitmap* a, glSmartBitmap* b)
     return (sizeA.x * sizeA.y) > (sizeB.x * sizeB.y);
 }
 
-bool glTexturePacker::packHelper(std::vector<glSmartBitmap*>& list)
+bool glTexturePacker::packHelper(std::vector<glSmartBitmap*>& list,
+                                 std::vector<libsiedler2::PixelBufferBGRA>* atlases)
 {
     glTexture texture;
 
@@ -102,15 +120,18 @@ bool glTexturePacker::packHelper(std::vector<glSmartBitmap*>& list)
             if(!texture.uploadData(buffer))
                 return false;
 
-            if(left.empty()) // nothing left, just generate texture and return success
+            if(left.empty() || maxTex)
             {
                 textures.emplace_back(std::move(texture));
+                if(atlases)
+                    atlases->push_back(std::move(buffer));
+            }
+            if(left.empty()) // nothing left, just generate texture and return success
                 return true;
-            } else if(maxTex) // maximum texture size reached and something still left
+            else if(maxTex) // maximum texture size reached and something still left
             {
-                textures.emplace_back(std::move(texture));
                 // recursively generate textures for what is left
-                return packHelper(left);
+                return packHelper(left, atlases);
             }
 
             // our pre-estimated size if the big texture was not enough for the algorithm to fit all textures in
@@ -129,10 +150,15 @@ bool glTexturePacker::packHelper(std::vector<glSmartBitmap*>& list)
 }
 
 bool glTexturePacker::pack()
+{
+    return packImpl(nullptr);
+}
+
+bool glTexturePacker::packImpl(std::vector<libsiedler2::PixelBufferBGRA>* atlases)
 {
     std::sort(items.begin(), items.end(), isSizeGreater);
 
-    if(packHelper(items))
+    if(packHelper(items, atlases))
         return true;
 
     // reset glSmartBitmap textures
@@ -144,6 +170,127 @@ bool glTexturePacker::pack()
     return false;
 }
 
+bool glTexturePacker::packAndSave(const bfs::path& cacheFilepath, uint64_t cacheKey)
+{
+    // The cache stores the bitmaps in the order they were added, which is the order they are added on the next run
+    const std::vector<glSmartBitmap*> addedItems = items;
+    std::vector<libsiedler2::PixelBufferBGRA> atlases;
+    if(!packImpl(&atlases))
+        return false;
+
+    // Write to a temporary file first, so an interrupted write does not leave a truncated cache behind
+    bfs::path tmpFilepath = cacheFilepath;
+    tmpFilepath += ".tmp";
+    BinaryFile file;
+    if(!file.Open(tmpFilepath, OFM_WRITE))
+        return true;
+    file.WriteRawData(cacheSignature, cacheSignatureLen);
+    file.WriteUnsignedShort(cacheVersion);
+    file.WriteUnsignedInt(static_cast<uint32_t>(cacheKey >> 32));
+    file.WriteUnsignedInt(static_cast<uint32_t>(cacheKey));
+    file.WriteUnsignedInt(atlases.size());
+    for(const libsiedler2::PixelBufferBGRA& atlas : atlases)
+    {
+        const unsigned dataSize = atlas.getWidth() * atlas.getHeight() * 4u;
+        const std::vector<char> compressedData = compressWithHeader(
+          reinterpret_cast<const char*>(atlas.getPixelPtr()), dataSize, CompressionCodec::GetFastCodec());
+        file.WriteUnsignedInt(atlas.getWidth());
+        file.WriteUnsignedInt(atlas.getHeight());
+        file.WriteUnsignedInt(compressedData.size());
+        file.WriteRawData(compressedData.data(), compressedData.size());
+    }
+    file.WriteUnsignedInt(addedItems.size());
+    for(const glSmartBitmap* bmp : addedItems)
+    {
+        const auto itTexture = std::find_if(textures.begin(), textures.end(), [bmp](const glTexture& texture) {
+            return texture.get() == bmp->getTexture();
+        });
+        const Extent texSize = bmp->getRequiredTexSize();
+        file.WriteUnsignedInt(static_cast<unsigned>(itTexture - textures.begin()));
+        file.WriteUnsignedInt(texSize.x);
+        file.WriteUnsignedInt(texSize.y);
+        file.WriteRawData(bmp->texCoords.data(), sizeof(bmp->texCoords));
+    }
+    file.Close();
+    boost::system::error_code ec;
+    bfs::rename(tmpFilepath, cacheFilepath, ec);
+    if(ec)
+        bfs::remove(tmpFilepath, ec);
+    return true;
+}
+
+bool glTexturePacker::loadCache(const bfs::path& cacheFilepath, uint64_t cacheKey)
+{
+    BinaryFile file;
+    if(!file.Open(cacheFilepath, OFM_READ))
+        return false;
+    try
+    {
+        char signature[cacheSignatureLen];
+        file.ReadRawData(signature, cacheSignatureLen);
+        if(std::memcmp(signature, cacheSignature, cacheSignatureLen) != 0 || file.ReadUnsignedShort() != cacheVersion)
+            return false;
+        uint64_t key = file.ReadUnsignedInt();
+        key = (key << 32) | file.ReadUnsignedInt();
+        if(key != cacheKey)
+            return false;
+
+        // Validate all counts and sizes against the file before allocating anything, corrupt files are a cache miss
+        const unsigned dataPos = file.Tell();
+        file.Seek(0, SEEK_END);
+        const unsigned fileSize = file.Tell();
+        file.Seek(dataPos, SEEK_SET);
+        const auto getRemainingSize = [&file, fileSize]() { return fileSize - static_cast<unsigned>(file.Tell()); };
+
+        const unsigned numTextures = file.ReadUnsignedInt();
+        if(numTextures > getRemainingSize() / (3 * sizeof(uint32_t)))
+            return false;
+        std::vector<glTexture> newTextures(numTextures);
+        for(glTexture& texture : newTextures)
+        {
+            const unsigned width = file.ReadUnsignedInt();
+            const unsigned height = file.ReadUnsignedInt();
+            const unsigned compressedSize = file.ReadUnsignedInt();
+            if(width > maxAtlasSize || height > maxAtlasSize || compressedSize > getRemainingSize())
+                return false;
+            std::vector<char> compressedData(compressedSize);
+            file.ReadRawData(compressedData.data(), compressedData.size());
+            libsiedler2::PixelBufferBGRA atlas(width, height);
+            decompressWithHeader(compressedData.data(), compressedData.size(),
+                                 reinterpret_cast<char*>(atlas.getPixelPtr()), width * height * 4u);
+            if(!texture.uploadData(atlas))
+                return false;
+        }
+
+        if(file.ReadUnsignedInt() != items.size() || getRemainingSize() / cachedBitmapSize < items.size())
+            return false;
+        std::vector<unsigned> textureIdxs(items.size());
+        std::vector<std::array<PointF, 8>> texCoords(items.size());
+        for(unsigned i = 0; i < items.size(); i++)
+        {
+            textureIdxs[i] = file.ReadUnsignedInt();
+            Extent texSize;
+            texSize.x = file.ReadUnsignedInt();
+            texSize.y = file.ReadUnsignedInt();
+            file.ReadRawData(texCoords[i].data(), sizeof(texCoords[i]));
+            // Detect changed bitmaps which would not fit into the reserved space anymore
+            if(textureIdxs[i] >= newTextures.size() || texSize != items[i]->getRequiredTexSize())
+                return false;
+        }
+
+        textures = std::move(newTextures);
+        for(unsigned i = 0; i < items.size(); i++)
+        {
+            items[i]->setSharedTexture(textures[textureIdxs[i]].get());
+            items[i]->texCoords = texCoords[i];
+        }
+        return true;
+    } catch(const std::exception&)
+    {
+        return false;
+    }
+}
+
 glTexture::glTexture() : handle(VIDEODRIVER.GenerateTexture()), size(0, 0)
 {
     if(!handle)
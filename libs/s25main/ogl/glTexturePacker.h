@@ -18,6 +18,8 @@
 #pragma once
 
 #include "Point.h"
+#include <boost/filesystem/path.hpp>
+#include <cstdint>
 #include <vector>
 
 class glSmartBitmap;
@@ -54,10 +56,17 @@ private:
     std::vector<glTexture> textures;
     std::vector<glSmartBitmap*> items;
 
-    bool packHelper(std::vector<glSmartBitmap*>& list);
+    /// Pack the bitmaps into textures. If atlases is set, the pixel data of each texture is stored there
+    bool packHelper(std::vector<glSmartBitmap*>& list, std::vector<libsiedler2::PixelBufferBGRA>* atlases);
+    bool packImpl(std::vector<libsiedler2::PixelBufferBGRA>* atlases);
 
 public:
     bool pack();
+    /// Pack and save the textures and the placement of all bitmaps to the cache file which is identified by the key
+    bool packAndSave(const boost::filesystem::path& cacheFilepath, uint64_t cacheKey);
+    /// Restore the textures for the added bitmaps from a cache file written by packAndSave for the same bitmaps.
+    /// Returns false if the file does not exist or does not match the key or bitmaps
+    bool loadCache(const boost::filesystem::path& cacheFilepath, uint64_t cacheKey);
     void add(glSmartBitmap& bmp) { items.push_back(&bmp); }
     const auto& getTextures() const { return textures; }
 };
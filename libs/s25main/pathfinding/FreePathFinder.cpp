@@ -28,12 +28,6 @@
 /// FreePathFinder implementation
 //////////////////////////////////////////////////////////////////////////
 
-/// MapNodes
-using MapNodes = std::vector<NewNode>;
-using FreePathNodes = std::vector<FreePathNode>;
-MapNodes nodes;
-FreePathNodes fpNodes;
-
 void FreePathFinder::Init(const MapExtent& mapSize)
 {
     currentVisit = 0;
@@ -41,15 +35,21 @@ void FreePathFinder::Init(const MapExtent& mapSize)
     // Reset nodes
     nodes.clear();
     fpNodes.clear();
+    fpNodesBackward.clear();
     nodes.resize(size_.x * size_.y);
     fpNodes.resize(nodes.size());
+    fpNodesBackward.resize(nodes.size());
     RTTR_FOREACH_PT(MapPoint, size_)
     {
         const unsigned idx = gwb_.GetIdx(pt);
         nodes[idx].mapPt = pt;
-        fpNodes[idx].lastVisited = 0;
-        fpNodes[idx].mapPt = pt;
-        fpNodes[idx].idx = idx;
+        for(FreePathNodes* curNodes : {&fpNodes, &fpNodesBackward})
+        {
+            FreePathNode& fpNode = (*curNodes)[idx];
+            fpNode.lastVisited = 0;
+            fpNode.mapPt = pt;
+            fpNode.idx = idx;
+        }
     }
 }
 
@@ -67,6 +67,10 @@ void FreePathFinder::IncreaseCurrentVisit()
         {
             fpNode.lastVisited = 0;
         }
+        for(auto& fpNode : fpNodesBackward)
+        {
+            fpNode.lastVisited = 0;
+        }
         currentVisit = 1;
     } else
         currentVisit++;
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "pathfinding/NewNode.h"
 #include "gameTypes/Direction.h"
 #include "gameTypes/MapCoordinates.h"
 #include <vector>
@@ -31,12 +32,19 @@ using FP_Node_OK_Callback = bool (*)(const GameWorldBase&, const MapPoint, const
 
 class FreePathFinder
 {
-    GameWorldBase& gwb_;
+    const GameWorldBase& gwb_;
     unsigned currentVisit;
     Extent size_;
+    unsigned numExpandedNodes;
+    using FreePathNodes = std::vector<FreePathNode>;
+    /// Search state per map node. Kept per instance, so multiple instances can search concurrently
+    std::vector<NewNode> nodes;
+    FreePathNodes fpNodes;
+    /// Nodes for the search from the destination in DoesPathExist
+    FreePathNodes fpNodesBackward;
 
 public:
-    FreePathFinder(GameWorldBase& gwb) : gwb_(gwb), currentVisit(0), size_(0, 0) {}
+    FreePathFinder(const GameWorldBase& gwb) : gwb_(gwb), currentVisit(0), size_(0, 0), numExpandedNodes(0) {}
     void Init(const MapExtent& mapSize);
 
     /// Wegfindung in freiem Terrain - Template version. Users need to include FreePathFinderImpl.h
@@ -46,6 +54,14 @@ public:
     bool FindPath(MapPoint start, MapPoint dest, bool randomRoute, unsigned maxLength, std::vector<Direction>* route,
                   unsigned* length, Direction* firstDir, const TNodeChecker& nodeChecker);
 
+    /// Check if there is a path of at most maxLength steps and optionally return the length of the shortest one.
+    /// Same result as FindPath with the same TNodeChecker but searches from both ends, so far less nodes are expanded
+    /// for long routes and especially when the destination cannot be reached.
+    /// Use FindPath if the route itself is required as this may find another route of the same length
+    template<class TNodeChecker>
+    bool DoesPathExist(MapPoint start, MapPoint dest, unsigned maxLength, unsigned* length,
+                       const TNodeChecker& nodeChecker);
+
     bool FindPathAlternatingConditions(MapPoint start, MapPoint dest, bool randomRoute, unsigned maxLength,
                                        std::vector<Direction>* route, unsigned* length, Direction* firstDir,
                                        FP_Node_OK_Callback IsNodeOK, FP_Node_OK_Callback IsNodeOKAlternate,
@@ -56,6 +72,9 @@ public:
     bool CheckRoute(MapPoint start, const std::vector<Direction>& route, unsigned pos, const TNodeChecker& nodeChecker,
                     MapPoint* dest) const;
 
+    /// Number of nodes expanded by the last call to FindPath or DoesPathExist
+    unsigned GetNumExpandedNodes() const { return numExpandedNodes; }
+
 private:
     void IncreaseCurrentVisit();
 };
@@ -24,9 +24,8 @@
 #include "pathfinding/OpenListPrioQueue.h"
 #include "pathfinding/PathfindingPoint.h"
 #include "world/GameWorldBase.h"
-
-using FreePathNodes = std::vector<FreePathNode>;
-extern FreePathNodes fpNodes;
+#include <algorithm>
+#include <limits>
 
 struct NodePtrCmpGreater
 {
@@ -59,6 +58,7 @@ bool FreePathFinder::FindPath(const MapPoint start, const MapPoint dest, bool ra
 
     // increase currentVisit, so we don't have to clear the visited-states at every run
     IncreaseCurrentVisit();
+    numExpandedNodes = 0;
 
     QueueImpl todo;
     const unsigned startId = gwb_.GetIdx(start);
@@ -84,6 +84,7 @@ bool FreePathFinder::FindPath(const MapPoint start, const MapPoint dest, bool ra
     {
         // Knoten mit den geringsten Wegkosten auswählen
         FreePathNode& best = *todo.pop();
+        ++numExpandedNodes;
 
         // Ziel schon erreicht?
         if(&best == &destNode)
@@ -176,6 +177,113 @@ bool FreePathFinder::FindPath(const MapPoint start, const MapPoint dest, bool ra
     return false;
 }
 
+template<class TNodeChecker>
+bool FreePathFinder::DoesPathExist(const MapPoint start, const MapPoint dest, unsigned maxLength, unsigned* length,
+                                   const TNodeChecker& nodeChecker)
+{
+    RTTR_Assert(start != dest);
+
+    IncreaseCurrentVisit();
+    numExpandedNodes = 0;
+
+    // Bidirectional A*: Forward search from start using fpNodes and backward search from dest using fpNodesBackward
+    FreePathNode& startNode = fpNodes[gwb_.GetIdx(start)];
+    FreePathNode& destNode = fpNodesBackward[gwb_.GetIdx(dest)];
+    for(FreePathNode* node : {&startNode, &destNode})
+    {
+        node->targetDistance = gwb_.CalcDistance(start, dest);
+        node->estimatedDistance = node->targetDistance;
+        node->lastVisited = currentVisit;
+        node->prev = nullptr;
+        node->curDistance = 0;
+    }
+    if(startNode.targetDistance > maxLength)
+        return false;
+
+    QueueImpl todoForward, todoBackward;
+    todoForward.push(&startNode);
+    todoBackward.push(&destNode);
+
+    // Length of the shortest path found so far
+    unsigned bestLength = std::numeric_limits<unsigned>::max();
+
+    const auto expandBest = [&](QueueImpl& todo, FreePathNodes& curNodes, const FreePathNodes& otherNodes,
+                                const MapPoint target, const bool isForward) {
+        FreePathNode& best = *todo.pop();
+        ++numExpandedNodes;
+        const unsigned newDistance = best.curDistance + 1;
+
+        for(const Direction dir : helpers::EnumRange<Direction>{})
+        {
+            const MapPoint neighbourPos = gwb_.GetNeighbour(best.mapPt, dir);
+            const unsigned nbId = gwb_.GetIdx(neighbourPos);
+            FreePathNode& neighbour = curNodes[nbId];
+
+            if(best.prev == &neighbour)
+                continue;
+
+            // Edges are always checked in walking direction (from start to dest)
+            const bool isVisited = neighbour.lastVisited == currentVisit;
+            if(isVisited)
+            {
+                if(newDistance >= neighbour.curDistance)
+                    continue;
+                if(isForward ? !nodeChecker.IsEdgeOk(best.mapPt, dir) : !nodeChecker.IsEdgeOk(neighbourPos, dir + 3u))
+                    continue;
+
+                neighbour.curDistance = newDistance;
+                neighbour.estimatedDistance = neighbour.curDistance + neighbour.targetDistance;
+                neighbour.prev = &best;
+                neighbour.dir = dir;
+                todo.rearrange(&neighbour);
+            } else
+            {
+                // Start and goal are assumed to be ok
+                if(neighbourPos != start && neighbourPos != dest && !nodeChecker.IsNodeOk(neighbourPos))
+                    continue;
+                if(isForward ? !nodeChecker.IsEdgeOk(best.mapPt, dir) : !nodeChecker.IsEdgeOk(neighbourPos, dir + 3u))
+                    continue;
+
+                const unsigned targetDistance = gwb_.CalcDistance(neighbourPos, target);
+                // Target can't be reached over this node without exceeding the max length
+                if(newDistance + targetDistance > maxLength)
+                    continue;
+
+                neighbour.lastVisited = currentVisit;
+                neighbour.curDistance = newDistance;
+                neighbour.targetDistance = targetDistance;
+                neighbour.estimatedDistance = neighbour.curDistance + neighbour.targetDistance;
+                neighbour.dir = dir;
+                neighbour.prev = &best;
+                todo.push(&neighbour);
+            }
+
+            // Met the other search?
+            const FreePathNode& otherNode = otherNodes[nbId];
+            if(otherNode.lastVisited == currentVisit)
+                bestLength = std::min(bestLength, neighbour.curDistance + otherNode.curDistance);
+        }
+    };
+
+    while(!todoForward.empty() && !todoBackward.empty())
+    {
+        // All paths over nodes not yet expanded by one of the searches are at least as long as the top estimate
+        if(todoForward.top()->estimatedDistance >= bestLength || todoBackward.top()->estimatedDistance >= bestLength)
+            break;
+        // Continue with the search with less open nodes
+        if(todoForward.size() <= todoBackward.size())
+            expandBest(todoForward, fpNodes, fpNodesBackward, dest, true);
+        else
+            expandBest(todoBackward, fpNodesBackward, fpNodes, start, false);
+    }
+
+    if(bestLength > maxLength)
+        return false;
+    if(length)
+        *length = bestLength;
+    return true;
+}
+
 /// Ermittelt, ob eine freie Route noch passierbar ist und gibt den Endpunkt der Route zurück
 template<class TNodeChecker>
 bool FreePathFinder::CheckRoute(const MapPoint start, const std::vector<Direction>& route, unsigned pos,
@@ -0,0 +1,132 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "RoadGraph.h"
+#include "RTTR_Assert.h"
+#include "RoadSegment.h"
+#include "helpers/EnumRange.h"
+#include "nodeObjs/noRoadNode.h"
+#include "gameTypes/GO_Type.h"
+
+constexpr unsigned RoadGraph::INVALID_IDX;
+
+unsigned RoadGraph::GetIdx(const noRoadNode& roadNode) const
+{
+    if(!useNodeHints)
+    {
+        const auto it = nodeIdxs.find(&roadNode);
+        return (it == nodeIdxs.end() || !parts[nodes[it->second].part].isValid) ? INVALID_IDX : it->second;
+    }
+    // The index stored in the node might be from an older graph
+    const unsigned idx = roadNode.roadGraphIdx;
+    if(idx < nodes.size() && nodes[idx].roadNode == &roadNode && parts[nodes[idx].part].isValid)
+        return idx;
+    return INVALID_IDX;
+}
+
+void RoadGraph::AddConnectedNodes(const noRoadNode& roadNode)
+{
+    RTTR_Assert(GetIdx(roadNode) == INVALID_IDX);
+    const unsigned firstNewNode = nodes.size();
+    const unsigned partIdx = parts.size();
+    parts.push_back(Part{firstNewNode, firstNewNode, true});
+    const auto addNode = [this, partIdx](const noRoadNode& newNode) {
+        if(useNodeHints)
+            newNode.roadGraphIdx = nodes.size();
+        else
+            nodeIdxs[&newNode] = nodes.size();
+        const GO_Type got = newNode.GetGOT();
+        Node node{};
+        node.roadNode = &newNode;
+        node.pos = newNode.GetPos();
+        node.isPassable = got == GO_Type::Flag || got == GO_Type::NobHarborbuilding;
+        node.isHarbor = got == GO_Type::NobHarborbuilding;
+        node.prev = INVALID_IDX;
+        node.part = partIdx;
+        nodes.push_back(node);
+    };
+    addNode(roadNode);
+    // Nodes are added in BFS order. Edges are added after all nodes of this part have an index
+    for(unsigned i = firstNewNode; i < nodes.size(); i++)
+    {
+        const noRoadNode& curNode = *nodes[i].roadNode;
+        for(const auto dir : helpers::EnumRange<Direction>{})
+        {
+            const noRoadNode* neighbour = curNode.GetNeighbour(dir);
+            if(neighbour && GetIdx(*neighbour) == INVALID_IDX)
+                addNode(*neighbour);
+        }
+    }
+    for(unsigned i = firstNewNode; i < nodes.size(); i++)
+    {
+        Node& node = nodes[i];
+        node.firstEdge = edges.size();
+        // Same order as the directions so searches visit the neighbours in the same order as before
+        for(const auto dir : helpers::EnumRange<Direction>{})
+        {
+            const RoadSegment* segment = node.roadNode->GetRoute(dir);
+            if(!segment)
+                continue;
+            const unsigned target = GetIdx(*node.roadNode->GetNeighbour(dir));
+            RTTR_Assert(target != INVALID_IDX);
+            edges.push_back(Edge{target, segment->GetLength(), segment, dir});
+        }
+        node.numEdges = static_cast<uint8_t>(edges.size() - node.firstEdge);
+    }
+    parts[partIdx].endNode = nodes.size();
+}
+
+void RoadGraph::InvalidatePart(const noRoadNode& roadNode)
+{
+    const unsigned idx = GetIdx(roadNode);
+    if(idx == INVALID_IDX)
+        return;
+    Part& part = parts[nodes[idx].part];
+    part.isValid = false;
+    numInvalidNodes += part.endNode - part.firstNode;
+    // Rebuild the remaining parts when they are needed again instead of keeping lots of unused nodes
+    if(numInvalidNodes * 2u > nodes.size())
+    {
+        Clear();
+        return;
+    }
+    if(!useNodeHints)
+    {
+        // The road nodes might be destroyed already, so only use their addresses
+        for(unsigned i = part.firstNode; i < part.endNode; i++)
+        {
+            const auto it = nodeIdxs.find(nodes[i].roadNode);
+            if(it != nodeIdxs.end() && it->second == i)
+                nodeIdxs.erase(it);
+        }
+    }
+}
+
+void RoadGraph::Clear()
+{
+    nodes.clear();
+    edges.clear();
+    parts.clear();
+    nodeIdxs.clear();
+    numInvalidNodes = 0;
+}
+
+void RoadGraph::ResetVisits()
+{
+    for(Node& node : nodes)
+        node.lastVisit = 0;
+}
@@ -0,0 +1,107 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "gameTypes/Direction.h"
+#include "gameTypes/MapCoordinates.h"
+#include "gameTypes/RoadPathDirection.h"
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+class noRoadNode;
+class RoadSegment;
+
+/// Compact representation of the road network of one player used by the RoadPathFinder.
+/// Nodes and their outgoing roads are stored in contiguous arrays (CSR) so searches don't need to follow the pointers
+/// of the road nodes and segments. Connected parts of the network are added on demand. When a road changes only the
+/// affected part is invalidated and added again when required, the graph is compacted once too many nodes are unused.
+class RoadGraph
+{
+public:
+    static constexpr unsigned INVALID_IDX = std::numeric_limits<unsigned>::max();
+
+    /// If useNodeHints is true, the index of each node is stored in the road node itself for fast lookups.
+    /// Only one graph per road node may do this, others use a (slower) map
+    explicit RoadGraph(bool useNodeHints = true) : useNodeHints(useNodeHints) {}
+
+    struct Edge
+    {
+        /// Index of the node at the other end
+        unsigned target;
+        /// Length of the road
+        unsigned length;
+        const RoadSegment* segment;
+        /// Direction of the road at the source node
+        Direction dir;
+    };
+
+    struct Node
+    {
+        const noRoadNode* roadNode;
+        MapPoint pos;
+        unsigned firstEdge;
+        uint8_t numEdges;
+        /// Node can be passed to reach other nodes (flags and harbors, not other buildings)
+        bool isPassable;
+        bool isHarbor;
+        /// Connected part this node belongs to
+        unsigned part;
+
+        // Search state, only valid if lastVisit == currentVisit of the search
+        unsigned lastVisit;
+        unsigned cost;
+        unsigned targetDistance;
+        unsigned estimate;
+        unsigned prev;
+        RoadPathDirection dir;
+    };
+
+    /// Return the index of the node or INVALID_IDX if it is not part of the graph
+    unsigned GetIdx(const noRoadNode& roadNode) const;
+    unsigned GetIdx(const Node& node) const { return static_cast<unsigned>(&node - nodes.data()); }
+    /// Add the node and all nodes connected to it by roads
+    void AddConnectedNodes(const noRoadNode& roadNode);
+    /// Remove the part containing the node from the graph (if any). Has to be called when a road of the part changed
+    void InvalidatePart(const noRoadNode& roadNode);
+    void Clear();
+    /// Reset the visited marker of all nodes
+    void ResetVisits();
+    bool IsEmpty() const { return nodes.empty(); }
+
+    Node& GetNode(unsigned idx) { return nodes[idx]; }
+    const Edge& GetEdge(unsigned idx) const { return edges[idx]; }
+
+private:
+    /// Nodes connected by roads, stored consecutively
+    struct Part
+    {
+        unsigned firstNode, endNode;
+        bool isValid;
+    };
+
+    bool useNodeHints;
+    std::vector<Node> nodes;
+    std::vector<Edge> edges;
+    std::vector<Part> parts;
+    /// Number of nodes in invalidated parts
+    unsigned numInvalidNodes = 0;
+    /// Index of each node if the hints are not used
+    std::unordered_map<const noRoadNode*, unsigned> nodeIdxs;
+};
@@ -17,35 +17,12 @@
 
 #include "RoadPathFinder.h"
 #include "EventManager.h"
-#include "RttrForeachPt.h"
 #include "buildings/nobHarborBuilding.h"
-#include "pathfinding/OpenListPrioQueue.h"
-#include "pathfinding/OpenListVector.h"
 #include "world/GameWorldBase.h"
 #include "nodeObjs/noRoadNode.h"
 #include "gameData/GameConsts.h"
 #include "s25util/Log.h"
 
-/// Comparison operator for road nodes that returns true if lhs > rhs (descending order)
-struct RoadNodeComperatorGreater
-{
-    bool operator()(const noRoadNode* const lhs, const noRoadNode* const rhs) const
-    {
-        if(lhs->estimate == rhs->estimate)
-        {
-            // Wenn die Wegkosten gleich sind, vergleichen wir die Koordinaten, da wir für std::set eine streng
-            // monoton steigende Folge brauchen
-            return (lhs->GetObjId() > rhs->GetObjId());
-        }
-
-        return (lhs->estimate > rhs->estimate);
-    }
-};
-
-using QueueImpl = OpenListPrioQueue<const noRoadNode*, RoadNodeComperatorGreater>;
-using VecImpl = OpenListVector<const noRoadNode*>;
-VecImpl todo;
-
 // Namespace with all functors usable as additional cost functors
 namespace AdditonalCosts {
 struct None
@@ -113,7 +90,44 @@ struct And : private T_Func1, private T_Func2
 };
 } // namespace SegmentConstraints
 
-/// Wegfinden ( A* ), O(v lg v) --> Wegfindung auf Stra�en
+void RoadPathFinder::Init(const unsigned numPlayers)
+{
+    roadGraphs.clear();
+    roadGraphs.resize(numPlayers, RoadGraph(useNodeHints));
+}
+
+void RoadPathFinder::InvalidateRoadGraph(const noRoadNode& node)
+{
+    const unsigned char player = node.GetPlayer();
+    if(player < roadGraphs.size())
+        roadGraphs[player].InvalidatePart(node);
+    if(player >= numInvalidations.size())
+        numInvalidations.resize(player + 1u, 0u);
+    ++numInvalidations[player];
+}
+
+void RoadPathFinder::ClearRoadGraph(const unsigned char player)
+{
+    if(player < roadGraphs.size())
+        roadGraphs[player].Clear();
+}
+
+unsigned RoadPathFinder::GetNumInvalidations(const unsigned char player) const
+{
+    return (player < numInvalidations.size()) ? numInvalidations[player] : 0u;
+}
+
+RoadGraph& RoadPathFinder::GetRoadGraph(const noRoadNode& node)
+{
+    if(node.GetPlayer() >= roadGraphs.size())
+        roadGraphs.resize(node.GetPlayer() + 1u, RoadGraph(useNodeHints));
+    RoadGraph& graph = roadGraphs[node.GetPlayer()];
+    if(graph.GetIdx(node) == RoadGraph::INVALID_IDX)
+        graph.AddConnectedNodes(node);
+    return graph;
+}
+
+/// Wegfinden ( A* ), O(v lg v) --> Wegfindung auf Straßen
 template<class T_AdditionalCosts, class T_SegmentConstraints>
 bool RoadPathFinder::FindPathImpl(const noRoadNode& start, const noRoadNode& goal, const unsigned max,
                                   const T_AdditionalCosts addCosts, const T_SegmentConstraints isSegmentAllowed,
@@ -137,130 +151,140 @@ bool RoadPathFinder::FindPathImpl(const noRoadNode& start, const noRoadNode& goa
         return true;
     }
 
-    // increase current_visit_on_roads, so we don't have to clear the visited-states at every run
-    currentVisit++;
-
-    // if the counter reaches its maximum, tidy up
-    if(currentVisit == std::numeric_limits<unsigned>::max())
+    RoadGraph& graph = GetRoadGraph(start);
+    bool found;
+    do
     {
-        RTTR_FOREACH_PT(MapPoint, gwb_.GetSize())
+        // increase current_visit_on_roads, so we don't have to clear the visited-states at every run
+        currentVisit++;
+
+        // if the counter reaches its maximum, tidy up
+        if(currentVisit == std::numeric_limits<unsigned>::max())
         {
-            auto* const node = gwb_.GetSpecObj<noRoadNode>(pt);
-            if(node)
-                node->last_visit = 0;
+            for(RoadGraph& curGraph : roadGraphs)
+                curGraph.ResetVisits();
+            currentVisit = 1;
         }
-        currentVisit = 1;
-    }
+        // Redo the search if a ship connection lead to a part of the road network not yet in the graph
+    } while(!FindPathOnGraph(graph, start, goal, max, addCosts, isSegmentAllowed, found, length, firstDir,
+                             firstNodePos));
+    return found;
+}
+
+template<class T_AdditionalCosts, class T_SegmentConstraints>
+bool RoadPathFinder::FindPathOnGraph(RoadGraph& graph, const noRoadNode& start, const noRoadNode& goal,
+                                     const unsigned max, const T_AdditionalCosts addCosts,
+                                     const T_SegmentConstraints isSegmentAllowed, bool& found, unsigned* const length,
+                                     RoadPathDirection* const firstDir, MapPoint* const firstNodePos)
+{
+    found = false;
+    const unsigned startIdx = graph.GetIdx(start);
+    RTTR_Assert(startIdx != RoadGraph::INVALID_IDX);
 
-    // Anfangsknoten einf�gen
+    // Anfangsknoten einfügen
     todo.clear();
 
-    start.targetDistance = gwb_.CalcDistance(start.GetPos(), goal.GetPos());
-    start.estimate = start.targetDistance;
-    start.last_visit = currentVisit;
-    start.prev = nullptr;
-    start.cost = 0;
-    start.dir_ = RoadPathDirection::None;
+    RoadGraph::Node& startNode = graph.GetNode(startIdx);
+    startNode.targetDistance = gwb_.CalcDistance(startNode.pos, goal.GetPos());
+    startNode.estimate = startNode.targetDistance;
+    startNode.lastVisit = currentVisit;
+    startNode.prev = RoadGraph::INVALID_IDX;
+    startNode.cost = 0;
+    startNode.dir = RoadPathDirection::None;
 
-    todo.push(&start);
+    todo.push(&startNode);
 
     while(!todo.empty())
     {
-        // Knoten mit den geringsten Wegkosten ausw�hlen
-        const noRoadNode& best = *todo.pop();
+        // Knoten mit den geringsten Wegkosten auswählen
+        RoadGraph::Node& best = *todo.pop();
 
         // Ziel erreicht?
-        if(&best == &goal)
+        if(best.roadNode == &goal)
         {
-            // Jeweils die einzelnen Angaben zur�ckgeben, falls gew�nscht (Pointer �bergeben)
+            // Jeweils die einzelnen Angaben zurückgeben, falls gewünscht (Pointer übergeben)
             if(length)
                 *length = best.cost;
 
             // Backtrace to get the last node that is not the start node (has a prev node) --> Next node from start on
             // path
-            const noRoadNode* firstNode = &best;
-            while(firstNode->prev != &start)
+            const RoadGraph::Node* firstNode = &best;
+            while(firstNode->prev != startIdx)
             {
-                firstNode = firstNode->prev;
+                firstNode = &graph.GetNode(firstNode->prev);
             }
 
             if(firstDir)
-                *firstDir = firstNode->dir_;
+                *firstDir = firstNode->dir;
 
             if(firstNodePos)
-                *firstNodePos = firstNode->GetPos();
+                *firstNodePos = firstNode->pos;
 
             // Done, path found
+            found = true;
             return true;
         }
 
-        // Nachbarflagge bzw. Wege in allen 6 Richtungen verfolgen
-        for(const auto dir : helpers::EnumRange<Direction>{})
+        const unsigned bestIdx = graph.GetIdx(best);
+        // Roads of the node are ordered by direction
+        for(unsigned edgeIdx = best.firstEdge; edgeIdx < best.firstEdge + best.numEdges; edgeIdx++)
         {
-            // Gibt es auch einen solchen Weg bzw. Nachbarflagge?
-            noRoadNode* neighbour = best.GetNeighbour(dir);
-
-            // Wenn nicht, brauchen wir mit dieser Richtung gar nicht weiter zu machen
-            if(!neighbour)
-                continue;
+            const RoadGraph::Edge& edge = graph.GetEdge(edgeIdx);
 
             // this eliminates 1/6 of all nodes and avoids cost calculation and further checks,
             // therefore - and because the profiler says so - it is more efficient that way
-            if(neighbour == best.prev)
+            if(edge.target == best.prev)
                 continue;
 
-            // No pathes over buildings
-            if((dir == Direction::NorthWest) && (neighbour != &goal))
-            {
-                // Flags and harbors are allowed
-                const GO_Type got = neighbour->GetGOT();
-                if(got != GO_Type::Flag && got != GO_Type::NobHarborbuilding)
-                    continue;
-            }
+            RoadGraph::Node& neighbour = graph.GetNode(edge.target);
+
+            // No pathes over buildings (Flags and harbors are allowed)
+            if((edge.dir == Direction::NorthWest) && !neighbour.isPassable && (neighbour.roadNode != &goal))
+                continue;
 
             // evtl verboten?
-            if(!isSegmentAllowed(*best.GetRoute(dir)))
+            if(!isSegmentAllowed(*edge.segment))
                 continue;
 
             // Neuer Weg für diesen neuen Knoten berechnen
-            unsigned cost = best.cost + best.GetRoute(dir)->GetLength();
-            cost += addCosts(best, dir);
+            unsigned cost = best.cost + edge.length;
+            cost += addCosts(*best.roadNode, edge.dir);
 
             if(cost > max)
                 continue;
 
             // Was node already visited?
-            if(neighbour->last_visit == currentVisit)
+            if(neighbour.lastVisit == currentVisit)
             {
-                // Dann nur ggf. Weg und Vorg�nger korrigieren, falls der Weg k�rzer ist
-                if(cost < neighbour->cost)
+                // Dann nur ggf. Weg und Vorgänger korrigieren, falls der Weg kürzer ist
+                if(cost < neighbour.cost)
                 {
-                    neighbour->cost = cost;
-                    neighbour->prev = &best;
-                    neighbour->estimate = neighbour->targetDistance + cost;
-                    todo.rearrange(neighbour);
-                    neighbour->dir_ = toRoadPathDirection(dir);
+                    neighbour.cost = cost;
+                    neighbour.prev = bestIdx;
+                    neighbour.estimate = neighbour.targetDistance + cost;
+                    todo.rearrange(&neighbour);
+                    neighbour.dir = toRoadPathDirection(edge.dir);
                 }
             } else
             {
                 // Not visited yet -> Add to list
-                neighbour->last_visit = currentVisit;
-                neighbour->cost = cost;
-                neighbour->dir_ = toRoadPathDirection(dir);
-                neighbour->prev = &best;
+                neighbour.lastVisit = currentVisit;
+                neighbour.cost = cost;
+                neighbour.dir = toRoadPathDirection(edge.dir);
+                neighbour.prev = bestIdx;
 
-                neighbour->targetDistance = gwb_.CalcDistance(neighbour->GetPos(), goal.GetPos());
-                neighbour->estimate = neighbour->targetDistance + cost;
+                neighbour.targetDistance = gwb_.CalcDistance(neighbour.pos, goal.GetPos());
+                neighbour.estimate = neighbour.targetDistance + cost;
 
-                todo.push(neighbour);
+                todo.push(&neighbour);
             }
         }
 
         // Stehen wir hier auf einem Hafenplatz
-        if(best.GetGOT() == GO_Type::NobHarborbuilding)
+        if(best.isHarbor)
         {
             std::vector<nobHarborBuilding::ShipConnection> scs =
-              static_cast<const nobHarborBuilding&>(best).GetShipConnections();
+              static_cast<const nobHarborBuilding*>(best.roadNode)->GetShipConnections();
 
             for(auto& sc : scs)
             {
@@ -270,29 +294,37 @@ bool RoadPathFinder::FindPathImpl(const noRoadNode& start, const noRoadNode& goa
                 if(cost > max)
                     continue;
 
-                noRoadNode& dest = *sc.dest;
+                const unsigned destIdx = graph.GetIdx(*sc.dest);
+                if(destIdx == RoadGraph::INVALID_IDX)
+                {
+                    // Harbor in a part of the road network we haven't seen yet. Add it and start over as this
+                    // invalidates the nodes in the open list
+                    graph.AddConnectedNodes(*sc.dest);
+                    return false;
+                }
+                RoadGraph::Node& dest = graph.GetNode(destIdx);
                 // Was node already visited?
-                if(dest.last_visit == currentVisit)
+                if(dest.lastVisit == currentVisit)
                 {
-                    // Dann nur ggf. Weg und Vorg�nger korrigieren, falls der Weg k�rzer ist
+                    // Dann nur ggf. Weg und Vorgänger korrigieren, falls der Weg kürzer ist
                     if(cost < dest.cost)
                     {
-                        dest.dir_ = RoadPathDirection::Ship;
+                        dest.dir = RoadPathDirection::Ship;
                         dest.cost = cost;
-                        dest.prev = &best;
+                        dest.prev = bestIdx;
                         dest.estimate = dest.targetDistance + cost;
                         todo.rearrange(&dest);
                     }
                 } else
                 {
                     // Not visited yet -> Add to list
-                    dest.last_visit = currentVisit;
+                    dest.lastVisit = currentVisit;
 
-                    dest.dir_ = RoadPathDirection::Ship;
-                    dest.prev = &best;
+                    dest.dir = RoadPathDirection::Ship;
+                    dest.prev = bestIdx;
                     dest.cost = cost;
 
-                    dest.targetDistance = gwb_.CalcDistance(dest.GetPos(), goal.GetPos());
+                    dest.targetDistance = gwb_.CalcDistance(dest.pos, goal.GetPos());
                     dest.estimate = dest.targetDistance + cost;
 
                     todo.push(&dest);
@@ -302,7 +334,7 @@ bool RoadPathFinder::FindPathImpl(const noRoadNode& start, const noRoadNode& goa
     }
 
     // Liste leer und kein Ziel erreicht --> kein Weg
-    return false;
+    return true;
 }
 
 bool RoadPathFinder::FindPath(const noRoadNode& start, const noRoadNode& goal, const bool wareMode, const unsigned max,
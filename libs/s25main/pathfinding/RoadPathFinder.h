@@ -17,9 +17,12 @@
 
 #pragma once
 
+#include "pathfinding/OpenListVector.h"
+#include "pathfinding/RoadGraph.h"
 #include "gameTypes/MapCoordinates.h"
 #include "gameTypes/RoadPathDirection.h"
 #include <limits>
+#include <vector>
 
 class GameWorldBase;
 class noRoadNode;
@@ -27,11 +30,31 @@ class RoadSegment;
 
 class RoadPathFinder
 {
-    GameWorldBase& gwb_;
+    const GameWorldBase& gwb_;
     unsigned currentVisit;
+    /// See RoadGraph
+    bool useNodeHints;
+    /// Cached road network for each player
+    std::vector<RoadGraph> roadGraphs;
+    /// Number of calls to InvalidateRoadGraph per player
+    std::vector<unsigned> numInvalidations;
+    /// Open list of the search. Per instance so path finders of different threads don't interfere
+    OpenListVector<RoadGraph::Node*> todo;
 
 public:
-    RoadPathFinder(GameWorldBase& gwb) : gwb_(gwb), currentVisit(0) {}
+    /// Only the path finder of the world should use the node hints, see RoadGraph
+    RoadPathFinder(const GameWorldBase& gwb, bool useNodeHints = true)
+        : gwb_(gwb), currentVisit(0), useNodeHints(useNodeHints)
+    {}
+
+    void Init(unsigned numPlayers);
+    /// Has to be called when the roads of the node changed (roads built/destroyed, node destroyed or changed owner...)
+    /// Only the connected part of the road network of the node's owner is rebuilt
+    void InvalidateRoadGraph(const noRoadNode& node);
+    /// Remove the whole road network of the player from the graph
+    void ClearRoadGraph(unsigned char player);
+    /// Counter increased by each call to InvalidateRoadGraph. Can be used to detect changes of the road network
+    unsigned GetNumInvalidations(unsigned char player) const;
 
     /// Calculates the best path from start to goal
     /// Outputs are only valid if true is returned!
@@ -57,8 +80,16 @@ public:
                     unsigned max = std::numeric_limits<unsigned>::max(), const RoadSegment* forbidden = nullptr);
 
 private:
+    /// Return the graph containing the given node, adding its connected nodes if required
+    RoadGraph& GetRoadGraph(const noRoadNode& node);
+
     template<class T_AdditionalCosts, class T_SegmentConstraints>
     bool FindPathImpl(const noRoadNode& start, const noRoadNode& goal, unsigned max, T_AdditionalCosts addCosts,
                       T_SegmentConstraints isSegmentAllowed, unsigned* length = nullptr,
                       RoadPathDirection* firstDir = nullptr, MapPoint* firstNodePos = nullptr);
+    /// Search on the graph. Returns false if the graph has been extended during the search so it has to be redone
+    template<class T_AdditionalCosts, class T_SegmentConstraints>
+    bool FindPathOnGraph(RoadGraph& graph, const noRoadNode& start, const noRoadNode& goal, unsigned max,
+                         T_AdditionalCosts addCosts, T_SegmentConstraints isSegmentAllowed, bool& found,
+                         unsigned* length, RoadPathDirection* firstDir, MapPoint* firstNodePos);
 };
@@ -0,0 +1,64 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "pathfinding/ThreadPathFinders.h"
+#include "RTTR_Assert.h"
+#include "world/GameWorldBase.h"
+
+namespace {
+thread_local ThreadPathFinders* curPathFinders = nullptr;
+}
+
+ThreadPathFinders::ThreadPathFinders(const GameWorldBase& gwb)
+    : gwb(gwb), freePathFinder(gwb), roadPathFinder(gwb, false) // Road nodes hints belong to the game thread
+{
+    freePathFinder.Init(gwb.GetSize());
+    roadPathFinder.Init(gwb.GetNumPlayers());
+    numRoadInvalidations.resize(gwb.GetNumPlayers());
+    for(unsigned i = 0; i < gwb.GetNumPlayers(); i++)
+        numRoadInvalidations[i] = gwb.GetRoadPathFinder().GetNumInvalidations(i);
+}
+
+void ThreadPathFinders::Update()
+{
+    RTTR_Assert(GetCurrent() != this);
+    const RoadPathFinder& worldRoadPathFinder = gwb.GetRoadPathFinder();
+    for(unsigned i = 0; i < numRoadInvalidations.size(); i++)
+    {
+        const unsigned curNumInvalidations = worldRoadPathFinder.GetNumInvalidations(i);
+        if(curNumInvalidations != numRoadInvalidations[i])
+        {
+            roadPathFinder.ClearRoadGraph(i);
+            numRoadInvalidations[i] = curNumInvalidations;
+        }
+    }
+}
+
+ThreadPathFinders* ThreadPathFinders::GetCurrent()
+{
+    return curPathFinders;
+}
+
+ThreadPathFinders::Scope::Scope(ThreadPathFinders& pathFinders) : prevPathFinders(curPathFinders)
+{
+    curPathFinders = &pathFinders;
+}
+
+ThreadPathFinders::Scope::~Scope()
+{
+    curPathFinders = prevPathFinders;
+}
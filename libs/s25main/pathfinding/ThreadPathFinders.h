@@ -0,0 +1,63 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "pathfinding/FreePathFinder.h"
+#include "pathfinding/RoadPathFinder.h"
+#include <vector>
+
+class GameWorldBase;
+
+/// Path finders with their own search state for use by a thread other than the game thread.
+/// While a Scope is active GameWorldBase::GetFreePathFinder/GetRoadPathFinder return those of the current thread.
+/// The world must not be changed while those are used
+class ThreadPathFinders
+{
+public:
+    explicit ThreadPathFinders(const GameWorldBase& gwb);
+
+    /// Has to be called by the game thread before use when the world might have changed since the last use.
+    /// Discards the road networks which were changed in the world
+    void Update();
+
+    FreePathFinder& GetFreePathFinder() { return freePathFinder; }
+    RoadPathFinder& GetRoadPathFinder() { return roadPathFinder; }
+
+    /// Return the path finders active for the current thread or nullptr if none
+    static ThreadPathFinders* GetCurrent();
+
+    /// Makes the path finders active for the current thread while in scope
+    class Scope
+    {
+    public:
+        explicit Scope(ThreadPathFinders& pathFinders);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ThreadPathFinders* prevPathFinders;
+    };
+
+private:
+    const GameWorldBase& gwb;
+    FreePathFinder freePathFinder;
+    RoadPathFinder roadPathFinder;
+    /// Invalidation counters of the worlds road path finder at the last update
+    std::vector<unsigned> numRoadInvalidations;
+};
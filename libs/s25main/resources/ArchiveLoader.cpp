@@ -19,6 +19,7 @@
 #include "ResolvedFile.h"
 #include "Timer.h"
 #include "commonDefines.h"
+#include "helpers/ThreadPool.h"
 #include "helpers/format.hpp"
 #include "mygettext/mygettext.h"
 #include "ogl/glArchivItem_Bob.h"
@@ -30,9 +31,12 @@
 #include "s25util/Log.h"
 #include "s25util/strAlgos.h"
 #include <boost/filesystem.hpp>
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 
 namespace fs = boost::filesystem;
 
@@ -77,11 +81,19 @@ std::map<uint16_t, uint16_t> extractBobMapping(libsiedler2::Archiv& archive, con
 }
 } // namespace
 
+void ArchiveLoader::log(std::string* logBuffer, const std::string& msg) const
+{
+    if(logBuffer)
+        *logBuffer += msg;
+    else
+        logger_.write("%1%") % msg;
+}
+
 /// Load a single file into the archive
-libsiedler2::Archiv ArchiveLoader::loadFile(const fs::path& filePath,
-                                            const libsiedler2::ArchivItem_Palette* palette) const
+libsiedler2::Archiv ArchiveLoader::loadFile(const fs::path& filePath, const libsiedler2::ArchivItem_Palette* palette,
+                                            std::string* logBuffer) const
 {
-    logger_.write(_("Loading \"%s\": ")) % filePath;
+    log(logBuffer, helpers::format(_("Loading \"%s\": "), filePath));
 
     libsiedler2::Archiv archive;
     if(int ec = libsiedler2::Load(filePath, archive, palette))
@@ -91,11 +103,12 @@ libsiedler2::Archiv ArchiveLoader::loadFile(const fs::path& filePath,
 }
 
 libsiedler2::Archiv ArchiveLoader::loadDirectory(const fs::path& filePath,
-                                                 const libsiedler2::ArchivItem_Palette* palette) const
+                                                 const libsiedler2::ArchivItem_Palette* palette,
+                                                 std::string* logBuffer) const
 {
-    logger_.write(_("Loading directory %s\n")) % filePath;
+    log(logBuffer, helpers::format(_("Loading directory %s\n"), filePath));
     std::vector<libsiedler2::FileEntry> files = libsiedler2::ReadFolderInfo(filePath);
-    logger_.write(_("  Loading %1% entries: ")) % files.size();
+    log(logBuffer, helpers::format(_("  Loading %1% entries: "), files.size()));
 
     libsiedler2::Archiv archive;
 
@@ -107,6 +120,13 @@ libsiedler2::Archiv ArchiveLoader::loadDirectory(const fs::path& filePath,
 
 libsiedler2::Archiv ArchiveLoader::loadFileOrDir(const fs::path& filePath,
                                                  const libsiedler2::ArchivItem_Palette* palette) const
+{
+    return loadFileOrDir(filePath, palette, nullptr);
+}
+
+libsiedler2::Archiv ArchiveLoader::loadFileOrDir(const fs::path& filePath,
+                                                 const libsiedler2::ArchivItem_Palette* palette,
+                                                 std::string* logBuffer) const
 {
     const auto fileStatus = status(filePath);
     if(!exists(fileStatus))
@@ -120,18 +140,18 @@ libsiedler2::Archiv ArchiveLoader::loadFileOrDir(const fs::path& filePath,
 
         libsiedler2::Archiv result;
         if(is_directory(fileStatus))
-            result = loadDirectory(filePath, palette);
+            result = loadDirectory(filePath, palette, logBuffer);
         else
-            result = loadFile(filePath, palette);
+            result = loadFile(filePath, palette, logBuffer);
 
         using namespace std::chrono;
         // TODO: Change translations and use chronoIO
-        logger_.write(_("done in %ums\n")) % duration_cast<milliseconds>(timer.getElapsed()).count();
+        log(logBuffer, helpers::format(_("done in %ums\n"), duration_cast<milliseconds>(timer.getElapsed()).count()));
 
         return result;
     } catch(const LoadError& e)
     {
-        logger_.write(_("failed: %1%\n")) % e.what();
+        log(logBuffer, helpers::format(_("failed: %1%\n"), e.what()));
         throw LoadError();
     }
 }
@@ -165,13 +185,19 @@ void ArchiveLoader::mergeArchives(libsiedler2::Archiv& targetArchiv, libsiedler2
 }
 
 libsiedler2::Archiv ArchiveLoader::load(const ResolvedFile& file, const libsiedler2::ArchivItem_Palette* palette) const
+{
+    return load(file, palette, nullptr);
+}
+
+libsiedler2::Archiv ArchiveLoader::load(const ResolvedFile& file, const libsiedler2::ArchivItem_Palette* palette,
+                                        std::string* logBuffer) const
 {
     libsiedler2::Archiv archive;
     for(const fs::path& curFilepath : file)
     {
         try
         {
-            libsiedler2::Archiv newEntries = loadFileOrDir(curFilepath, palette);
+            libsiedler2::Archiv newEntries = loadFileOrDir(curFilepath, palette, logBuffer);
 
             std::map<uint16_t, uint16_t> bobMapping;
             if(isBobOverride(curFilepath))
@@ -189,9 +215,45 @@ libsiedler2::Archiv ArchiveLoader::load(const ResolvedFile& file, const libsiedl
         } catch(const LoadError& e)
         {
             if(e.what() != std::string())
-                logger_.write("Exception caught: %1%\n") % e.what();
+                log(logBuffer, helpers::format("Exception caught: %1%\n", e.what()));
             throw LoadError();
         }
     }
     return archive;
 }
+
+std::vector<libsiedler2::Archiv> ArchiveLoader::loadAll(const std::vector<ResolvedFile>& files,
+                                                        const libsiedler2::ArchivItem_Palette* palette) const
+{
+    std::vector<libsiedler2::Archiv> archives(files.size());
+    if(files.size() <= 1u)
+    {
+        for(unsigned i = 0; i < files.size(); i++)
+            archives[i] = load(files[i], palette);
+        return archives;
+    }
+
+    // Decoding only creates the archive items (no OpenGL calls) and only reads the palette,
+    // so the files can be loaded concurrently. The log is not thread safe though, so buffer the messages.
+    std::vector<std::string> logBuffers(files.size());
+    std::atomic<bool> failed(false);
+    const unsigned numThreads = std::min<unsigned>(files.size(), std::max(1u, std::thread::hardware_concurrency()));
+    helpers::ThreadPool threadPool(numThreads);
+    threadPool.run(files.size(), [&](unsigned idx, unsigned) {
+        try
+        {
+            archives[idx] = load(files[idx], palette, &logBuffers[idx]);
+        } catch(const LoadError&)
+        {
+            failed = true;
+        }
+    });
+    for(const std::string& logBuffer : logBuffers)
+    {
+        if(!logBuffer.empty())
+            log(nullptr, logBuffer);
+    }
+    if(failed)
+        throw LoadError();
+    return archives;
+}
@@ -19,6 +19,8 @@
 
 #include <boost/filesystem/path.hpp>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 class Log;
 class ResolvedFile;
@@ -43,6 +45,10 @@ public:
     explicit ArchiveLoader(Log& logger) : logger_(logger) {}
     /// Load a resolved file. Throws a LoadError on error.
     libsiedler2::Archiv load(const ResolvedFile& file, const libsiedler2::ArchivItem_Palette* palette = nullptr) const;
+    /// Load multiple resolved files in parallel. The log messages are written in order after all files are loaded.
+    /// Throws a LoadError if any file failed to load.
+    std::vector<libsiedler2::Archiv> loadAll(const std::vector<ResolvedFile>& files,
+                                             const libsiedler2::ArchivItem_Palette* palette = nullptr) const;
     /// Load a file or directory. Throws a LoadError on error.
     libsiedler2::Archiv loadFileOrDir(const boost::filesystem::path& filePath,
                                       const libsiedler2::ArchivItem_Palette* palette = nullptr) const;
@@ -50,12 +56,18 @@ public:
     static void mergeArchives(libsiedler2::Archiv& targetArchiv, libsiedler2::Archiv& otherArchiv);
 
 private:
+    /// Write the message to the log or append it to the buffer if one is given
+    void log(std::string* logBuffer, const std::string& msg) const;
+    libsiedler2::Archiv load(const ResolvedFile& file, const libsiedler2::ArchivItem_Palette* palette,
+                             std::string* logBuffer) const;
+    libsiedler2::Archiv loadFileOrDir(const boost::filesystem::path& filePath,
+                                      const libsiedler2::ArchivItem_Palette* palette, std::string* logBuffer) const;
     /// Load a single file, logs a message without trailing newline on start and throws a LoadError on error.
     libsiedler2::Archiv loadFile(const boost::filesystem::path& filePath,
-                                 const libsiedler2::ArchivItem_Palette* palette) const;
+                                 const libsiedler2::ArchivItem_Palette* palette, std::string* logBuffer) const;
     /// Load a single file, logs a message without trailing newline on start and throws a LoadError on error.
     libsiedler2::Archiv loadDirectory(const boost::filesystem::path& filePath,
-                                      const libsiedler2::ArchivItem_Palette* palette) const;
+                                      const libsiedler2::ArchivItem_Palette* palette, std::string* logBuffer) const;
 
     Log& logger_;
 };
@@ -32,6 +32,7 @@
 #include "notifications/PlayerNodeNote.h"
 #include "pathfinding/FreePathFinder.h"
 #include "pathfinding/RoadPathFinder.h"
+#include "pathfinding/ThreadPathFinders.h"
 #include "nodeObjs/noFlag.h"
 #include "gameData/BuildingProperties.h"
 #include "gameData/GameConsts.h"
@@ -40,7 +41,7 @@
 
 GameWorldBase::GameWorldBase(std::vector<GamePlayer> players, const GlobalGameSettings& gameSettings, EventManager& em)
     : roadPathFinder(new RoadPathFinder(*this)), freePathFinder(new FreePathFinder(*this)), players(std::move(players)),
-      gameSettings(gameSettings), em(em), gi(nullptr)
+      gameSettings(gameSettings), em(em), visibilityBatchPlayer(0), visibilityBatchDepth(0), gi(nullptr)
 {}
 
 GameWorldBase::~GameWorldBase() = default;
@@ -50,6 +51,19 @@ void GameWorldBase::Init(const MapExtent& mapSize, DescIdx<LandscapeDesc> lt)
     RTTR_Assert(GetDescription().terrain.size() > 0); // Must have game data initialized
     World::Init(mapSize, lt);
     freePathFinder->Init(mapSize);
+    roadPathFinder->Init(GetNumPlayers());
+}
+
+RoadPathFinder& GameWorldBase::GetRoadPathFinder() const
+{
+    ThreadPathFinders* threadPathFinders = ThreadPathFinders::GetCurrent();
+    return threadPathFinders ? threadPathFinders->GetRoadPathFinder() : *roadPathFinder;
+}
+
+FreePathFinder& GameWorldBase::GetFreePathFinder() const
+{
+    ThreadPathFinders* threadPathFinders = ThreadPathFinders::GetCurrent();
+    return threadPathFinders ? threadPathFinders->GetFreePathFinder() : *freePathFinder;
 }
 
 void GameWorldBase::InitAfterLoad()
@@ -224,6 +238,12 @@ sortedMilitaryBlds GameWorldBase::LookForMilitaryBuildings(const MapPoint pt, un
     return militarySquares.GetBuildingsInRange(pt, radius);
 }
 
+void GameWorldBase::LookForMilitaryBuildings(const MapPoint pt, unsigned short radius,
+                                             sortedMilitaryBlds& result) const
+{
+    militarySquares.GetBuildingsInRange(pt, radius, result);
+}
+
 noFlag* GameWorldBase::GetRoadFlag(MapPoint pt, Direction& dir, const helpers::OptionalEnum<Direction> prevDir)
 {
     // Getting a flag is const
@@ -267,9 +287,29 @@ Position GameWorldBase::GetNodePos(const MapPoint pt) const
     return ::GetNodePos(pt, GetNode(pt).altitude);
 }
 
+void GameWorldBase::BeginVisibilityBatch(const unsigned player)
+{
+    if(visibilityBatchDepth++ == 0)
+        visibilityBatchPlayer = player;
+}
+
+void GameWorldBase::EndVisibilityBatch()
+{
+    RTTR_Assert(visibilityBatchDepth > 0);
+    if(--visibilityBatchDepth > 0 || visibilityBatch.empty())
+        return;
+    // Clear the batch before publishing in case a subscriber changes the visibility again
+    std::vector<MapPoint> pts;
+    std::swap(pts, visibilityBatch);
+    GetNotifications().publish(PlayerNodesNote(PlayerNodesNote::Visibility, std::move(pts), visibilityBatchPlayer));
+}
+
 void GameWorldBase::VisibilityChanged(const MapPoint pt, unsigned player, Visibility /*oldVis*/, Visibility /*newVis*/)
 {
-    GetNotifications().publish(PlayerNodeNote(PlayerNodeNote::Visibility, pt, player));
+    if(visibilityBatchDepth > 0 && player == visibilityBatchPlayer)
+        visibilityBatch.push_back(pt);
+    else
+        GetNotifications().publish(PlayerNodeNote(PlayerNodeNote::Visibility, pt, player));
 }
 
 /// Verändert die Höhe eines Punktes und die damit verbundenen Schatten
@@ -297,8 +337,7 @@ void GameWorldBase::RecalcBQAroundPointBig(const MapPoint pt)
 
 Visibility GameWorldBase::CalcVisiblityWithAllies(const MapPoint pt, const unsigned char player) const
 {
-    const MapNode& node = GetNode(pt);
-    Visibility best_visibility = node.fow[player].visibility;
+    Visibility best_visibility = GetFoWNode(pt, player).visibility;
 
     if(best_visibility == Visibility::Visible)
         return best_visibility;
@@ -312,8 +351,9 @@ Visibility GameWorldBase::CalcVisiblityWithAllies(const MapPoint pt, const unsig
         {
             if(i != player && curPlayer.IsAlly(i))
             {
-                if(node.fow[i].visibility > best_visibility)
-                    best_visibility = node.fow[i].visibility;
+                const Visibility allyVisibility = GetFoWNode(pt, i).visibility;
+                if(allyVisibility > best_visibility)
+                    best_visibility = allyVisibility;
             }
         }
     }
@@ -429,7 +469,7 @@ bool GameWorldBase::IsAHarborInSeaAttackDistance(const MapPoint pos) const
     {
         if(CalcDistance(pos, GetHarborPoint(i)) < SEAATTACK_DISTANCE)
         {
-            if(FindHumanPath(pos, GetHarborPoint(i), SEAATTACK_DISTANCE))
+            if(DoesHumanPathExist(pos, GetHarborPoint(i), SEAATTACK_DISTANCE))
                 return true;
         }
     }
@@ -483,7 +523,7 @@ std::vector<unsigned> GameWorldBase::GetUsableTargetHarborsForAttack(const MapPo
 
             // Can figures reach flag from coast
             const MapPoint coastalPt = GetCoastalPoint(curHbId, seaId);
-            if((flagPt == coastalPt) || FindHumanPath(flagPt, coastalPt, SEAATTACK_DISTANCE))
+            if((flagPt == coastalPt) || DoesHumanPathExist(flagPt, coastalPt, SEAATTACK_DISTANCE))
             {
                 use_seas.at(seaId - 1) = true;
                 if(!harborinlist)
@@ -546,7 +586,7 @@ std::vector<unsigned short> GameWorldBase::GetFilteredSeaIDsForAttack(const MapP
 
             // Can figures reach flag from coast
             MapPoint coastalPt = GetCoastalPoint(curHbId, seaId);
-            if((flagPt == coastalPt) || FindHumanPath(flagPt, coastalPt, SEAATTACK_DISTANCE))
+            if((flagPt == coastalPt) || DoesHumanPathExist(flagPt, coastalPt, SEAATTACK_DISTANCE))
             {
                 confirmedSeaIds.push_back(seaId);
                 // all sea ids confirmed? return without changes
@@ -571,7 +611,7 @@ std::vector<unsigned> GameWorldBase::GetHarborPointsAroundMilitaryBuilding(const
         if(CalcDistance(harborPt, pt) <= SEAATTACK_DISTANCE)
         {
             // Wird ein Weg vom Militärgebäude zum Hafen gefunden bzw. Ziel = Hafen?
-            if(pt == harborPt || FindHumanPath(pt, harborPt, SEAATTACK_DISTANCE))
+            if(pt == harborPt || DoesHumanPathExist(pt, harborPt, SEAATTACK_DISTANCE))
                 harbor_points.push_back(i);
         }
     }
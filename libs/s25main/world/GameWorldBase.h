@@ -68,6 +68,11 @@ class GameWorldBase : public World
     std::vector<GamePlayer> players;
     const GlobalGameSettings& gameSettings;
     EventManager& em;
+    /// Points whose visibility changed for visibilityBatchPlayer since BeginVisibilityBatch
+    std::vector<MapPoint> visibilityBatch;
+    unsigned visibilityBatchPlayer;
+    /// Number of active (nested) visibility batches
+    unsigned visibilityBatchDepth;
 
 public:
     std::unique_ptr<EconomyModeHandler> econHandler;
@@ -113,19 +118,25 @@ public:
     /// Erstellt eine Liste mit allen Milit�rgeb�uden in der Umgebung, radius bestimmt wie viele K�stchen nach einer
     /// Richtung im Umkreis
     sortedMilitaryBlds LookForMilitaryBuildings(MapPoint pt, unsigned short radius) const;
+    /// Same as above but reuses the memory of result (e.g. in loops)
+    void LookForMilitaryBuildings(MapPoint pt, unsigned short radius, sortedMilitaryBlds& result) const;
 
     /// Finds a path for figures. Returns first direction to walk in if found
     helpers::OptionalEnum<Direction> FindHumanPath(MapPoint start, MapPoint dest, unsigned max_route = 0xFFFFFFFF,
                                                    bool random_route = false, unsigned* length = nullptr,
                                                    std::vector<Direction>* route = nullptr) const;
+    /// Check if figures can walk from start to dest in at most maxLength steps. Optionally returns the path length
+    bool DoesHumanPathExist(MapPoint start, MapPoint dest, unsigned maxLength = 0xFFFFFFFF,
+                            unsigned* length = nullptr) const;
     /// Find path for ships to a specific harbor and see. Return true on success
     bool FindShipPathToHarbor(MapPoint start, unsigned harborId, unsigned seaId, std::vector<Direction>* route,
                               unsigned* length);
     /// Find path for ships with a limited distance. Return true on success
     bool FindShipPath(MapPoint start, MapPoint dest, unsigned maxDistance, std::vector<Direction>* route,
                       unsigned* length);
-    RoadPathFinder& GetRoadPathFinder() const { return *roadPathFinder; }
-    FreePathFinder& GetFreePathFinder() const { return *freePathFinder; }
+    /// Return the path finders to use. Those of the current thread if set, see ThreadPathFinders
+    RoadPathFinder& GetRoadPathFinder() const;
+    FreePathFinder& GetFreePathFinder() const;
 
     /// Return flag that is on road at given point. dir will be set to the direction of the road from the returned flag
     /// prevDir (if set) will be skipped when searching for the road points
@@ -222,6 +233,11 @@ public:
     void SetLua(std::unique_ptr<LuaInterfaceGame> newLua) { lua = std::move(newLua); }
 
 protected:
+    /// Collect the visibility changes of the player until EndVisibilityBatch instead of notifying about each point.
+    /// Batches may be nested, the player of the outermost one is used
+    void BeginVisibilityBatch(unsigned player);
+    /// Notify about all visibility changes collected since BeginVisibilityBatch at once
+    void EndVisibilityBatch();
     /// Called when the visibility of point changed for a player
     void VisibilityChanged(MapPoint pt, unsigned player, Visibility oldVis, Visibility newVis) override;
     /// Called, when the altitude of a point was changed
@@ -451,6 +451,8 @@ void GameWorldGame::RecalcTerritory(const noBaseBuilding& building, TerritoryCha
     // Notify
     for(const MapPoint& curMapPt : ptsWithChangedOwners)
         GetNotifications().publish(NodeNote(NodeNote::Owner, curMapPt));
+    if(GetGGS().isEnabled(AddonId::TRADE))
+        TradePathCache::inst().OnOwnersChanged(*this, ptsWithChangedOwners);
 
     for(const MapPoint& pt : ptsHandled)
     {
@@ -908,7 +910,7 @@ void GameWorldGame::StopOnRoads(const MapPoint pt, const helpers::OptionalEnum<D
     std::vector<noFigure*> figures;
 
     // Auch vom Ausgangspunkt aus, da sie im GameWorldGame wegem Zeichnen auch hier hängen können!
-    const std::list<noBase*>& fieldFigures = GetFigures(pt);
+    const FigureList& fieldFigures = GetFigures(pt);
     for(auto* fieldFigure : fieldFigures)
         if(fieldFigure->GetType() == NodalObjectType::Figure)
             figures.push_back(static_cast<noFigure*>(fieldFigure));
@@ -916,7 +918,7 @@ void GameWorldGame::StopOnRoads(const MapPoint pt, const helpers::OptionalEnum<D
     // Und natürlich in unmittelbarer Umgebung suchen
     for(Direction dir : helpers::EnumRange<Direction>{})
     {
-        const std::list<noBase*>& fieldFigures = GetFigures(GetNeighbour(pt, dir));
+        const FigureList& fieldFigures = GetFigures(GetNeighbour(pt, dir));
         for(auto* fieldFigure : fieldFigures)
             if(fieldFigure->GetType() == NodalObjectType::Figure)
                 figures.push_back(static_cast<noFigure*>(fieldFigure));
@@ -968,7 +970,7 @@ bool GameWorldGame::ValidWaitingAroundBuildingPoint(const MapPoint pt, nofAttack
         return false;
 
     // Objekte, die sich hier befinden durchgehen
-    const std::list<noBase*>& figures = GetFigures(pt);
+    const FigureList& figures = GetFigures(pt);
     for(auto* figure : figures)
     {
         // Ist hier ein anderer Soldat, der hier ebenfalls wartet?
@@ -986,7 +988,7 @@ bool GameWorldGame::ValidWaitingAroundBuildingPoint(const MapPoint pt, nofAttack
             return false;
     }
     // object wall or impassable terrain increasing my path to target length to a higher value than the direct distance?
-    return FindHumanPath(pt, center, CalcDistance(pt, center)) != boost::none;
+    return DoesHumanPathExist(pt, center, CalcDistance(pt, center));
 }
 
 bool GameWorldGame::ValidPointForFighting(const MapPoint pt, const bool avoid_military_building_flags,
@@ -1001,7 +1003,7 @@ bool GameWorldGame::ValidPointForFighting(const MapPoint pt, const bool avoid_mi
     }
 
     // Objekte, die sich hier befinden durchgehen
-    const std::list<noBase*>& figures = GetFigures(pt);
+    const FigureList& figures = GetFigures(pt);
     for(auto* figure : figures)
     {
         // Ist hier ein anderer Soldat, der hier ebenfalls wartet?
@@ -1091,6 +1093,72 @@ bool GameWorldGame::IsPointCompletelyVisible(const MapPoint& pt, unsigned char p
     return IsPointScoutedByShip(pt, player);
 }
 
+std::vector<bool> GameWorldGame::ArePointsCompletelyVisible(const std::vector<MapPoint>& pts, const MapPoint center,
+                                                             const unsigned radius, const unsigned char player,
+                                                             const noBaseBuilding* exception) const
+{
+    // Everything that can see points in the area with its position and visual range. Same checks as in
+    // IsPointCompletelyVisible but done only once for the whole area
+    struct VisionSource
+    {
+        MapPoint pos;
+        unsigned range;
+    };
+    std::vector<VisionSource> sources;
+    const auto addSource = [this, &sources, center, radius](const MapPoint pos, const unsigned range) {
+        if(CalcDistance(center, pos) <= radius + range)
+            sources.push_back(VisionSource{pos, range});
+    };
+
+    const unsigned short milRadius = 3 + (radius + MILITARY_SQUARE_SIZE - 1) / MILITARY_SQUARE_SIZE;
+    for(const nobBaseMilitary* milBld : LookForMilitaryBuildings(center, milRadius))
+    {
+        if(milBld->GetPlayer() != player || milBld == exception)
+            continue;
+        if(milBld->GetGOT() == GO_Type::NobMilitary && static_cast<const nobMilitary*>(milBld)->IsNewBuilt())
+            continue;
+        addSource(milBld->GetPos(), milBld->GetMilitaryRadius() + VISUALRANGE_MILITARY);
+    }
+
+    for(const noBuildingSite* bldSite : harbor_building_sites_from_sea)
+    {
+        if(bldSite->GetPlayer() == player && bldSite != exception)
+            addSource(bldSite->GetPos(), HARBOR_RADIUS + VISUALRANGE_MILITARY);
+    }
+
+    for(const nobUsual* bld : GetPlayer(player).GetBuildingRegister().GetBuildings(BuildingType::LookoutTower)) //-V807
+    {
+        if(bld->HasWorker() && bld != exception)
+            addSource(bld->GetPos(), VISUALRANGE_LOOKOUTTOWER);
+    }
+
+    // Scouts and soldiers can only see points within their visual range, so only the border around the area is
+    // relevant
+    for(const MapPoint& pt : GetPointsInRadiusWithCenter(center, radius + VISUALRANGE_SCOUT))
+    {
+        if(GetFigures(pt).empty())
+            continue;
+        if(IsScoutingFigureOnNode(pt, player, VISUALRANGE_SCOUT))
+            addSource(pt, VISUALRANGE_SCOUT);
+        else if(IsScoutingFigureOnNode(pt, player, VISUALRANGE_SOLDIER))
+            addSource(pt, VISUALRANGE_SOLDIER);
+    }
+
+    for(const noShip* ship : GetPlayer(player).GetShips())
+        addSource(ship->GetPos(), ship->GetVisualRange());
+
+    std::vector<bool> visible(pts.size(), false);
+    if(sources.empty())
+        return visible;
+    for(unsigned i = 0; i < pts.size(); ++i)
+    {
+        RTTR_Assert(CalcDistance(center, pts[i]) <= radius);
+        visible[i] = helpers::contains_if(
+          sources, [this, &pt = pts[i]](const VisionSource& src) { return CalcDistance(pt, src.pos) <= src.range; });
+    }
+    return visible;
+}
+
 bool GameWorldGame::IsScoutingFigureOnNode(const MapPoint& pt, unsigned player, unsigned distance) const
 {
     static_assert(VISUALRANGE_SCOUT >= VISUALRANGE_SOLDIER, "Visual range changed. Check loop below!");
@@ -1143,12 +1211,11 @@ bool GameWorldGame::IsPointScoutedByShip(const MapPoint& pt, unsigned player) co
 void GameWorldGame::RecalcVisibility(const MapPoint pt, const unsigned char player,
                                      const noBaseBuilding* const exception)
 {
-    /// Zustand davor merken
-    Visibility visibility_before = GetNode(pt).fow[player].visibility;
-
-    /// Herausfinden, ob vollständig sichtbar
-    bool visible = IsPointCompletelyVisible(pt, player, exception);
+    ApplyVisibility(pt, player, IsPointCompletelyVisible(pt, player, exception));
+}
 
+void GameWorldGame::ApplyVisibility(const MapPoint pt, const unsigned char player, const bool visible)
+{
     // Vollständig sichtbar --> vollständig sichtbar logischerweise
     if(visible)
         MakeVisible(pt, player);
@@ -1166,7 +1233,7 @@ void GameWorldGame::RecalcVisibility(const MapPoint pt, const unsigned char play
             case Exploration::FogOfWar:
             case Exploration::FogOfWarExplored:
                 // wenn es mal sichtbar war, nun im Nebel des Krieges
-                if(visibility_before == Visibility::Visible)
+                if(GetFoWNode(pt, player).visibility == Visibility::Visible)
                 {
                     SetVisibility(pt, player, Visibility::FogOfWar, GetEvMgr().GetCurrentGF());
                 }
@@ -1185,16 +1252,23 @@ void GameWorldGame::RecalcVisibilitiesAroundPoint(const MapPoint pt, const MapCo
                                                   const noBaseBuilding* const exception)
 {
     std::vector<MapPoint> pts = GetPointsInRadiusWithCenter(pt, radius);
-    for(const MapPoint& pt : pts)
-        RecalcVisibility(pt, player, exception);
+    // Determine the new visibility of the whole area first and only then apply it, so the observers get notified
+    // only once
+    const std::vector<bool> visible = ArePointsCompletelyVisible(pts, pt, radius, player, exception);
+    BeginVisibilityBatch(player);
+    for(unsigned i = 0; i < pts.size(); ++i)
+        ApplyVisibility(pts[i], player, visible[i]);
+    EndVisibilityBatch();
 }
 
 /// Setzt die Sichtbarkeiten um einen Punkt auf sichtbar (aus Performancegründen Alternative zu oberem)
 void GameWorldGame::MakeVisibleAroundPoint(const MapPoint pt, const MapCoord radius, const unsigned char player)
 {
     std::vector<MapPoint> pts = GetPointsInRadiusWithCenter(pt, radius);
+    BeginVisibilityBatch(player);
     for(const MapPoint& curPt : pts)
         MakeVisible(curPt, player);
+    EndVisibilityBatch();
 }
 
 /// Bestimmt bei der Bewegung eines spähenden Objekts die Sichtbarkeiten an
@@ -1218,7 +1292,7 @@ void GameWorldGame::RecalcMovingVisibilities(const MapPoint pt, const unsigned c
         // Sichtbarkeit und für FOW-Gebiet vorherigen Besitzer merken
         // (d.h. der dort  zuletzt war, als es für Spieler player sichtbar war)
         Visibility old_vis = CalcVisiblityWithAllies(tt, player);
-        unsigned char old_owner = GetNode(tt).fow[player].owner;
+        unsigned char old_owner = GetFoWNode(tt, player).owner;
         MakeVisible(tt, player);
         // Neues feindliches Gebiet entdeckt?
         // Muss vorher undaufgedeckt oder FOW gewesen sein, aber in dem Fall darf dort vorher noch kein
@@ -1242,7 +1316,7 @@ void GameWorldGame::RecalcMovingVisibilities(const MapPoint pt, const unsigned c
         // Sichtbarkeit und für FOW-Gebiet vorherigen Besitzer merken
         // (d.h. der dort  zuletzt war, als es für Spieler player sichtbar war)
         Visibility old_vis = CalcVisiblityWithAllies(tt, player);
-        unsigned char old_owner = GetNode(tt).fow[player].owner;
+        unsigned char old_owner = GetFoWNode(tt, player).owner;
         MakeVisible(tt, player);
         // Neues feindliches Gebiet entdeckt?
         // Muss vorher undaufgedeckt oder FOW gewesen sein, aber in dem Fall darf dort vorher noch kein
@@ -1411,6 +1485,11 @@ MapNode& GameWorldGame::GetNodeWriteable(const MapPoint pt)
     return GetNodeInt(pt);
 }
 
+FoWNode& GameWorldGame::GetFoWNodeWriteable(const MapPoint pt, unsigned player)
+{
+    return GetFoWNodeInt(pt, player);
+}
+
 void GameWorldGame::VisibilityChanged(const MapPoint pt, unsigned player, Visibility oldVis, Visibility newVis)
 {
     GameWorldBase::VisibilityChanged(pt, player, oldVis, newVis);
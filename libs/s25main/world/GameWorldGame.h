@@ -51,15 +51,17 @@ class GameWorldGame : public GameWorldBase
     bool HasRemovableObjForRoad(MapPoint pt) const;
 
     bool IsPointCompletelyVisible(const MapPoint& pt, unsigned char player, const noBaseBuilding* exception) const;
+    /// Same as IsPointCompletelyVisible for each of the points which must lie within radius around center.
+    /// The vision sources are gathered only once for the whole area
+    std::vector<bool> ArePointsCompletelyVisible(const std::vector<MapPoint>& pts, MapPoint center, unsigned radius,
+                                                 unsigned char player, const noBaseBuilding* exception) const;
     /// Return if there is a scout (or an attacking soldier) of this player at that node with a visual range of at most
     /// the given distance. Excludes scouting ships!
     bool IsScoutingFigureOnNode(const MapPoint& pt, unsigned player, unsigned distance) const;
     /// Return true, if the point is explored by any ship of the player
     bool IsPointScoutedByShip(const MapPoint& pt, unsigned player) const;
-    /// Berechnet die Sichtbarkeit eines Punktes neu für den angegebenen Spieler
-    /// exception ist ein Gebäude (Spähturm, Militärgebäude), was nicht mit in die Berechnung einbezogen
-    /// werden soll, z.b. weil es abgerissen wird
-    void RecalcVisibility(MapPoint pt, unsigned char player, const noBaseBuilding* exception);
+    /// Sets the visibility of a point after its (complete) visibility was determined
+    void ApplyVisibility(MapPoint pt, unsigned char player, bool visible);
     /// Setzt Punkt auf jeden Fall auf sichtbar
     void MakeVisible(MapPoint pt, unsigned char player);
 
@@ -148,6 +150,10 @@ public:
     /// Geeigneter Punkt für Kämpfe?
     bool ValidPointForFighting(MapPoint pt, bool avoid_military_building_flags, nofActiveSoldier* exception = nullptr);
 
+    /// Berechnet die Sichtbarkeit eines Punktes neu für den angegebenen Spieler
+    /// exception ist ein Gebäude (Spähturm, Militärgebäude), was nicht mit in die Berechnung einbezogen
+    /// werden soll, z.b. weil es abgerissen wird
+    void RecalcVisibility(MapPoint pt, unsigned char player, const noBaseBuilding* exception);
     /// Berechnet die Sichtbarkeiten neu um einen Punkt mit radius
     void RecalcVisibilitiesAroundPoint(MapPoint pt, MapCoord radius, unsigned char player,
                                        const noBaseBuilding* exception);
@@ -183,6 +189,8 @@ public:
 
     /// Writeable access to node. Use only for initial map setup!
     MapNode& GetNodeWriteable(MapPoint pt);
+    /// Writeable access to the FoW state of a player. Use only for initial map setup!
+    FoWNode& GetFoWNodeWriteable(MapPoint pt, unsigned player);
     /// Recalculates where border stones should be done after a change in the given region
     void RecalcBorderStones(Position startPt, Extent areaSize);
 
@@ -31,6 +31,7 @@
 #include "helpers/containerUtils.h"
 #include "helpers/toString.h"
 #include "ogl/FontStyle.h"
+#include "ogl/SpriteBatch.h"
 #include "ogl/glArchivItem_Bitmap.h"
 #include "ogl/glFont.h"
 #include "ogl/glSmartBitmap.h"
@@ -47,7 +48,8 @@
 
 GameWorldView::GameWorldView(const GameWorldViewer& gwv, const Position& pos, const Extent& size)
     : selPt(0, 0), show_bq(false), show_names(false), show_productivity(false), offset(0, 0), lastOffset(0, 0),
-      gwv(gwv), origin_(pos), size_(size), zoomFactor_(1.f), targetZoomFactor_(1.f), zoomSpeed_(0.f)
+      gwv(gwv), origin_(pos), size_(size), zoomFactor_(1.f), targetZoomFactor_(1.f), zoomSpeed_(0.f),
+      spriteBatch_(std::make_unique<SpriteBatch>())
 {
     MoveTo(0, 0);
 }
@@ -148,6 +150,8 @@ void GameWorldView::Draw(const RoadBuildState& rb, const MapPoint selected, bool
     terrainRenderer.Draw(GetFirstPt(), GetLastPt(), gwv, water);
     glTranslatef(static_cast<GLfloat>(offset.x), static_cast<GLfloat>(offset.y), 0.0f);
 
+    // All objects and figures are bitmaps so collect them and draw them grouped by texture
+    spriteBatch_->Begin();
     for(int y = firstPt.y; y <= lastPt.y; ++y)
     {
         // Figuren speichern, die in dieser Zeile gemalt werden müssen
@@ -189,14 +193,20 @@ void GameWorldView::Draw(const RoadBuildState& rb, const MapPoint selected, bool
                     fowobj->Draw(curPos);
             }
 
-            for(IDrawNodeCallback* callback : drawNodeCallbacks)
-                callback->onDraw(curPt, curPos);
+            if(!drawNodeCallbacks.empty())
+            {
+                // Callbacks may draw anything, so the sprites so far must be drawn before
+                spriteBatch_->Flush();
+                for(IDrawNodeCallback* callback : drawNodeCallbacks)
+                    callback->onDraw(curPt, curPos);
+            }
         }
 
         // Figuren zwischen den Zeilen zeichnen
         for(auto& between_line : between_lines)
             between_line.obj->Draw(between_line.pos);
     }
+    spriteBatch_->End();
 
     if(show_names || show_productivity)
         DrawNameProductivityOverlay(terrainRenderer);
@@ -430,7 +440,7 @@ void GameWorldView::DrawProductivity(const noBaseBuilding& no, const DrawPoint&
 void GameWorldView::DrawFigures(const MapPoint& pt, const DrawPoint& curPos,
                                 std::vector<ObjectBetweenLines>& between_lines) const
 {
-    const std::list<noBase*>& figures = GetWorld().GetFigures(pt);
+    const FigureList& figures = GetWorld().GetFigures(pt);
     for(noBase* figure : figures)
     {
         if(figure->IsMoving())
@@ -462,7 +472,7 @@ void GameWorldView::DrawMovingFiguresFromBelow(const TerrainRenderer& terrainRen
         MapPoint curPt = terrainRenderer.ConvertCoords(GetNeighbour(curPos, dir + 3u), &curOffset);
         Position figPos = GetWorld().GetNodePos(curPt) - offset + curOffset;
 
-        const std::list<noBase*>& figures = GetWorld().GetFigures(curPt);
+        const FigureList& figures = GetWorld().GetFigures(curPt);
         for(noBase* figure : figures)
         {
             if(figure->IsMoving() && static_cast<noMovable*>(figure)->GetCurMoveDir() == dir)
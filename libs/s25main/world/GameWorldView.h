@@ -20,6 +20,7 @@
 #include "DrawPoint.h"
 #include "gameTypes/MapCoordinates.h"
 #include "gameTypes/MapTypes.h"
+#include <memory>
 #include <vector>
 
 class GameWorldViewer;
@@ -27,6 +28,7 @@ class GameWorldBase;
 struct RoadBuildState;
 class TerrainRenderer;
 class noBaseBuilding;
+class SpriteBatch;
 
 class IDrawNodeCallback
 {
@@ -77,6 +79,9 @@ class GameWorldView
     float targetZoomFactor_;
     float zoomSpeed_;
 
+    /// Batch for the objects and figures on the map
+    std::unique_ptr<SpriteBatch> spriteBatch_;
+
 public:
     GameWorldView(const GameWorldViewer& gwv, const Position& pos, const Extent& size);
     ~GameWorldView();
@@ -102,6 +107,8 @@ public:
     void ToggleShowNamesAndProductivity();
 
     void Draw(const RoadBuildState& rb, MapPoint selected, bool drawMouse, unsigned* water = nullptr);
+    /// Batch used for the map objects, e.g. to get the draw call statistics of the last frame
+    const SpriteBatch& GetSpriteBatch() const { return *spriteBatch_; }
 
     /// Bewegt sich zu einer bestimmten Position in Pixeln auf der Karte
     void MoveTo(int x, int y, bool absolute = false);
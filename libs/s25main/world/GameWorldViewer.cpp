@@ -60,13 +60,17 @@ void GameWorldViewer::InitTerrainRenderer()
     // Notify renderer about altitude changes
     evAltitudeChanged = gwb.GetNotifications().subscribe<NodeNote>([this](const NodeNote& note) {
         if(note.type == NodeNote::Altitude)
-            tr.AltitudeChanged(note.pos, *this);
+            tr.AltitudeChanged(note.pos);
     });
     // And visibility changes
     evVisibilityChanged = gwb.GetNotifications().subscribe<PlayerNodeNote>([this](const PlayerNodeNote& note) {
         if(note.type == PlayerNodeNote::Visibility)
             VisibilityChanged(note.pt, note.player);
     });
+    evVisibilitiesChanged = gwb.GetNotifications().subscribe<PlayerNodesNote>([this](const PlayerNodesNote& note) {
+        if(note.type == PlayerNodesNote::Visibility)
+            VisibilitiesChanged(note.pts, note.player);
+    });
 }
 
 const GamePlayer& GameWorldViewer::GetPlayer() const
@@ -138,6 +142,11 @@ MapPoint GameWorldViewer::GetNeighbour(const MapPoint pt, const Direction dir) c
     return GetWorld().GetNeighbour(pt, dir);
 }
 
+void GameWorldViewer::ApplyTerrainChanges()
+{
+    tr.ApplyPendingChanges(*this);
+}
+
 void GameWorldViewer::RecalcAllColors()
 {
     tr.UpdateAllColors(*this);
@@ -207,7 +216,7 @@ const noShip* GameWorldViewer::GetShip(const MapPoint pt) const
     };
     const auto& world = GetWorld();
     auto checkPointForShips = [&world, checkShip](const MapPoint curPt, auto /*radius*/) {
-        const std::list<noBase*>& figures = world.GetFigures(curPt);
+        const FigureList& figures = world.GetFigures(curPt);
         for(const auto* figure : figures)
         {
             if(figure->GetGOT() == GO_Type::Ship && checkShip(static_cast<const noShip&>(*figure)))
@@ -242,7 +251,13 @@ void GameWorldViewer::VisibilityChanged(const MapPoint& pt, unsigned player)
 {
     // If visibility changed for us, or our team mate if shared view is on -> Update renderer
     if(player == playerId_ || (GetWorld().GetGGS().teamView && GetWorld().GetPlayer(playerId_).IsAlly(player)))
-        tr.VisibilityChanged(pt, *this);
+        tr.VisibilityChanged(pt);
+}
+
+void GameWorldViewer::VisibilitiesChanged(const std::vector<MapPoint>& pts, unsigned player)
+{
+    if(player == playerId_ || (GetWorld().GetGGS().teamView && GetWorld().GetPlayer(playerId_).IsAlly(player)))
+        tr.VisibilityChanged(pts);
 }
 
 void GameWorldViewer::RoadConstructionEnded(const RoadNote& note)
@@ -295,8 +310,7 @@ const FOWObject* GameWorldViewer::GetYoungestFOWObject(const MapPoint pos) const
 /// with the local player via team view
 const FoWNode& GameWorldViewer::GetYoungestFOWNode(const MapPoint pos) const
 {
-    const MapNode& node = GetWorld().GetNode(pos);
-    const FoWNode* bestNode = &node.fow[playerId_];
+    const FoWNode* bestNode = &GetWorld().GetFoWNode(pos, playerId_);
     unsigned youngest_time = bestNode->last_update_time;
 
     // Shared team view enabled?
@@ -309,7 +323,7 @@ const FoWNode& GameWorldViewer::GetYoungestFOWNode(const MapPoint pos) const
             if(!player.IsAlly(i))
                 continue;
             // Has the player FOW at this point at all?
-            const FoWNode* curNode = &node.fow[i];
+            const FoWNode* curNode = &GetWorld().GetFoWNode(pos, i);
             if(curNode->visibility == Visibility::FogOfWar)
             {
                 // Younger than the youngest or no object at all?
@@ -48,6 +48,8 @@ public:
     /// Return non-const world (TODO: Remove, this is a view only!)
     GameWorldBase& GetWorldNonConst() { return gwb; }
     const TerrainRenderer& GetTerrainRenderer() const { return tr; }
+    /// Update the terrain renderer with the changes of the world since the last call. Call before drawing a frame
+    void ApplyTerrainChanges();
     /// Get the player instance for this view
     const GamePlayer& GetPlayer() const;
     /// Get the ID of the views player
@@ -111,11 +113,12 @@ private:
     unsigned playerId_;
     GameWorldBase& gwb;
     TerrainRenderer tr;
-    Subscription evVisibilityChanged, evAltitudeChanged, evRoadConstruction, evBQChanged;
+    Subscription evVisibilityChanged, evVisibilitiesChanged, evAltitudeChanged, evRoadConstruction, evBQChanged;
     NodeMapBase<VisualMapNode> visualNodes;
 
     void InitVisualData();
     inline void VisibilityChanged(const MapPoint& pt, unsigned player);
+    inline void VisibilitiesChanged(const std::vector<MapPoint>& pts, unsigned player);
     inline void RoadConstructionEnded(const RoadNote& note);
     void RecalcBQ(const MapPoint& pt);
 };
@@ -0,0 +1,204 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "world/HarborRoutes.h"
+#include "RttrForeachPt.h"
+#include "helpers/EnumRange.h"
+#include "helpers/ThreadPool.h"
+#include "pathfinding/PathConditionShip.h"
+#include "world/World.h"
+#include <algorithm>
+#include <iterator>
+
+namespace {
+/// Buffers for the search from one coastal point, reused by each thread
+struct SearchState
+{
+    /// Index+1 of the start point for which the node was visited last
+    std::vector<unsigned> visitedFrom;
+    /// Direction in which the node was entered
+    std::vector<Direction> dirTo;
+    std::vector<MapPoint> todo;
+};
+} // namespace
+
+void HarborRoutes::Clear()
+{
+    coastalPts_.clear();
+    routes_.clear();
+    directions_.clear();
+}
+
+void HarborRoutes::Calculate(const World& world)
+{
+    Clear();
+    for(unsigned harborId = 1; harborId <= world.GetNumHarborPoints(); harborId++)
+    {
+        for(unsigned short seaId = 1; seaId <= world.GetNumSeas(); seaId++)
+        {
+            const MapPoint coastPt = world.GetCoastalPoint(harborId, seaId);
+            if(coastPt.isValid())
+                coastalPts_.push_back(coastPt);
+        }
+    }
+    std::sort(coastalPts_.begin(), coastalPts_.end(), MapPointLess());
+    coastalPts_.erase(std::unique(coastalPts_.begin(), coastalPts_.end()), coastalPts_.end());
+    const auto numPts = static_cast<unsigned>(coastalPts_.size());
+    if(numPts < 2u)
+        return;
+
+    const PathConditionShip shipPathChecker(world);
+    // pre-calculate sea-points, as IsSeaPoint is rather expensive
+    std::vector<bool> ptIsSeaPt(prodOfComponents(world.GetSize()));
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        if(shipPathChecker.IsNodeOk(pt))
+            ptIsSeaPt[world.GetIdx(pt)] = true;
+    }
+
+    // Breadth-first search from each coastal point to all the following ones.
+    // Like the path finder only sea points are used on the way, but the goal may be any point
+    std::vector<std::vector<Route>> routesFrom(numPts - 1u);
+    std::vector<std::vector<Direction>> directionsFrom(numPts - 1u);
+    const auto searchFrom = [&](unsigned startIdx, SearchState& state) {
+        if(state.visitedFrom.empty())
+        {
+            state.visitedFrom.resize(ptIsSeaPt.size(), 0u);
+            state.dirTo.resize(ptIsSeaPt.size());
+        }
+        const unsigned visitMark = startIdx + 1u;
+        const MapPoint startPt = coastalPts_[startIdx];
+        state.visitedFrom[world.GetIdx(startPt)] = visitMark;
+        state.todo.clear();
+        state.todo.push_back(startPt);
+        for(unsigned i = 0; i < state.todo.size(); i++)
+        {
+            const MapPoint curPt = state.todo[i];
+            for(const auto dir : helpers::EnumRange<Direction>{})
+            {
+                const MapPoint nbPt = world.GetNeighbour(curPt, dir);
+                const unsigned nbIdx = world.GetIdx(nbPt);
+                if(state.visitedFrom[nbIdx] == visitMark || !shipPathChecker.IsEdgeOk(curPt, dir))
+                    continue;
+                state.visitedFrom[nbIdx] = visitMark;
+                state.dirTo[nbIdx] = dir;
+                if(ptIsSeaPt[nbIdx])
+                    state.todo.push_back(nbPt);
+            }
+        }
+
+        std::vector<Route>& routes = routesFrom[startIdx];
+        std::vector<Direction>& directions = directionsFrom[startIdx];
+        for(unsigned destIdx = startIdx + 1u; destIdx < numPts; destIdx++)
+        {
+            MapPoint curPt = coastalPts_[destIdx];
+            if(state.visitedFrom[world.GetIdx(curPt)] != visitMark)
+            {
+                routes.push_back(Route{0, NO_ROUTE});
+                continue;
+            }
+            const auto offset = static_cast<unsigned>(directions.size());
+            // Walk back to the start and reverse the directions
+            while(curPt != startPt)
+            {
+                const Direction dir = state.dirTo[world.GetIdx(curPt)];
+                directions.push_back(dir);
+                curPt = world.GetNeighbour(curPt, dir + 3u);
+            }
+            std::reverse(directions.begin() + offset, directions.end());
+            routes.push_back(Route{offset, static_cast<unsigned>(directions.size()) - offset});
+        }
+    };
+
+    helpers::ThreadPool threadPool;
+    std::vector<SearchState> states(threadPool.getNumThreads());
+    threadPool.run(numPts - 1u,
+                   [&](unsigned startIdx, unsigned threadIdx) { searchFrom(startIdx, states[threadIdx]); });
+
+    // Merge in a fixed order, so the result does not depend on the threads
+    routes_.reserve(numPts * (numPts - 1u) / 2u);
+    for(unsigned startIdx = 0; startIdx + 1u < numPts; startIdx++)
+    {
+        const auto offset = static_cast<unsigned>(directions_.size());
+        for(Route route : routesFrom[startIdx])
+        {
+            if(route.length != NO_ROUTE)
+                route.offset += offset;
+            routes_.push_back(route);
+        }
+        directions_.insert(directions_.end(), directionsFrom[startIdx].begin(), directionsFrom[startIdx].end());
+    }
+}
+
+unsigned HarborRoutes::GetPtIdx(const MapPoint pt) const
+{
+    const auto it = std::lower_bound(coastalPts_.begin(), coastalPts_.end(), pt, MapPointLess());
+    if(it == coastalPts_.end() || *it != pt)
+        return static_cast<unsigned>(coastalPts_.size());
+    return static_cast<unsigned>(it - coastalPts_.begin());
+}
+
+unsigned HarborRoutes::GetRouteIdx(unsigned startIdx, unsigned destIdx) const
+{
+    RTTR_Assert(startIdx < destIdx);
+    const auto numPts = static_cast<unsigned>(coastalPts_.size());
+    // Rows of the triangular matrix have numPts - 1, numPts - 2, ... entries
+    return startIdx * (2u * numPts - startIdx - 1u) / 2u + (destIdx - startIdx - 1u);
+}
+
+bool HarborRoutes::HasRoutesFrom(const MapPoint pt) const
+{
+    return GetPtIdx(pt) < coastalPts_.size();
+}
+
+bool HarborRoutes::FindRoute(const MapPoint start, const MapPoint dest, unsigned maxLength,
+                             std::vector<Direction>* route, unsigned* length) const
+{
+    const unsigned startIdx = GetPtIdx(start);
+    const unsigned destIdx = GetPtIdx(dest);
+    if(startIdx >= coastalPts_.size() || destIdx >= coastalPts_.size())
+        return false;
+    if(startIdx == destIdx)
+    {
+        if(route)
+            route->clear();
+        if(length)
+            *length = 0;
+        return true;
+    }
+    const Route& storedRoute = routes_[GetRouteIdx(std::min(startIdx, destIdx), std::max(startIdx, destIdx))];
+    if(storedRoute.length == NO_ROUTE || storedRoute.length > maxLength)
+        return false;
+    if(length)
+        *length = storedRoute.length;
+    if(route)
+    {
+        const auto itStart = directions_.begin() + storedRoute.offset;
+        const auto itEnd = itStart + storedRoute.length;
+        if(startIdx < destIdx)
+            route->assign(itStart, itEnd);
+        else
+        {
+            // Go backwards in the opposite directions
+            route->clear();
+            route->reserve(storedRoute.length);
+            std::transform(std::make_reverse_iterator(itEnd), std::make_reverse_iterator(itStart),
+                           std::back_inserter(*route), [](Direction dir) { return dir + 3u; });
+        }
+    }
+    return true;
+}
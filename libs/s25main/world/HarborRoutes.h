@@ -0,0 +1,63 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "gameTypes/Direction.h"
+#include "gameTypes/MapCoordinates.h"
+#include <vector>
+
+class World;
+
+/// Shortest ship routes between the coastal points of all harbors, calculated once when the harbors are set up.
+/// The routes follow the same rules as the path finding for ships (PathConditionShip), so ships starting at a coastal
+/// point can use them instead of searching. As a reversed route is a valid route too, only one direction is stored
+/// and the directions of all routes are kept consecutively.
+class HarborRoutes
+{
+public:
+    /// Calculate the routes between all coastal points of the world. The searches are distributed to multiple threads
+    void Calculate(const World& world);
+    void Clear();
+
+    /// Return true if routes from the point are known, i.e. it is a coastal point of a harbor
+    bool HasRoutesFrom(MapPoint pt) const;
+    /// Get the route between 2 coastal points if it exists and is at most maxLength long. Returns true on success
+    bool FindRoute(MapPoint start, MapPoint dest, unsigned maxLength, std::vector<Direction>* route,
+                   unsigned* length) const;
+
+private:
+    struct Route
+    {
+        /// Index of the first direction in directions_
+        unsigned offset;
+        /// Number of directions, NO_ROUTE if the points are not connected
+        unsigned length;
+    };
+    static constexpr unsigned NO_ROUTE = 0xFFFFFFFF;
+
+    /// Index of the point in coastalPts_ or coastalPts_.size() if not found
+    unsigned GetPtIdx(MapPoint pt) const;
+    /// Index of the route between the coastal points with the given indices (startIdx < destIdx) in routes_
+    unsigned GetRouteIdx(unsigned startIdx, unsigned destIdx) const;
+
+    /// All coastal points, sorted by their index in the world
+    std::vector<MapPoint> coastalPts_;
+    /// Routes between all pairs of coastal points (triangular matrix)
+    std::vector<Route> routes_;
+    std::vector<Direction> directions_;
+};
@@ -66,6 +66,8 @@ bool MapLoader::Load(const glArchivItem_Map& map, Exploration exploration)
         return false;
     PlaceObjects(map);
     PlaceAnimals(map);
+    // Objects were placed directly
+    world_.stateHash = world_.CalcStateHash();
     if(!InitSeasAndHarbors(world_))
         return false;
 
@@ -98,7 +100,7 @@ void MapLoader::SetMapExplored(World& world)
         for(unsigned i = 0; i < MAX_PLAYERS; ++i)
         {
             // If we have FoW here, save it
-            if(world.GetNode(pt).fow[i].visibility == Visibility::FogOfWar)
+            if(world.GetFoWNode(pt, i).visibility == Visibility::FogOfWar)
                 world.SaveFOWNode(pt, i, 0);
         }
     }
@@ -174,8 +176,9 @@ bool MapLoader::InitNodes(const glArchivItem_Map& map, Exploration exploration)
         }
 
         // FOW-Zeug initialisieren
-        for(auto& fow : node.fow)
+        for(unsigned player = 0; player < MAX_PLAYERS; player++)
         {
+            FoWNode& fow = world_.GetFoWNodeInt(pt, player);
             fow.last_update_time = 0;
             fow.visibility = fowVisibility;
             fow.object = nullptr;
@@ -185,7 +188,7 @@ bool MapLoader::InitNodes(const glArchivItem_Map& map, Exploration exploration)
         }
 
         node.obj = nullptr; // Will be overwritten later...
-        RTTR_Assert(node.figures.empty());
+        RTTR_Assert(world_.GetFigures(pt).empty());
     }
     return true;
 }
@@ -488,6 +491,8 @@ bool MapLoader::InitSeasAndHarbors(World& world, const std::vector<MapPoint>& ad
             }
         }
     }
+
+    world.harborRoutes.Calculate(world);
     return true;
 }
 
@@ -33,9 +33,13 @@ void MapSerializer::Serialize(const World& world, const unsigned numPlayers, Ser
     sgd.PushUnsignedInt(GameObject::GetObjIDCounter());
 
     // Alle Weltpunkte serialisieren
-    for(const auto& node : world.nodes)
+    RTTR_Assert(numPlayers <= world.fowNodes.size());
+    std::vector<const FoWNode*> fow(numPlayers);
+    for(unsigned idx = 0; idx < world.nodes.size(); idx++)
     {
-        node.Serialize(sgd, numPlayers, world.GetDescription());
+        for(unsigned player = 0; player < numPlayers; player++)
+            fow[player] = &world.fowNodes[player][idx];
+        world.nodes[idx].Serialize(sgd, world.GetDescription(), fow, world.figures[idx]);
     }
 
     // Katapultsteine serialisieren
@@ -108,10 +112,15 @@ void MapSerializer::Deserialize(World& world, const unsigned numPlayers, Seriali
         }
     }
     // Alle Weltpunkte
+    RTTR_Assert(numPlayers <= world.fowNodes.size());
+    std::vector<FoWNode*> fow(numPlayers);
     MapPoint curPos(0, 0);
-    for(auto& node : world.nodes)
+    for(unsigned idx = 0; idx < world.nodes.size(); idx++)
     {
-        node.Deserialize(sgd, numPlayers, world.GetDescription(), landscapeTerrains);
+        for(unsigned player = 0; player < numPlayers; player++)
+            fow[player] = &world.fowNodes[player][idx];
+        MapNode& node = world.nodes[idx];
+        node.Deserialize(sgd, world.GetDescription(), landscapeTerrains, fow, world.figures[idx]);
         if(node.harborId)
         {
             HarborPos p(curPos);
@@ -124,6 +133,7 @@ void MapSerializer::Deserialize(World& world, const unsigned numPlayers, Seriali
             curPos.y++;
         }
     }
+    world.stateHash = world.CalcStateHash();
 
     // Katapultsteine deserialisieren
     sgd.PopObjectContainer(world.catapult_stones, GO_Type::Catapultstone);
@@ -159,4 +169,6 @@ void MapSerializer::Deserialize(World& world, const unsigned numPlayers, Seriali
             }
         }
     }
+    // Derived from the terrain and harbors, so not stored
+    world.harborRoutes.Calculate(world);
 }
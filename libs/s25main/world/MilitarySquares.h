@@ -17,9 +17,8 @@
 
 #pragma once
 
+#include "world/SpatialIndex.h"
 #include "gameTypes/MapCoordinates.h"
-#include <list>
-#include <vector>
 
 class nobBaseMilitary;
 class sortedMilitaryBlds;
@@ -27,10 +26,7 @@ class sortedMilitaryBlds;
 class MilitarySquares
 {
     /// military buildings (including HQs and harbors) per military square
-    std::vector<std::list<nobBaseMilitary*>> squares;
-    MapExtent size_;
-    // Liefert das entsprechende Militärquadrat für einen bestimmten Punkt auf der Karte zurück (normale Koordinaten)
-    std::list<nobBaseMilitary*>& GetSquare(MapPoint pt);
+    SpatialIndex<nobBaseMilitary> index_;
 
 public:
     MilitarySquares();
@@ -38,5 +34,8 @@ public:
     void Clear();
     void Add(nobBaseMilitary* bld);
     void Remove(nobBaseMilitary* bld);
+    /// Return the buildings in the military squares up to radius squares around pt
     sortedMilitaryBlds GetBuildingsInRange(MapPoint pt, unsigned short radius) const;
+    /// Same as above but reuses the memory of result
+    void GetBuildingsInRange(MapPoint pt, unsigned short radius, sortedMilitaryBlds& result) const;
 };
@@ -0,0 +1,119 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "helpers/containerUtils.h"
+#include "gameTypes/MapCoordinates.h"
+#include <algorithm>
+#include <vector>
+
+/// Index of objects on the map by their position to quickly find the objects close to a point.
+/// The map is divided into square cells of cellSize x cellSize nodes, each storing the objects in it contiguously.
+/// The wrap-around of the map is handled by the queries.
+template<class T>
+class SpatialIndex
+{
+public:
+    explicit SpatialIndex(unsigned short cellSize) : cellSize_(cellSize), size_(MapExtent::all(0)) {}
+
+    void Init(const MapExtent& mapSize);
+    void Clear();
+    bool IsInitialized() const { return !cells_.empty(); }
+
+    void Add(T* obj, MapPoint pos) { GetCell(pos).push_back(obj); }
+    void Remove(T* obj, MapPoint pos);
+
+    /// Call func(T*) for all objects in the cells up to cellRadius cells around the cell of pt.
+    /// Each object is passed exactly once, even if the radius exceeds the map size
+    template<class T_Func>
+    void ForEachInRange(MapPoint pt, unsigned cellRadius, T_Func&& func) const;
+    /// Append all objects in the cells up to cellRadius cells around the cell of pt to result
+    template<class T_Container>
+    void GetInRange(MapPoint pt, unsigned cellRadius, T_Container& result) const
+    {
+        ForEachInRange(pt, cellRadius, [&result](T* obj) { result.push_back(obj); });
+    }
+
+    unsigned short GetCellSize() const { return cellSize_; }
+    /// Return the number of cells in x and y direction
+    MapExtent GetNumCells() const { return size_; }
+
+private:
+    const unsigned short cellSize_;
+    /// Size in cells
+    MapExtent size_;
+    std::vector<std::vector<T*>> cells_;
+
+    std::vector<T*>& GetCell(MapPoint pt)
+    {
+        const MapPoint cellPt = pt / cellSize_;
+        return cells_[cellPt.y * size_.x + cellPt.x];
+    }
+};
+
+template<class T>
+void SpatialIndex<T>::Init(const MapExtent& mapSize)
+{
+    RTTR_Assert(!IsInitialized());                // Already initialized
+    RTTR_Assert(mapSize.x > 0 && mapSize.y > 0); // No empty map
+    // Calculate size (rounding up)
+    size_ = (mapSize + MapExtent::all(cellSize_ - 1)) / cellSize_;
+    cells_.resize(size_.x * size_.y);
+}
+
+template<class T>
+void SpatialIndex<T>::Clear()
+{
+    cells_.clear();
+    size_ = MapExtent::all(0);
+}
+
+template<class T>
+void SpatialIndex<T>::Remove(T* obj, MapPoint pos)
+{
+    std::vector<T*>& cell = GetCell(pos);
+    const auto it = helpers::find(cell, obj);
+    RTTR_Assert(it != cell.end());
+    cell.erase(it);
+}
+
+template<class T>
+template<class T_Func>
+void SpatialIndex<T>::ForEachInRange(const MapPoint pt, unsigned cellRadius, T_Func&& func) const
+{
+    // Visit each cell at most once: Clamp the number of cells per dimension to the number of cells of the map
+    const unsigned numCellsX = std::min<unsigned>(cellRadius * 2 + 1, size_.x);
+    const unsigned numCellsY = std::min<unsigned>(cellRadius * 2 + 1, size_.y);
+    const MapPoint cellPt = pt / cellSize_;
+    // Start left/above of the cell, wrapped into the map (size_ is added to avoid negative values)
+    const unsigned firstX = (cellPt.x + size_.x - std::min<unsigned>(cellRadius, size_.x - 1)) % size_.x;
+    unsigned y = (cellPt.y + size_.y - std::min<unsigned>(cellRadius, size_.y - 1)) % size_.y;
+    for(unsigned i = 0; i < numCellsY; ++i)
+    {
+        unsigned x = firstX;
+        for(unsigned j = 0; j < numCellsX; ++j)
+        {
+            for(T* obj : cells_[y * size_.x + x])
+                func(obj);
+            if(++x == size_.x)
+                x = 0;
+        }
+        if(++y == size_.y)
+            y = 0;
+    }
+}
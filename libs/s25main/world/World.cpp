@@ -23,6 +23,7 @@
 #endif
 #include "FOWObjects.h"
 #include "RoadSegment.h"
+#include "RttrForeachPt.h"
 #include "enum_cast.hpp"
 #include "helpers/containerUtils.h"
 #include "gameTypes/ShipDirection.h"
@@ -31,6 +32,20 @@
 #include <set>
 #include <stdexcept>
 
+namespace {
+unsigned getObjHash(const noBase* obj)
+{
+    return obj ? obj->GetObjId() : 0u;
+}
+unsigned getRoadsHash(const MapNode& node)
+{
+    unsigned result = 0;
+    for(const PointRoad road : node.roads)
+        result = (result << 8u) | rttr::enum_cast(road);
+    return result;
+}
+} // namespace
+
 World::World() : noNodeObj(nullptr) {}
 
 World::~World()
@@ -77,17 +92,16 @@ void World::Unload()
     for(auto& node : nodes)
     {
         deletePtr(node.obj);
-
-        for(auto& z : node.fow)
-        {
-            deletePtr(z.object);
-        }
+    }
+    for(auto& playerFoWNodes : fowNodes)
+    {
+        for(auto& fowNode : playerFoWNodes)
+            deletePtr(fowNode.object);
     }
 
     // Figuren vernichten
-    for(auto& node : nodes)
+    for(auto& nodeFigures : figures)
     {
-        std::list<noBase*>& nodeFigures = node.figures;
         for(auto& nodeFigure : nodeFigures)
             delete nodeFigure;
 
@@ -96,6 +110,7 @@ void World::Unload()
 
     catapult_stones.clear();
     harbor_pos.clear();
+    harborRoutes.Clear();
     noNodeObj.reset();
     Resize(MapExtent::all(0));
 }
@@ -104,10 +119,18 @@ void World::Resize(const MapExtent& newSize)
 {
     MapBase::Resize(newSize);
     nodes.clear();
+    for(auto& playerFoWNodes : fowNodes)
+        playerFoWNodes.clear();
+    figures.clear();
     militarySquares.Clear();
+    stateHash.Init(GetSize());
     if(GetSize().x > 0)
     {
-        nodes.resize(prodOfComponents(GetSize()));
+        const unsigned numNodes = prodOfComponents(GetSize());
+        nodes.resize(numNodes);
+        for(auto& playerFoWNodes : fowNodes)
+            playerFoWNodes.resize(numNodes);
+        figures.resize(numNodes);
         militarySquares.Init(GetSize());
     }
 }
@@ -117,23 +140,23 @@ void World::AddFigure(const MapPoint pt, noBase* fig)
     if(!fig)
         return;
 
-    std::list<noBase*>& figures = GetNodeInt(pt).figures;
-    RTTR_Assert(!helpers::contains(figures, fig));
-    figures.push_back(fig);
+    FigureList& nodeFigures = figures[GetIdx(pt)];
+    RTTR_Assert(!helpers::contains(nodeFigures, fig));
+    nodeFigures.push_back(fig);
 
 #if RTTR_ENABLE_ASSERTS
     for(const auto dir : helpers::EnumRange<Direction>{})
     {
         MapPoint nb = GetNeighbour(pt, dir);
-        RTTR_Assert(!helpers::contains(GetNode(nb).figures, fig)); // Added figure that is in surrounding?
+        RTTR_Assert(!helpers::contains(GetFigures(nb), fig)); // Added figure that is in surrounding?
     }
 #endif
 }
 
 void World::RemoveFigure(const MapPoint pt, noBase* fig)
 {
-    RTTR_Assert(helpers::contains(GetNode(pt).figures, fig));
-    GetNodeInt(pt).figures.remove(fig);
+    RTTR_Assert(helpers::contains(GetFigures(pt), fig));
+    figures[GetIdx(pt)].remove(fig);
 }
 
 noBase* World::GetNO(const MapPoint pt)
@@ -158,7 +181,9 @@ void World::SetNO(const MapPoint pt, noBase* obj, const bool replace /* = false*
 #if RTTR_ENABLE_ASSERTS
     RTTR_Assert(!dynamic_cast<noMovable*>(obj)); // It should be a static, non-movable object
 #endif
-    GetNodeInt(pt).obj = obj;
+    MapNode& node = GetNodeInt(pt);
+    stateHash.Update(pt, WorldStateHash::Field::Object, getObjHash(node.obj), getObjHash(obj));
+    node.obj = obj;
 }
 
 void World::DestroyNO(const MapPoint pt, const bool checkExists /* = true*/)
@@ -168,6 +193,7 @@ void World::DestroyNO(const MapPoint pt, const bool checkExists /* = true*/)
     {
         // Destroy may remove the NO already from the map or replace it (e.g. building -> fire)
         // So remove from map, then destroy and free
+        stateHash.Update(pt, WorldStateHash::Field::Object, getObjHash(obj), 0u);
         GetNodeInt(pt).obj = nullptr;
         obj->Destroy();
         deletePtr(obj);
@@ -185,6 +211,13 @@ GO_Type World::GetGOT(const MapPoint pt) const
         return GO_Type::Nothing;
 }
 
+void World::SetOwner(const MapPoint pt, const unsigned char newOwner)
+{
+    MapNode& node = GetNodeInt(pt);
+    stateHash.Update(pt, WorldStateHash::Field::Owner, node.owner, newOwner);
+    node.owner = newOwner;
+}
+
 void World::ReduceResource(const MapPoint pt)
 {
     uint8_t curAmount = GetNodeInt(pt).resources.getAmount();
@@ -200,7 +233,7 @@ void World::SetReserved(const MapPoint pt, const bool reserved)
 
 void World::SetVisibility(const MapPoint pt, unsigned char player, Visibility vis, unsigned fowTime)
 {
-    FoWNode& node = GetNodeInt(pt).fow[player];
+    FoWNode& node = GetFoWNodeInt(pt, player);
     Visibility oldVis = node.visibility;
     if(oldVis == vis)
         return;
@@ -288,7 +321,7 @@ DescIdx<TerrainDesc> World::GetLeftTerrain(const MapPoint pt, Direction dir) con
 
 void World::SaveFOWNode(const MapPoint pt, const unsigned player, unsigned curTime)
 {
-    FoWNode& fow = GetNodeInt(pt).fow[player];
+    FoWNode& fow = GetFoWNodeInt(pt, player);
     fow.last_update_time = curTime;
 
     // FOW-Objekt erzeugen
@@ -365,7 +398,7 @@ PointRoad World::GetPointRoad(MapPoint pt, Direction dir) const
 PointRoad World::GetPointFOWRoad(MapPoint pt, Direction dir, const unsigned char viewing_player) const
 {
     const RoadDir rDir = toRoadDir(pt, dir);
-    return GetNode(pt).fow[viewing_player].roads[rDir];
+    return GetFoWNode(pt, viewing_player).roads[rDir];
 }
 
 void World::AddCatapultStone(CatapultStone* cs)
@@ -438,7 +471,24 @@ unsigned short World::GetSeaFromCoastalPoint(const MapPoint pt) const
 
 void World::SetRoad(const MapPoint pt, RoadDir roadDir, PointRoad type)
 {
-    GetNodeInt(pt).roads[roadDir] = type;
+    MapNode& node = GetNodeInt(pt);
+    const unsigned oldRoadsHash = getRoadsHash(node);
+    node.roads[roadDir] = type;
+    stateHash.Update(pt, WorldStateHash::Field::Roads, oldRoadsHash, getRoadsHash(node));
+}
+
+WorldStateHash World::CalcStateHash() const
+{
+    WorldStateHash result;
+    result.Init(GetSize());
+    RTTR_FOREACH_PT(MapPoint, GetSize())
+    {
+        const MapNode& node = GetNode(pt);
+        result.Update(pt, WorldStateHash::Field::Owner, 0u, node.owner);
+        result.Update(pt, WorldStateHash::Field::Object, 0u, getObjHash(node.obj));
+        result.Update(pt, WorldStateHash::Field::Roads, 0u, getRoadsHash(node));
+    }
+    return result;
 }
 
 bool World::SetBQ(const MapPoint pt, BuildingQuality bq)
@@ -466,9 +516,9 @@ void World::RecalcShadow(const MapPoint pt)
 
 void World::MakeWholeMapVisibleForAllPlayers()
 {
-    for(auto& mapNode : nodes)
+    for(auto& playerFoWNodes : fowNodes)
     {
-        for(auto& fowNode : mapNode.fow)
+        for(auto& fowNode : playerFoWNodes)
         {
             fowNode.visibility = Visibility::Visible;
             deletePtr(fowNode.object);
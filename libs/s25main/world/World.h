@@ -18,16 +18,22 @@
 #pragma once
 
 #include "enum_cast.hpp"
+#include "world/HarborRoutes.h"
 #include "world/MapBase.h"
 #include "world/MilitarySquares.h"
+#include "world/WorldStateHash.h"
 #include "gameTypes/Direction.h"
+#include "gameTypes/FigureList.h"
+#include "gameTypes/FoWNode.h"
 #include "gameTypes/GO_Type.h"
 #include "gameTypes/HarborPos.h"
 #include "gameTypes/MapCoordinates.h"
 #include "gameTypes/MapNode.h"
 #include "gameTypes/MapTypes.h"
 #include "gameData/DescIdx.h"
+#include "gameData/MaxPlayers.h"
 #include "gameData/WorldDescription.h"
+#include <array>
 #include <list>
 #include <memory>
 #include <vector>
@@ -58,15 +64,23 @@ class World : public MapBase
 
     /// Eigenschaften von einem Punkt auf der Map
     std::vector<MapNode> nodes;
+    /// How the players see the map (one plane per player)
+    std::array<std::vector<FoWNode>, MAX_PLAYERS> fowNodes;
+    /// Figures or fights on each node
+    std::vector<FigureList> figures;
 
     std::vector<Sea> seas;
 
     /// Alle Hafenpositionen
     std::vector<HarborPos> harbor_pos;
+    /// Precalculated ship routes between the harbors
+    HarborRoutes harborRoutes;
 
     WorldDescription description_;
 
     std::unique_ptr<noBase> noNodeObj;
+    /// Hash of the node states, kept up to date by the setters
+    WorldStateHash stateHash;
     void Resize(const MapExtent& newSize) override final;
 
 public:
@@ -92,6 +106,8 @@ public:
     const MapNode& GetNode(MapPoint pt) const;
     /// Return the neighboring node
     const MapNode& GetNeighbourNode(MapPoint pt, Direction dir) const;
+    /// Return how the player sees the point in FoW
+    const FoWNode& GetFoWNode(MapPoint pt, unsigned player) const;
 
     void AddFigure(MapPoint pt, noBase* fig);
     void RemoveFigure(MapPoint pt, noBase* fig);
@@ -109,7 +125,7 @@ public:
     GO_Type GetGOT(MapPoint pt) const;
     void ReduceResource(MapPoint pt);
     void SetResource(const MapPoint pt, Resource newResource) { GetNodeInt(pt).resources = newResource; }
-    void SetOwner(const MapPoint pt, unsigned char newOwner) { GetNodeInt(pt).owner = newOwner; }
+    void SetOwner(MapPoint pt, unsigned char newOwner);
     void SetReserved(MapPoint pt, bool reserved);
     /// Sets the visibility and fires a Visibility Changed event if different
     /// fowTime is only used if visibility gets changed to FoW
@@ -130,7 +146,7 @@ public:
     BuildingQuality AdjustBQ(MapPoint pt, unsigned char player, BuildingQuality nodeBQ) const;
 
     /// Return the figures currently on the node
-    const std::list<noBase*>& GetFigures(const MapPoint pt) const { return GetNode(pt).figures; }
+    const FigureList& GetFigures(const MapPoint pt) const { return figures[GetIdx(pt)]; }
 
     /// Return a specific object or nullptr
     template<typename T>
@@ -180,6 +196,8 @@ public:
     const std::vector<HarborPos::Neighbor>& GetHarborNeighbors(unsigned harborId, const ShipDirection& dir) const;
     /// Berechnet die Entfernung zwischen 2 Hafenpunkten
     unsigned CalcHarborDistance(unsigned habor_id1, unsigned harborId2) const;
+    /// Return the precalculated ship routes between the coastal points of the harbors
+    const HarborRoutes& GetHarborRoutes() const { return harborRoutes; }
     /// Return the sea id if this is a point at a coast to a sea where ships can go. Else returns 0
     unsigned short GetSeaFromCoastalPoint(MapPoint pt) const;
 
@@ -214,6 +232,11 @@ public:
     /// Return the FOW road type for a player
     PointRoad GetPointFOWRoad(MapPoint pt, Direction dir, unsigned char viewing_player) const;
 
+    /// Return the incrementally updated hash of the world state
+    const WorldStateHash& GetStateHash() const { return stateHash; }
+    /// Calculate the hash of the world state from scratch
+    WorldStateHash CalcStateHash() const;
+
     /// Adds a catapult stone currently flying
     void AddCatapultStone(CatapultStone* cs);
     void RemoveCatapultStone(CatapultStone* cs);
@@ -222,6 +245,7 @@ protected:
     /// Internal method for access to nodes with write access
     MapNode& GetNodeInt(MapPoint pt);
     MapNode& GetNeighbourNodeInt(MapPoint pt, Direction dir);
+    FoWNode& GetFoWNodeInt(MapPoint pt, unsigned player);
 
     /// Notify derived classes of changed altitude
     virtual void AltitudeChanged(MapPoint pt) = 0;
@@ -261,6 +285,16 @@ inline MapNode& World::GetNeighbourNodeInt(const MapPoint pt, Direction dir)
     return GetNodeInt(GetNeighbour(pt, dir));
 }
 
+inline const FoWNode& World::GetFoWNode(const MapPoint pt, unsigned player) const
+{
+    return fowNodes[player][GetIdx(pt)];
+}
+
+inline FoWNode& World::GetFoWNodeInt(const MapPoint pt, unsigned player)
+{
+    return fowNodes[player][GetIdx(pt)];
+}
+
 template<class T_Predicate>
 inline bool World::IsOfTerrain(const MapPoint pt, T_Predicate predicate) const
 {
@@ -0,0 +1,35 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "world/WorldStateHash.h"
+
+constexpr unsigned WorldStateHash::REGION_SIZE;
+
+void WorldStateHash::Init(const MapExtent& mapSize)
+{
+    numRegions = (Extent(mapSize) + Extent::all(REGION_SIZE - 1u)) / REGION_SIZE;
+    regionHashes.clear();
+    regionHashes.resize(numRegions.x * numRegions.y, 0u);
+}
+
+unsigned WorldStateHash::GetHash() const
+{
+    unsigned hash = 0;
+    for(const unsigned regionHash : regionHashes)
+        hash = Combine(hash, regionHash);
+    return hash;
+}
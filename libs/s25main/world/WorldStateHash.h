@@ -0,0 +1,88 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "gameTypes/MapCoordinates.h"
+#include <cstdint>
+#include <vector>
+
+/// Hash over the relevant state of the map nodes (owner, objects and roads).
+/// It is updated whenever such a value changes so it never needs to scan the whole map.
+/// The map is split into square regions with one hash each, so a difference between 2 clients can be narrowed down.
+class WorldStateHash
+{
+public:
+    /// Width and height of a region in nodes
+    static constexpr unsigned REGION_SIZE = 16;
+
+    enum class Field : uint8_t
+    {
+        Owner,
+        Object,
+        Roads
+    };
+
+    /// Reset to the hash of an empty map with the given size
+    void Init(const MapExtent& mapSize);
+    /// Set the value of the field at the given point from oldValue to newValue. A value of 0 is "nothing".
+    void Update(MapPoint pt, Field field, unsigned oldValue, unsigned newValue)
+    {
+        if(oldValue != newValue)
+        {
+            const unsigned key = GetKey(pt, field);
+            regionHashes[GetRegionIdx(pt)] ^= CalcEntryHash(key, oldValue) ^ CalcEntryHash(key, newValue);
+        }
+    }
+
+    /// Return the combined hash of all regions
+    unsigned GetHash() const;
+    const std::vector<unsigned>& GetRegionHashes() const { return regionHashes; }
+    /// Number of regions in x and y direction
+    const Extent& GetNumRegions() const { return numRegions; }
+    unsigned GetRegionIdx(MapPoint pt) const { return (pt.y / REGION_SIZE) * numRegions.x + pt.x / REGION_SIZE; }
+
+    /// Hash for a (key, value) pair which can be combined with others by XOR. Value 0 has a hash of 0
+    static unsigned CalcEntryHash(unsigned key, unsigned value)
+    {
+        return value ? mix(mix(key) + value) : 0u;
+    }
+    /// Combine 2 hashes (order dependent)
+    static unsigned Combine(unsigned hash, unsigned value) { return mix(hash ^ mix(value)); }
+
+    bool operator==(const WorldStateHash& rhs) const { return regionHashes == rhs.regionHashes; }
+    bool operator!=(const WorldStateHash& rhs) const { return !(*this == rhs); }
+
+private:
+    std::vector<unsigned> regionHashes;
+    Extent numRegions;
+
+    static unsigned GetKey(MapPoint pt, Field field)
+    {
+        return ((static_cast<unsigned>(pt.y) << 16) | pt.x) ^ (static_cast<unsigned>(field) << 30);
+    }
+    /// Finalizer of MurmurHash3
+    static unsigned mix(unsigned h)
+    {
+        h ^= h >> 16;
+        h *= 0x85ebca6bu;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35u;
+        h ^= h >> 16;
+        return h;
+    }
+};
@@ -0,0 +1,211 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "HeadlessGame.h"
+#include "EventManager.h"
+#include "Game.h"
+#include "GameInterface.h"
+#include "GamePlayer.h"
+#include "PlayerInfo.h"
+#include "Savegame.h"
+#include "ai/AIPlayer.h"
+#include "commonDefines.h"
+#include "factories/AIFactory.h"
+#include "helpers/format.hpp"
+#include "ogl/glArchivItem_Map.h"
+#include "random/Random.h"
+#include "world/GameWorld.h"
+#include "gameData/GameConsts.h"
+#include "libsiedler2/ArchivItem_Map_Header.h"
+#include "libsiedler2/prototypen.h"
+#include "s25util/Log.h"
+#include "s25util/colors.h"
+#include "s25util/strAlgos.h"
+#include <boost/filesystem/operations.hpp>
+#include <stdexcept>
+
+namespace {
+/// GameInterface which ignores everything as there is no GUI
+class HeadlessGameInterface : public GameInterface
+{
+public:
+    void GI_PlayerDefeated(unsigned playerId) override { LOG.write("Player %1% was defeated\n") % playerId; }
+    void GI_UpdateMinimap(MapPoint) override {}
+    void GI_FlagDestroyed(MapPoint) override {}
+    void GI_TreatyOfAllianceChanged(unsigned) override {}
+    void GI_Winner(unsigned playerId) override { LOG.write("Player %1% has won\n") % playerId; }
+    void GI_TeamWinner(unsigned playerMask) override { LOG.write("Team %1% has won\n") % playerMask; }
+    void GI_WindowClosed(Window*) override {}
+    void GI_StartRoadBuilding(MapPoint, bool) override {}
+    void GI_CancelRoadBuilding() override {}
+    void GI_BuildRoad() override {}
+};
+
+using Clock = std::chrono::steady_clock;
+} // namespace
+
+HeadlessGame::HeadlessGame(const boost::filesystem::path& mapOrSavePath, unsigned numAIs, AI::Level aiLevel,
+                           unsigned seed, unsigned nwfLength)
+    : gameInterface_(std::make_unique<HeadlessGameInterface>()), nwfLength_(nwfLength), numAIs_(0)
+{
+    if(nwfLength_ == 0u)
+        throw std::runtime_error("NWF length must not be 0");
+    if(!exists(mapOrSavePath))
+        throw std::runtime_error("File " + mapOrSavePath.string() + " does not exist");
+
+    RANDOM.Init(seed);
+    const bool isSavegame = s25util::toLower(mapOrSavePath.extension().string()) == ".sav";
+    if(isSavegame)
+        LoadSavegame(mapOrSavePath, numAIs, aiLevel);
+    else
+        LoadMap(mapOrSavePath, numAIs, aiLevel);
+
+    GameWorld& world = game_->world_;
+    world.SetGameInterface(gameInterface_.get());
+    world.InitAfterLoad();
+    game_->Start(isSavegame);
+    pendingCmds_.resize(game_->aiPlayers_.size());
+}
+
+HeadlessGame::~HeadlessGame()
+{
+    if(game_)
+        game_->world_.SetGameInterface(nullptr);
+}
+
+void HeadlessGame::LoadMap(const boost::filesystem::path& mapPath, unsigned numAIs, AI::Level aiLevel)
+{
+    libsiedler2::Archiv mapHeader;
+    if(libsiedler2::loader::LoadMAP(mapPath, mapHeader, true) != 0)
+        throw std::runtime_error("Could not load map header of " + mapPath.string());
+    const unsigned numPlayers =
+      checkedCast<const glArchivItem_Map*>(mapHeader.get(0))->getHeader().getNumPlayers();
+    if(numAIs == 0u || numAIs > numPlayers)
+    {
+        throw std::runtime_error("Invalid number of AIs: " + std::to_string(numAIs) + ". Map supports "
+                                 + std::to_string(numPlayers) + " players");
+    }
+
+    std::vector<PlayerInfo> players(numPlayers);
+    for(unsigned i = 0; i < numAIs; i++)
+    {
+        PlayerInfo& player = players[i];
+        player.ps = PlayerState::AI;
+        player.aiInfo = AI::Info(AI::Type::Default, aiLevel);
+        player.name = "AI " + std::to_string(i);
+        player.nation = Nation(i % NUM_NATIVE_NATIONS);
+        player.color = PLAYER_COLORS[i % PLAYER_COLORS.size()];
+        player.team = Team::None;
+    }
+    game_ = std::make_shared<Game>(GlobalGameSettings(), 0u, players);
+    GameWorld& world = game_->world_;
+    for(unsigned i = 0; i < world.GetNumPlayers(); ++i)
+        world.GetPlayer(i).MakeStartPacts();
+    if(!world.LoadMap(game_, *this, mapPath, boost::filesystem::path(mapPath).replace_extension("lua")))
+        throw std::runtime_error("Could not load map " + mapPath.string());
+    world.PlaceAndFixWater();
+
+    for(unsigned i = 0; i < numAIs; i++)
+        game_->AddAIPlayer(AIFactory::Create(players[i].aiInfo, i, world));
+    numAIs_ = numAIs;
+}
+
+void HeadlessGame::LoadSavegame(const boost::filesystem::path& savePath, unsigned numAIs, AI::Level aiLevel)
+{
+    Savegame save;
+    if(!save.Load(savePath, SaveGameDataToLoad::All))
+        throw std::runtime_error("Could not load savegame " + savePath.string() + ": " + save.GetLastErrorMsg());
+
+    std::vector<PlayerInfo> players;
+    for(unsigned i = 0; i < save.GetNumPlayers(); i++)
+        players.emplace_back(save.GetPlayer(i));
+    game_ = std::make_shared<Game>(save.ggs, save.start_gf, players);
+    save.sgd.ReadSnapshot(game_, *this);
+
+    // Let AIs take over the first numAIs used slots (human or AI)
+    for(unsigned i = 0; i < players.size() && numAIs_ < numAIs; i++)
+    {
+        if(!players[i].isUsed())
+            continue;
+        game_->AddAIPlayer(AIFactory::Create(AI::Info(AI::Type::Default, aiLevel), i, game_->world_));
+        ++numAIs_;
+    }
+    if(numAIs_ == 0u)
+        throw std::runtime_error("Savegame does not contain any used player slots");
+}
+
+unsigned HeadlessGame::GetCurrentGF() const
+{
+    return game_->em_->GetCurrentGF();
+}
+
+void HeadlessGame::RunGF()
+{
+    const unsigned curGF = GetCurrentGF();
+    const bool isNWF = curGF % nwfLength_ == 0u;
+    if(isNWF)
+    {
+        const auto startTime = Clock::now();
+        for(unsigned i = 0; i < pendingCmds_.size(); i++)
+        {
+            const unsigned playerId = game_->aiPlayers_[i].GetPlayerId();
+            for(const gc::GameCommandPtr& gc : pendingCmds_[i])
+                gc->Execute(game_->world_, playerId);
+            pendingCmds_[i].clear();
+        }
+        times_.gameCommands += Clock::now() - startTime;
+    }
+    {
+        const auto startTime = Clock::now();
+        game_->RunAIs(curGF, isNWF);
+        // There is nobody to read the chat
+        for(AIPlayer& ai : game_->aiPlayers_)
+            ai.FetchChatMessages();
+        times_.ai += Clock::now() - startTime;
+    }
+    {
+        const auto startTime = Clock::now();
+        game_->RunGF();
+        times_.simulation += Clock::now() - startTime;
+    }
+    // Commands are sent at the NWF and executed at the next one
+    if(isNWF)
+    {
+        for(unsigned i = 0; i < pendingCmds_.size(); i++)
+            pendingCmds_[i] = game_->aiPlayers_[i].FetchGameCommands();
+    }
+}
+
+std::string HeadlessGame::FormatGFTime(unsigned numGFs) const
+{
+    using seconds = std::chrono::duration<uint32_t, std::chrono::seconds::period>;
+    using hours = std::chrono::duration<uint32_t, std::chrono::hours::period>;
+    using minutes = std::chrono::duration<uint32_t, std::chrono::minutes::period>;
+    using std::chrono::duration_cast;
+
+    seconds numSeconds = duration_cast<seconds>(numGFs * SPEED_GF_LENGTHS[referenceSpeed]);
+    const hours numHours = duration_cast<hours>(numSeconds);
+    numSeconds -= numHours;
+    const minutes numMinutes = duration_cast<minutes>(numSeconds);
+    numSeconds -= numMinutes;
+    return helpers::format("%u:%02u:%02u", numHours.count(), numMinutes.count(), numSeconds.count());
+}
+
+void HeadlessGame::SystemChat(const std::string& text)
+{
+    LOG.write("%1%\n") % text;
+}
@@ -0,0 +1,77 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "GameCommand.h"
+#include "ILocalGameState.h"
+#include "gameTypes/AIInfo.h"
+#include <boost/filesystem/path.hpp>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+class Game;
+class GameInterface;
+
+/// Runs a game without GUI, sound or network.
+/// Commands of the AI players are executed at the next network frame, just like they would be when sent over the network
+class HeadlessGame : public ILocalGameState
+{
+public:
+    using Duration = std::chrono::duration<double>;
+    /// Time spent in the different parts of a GF
+    struct SubsystemTimes
+    {
+        Duration simulation{0};
+        Duration ai{0};
+        Duration gameCommands{0};
+    };
+
+    /// Load the map (*.swd, *.wld) or savegame (*.sav).
+    /// The first numAIs players are controlled by an AI of the given level, others are not used (maps) or idle (saves)
+    /// Throws a std::runtime_error on failure
+    HeadlessGame(const boost::filesystem::path& mapOrSavePath, unsigned numAIs, AI::Level aiLevel, unsigned seed,
+                 unsigned nwfLength = 10);
+    ~HeadlessGame();
+
+    /// Run a single GF including the AIs
+    void RunGF();
+    unsigned GetCurrentGF() const;
+    const Game& GetGame() const { return *game_; }
+    Game& GetGame() { return *game_; }
+    const SubsystemTimes& GetTimes() const { return times_; }
+    unsigned GetNumAIs() const { return numAIs_; }
+
+    unsigned GetPlayerId() const override { return 0; }
+    bool IsHost() const override { return true; }
+    std::string FormatGFTime(unsigned numGFs) const override;
+    void SystemChat(const std::string& text) override;
+
+private:
+    std::shared_ptr<Game> game_;
+    std::unique_ptr<GameInterface> gameInterface_;
+    const unsigned nwfLength_;
+    unsigned numAIs_;
+    /// Commands of each AI which will be executed at the next NWF
+    std::vector<std::vector<gc::GameCommandPtr>> pendingCmds_;
+    SubsystemTimes times_;
+
+    void LoadMap(const boost::filesystem::path& mapPath, unsigned numAIs, AI::Level aiLevel);
+    void LoadSavegame(const boost::filesystem::path& savePath, unsigned numAIs, AI::Level aiLevel);
+};
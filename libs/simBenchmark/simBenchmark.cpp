@@ -0,0 +1,253 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "EventManager.h"
+#include "Game.h"
+#include "GameObject.h"
+#include "GamePlayer.h"
+#include "HeadlessGame.h"
+#include "RTTR_Version.h"
+#include "RttrConfig.h"
+#include "StatisticTimeSeries.h"
+#include "helpers/EnumRange.h"
+#include "helpers/format.hpp"
+#include "lua/LuaInterfaceGame.h"
+#include "ogl/glAllocator.h"
+#include "world/GameWorld.h"
+#include "libsiedler2/libsiedler2.h"
+#include "s25util/LocaleHelper.h"
+#include "s25util/strAlgos.h"
+#include <boost/filesystem/path.hpp>
+#include <boost/nowide/args.hpp>
+#include <boost/nowide/fstream.hpp>
+#include <boost/nowide/iostream.hpp>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iostream>
+#ifdef _WIN32
+#    include <windows.h>
+#    include <psapi.h>
+#else
+#    include <sys/resource.h>
+#endif
+
+// Runs a game with AI players only and without GUI, sound or network for a number of GFs
+// and reports the simulation speed as JSON. Optionally exports the statistics of all players as CSV
+
+namespace po = boost::program_options;
+namespace bnw = boost::nowide;
+
+namespace {
+/// Return the peak resident set size of this process in KiB (0 if unknown)
+uint64_t getPeakRSS()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS info;
+    if(!GetProcessMemoryInfo(GetCurrentProcess(), &info, sizeof(info)))
+        return 0;
+    return info.PeakWorkingSetSize / 1024u;
+#else
+    rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#    ifdef __APPLE__
+    return static_cast<uint64_t>(usage.ru_maxrss) / 1024u; // Bytes
+#    else
+    return static_cast<uint64_t>(usage.ru_maxrss); // KiB
+#    endif
+#endif
+}
+
+AI::Level parseAILevel(const std::string& level)
+{
+    const std::string lvl = s25util::toLower(level);
+    if(lvl == "easy")
+        return AI::Level::Easy;
+    if(lvl == "medium")
+        return AI::Level::Medium;
+    if(lvl == "hard")
+        return AI::Level::Hard;
+    throw std::runtime_error("Invalid AI level: " + level);
+}
+
+std::string escapeJSON(const std::string& str)
+{
+    std::string result;
+    for(const char c : str)
+    {
+        if(c == '"' || c == '\\')
+            result += '\\';
+        result += c;
+    }
+    return result;
+}
+
+/// Write the statistic values of all used players for every statistic step
+void writeStatistics(const Game& game, const std::string& filePath)
+{
+    bnw::ofstream file(filePath);
+    StatisticTimeSeries::WriteCSVHeader(file, "player,");
+    for(unsigned i = 0; i < game.world_.GetNumPlayers(); i++)
+    {
+        const GamePlayer& player = game.world_.GetPlayer(i);
+        if(player.isUsed())
+            player.GetStatisticTimeSeries().WriteCSV(file, std::to_string(i) + ",");
+    }
+    if(!file)
+        throw std::runtime_error("Could not write to " + filePath);
+}
+
+/// Return the number of calls and time spent in each Lua callback called by the map script as JSON object
+std::string getLuaCallbackStats(const Game& game)
+{
+    std::string result;
+    if(game.world_.HasLua())
+    {
+        for(const auto callback : helpers::EnumRange<LuaCallback>{})
+        {
+            const LuaCallbackStats& stats = game.world_.GetLua().GetCallbackStats(callback);
+            if(stats.numCalls == 0)
+                continue;
+            if(!result.empty())
+                result += ",\n";
+            result += helpers::format("    \"%1%\": {\"calls\": %2%, \"time\": %3$.3f}",
+                                      LuaInterfaceGame::GetCallbackName(callback), stats.numCalls,
+                                      std::chrono::duration<double>(stats.time).count());
+        }
+    }
+    return "{" + (result.empty() ? "" : "\n" + result + "\n  ") + "}";
+}
+
+int runBenchmark(const po::variables_map& options)
+{
+    const boost::filesystem::path mapPath = options["map"].as<std::string>();
+    const unsigned numGFs = options["gfs"].as<unsigned>();
+
+    using Clock = std::chrono::steady_clock;
+    const auto loadStart = Clock::now();
+    HeadlessGame game(mapPath, options["ais"].as<unsigned>(), parseAILevel(options["ai-level"].as<std::string>()),
+                      options["seed"].as<unsigned>(), options["nwf-length"].as<unsigned>());
+    game.GetGame().SetNumAIThreads(options["ai-threads"].as<unsigned>());
+    const std::chrono::duration<double> loadTime = Clock::now() - loadStart;
+
+    const unsigned startGF = game.GetCurrentGF();
+    const auto runStart = Clock::now();
+    for(unsigned i = 0; i < numGFs && !game.GetGame().IsGameFinished(); i++)
+        game.RunGF();
+    const std::chrono::duration<double> runTime = Clock::now() - runStart;
+    const unsigned numGFsRun = game.GetCurrentGF() - startGF;
+
+    const HeadlessGame::SubsystemTimes& times = game.GetTimes();
+    const std::string result = helpers::format(
+      "{\n"
+      "  \"version\": \"%1%\",\n"
+      "  \"map\": \"%2%\",\n"
+      "  \"numAIs\": %3%,\n"
+      "  \"seed\": %4%,\n"
+      "  \"startGF\": %5%,\n"
+      "  \"numGFs\": %6%,\n"
+      "  \"loadTime\": %7$.3f,\n"
+      "  \"runTime\": %8$.3f,\n"
+      "  \"gfPerSecond\": %9$.1f,\n"
+      "  \"peakRSSKiB\": %10%,\n"
+      "  \"subsystems\": {\n"
+      "    \"simulation\": %11$.3f,\n"
+      "    \"ai\": %12$.3f,\n"
+      "    \"gameCommands\": %13$.3f\n"
+      "  },\n"
+      "  \"luaCallbacks\": %14%,\n"
+      "  \"numObjects\": %15%,\n"
+      "  \"numEvents\": %16%\n"
+      "}\n",
+      escapeJSON(RTTR_Version::GetReadableVersion()), escapeJSON(mapPath.generic_string()), game.GetNumAIs(),
+      options["seed"].as<unsigned>(), startGF, numGFsRun, loadTime.count(), runTime.count(),
+      runTime.count() > 0 ? numGFsRun / runTime.count() : 0., getPeakRSS(), times.simulation.count(),
+      times.ai.count(), times.gameCommands.count(), getLuaCallbackStats(game.GetGame()), GameObject::GetNumObjs(),
+      game.GetGame().em_->GetNumActiveEvents());
+
+    if(options.count("output"))
+    {
+        bnw::ofstream file(options["output"].as<std::string>());
+        if(!(file << result))
+            throw std::runtime_error("Could not write to " + options["output"].as<std::string>());
+    } else
+        bnw::cout << result;
+    if(options.count("statistics-csv"))
+        writeStatistics(game.GetGame(), options["statistics-csv"].as<std::string>());
+    return 0;
+}
+} // namespace
+
+// NOLINTNEXTLINE(bugprone-exception-escape)
+int main(int argc, char** argv)
+{
+    bnw::args _(argc, argv);
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help,h", "Show help")
+        ("map,m", po::value<std::string>(), "Map (*.swd, *.wld) or savegame (*.sav) to load")
+        ("ais,n", po::value<unsigned>()->default_value(2), "Number of AI players")
+        ("ai-level", po::value<std::string>()->default_value("hard"), "AI level (easy, medium, hard)")
+        ("gfs,g", po::value<unsigned>()->default_value(10000), "Number of GFs to run")
+        ("seed", po::value<unsigned>()->default_value(42), "Seed for the random number generator")
+        ("nwf-length", po::value<unsigned>()->default_value(10), "Number of GFs per network frame")
+        ("ai-threads", po::value<unsigned>()->default_value(0), "Number of threads to run the AIs on (0 = sequential)")
+        ("output,o", po::value<std::string>(), "Write the JSON result to this file instead of stdout")
+        ("statistics-csv", po::value<std::string>(), "Write the statistics of all players to this CSV file")
+        ;
+    // clang-format on
+    po::positional_options_description positionalOptions;
+    positionalOptions.add("map", 1);
+
+    po::variables_map options;
+    try
+    {
+        po::store(po::command_line_parser(argc, argv).options(desc).positional(positionalOptions).run(), options);
+        po::notify(options);
+    } catch(const std::exception& e)
+    {
+        bnw::cerr << "Error: " << e.what() << "\n\n";
+        bnw::cerr << desc << "\n";
+        return 1;
+    }
+
+    if(options.count("help") || !options.count("map"))
+    {
+        bnw::cout << desc << "\n";
+        return options.count("help") ? 0 : 1;
+    }
+
+    if(!LocaleHelper::init())
+        return 1;
+    if(!RTTRCONFIG.Init())
+        return 1;
+    libsiedler2::setAllocator(new GlAllocator());
+
+    int result;
+    try
+    {
+        result = runBenchmark(options);
+    } catch(const std::exception& e)
+    {
+        bnw::cerr << "Error: " << e.what() << "\n";
+        result = 1;
+    }
+    libsiedler2::setAllocator(nullptr);
+    return result;
+}
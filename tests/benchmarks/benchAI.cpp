@@ -0,0 +1,134 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "EventManager.h"
+#include "Game.h"
+#include "GlobalGameSettings.h"
+#include "PlayerInfo.h"
+#include "RttrConfig.h"
+#include "ai/AIPlayer.h"
+#include "factories/AIFactory.h"
+#include "random/Random.h"
+#include "worldFixtures/CreateEmptyWorld.h"
+#include "world/GameWorld.h"
+#include "gameTypes/AIInfo.h"
+#include <rttr/bench/Benchmark.hpp>
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Runs a game with many AI players and compares the time spent in the AIs when they run sequentially
+// on the game thread and when they run on a thread pool with different numbers of threads.
+// Commands are executed every network frame as in a real game so the AIs have work to do.
+
+namespace {
+constexpr unsigned numPlayers = 8;
+constexpr unsigned mapSize = 128;
+constexpr unsigned numGFs = 3000;
+constexpr unsigned nwfLength = 10;
+
+struct Result
+{
+    rttr::bench::Seconds aiTime{0};
+    unsigned numCmds = 0;
+};
+
+Result runGame(unsigned numThreads)
+{
+    using namespace rttr::bench;
+    // Same game and AI seeds for each run
+    RANDOM.Init(42);
+    PlayerInfo player;
+    player.ps = PlayerState::AI;
+    player.aiInfo = AI::Info(AI::Type::Default, AI::Level::Hard);
+    auto game = std::make_unique<Game>(GlobalGameSettings(), std::make_unique<EventManager>(0),
+                                       std::vector<PlayerInfo>(numPlayers, player));
+    GameWorld& world = game->world_;
+    if(!CreateEmptyWorld(MapExtent(mapSize, mapSize))(world))
+        throw std::runtime_error("Could not create world");
+    for(unsigned i = 0; i < numPlayers; i++)
+        game->AddAIPlayer(AIFactory::Create(player.aiInfo, i, world));
+    game->SetNumAIThreads(numThreads);
+    game->Start(false);
+
+    Result result;
+    std::vector<std::vector<gc::GameCommandPtr>> pendingCmds(numPlayers);
+    for(unsigned gf = 0; gf < numGFs; gf++)
+    {
+        const bool isNWF = gf % nwfLength == 0u;
+        if(isNWF)
+        {
+            for(unsigned i = 0; i < numPlayers; i++)
+            {
+                for(const gc::GameCommandPtr& gc : pendingCmds[i])
+                    gc->Execute(world, game->aiPlayers_[i].GetPlayerId());
+                pendingCmds[i].clear();
+            }
+        }
+        const auto startTime = Clock::now();
+        game->RunAIs(gf, isNWF);
+        result.aiTime += Clock::now() - startTime;
+        for(AIPlayer& ai : game->aiPlayers_)
+            ai.FetchChatMessages();
+        game->RunGF();
+        if(isNWF)
+        {
+            for(unsigned i = 0; i < numPlayers; i++)
+            {
+                pendingCmds[i] = game->aiPlayers_[i].FetchGameCommands();
+                result.numCmds += pendingCmds[i].size();
+            }
+        }
+    }
+    return result;
+}
+} // namespace
+
+int main()
+{
+    if(!RTTRCONFIG.Init())
+        return 1;
+    const unsigned hwThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> threadCounts{0, 2, 4};
+    if(hwThreads > 4u)
+        threadCounts.push_back(hwThreads);
+
+    int exitCode = 0;
+    unsigned expectedNumCmds = 0;
+    for(const unsigned numThreads : threadCounts)
+    {
+        const Result result = runGame(numThreads);
+        const std::string name =
+          numThreads == 0u ? "AIs sequential" : "AIs on " + std::to_string(numThreads) + " threads";
+        rttr::bench::printResult(name, result.aiTime, numGFs, "GFs");
+        std::cout << "    " << result.numCmds << " commands" << std::endl;
+        // Each AI uses its own RNG, so running them in parallel must not change what they do
+        if(numThreads == 0u)
+            expectedNumCmds = result.numCmds;
+        else if(result.numCmds != expectedNumCmds)
+        {
+            std::cerr << "Number of commands differs from the sequential run (" << expectedNumCmds << ")"
+                      << std::endl;
+            exitCode = 1;
+        }
+    }
+    return exitCode;
+}
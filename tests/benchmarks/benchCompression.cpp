@@ -0,0 +1,174 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "EventManager.h"
+#include "Game.h"
+#include "GlobalGameSettings.h"
+#include "ListDir.h"
+#include "PlayerInfo.h"
+#include "RttrConfig.h"
+#include "SerializedGameData.h"
+#include "ai/AIPlayer.h"
+#include "compression/CompressionCodec.h"
+#include "factories/AIFactory.h"
+#include "files.h"
+#include "worldFixtures/CreateEmptyWorld.h"
+#include "world/GameWorld.h"
+#include "gameTypes/AIInfo.h"
+#include <rttr/bench/Benchmark.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/nowide/fstream.hpp>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Compares the compression codecs on maps and savegames.
+// Reports the compression ratio and the throughput of compressing and decompressing for each codec and level.
+// Maps are taken from the game folders if available. Additional files can be passed on the command line.
+
+namespace {
+struct Input
+{
+    std::string name;
+    std::vector<char> data;
+};
+
+std::vector<char> readFile(const boost::filesystem::path& filepath)
+{
+    boost::nowide::ifstream file(filepath, std::ios::binary);
+    if(!file)
+        throw std::runtime_error("Could not open " + filepath.string());
+    return std::vector<char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+/// Snapshot of a game with AI players which played for a while
+std::vector<char> createSavegameData()
+{
+    constexpr unsigned numPlayers = 4;
+    constexpr unsigned numGFs = 2000;
+    constexpr unsigned nwfLength = 10;
+    PlayerInfo player;
+    player.ps = PlayerState::AI;
+    player.aiInfo = AI::Info(AI::Type::Default, AI::Level::Hard);
+    auto game = std::make_shared<Game>(GlobalGameSettings(), std::make_unique<EventManager>(0),
+                                       std::vector<PlayerInfo>(numPlayers, player));
+    GameWorld& world = game->world_;
+    if(!CreateEmptyWorld(MapExtent(128, 128))(world))
+        throw std::runtime_error("Could not create world");
+    for(unsigned i = 0; i < numPlayers; i++)
+        game->AddAIPlayer(AIFactory::Create(player.aiInfo, i, world));
+    game->Start(false);
+    for(unsigned gf = 0; gf < numGFs; gf++)
+    {
+        const bool isNWF = gf % nwfLength == 0u;
+        game->RunAIs(gf, isNWF);
+        game->RunGF();
+        if(!isNWF)
+            continue;
+        for(AIPlayer& ai : game->aiPlayers_)
+        {
+            ai.FetchChatMessages();
+            for(const gc::GameCommandPtr& gc : ai.FetchGameCommands())
+                gc->Execute(world, ai.GetPlayerId());
+        }
+    }
+    SerializedGameData sgd;
+    sgd.MakeSnapshot(game);
+    return std::vector<char>(sgd.GetData(), sgd.GetData() + sgd.GetLength());
+}
+
+std::vector<Input> getInputs(int argc, char** argv)
+{
+    std::vector<Input> result;
+    for(int i = 1; i < argc; i++)
+        result.push_back({boost::filesystem::path(argv[i]).filename().string(), readFile(argv[i])});
+    for(const char* folder : {s25::folders::mapsOld, s25::folders::mapsRttr})
+    {
+        const boost::filesystem::path folderPath = RTTRCONFIG.ExpandPath(folder);
+        if(!boost::filesystem::is_directory(folderPath))
+            continue;
+        for(const char* extension : {"swd", "wld"})
+        {
+            for(const boost::filesystem::path& filepath : ListDir(folderPath, extension))
+                result.push_back({filepath.filename().string(), readFile(filepath)});
+        }
+    }
+    result.push_back({"Savegame (4 AIs, 2000 GFs)", createSavegameData()});
+    return result;
+}
+
+void benchCodec(const CompressionCodec& codec, int level, const std::vector<Input>& inputs)
+{
+    using namespace rttr::bench;
+    size_t totalSize = 0, totalCompressedSize = 0;
+    Seconds compressTime{0}, decompressTime{0};
+    for(const Input& input : inputs)
+    {
+        std::vector<char> compressed;
+        compressTime += measure([&]() {
+            compressed.clear();
+            codec.Compress(input.data.data(), input.data.size(), compressed, level);
+        });
+        std::vector<char> decompressed(input.data.size());
+        decompressTime += measure([&]() {
+            codec.Decompress(compressed.data(), compressed.size(), decompressed.data(), decompressed.size());
+            doNotOptimize(decompressed.front());
+        });
+        if(decompressed != input.data)
+            throw std::runtime_error(std::string("Round trip failed for ") + codec.GetName() + " on " + input.name);
+        totalSize += input.data.size();
+        totalCompressedSize += compressed.size();
+    }
+    const double totalMB = totalSize / (1024. * 1024.);
+    const std::string name = std::string(codec.GetName()) + (level ? " level " + std::to_string(level) : "");
+    printResult(name + " compress", compressTime, totalMB, "MB");
+    printResult(name + " decompress", decompressTime, totalMB, "MB");
+    std::cout << "    ratio " << std::setprecision(3) << static_cast<double>(totalSize) / totalCompressedSize
+              << std::endl;
+}
+
+std::vector<int> getLevels(CodecId id)
+{
+    switch(id)
+    {
+        case CodecId::BZip2: return {1, 9};
+        case CodecId::Zstd: return {1, 3, 9, 19};
+        default: return {0};
+    }
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if(!RTTRCONFIG.Init())
+        return 1;
+    const std::vector<Input> inputs = getInputs(argc, argv);
+    size_t totalSize = 0;
+    for(const Input& input : inputs)
+        totalSize += input.data.size();
+    std::cout << inputs.size() << " inputs with " << totalSize / 1024 << " KiB" << std::endl;
+    for(const CompressionCodec* codec : CompressionCodec::GetAll())
+    {
+        for(const int level : getLevels(codec->GetId()))
+            benchCodec(*codec, level, inputs);
+    }
+    return 0;
+}
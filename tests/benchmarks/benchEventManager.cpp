@@ -0,0 +1,167 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "EventManager.h"
+#include "GameEvent.h"
+#include "GameObject.h"
+#include <rttr/bench/Benchmark.hpp>
+#include <list>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Compares the EventManager against the previous implementation which used a std::map<GF, std::list<GameEvent*>>
+// and a heap allocation per event. Objects mimic figures: Mostly short walking events with some long running ones
+// (work, waiting) and some events which are removed before they are due.
+
+namespace {
+class LegacyEventManager;
+
+struct LegacyEvent
+{
+    GameObject* obj;
+    unsigned startGF, length, id;
+    unsigned GetTargetGF() const { return startGF + length; }
+};
+
+/// Copy of the old implementation (without serialization and kill list)
+class LegacyEventManager
+{
+    using EventList = std::list<const LegacyEvent*>;
+    std::map<unsigned, EventList> events;
+    unsigned currentGF;
+
+public:
+    explicit LegacyEventManager(unsigned startGF) : currentGF(startGF) {}
+    ~LegacyEventManager()
+    {
+        for(auto& it : events)
+        {
+            for(const LegacyEvent* ev : it.second)
+                delete ev;
+        }
+    }
+    unsigned GetCurrentGF() const { return currentGF; }
+    const LegacyEvent* AddEvent(GameObject* obj, unsigned length, unsigned id = 0)
+    {
+        auto* ev = new LegacyEvent{obj, currentGF, length, id};
+        events[ev->GetTargetGF()].push_back(ev);
+        return ev;
+    }
+    void RemoveEvent(const LegacyEvent*& ev)
+    {
+        auto it = events.find(ev->GetTargetGF());
+        it->second.remove(ev);
+        if(it->second.empty())
+            events.erase(it);
+        delete ev;
+        ev = nullptr;
+    }
+    void ExecuteNextGF()
+    {
+        currentGF++;
+        if(events.empty() || events.begin()->first != currentGF)
+            return;
+        auto itEvents = events.begin();
+        EventList& curEvents = itEvents->second;
+        for(auto it = curEvents.begin(); it != curEvents.end(); it = curEvents.erase(it))
+        {
+            (*it)->obj->HandleEvent((*it)->id);
+            delete *it;
+        }
+        events.erase(itEvents);
+    }
+};
+
+template<class T_EventMgr, class T_Event>
+class BenchFigure : public GameObject
+{
+    T_EventMgr& em;
+    std::minstd_rand& rng;
+    const T_Event* waitEvent = nullptr;
+
+public:
+    unsigned numHandled = 0;
+
+    BenchFigure(T_EventMgr& em, std::minstd_rand& rng) : em(em), rng(rng) {}
+
+    void Start() { em.AddEvent(this, 1 + rng() % 20, 0); }
+
+    void HandleEvent(unsigned id) override
+    {
+        ++numHandled;
+        if(id == 1)
+        {
+            waitEvent = nullptr;
+            return;
+        }
+        const unsigned r = rng() % 100;
+        if(r < 90)
+            em.AddEvent(this, 20, 0); // Walk
+        else if(r < 99)
+            em.AddEvent(this, 100 + rng() % 1000, 0); // Work
+        else
+            em.AddEvent(this, 5000 + rng() % 100000, 0); // Long idle
+        // Sometimes start a timeout which is cancelled before it is due
+        if(!waitEvent)
+            waitEvent = em.AddEvent(this, 50 + rng() % 500, 1);
+        else if(r % 2 == 0)
+            em.RemoveEvent(waitEvent);
+    }
+    void Destroy() override {}
+    void Serialize(SerializedGameData&) const override {}
+    GO_Type GetGOT() const override { return GO_Type::Unknown; }
+};
+
+template<class T_EventMgr, class T_Event>
+unsigned runBenchmark(unsigned numFigures, unsigned numGFs)
+{
+    std::minstd_rand rng(42);
+    T_EventMgr em(1000);
+    std::vector<std::unique_ptr<BenchFigure<T_EventMgr, T_Event>>> figures;
+    figures.reserve(numFigures);
+    for(unsigned i = 0; i < numFigures; i++)
+    {
+        figures.push_back(std::make_unique<BenchFigure<T_EventMgr, T_Event>>(em, rng));
+        figures.back()->Start();
+    }
+    for(unsigned i = 0; i < numGFs; i++)
+        em.ExecuteNextGF();
+    unsigned numHandled = 0;
+    for(const auto& figure : figures)
+        numHandled += figure->numHandled;
+    return numHandled;
+}
+} // namespace
+
+int main()
+{
+    using namespace rttr::bench;
+    const unsigned numGFs = 2000;
+    for(unsigned numFigures : {1000u, 10000u, 50000u})
+    {
+        unsigned numEvents = 0;
+        const Seconds legacyTime =
+          measure([&]() { numEvents = runBenchmark<LegacyEventManager, LegacyEvent>(numFigures, numGFs); });
+        printResult("Map+list (old), " + std::to_string(numFigures) + " figures", legacyTime, numEvents, "events");
+        const Seconds wheelTime =
+          measure([&]() { numEvents = runBenchmark<EventManager, GameEvent>(numFigures, numGFs); });
+        printResult("Timing wheel, " + std::to_string(numFigures) + " figures", wheelTime, numEvents, "events");
+    }
+    return 0;
+}
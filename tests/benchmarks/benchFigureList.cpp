@@ -0,0 +1,89 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "gameTypes/FigureList.h"
+#include <rttr/bench/Benchmark.hpp>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
+// Stress test for the figure lists of the world: Many figures walking across a large map.
+// Each step a figure is removed from the list of its node and added to the list of a neighbour,
+// same as World::RemoveFigure/AddFigure do. Compares the pooled FigureList against a plain std::list.
+
+namespace {
+struct WalkingFigure
+{
+    unsigned x, y;
+};
+
+template<class T_List>
+size_t runBenchmark(unsigned mapSize, unsigned numFigures, unsigned numSteps)
+{
+    std::minstd_rand rng(42);
+    std::vector<T_List> nodes(mapSize * mapSize);
+    std::vector<WalkingFigure> figures(numFigures);
+    // Only the address is used as an identifier, same as noBase* in the world
+    const auto toPtr = [](WalkingFigure& fig) { return reinterpret_cast<noBase*>(&fig); };
+    for(WalkingFigure& fig : figures)
+    {
+        // Cluster figures in the middle like in a real game
+        fig.x = mapSize / 4 + rng() % (mapSize / 2);
+        fig.y = mapSize / 4 + rng() % (mapSize / 2);
+        nodes[fig.y * mapSize + fig.x].push_back(toPtr(fig));
+    }
+    for(unsigned step = 0; step < numSteps; step++)
+    {
+        for(WalkingFigure& fig : figures)
+        {
+            nodes[fig.y * mapSize + fig.x].remove(toPtr(fig));
+            switch(rng() % 4)
+            {
+                case 0: fig.x = (fig.x + 1) % mapSize; break;
+                case 1: fig.x = (fig.x + mapSize - 1) % mapSize; break;
+                case 2: fig.y = (fig.y + 1) % mapSize; break;
+                default: fig.y = (fig.y + mapSize - 1) % mapSize; break;
+            }
+            nodes[fig.y * mapSize + fig.x].push_back(toPtr(fig));
+        }
+    }
+    size_t numOnMap = 0;
+    for(const T_List& node : nodes)
+        numOnMap += node.size();
+    return numOnMap;
+}
+} // namespace
+
+int main()
+{
+    using namespace rttr::bench;
+    const unsigned mapSize = 1024;
+    const unsigned numSteps = 20;
+    for(unsigned numFigures : {10000u, 100000u})
+    {
+        const double numMoves = static_cast<double>(numFigures) * numSteps;
+        const std::string suffix = ", " + std::to_string(numFigures) + " figures";
+        printResult("std::list" + suffix,
+                    measure([&]() { doNotOptimize(runBenchmark<std::list<noBase*>>(mapSize, numFigures, numSteps)); }),
+                    numMoves, "moves");
+        printResult("FigureList" + suffix,
+                    measure([&]() { doNotOptimize(runBenchmark<FigureList>(mapSize, numFigures, numSteps)); }),
+                    numMoves, "moves");
+    }
+    return 0;
+}
@@ -0,0 +1,152 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "EventManager.h"
+#include "Game.h"
+#include "GlobalGameSettings.h"
+#include "PlayerInfo.h"
+#include "RttrConfig.h"
+#include "pathfinding/FreePathFinder.h"
+#include "worldFixtures/CreateEmptyWorld.h"
+#include "world/GameWorld.h"
+#include "gameData/TerrainDesc.h"
+#include <rttr/bench/Benchmark.hpp>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Compares the A* search used for routes (FindHumanPath) against the bidirectional search used when only the
+// existence of a path is required (DoesHumanPathExist) on a large map with lakes and enclosed islands.
+// Reports the time per query and the number of expanded nodes.
+
+namespace {
+struct Query
+{
+    MapPoint start, dest;
+};
+
+DescIdx<TerrainDesc> findWater(const WorldDescription& desc)
+{
+    for(DescIdx<TerrainDesc> t(0); t.value < desc.terrain.size(); t.value++)
+    {
+        if(desc.get(t).kind == TerrainKind::Water && !desc.get(t).Is(ETerrain::Walkable))
+            return t;
+    }
+    throw std::runtime_error("No water terrain found");
+}
+
+void setTerrain(GameWorld& world, MapPoint center, unsigned radius, DescIdx<TerrainDesc> t, unsigned minRadius = 0)
+{
+    for(const MapPoint pt : world.GetPointsInRadius(center, radius))
+    {
+        if(world.CalcDistance(pt, center) < minRadius)
+            continue;
+        MapNode& node = world.GetNodeWriteable(pt);
+        node.t1 = node.t2 = t;
+    }
+}
+
+/// Create lakes for detours and islands enclosed by water which can't be reached
+std::vector<MapPoint> createLandscape(GameWorld& world, std::minstd_rand& rng)
+{
+    const DescIdx<TerrainDesc> tWater = findWater(world.GetDescription());
+    const unsigned size = world.GetWidth();
+    for(unsigned i = 0; i < size / 8; i++)
+        setTerrain(world, MapPoint(rng() % size, rng() % size), 5 + rng() % 20, tWater);
+    std::vector<MapPoint> islands;
+    for(unsigned i = 0; i < 8; i++)
+    {
+        const MapPoint center(rng() % size, rng() % size);
+        setTerrain(world, center, 30, tWater, 25);
+        islands.push_back(center);
+    }
+    return islands;
+}
+
+template<class T_Func>
+void runQueries(const std::string& name, const std::vector<Query>& queries, FreePathFinder& pf, T_Func&& findPath)
+{
+    using namespace rttr::bench;
+    unsigned numFound = 0;
+    double numExpanded = 0;
+    const Seconds duration = measure(
+      [&]() {
+          numFound = 0;
+          numExpanded = 0;
+          for(const Query& query : queries)
+          {
+              if(findPath(query))
+                  ++numFound;
+              numExpanded += pf.GetNumExpandedNodes();
+          }
+      },
+      1);
+    printResult(name, duration, queries.size(), "queries");
+    std::cout << "    " << numFound << "/" << queries.size() << " found, "
+              << static_cast<unsigned>(numExpanded / queries.size()) << " nodes expanded per query" << std::endl;
+}
+} // namespace
+
+int main()
+{
+    if(!RTTRCONFIG.Init())
+        return 1;
+    const unsigned mapSize = 1024;
+    const unsigned numQueries = 200;
+
+    auto game = std::make_unique<Game>(GlobalGameSettings(), std::make_unique<EventManager>(0),
+                                       std::vector<PlayerInfo>());
+    GameWorld& world = game->world_;
+    if(!CreateEmptyWorld(MapExtent(mapSize, mapSize))(world))
+        return 1;
+    std::minstd_rand rng(42);
+    const std::vector<MapPoint> islands = createLandscape(world, rng);
+
+    std::vector<Query> longQueries, unreachableQueries;
+    while(longQueries.size() < numQueries)
+    {
+        const Query query{MapPoint(rng() % mapSize, rng() % mapSize), MapPoint(rng() % mapSize, rng() % mapSize)};
+        if(world.CalcDistance(query.start, query.dest) >= 100)
+            longQueries.push_back(query);
+    }
+    for(unsigned i = 0; i < numQueries / 10; i++)
+        unreachableQueries.push_back(Query{longQueries[i].start, islands[i % islands.size()]});
+
+    FreePathFinder& pf = world.GetFreePathFinder();
+    for(const unsigned maxLength : {300u, 0xFFFFFFFFu})
+    {
+        const std::string suffix = maxLength == 300u ? " (max 300)" : "";
+        runQueries("A* long routes" + suffix, longQueries, pf, [&](const Query& query) {
+            unsigned length;
+            return static_cast<bool>(world.FindHumanPath(query.start, query.dest, maxLength, false, &length));
+        });
+        runQueries("Bidirectional long routes" + suffix, longQueries, pf, [&](const Query& query) {
+            unsigned length;
+            return world.DoesHumanPathExist(query.start, query.dest, maxLength, &length);
+        });
+        runQueries("A* unreachable" + suffix, unreachableQueries, pf, [&](const Query& query) {
+            return static_cast<bool>(world.FindHumanPath(query.start, query.dest, maxLength));
+        });
+        runQueries("Bidirectional unreachable" + suffix, unreachableQueries, pf, [&](const Query& query) {
+            return world.DoesHumanPathExist(query.start, query.dest, maxLength);
+        });
+    }
+    return 0;
+}
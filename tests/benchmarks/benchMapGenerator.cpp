@@ -0,0 +1,133 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "RttrConfig.h"
+#include "lua/GameDataLoader.h"
+#include "mapGenerator/Algorithms.h"
+#include "mapGenerator/RandomMap.h"
+#include "gameData/WorldDescription.h"
+#include <rttr/bench/Benchmark.hpp>
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Measures the generation of random maps from 64x64 up to 1024x1024 with one and multiple threads
+// and the data-parallel algorithms used by it.
+// The generated maps must be the same no matter how many threads are used.
+
+using namespace rttr::mapGenerator;
+
+namespace {
+constexpr uint64_t seed = 0x5EED;
+
+bool isSameMap(const Map& lhs, const Map& rhs)
+{
+    const auto isSameTexture = [](const TexturePair& l, const TexturePair& r) {
+        return l.rsu.value == r.rsu.value && l.lsd.value == r.lsd.value;
+    };
+    return std::equal(lhs.z.begin(), lhs.z.end(), rhs.z.begin())
+           && std::equal(lhs.textures.begin(), lhs.textures.end(), rhs.textures.begin(), isSameTexture)
+           && std::equal(lhs.objectTypes.begin(), lhs.objectTypes.end(), rhs.objectTypes.begin())
+           && std::equal(lhs.objectInfos.begin(), lhs.objectInfos.end(), rhs.objectInfos.begin())
+           && std::equal(lhs.resources.begin(), lhs.resources.end(), rhs.resources.begin())
+           && lhs.hqPositions == rhs.hqPositions;
+}
+
+void benchGenerateMap(const WorldDescription& worldDesc, unsigned mapSize)
+{
+    using namespace rttr::bench;
+    MapSettings settings;
+    settings.size = MapExtent::all(mapSize);
+    settings.numPlayers = 4;
+    const std::string sizeStr = std::to_string(mapSize) + "x" + std::to_string(mapSize);
+    const unsigned numRuns = mapSize >= 512 ? 1 : 3;
+
+    std::vector<Map> maps;
+    for(const bool multiThreaded : {false, true})
+    {
+        SetMultiThreaded(multiThreaded);
+        const std::string suffix = multiThreaded ? " (threads)" : " (1 thread)";
+        const auto duration = measure(
+          [&]() {
+              RandomUtility rnd(seed);
+              maps.push_back(GenerateRandomMap(rnd, worldDesc, settings));
+          },
+          numRuns);
+        printResult("GenerateRandomMap " + sizeStr + suffix, duration, 1, "maps");
+    }
+    if(!std::all_of(maps.begin(), maps.end(), [&maps](const Map& map) { return isSameMap(map, maps.front()); }))
+        throw std::runtime_error("Generated maps differ for " + sizeStr);
+}
+
+void benchAlgorithms(unsigned mapSize)
+{
+    using namespace rttr::bench;
+    const MapExtent size = MapExtent::all(mapSize);
+    const std::string sizeStr = std::to_string(mapSize) + "x" + std::to_string(mapSize);
+    const unsigned numPts = mapSize * mapSize;
+
+    NodeMapBase<uint8_t> z;
+    z.Resize(size);
+    RandomUtility rnd(seed);
+    RTTR_FOREACH_PT(MapPoint, size)
+        z[pt] = static_cast<uint8_t>(rnd.RandomValue(0, 60));
+    std::vector<MapPoint> sources;
+    for(unsigned i = 0; i < 20; i++)
+        sources.push_back(rnd.Point(size));
+
+    for(const bool multiThreaded : {false, true})
+    {
+        SetMultiThreaded(multiThreaded);
+        const std::string suffix = multiThreaded ? " (threads)" : " (1 thread)";
+        printResult("Smooth " + sizeStr + suffix, measure([&]() {
+                        NodeMapBase<uint8_t> smoothed = z;
+                        Smooth(1, GetSmoothRadius(size), smoothed);
+                        doNotOptimize(smoothed[0]);
+                    }),
+                    numPts, "pts");
+        printResult("Scale " + sizeStr + suffix, measure([&]() {
+                        NodeMapBase<uint8_t> scaled = z;
+                        Scale(scaled, uint8_t(0), uint8_t(0x60));
+                        doNotOptimize(scaled[0]);
+                    }),
+                    numPts, "pts");
+        printResult("LimitFor " + sizeStr + suffix, measure([&]() { doNotOptimize(LimitFor(z, 0.5, uint8_t(1))); }),
+                    numPts, "pts");
+        printResult("DistancesTo " + sizeStr + suffix, measure([&]() {
+                        const auto distances = DistancesTo(sources, size);
+                        doNotOptimize(distances[0]);
+                    }),
+                    numPts, "pts");
+    }
+}
+} // namespace
+
+int main()
+{
+    if(!RTTRCONFIG.Init())
+        return 1;
+    WorldDescription worldDesc;
+    loadGameData(worldDesc);
+    for(const unsigned mapSize : {64u, 128u, 256u, 512u, 1024u})
+    {
+        benchAlgorithms(mapSize);
+        benchGenerateMap(worldDesc, mapSize);
+    }
+    return 0;
+}
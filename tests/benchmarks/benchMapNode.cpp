@@ -0,0 +1,113 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+#include "EventManager.h"
+#include "Game.h"
+#include "GlobalGameSettings.h"
+#include "PlayerInfo.h"
+#include "RttrConfig.h"
+#include "RttrForeachPt.h"
+#include "nodeObjs/noEnvObject.h"
+#include "pathfinding/FreePathFinder.h"
+#include "worldFixtures/CreateEmptyWorld.h"
+#include "world/GameWorld.h"
+#include "gameTypes/MapNode.h"
+#include <rttr/bench/Benchmark.hpp>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Runs the hot loops of the game which scan the nodes of the world on maps of different sizes:
+// The BQ calculation of all nodes, free pathfinding (A*) between random points and reading the FoW of a player.
+// Only the FoW and the figures are stored outside of MapNode, so these measure the effect of the smaller nodes.
+
+namespace {
+/// Add some height differences and obstacles so BQ calculation and pathfinding have to check the neighbours
+void createLandscape(GameWorld& world, std::minstd_rand& rng)
+{
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        world.GetNodeWriteable(pt).altitude = 10 + rng() % 6;
+        if(rng() % 8 == 0)
+            world.SetNO(pt, new noEnvObject(pt, 500 + rng() % 3));
+    }
+}
+
+void runBenchmarks(unsigned mapSize)
+{
+    using namespace rttr::bench;
+    auto game = std::make_unique<Game>(GlobalGameSettings(), std::make_unique<EventManager>(0),
+                                       std::vector<PlayerInfo>());
+    GameWorld& world = game->world_;
+    if(!CreateEmptyWorld(MapExtent(mapSize, mapSize))(world))
+        throw std::runtime_error("Could not create world");
+    std::minstd_rand rng(42);
+    createLandscape(world, rng);
+
+    const unsigned numNodes = mapSize * mapSize;
+    const std::string suffix = ", " + std::to_string(mapSize) + "x" + std::to_string(mapSize);
+
+    printResult("RecalcBQ" + suffix, measure([&]() {
+                    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+                        world.RecalcBQ(pt);
+                }),
+                numNodes, "nodes");
+
+    const unsigned numQueries = 100;
+    std::vector<std::pair<MapPoint, MapPoint>> queries;
+    for(unsigned i = 0; i < numQueries; i++)
+        queries.emplace_back(MapPoint(rng() % mapSize, rng() % mapSize), MapPoint(rng() % mapSize, rng() % mapSize));
+    FreePathFinder& pf = world.GetFreePathFinder();
+    double numExpanded = 0;
+    const Seconds pathDuration = measure(
+      [&]() {
+          numExpanded = 0;
+          for(const auto& query : queries)
+          {
+              doNotOptimize(world.FindHumanPath(query.first, query.second));
+              numExpanded += pf.GetNumExpandedNodes();
+          }
+      },
+      1);
+    printResult("FindPath" + suffix, pathDuration, numQueries, "queries");
+    std::cout << "    " << static_cast<unsigned>(numExpanded / numQueries) << " nodes expanded per query"
+              << std::endl;
+
+    printResult("Visibility" + suffix, measure([&]() {
+                    unsigned numVisible = 0;
+                    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+                    {
+                        if(world.GetFoWNode(pt, 0).visibility != Visibility::Invisible)
+                            ++numVisible;
+                    }
+                    doNotOptimize(numVisible);
+                }),
+                numNodes, "nodes");
+}
+} // namespace
+
+int main()
+{
+    if(!RTTRCONFIG.Init())
+        return 1;
+    std::cout << "sizeof(MapNode): " << sizeof(MapNode) << std::endl;
+    for(unsigned mapSize : {256u, 512u, 1024u})
+        runBenchmarks(mapSize);
+    return 0;
+}
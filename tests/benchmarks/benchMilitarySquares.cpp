@@ -0,0 +1,104 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "EventManager.h"
+#include "Game.h"
+#include "GlobalGameSettings.h"
+#include "PlayerInfo.h"
+#include "RttrConfig.h"
+#include "buildings/nobBaseMilitary.h"
+#include "factories/BuildingFactory.h"
+#include "worldFixtures/CreateEmptyWorld.h"
+#include "world/GameWorld.h"
+#include "nodeObjs/noBase.h"
+#include <rttr/bench/Benchmark.hpp>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Measures the military building queries on maps densely covered with military buildings as in attack-heavy games:
+// Attacks, captures and the AI search for buildings in a radius of 3 - 4 military squares around a point.
+
+namespace {
+constexpr unsigned numPlayers = 4;
+constexpr unsigned numQueries = 100000;
+
+void benchmarkMap(unsigned mapSize, unsigned bldDistance)
+{
+    using namespace rttr::bench;
+    PlayerInfo player;
+    player.ps = PlayerState::Occupied;
+    auto game = std::make_unique<Game>(GlobalGameSettings(), std::make_unique<EventManager>(0),
+                                       std::vector<PlayerInfo>(numPlayers, player));
+    GameWorld& world = game->world_;
+    if(!CreateEmptyWorld(MapExtent(mapSize, mapSize))(world))
+        throw std::runtime_error("Could not create world");
+    unsigned numBlds = 0;
+    for(unsigned y = 0; y < mapSize; y += bldDistance)
+    {
+        for(unsigned x = 0; x < mapSize; x += bldDistance)
+        {
+            const MapPoint pt(x, y);
+            if(world.GetNO(pt)->GetType() != NodalObjectType::Nothing)
+                continue;
+            BuildingFactory::CreateBuilding(world, BuildingType::Watchtower, pt, numBlds % numPlayers,
+                                            Nation::Romans);
+            numBlds++;
+        }
+    }
+
+    std::minstd_rand rng(42);
+    std::vector<MapPoint> queryPts(numQueries);
+    for(MapPoint& pt : queryPts)
+        pt = MapPoint(rng() % mapSize, rng() % mapSize);
+
+    const std::string name =
+      std::to_string(mapSize) + "x" + std::to_string(mapSize) + ", " + std::to_string(numBlds) + " buildings";
+    for(const unsigned short radius : {3, 4})
+    {
+        const std::string suffix = name + ", radius " + std::to_string(radius);
+        printResult("Query " + suffix, measure([&]() {
+                        for(const MapPoint pt : queryPts)
+                            doNotOptimize(world.LookForMilitaryBuildings(pt, radius));
+                    }),
+                    numQueries, "queries");
+        sortedMilitaryBlds buildings;
+        printResult("Query reusing result " + suffix, measure([&]() {
+                        for(const MapPoint pt : queryPts)
+                        {
+                            world.LookForMilitaryBuildings(pt, radius, buildings);
+                            doNotOptimize(buildings);
+                        }
+                    }),
+                    numQueries, "queries");
+    }
+}
+} // namespace
+
+int main()
+{
+    if(!RTTRCONFIG.Init())
+        return 1;
+    for(const unsigned mapSize : {128u, 256u, 512u})
+    {
+        for(const unsigned bldDistance : {6u, 12u})
+            benchmarkMap(mapSize, bldDistance);
+    }
+    return 0;
+}
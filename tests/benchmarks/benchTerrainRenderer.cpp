@@ -0,0 +1,94 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "EventManager.h"
+#include "Game.h"
+#include "GlobalGameSettings.h"
+#include "PlayerInfo.h"
+#include "RttrConfig.h"
+#include "TerrainRenderer.h"
+#include "worldFixtures/CreateEmptyWorld.h"
+#include "world/GameWorld.h"
+#include "world/GameWorldViewer.h"
+#include <rttr/bench/Benchmark.hpp>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Measures the (re)generation of the terrain data on big maps with one and multiple threads
+// and the per frame cost of applying altitude and visibility changes.
+// Loading the textures requires the game files, so the full generation is represented by UpdateAllColors
+// which runs the same passes over the vertices, borders and triangles.
+
+namespace {
+void benchmarkMap(unsigned mapSize)
+{
+    using namespace rttr::bench;
+    PlayerInfo player;
+    player.ps = PlayerState::Occupied;
+    auto game = std::make_unique<Game>(GlobalGameSettings(), std::make_unique<EventManager>(0),
+                                       std::vector<PlayerInfo>(1, player));
+    GameWorld& world = game->world_;
+    if(!CreateEmptyWorld(MapExtent(mapSize, mapSize))(world))
+        throw std::runtime_error("Could not create world");
+    GameWorldViewer gwv(0, world);
+    const std::string sizeStr = std::to_string(mapSize) + "x" + std::to_string(mapSize);
+    const unsigned numPts = mapSize * mapSize;
+
+    TerrainRenderer tr;
+    tr.Init(world.GetSize());
+    for(const bool multiThreaded : {false, true})
+    {
+        tr.SetMultiThreaded(multiThreaded);
+        const std::string suffix = multiThreaded ? " (threads)" : " (1 thread)";
+        printResult("UpdateAllColors " + sizeStr + suffix, measure([&]() { tr.UpdateAllColors(gwv); }), numPts,
+                    "points");
+    }
+
+    // Typical changes within one frame: Some altitude changes (building sites) and a moving soldier/scout
+    std::minstd_rand rng(42);
+    std::vector<MapPoint> altitudePts, visibilityPts;
+    for(unsigned i = 0; i < 20; i++)
+        altitudePts.push_back(MapPoint(rng() % mapSize, rng() % mapSize));
+    const MapPoint center(rng() % mapSize, rng() % mapSize);
+    for(const MapPoint pt : world.GetPointsInRadius(center, 8))
+        visibilityPts.push_back(pt);
+    const auto applyChanges = [&]() {
+        for(const MapPoint pt : altitudePts)
+            tr.AltitudeChanged(pt);
+        tr.VisibilityChanged(visibilityPts);
+        tr.ApplyPendingChanges(gwv);
+    };
+    const unsigned numFrames = 1000;
+    printResult("Apply changes per frame " + sizeStr, measure([&]() {
+                    for(unsigned i = 0; i < numFrames; i++)
+                        applyChanges();
+                }),
+                numFrames, "frames");
+}
+} // namespace
+
+int main()
+{
+    if(!RTTRCONFIG.Init())
+        return 1;
+    for(const unsigned mapSize : {256u, 512u, 1024u})
+        benchmarkMap(mapSize);
+    return 0;
+}
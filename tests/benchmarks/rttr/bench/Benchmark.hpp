@@ -0,0 +1,64 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+
+namespace rttr { namespace bench {
+    using Clock = std::chrono::steady_clock;
+    using Seconds = std::chrono::duration<double>;
+
+    /// Run the function numRuns times and return the duration of the fastest run
+    template<class T_Func>
+    Seconds measure(T_Func&& func, unsigned numRuns = 3)
+    {
+        Seconds best(std::numeric_limits<double>::max());
+        for(unsigned i = 0; i < numRuns; i++)
+        {
+            const auto start = Clock::now();
+            func();
+            best = std::min<Seconds>(best, Clock::now() - start);
+        }
+        return best;
+    }
+
+    /// Print a line with the name of the benchmark, the time taken and the resulting throughput
+    inline void printResult(const std::string& name, Seconds duration, double numOps, const std::string& opName)
+    {
+        std::cout << std::left << std::setw(48) << name << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(10) << duration.count() * 1000. << " ms" << std::setprecision(0) << std::setw(14)
+                  << numOps / duration.count() << " " << opName << "/s" << std::endl;
+    }
+
+    /// Prevent the compiler from optimizing away a computed value
+    template<typename T>
+    void doNotOptimize(const T& value)
+    {
+#if defined(__GNUC__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+}} // namespace rttr::bench
@@ -0,0 +1,138 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "helpers/ObjectPool.h"
+#include "helpers/PoolAllocator.h"
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <list>
+#include <set>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(ObjectPoolTests)
+
+namespace {
+struct Foo
+{
+    double value;
+    char padding[13];
+};
+} // namespace
+
+BOOST_AUTO_TEST_CASE(AllocateAndReuse)
+{
+    helpers::ObjectPool<Foo, 4> pool;
+    BOOST_TEST(pool.size() == 0u);
+    BOOST_TEST(pool.capacity() == 0u);
+
+    std::vector<void*> ptrs;
+    for(unsigned i = 0; i < 10; i++)
+    {
+        void* ptr = pool.allocate();
+        BOOST_TEST_REQUIRE(ptr);
+        BOOST_TEST(reinterpret_cast<uintptr_t>(ptr) % alignof(Foo) == 0u);
+        ptrs.push_back(ptr);
+    }
+    BOOST_TEST(pool.size() == 10u);
+    BOOST_TEST(pool.capacity() == 12u);
+    // All distinct
+    BOOST_TEST(std::set<void*>(ptrs.begin(), ptrs.end()).size() == ptrs.size());
+    // Memory is usable
+    for(void* ptr : ptrs)
+        new(ptr) Foo{1.5, {}};
+
+    // Freed memory gets reused before new slabs are requested
+    void* freed = ptrs[3];
+    pool.deallocate(freed);
+    BOOST_TEST(pool.size() == 9u);
+    ptrs[3] = pool.allocate();
+    BOOST_TEST(ptrs[3] == freed);
+    ptrs.push_back(pool.allocate());
+    ptrs.push_back(pool.allocate());
+    BOOST_TEST(pool.size() == 12u);
+    BOOST_TEST(pool.capacity() == 12u);
+    ptrs.push_back(pool.allocate());
+    BOOST_TEST(pool.capacity() == 16u);
+
+    // Nullptr is ignored
+    pool.deallocate(nullptr);
+    BOOST_TEST(pool.size() == 13u);
+    for(void* ptr : ptrs)
+        pool.deallocate(ptr);
+    BOOST_TEST(pool.size() == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(FreeAll)
+{
+    helpers::ObjectPool<Foo, 8> pool;
+    std::vector<void*> ptrs;
+    for(unsigned i = 0; i < 20; i++)
+        ptrs.push_back(pool.allocate());
+    for(void* ptr : ptrs)
+        pool.deallocate(ptr);
+    BOOST_TEST(pool.size() == 0u);
+    // No new slab required
+    const size_t capacity = pool.capacity();
+    for(void*& ptr : ptrs)
+        ptr = pool.allocate();
+    BOOST_TEST(pool.capacity() == capacity);
+    for(void* ptr : ptrs)
+        pool.deallocate(ptr);
+}
+
+BOOST_AUTO_TEST_CASE(PoolAllocatorInList)
+{
+    using PoolList = std::list<int, helpers::PoolAllocator<int>>;
+    std::vector<PoolList> lists(3);
+    std::vector<std::list<int>> expectedLists(3);
+    // Move elements around like figures moving between nodes
+    for(int i = 0; i < 100; i++)
+    {
+        const unsigned src = i % 3, dst = (i + 1) % 3;
+        lists[src].push_back(i);
+        expectedLists[src].push_back(i);
+        if(i % 4 == 0)
+        {
+            const int value = lists[src].front();
+            lists[src].remove(value);
+            expectedLists[src].remove(value);
+            lists[dst].push_back(value);
+            expectedLists[dst].push_back(value);
+        }
+    }
+    for(unsigned i = 0; i < lists.size(); i++)
+        BOOST_TEST(std::vector<int>(lists[i].begin(), lists[i].end())
+                   == std::vector<int>(expectedLists[i].begin(), expectedLists[i].end()));
+    // Copies and moves work across lists
+    PoolList copy = lists[0];
+    BOOST_TEST(copy.size() == lists[0].size());
+    lists[1].splice(lists[1].end(), copy);
+    BOOST_TEST(copy.empty());
+    BOOST_TEST(lists[1].size() == expectedLists[1].size() + expectedLists[0].size());
+
+    // Multiple elements are allocated from the heap
+    helpers::PoolAllocator<int> alloc;
+    int* values = alloc.allocate(10);
+    BOOST_TEST(helpers::PoolAllocator<int>::getPool().size() == 0u);
+    alloc.deallocate(values, 10);
+    int* value = alloc.allocate(1);
+    BOOST_TEST(helpers::PoolAllocator<int>::getPool().size() == 1u);
+    alloc.deallocate(value, 1);
+    BOOST_TEST(helpers::PoolAllocator<int>::getPool().size() == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
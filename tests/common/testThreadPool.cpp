@@ -0,0 +1,91 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "helpers/ThreadPool.h"
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolTests)
+
+BOOST_AUTO_TEST_CASE(RunExecutesAllTasks)
+{
+    helpers::ThreadPool pool(4);
+    BOOST_TEST(pool.getNumThreads() == 4u);
+
+    std::vector<unsigned> results(100, 0u);
+    std::vector<std::atomic<unsigned>> numRunningPerThread(pool.getNumThreads());
+    // Boost.Test is not thread safe, so only record failures in the tasks
+    std::atomic<bool> threadIdxInvalid(false), threadIdxShared(false);
+    pool.run(results.size(), [&](unsigned taskIdx, unsigned threadIdx) {
+        if(threadIdx >= numRunningPerThread.size())
+        {
+            threadIdxInvalid = true;
+            return;
+        }
+        if(numRunningPerThread[threadIdx]++ != 0u)
+            threadIdxShared = true;
+        results[taskIdx] += taskIdx * 2u;
+        numRunningPerThread[threadIdx]--;
+    });
+    BOOST_TEST(!threadIdxInvalid);
+    BOOST_TEST(!threadIdxShared);
+    for(unsigned i = 0; i < results.size(); i++)
+        BOOST_TEST(results[i] == i * 2u);
+
+    // Can be reused and handles no tasks
+    bool called = false;
+    pool.run(0, [&called](unsigned, unsigned) { called = true; });
+    BOOST_TEST(!called);
+    std::atomic<unsigned> sum(0);
+    pool.run(10, [&sum](unsigned taskIdx, unsigned) { sum += taskIdx; });
+    BOOST_TEST(sum == 45u);
+}
+
+BOOST_AUTO_TEST_CASE(RunRethrowsExceptions)
+{
+    helpers::ThreadPool pool(2);
+    std::atomic<unsigned> numExecuted(0);
+    BOOST_CHECK_THROW(pool.run(10,
+                               [&numExecuted](unsigned taskIdx, unsigned) {
+                                   numExecuted++;
+                                   if(taskIdx == 3u)
+                                       throw std::runtime_error("Task failed");
+                               }),
+                      std::runtime_error);
+    // All tasks were still run
+    BOOST_TEST(numExecuted == 10u);
+}
+
+BOOST_AUTO_TEST_CASE(SubmitReturnsResults)
+{
+    helpers::ThreadPool pool;
+    BOOST_TEST(pool.getNumThreads() >= 1u);
+
+    std::vector<std::future<int>> results;
+    for(int i = 0; i < 20; i++)
+        results.push_back(pool.submit([i]() { return i * i; }));
+    for(int i = 0; i < 20; i++)
+        BOOST_TEST(results[i].get() == i * i);
+
+    auto failed = pool.submit([]() -> int { throw std::runtime_error("Job failed"); });
+    BOOST_CHECK_THROW(failed.get(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,181 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "compression/CompressionCodec.h"
+#include "gameTypes/CompressedData.h"
+#include "rttr/test/TmpFolder.hpp"
+#include "rttr/test/random.hpp"
+#include <boost/filesystem.hpp>
+#include <boost/nowide/fstream.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace {
+std::vector<std::vector<char>> getTestData()
+{
+    std::vector<std::vector<char>> result;
+    result.emplace_back();
+    result.push_back({'a'});
+    // Short data with a repetition
+    const std::string text = "The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the dog.";
+    result.emplace_back(text.begin(), text.end());
+    // Random data (incompressible)
+    std::vector<char> data(100000);
+    for(char& c : data)
+        c = static_cast<char>(rttr::test::randomValue<int>(0, 255));
+    result.push_back(data);
+    // Long runs of equal values (overlapping matches)
+    data.assign(200000, 'x');
+    for(unsigned i = 0; i < 100; i++)
+        data[rttr::test::randomValue<size_t>(0, data.size() - 1)] = static_cast<char>(i);
+    result.push_back(data);
+    // Few different values in random order
+    for(char& c : data)
+        c = static_cast<char>(rttr::test::randomValue<int>(0, 3));
+    result.push_back(data);
+    return result;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(CompressionSuite)
+
+BOOST_AUTO_TEST_CASE(RequiredCodecsAreAvailable)
+{
+    for(CodecId id : {CodecId::Store, CodecId::BZip2, CodecId::LZ4})
+    {
+        const CompressionCodec* codec = CompressionCodec::Get(id);
+        BOOST_TEST_REQUIRE(codec);
+        BOOST_TEST((codec->GetId() == id));
+    }
+    BOOST_TEST(CompressionCodec::Get(CompressionCodec::GetFastCodec()));
+    BOOST_TEST(CompressionCodec::Get(CompressionCodec::GetHighRatioCodec()));
+    BOOST_TEST(!CompressionCodec::Get(static_cast<CodecId>(42)));
+}
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+    for(const std::vector<char>& data : getTestData())
+    {
+        for(const CompressionCodec* codec : CompressionCodec::GetAll())
+        {
+            BOOST_TEST_CONTEXT("Codec " << codec->GetName() << ", size " << data.size())
+            {
+                const std::vector<char> compressed = compressWithHeader(data.data(), data.size(), codec->GetId());
+                BOOST_TEST((getCompressedCodec(compressed.data(), compressed.size()) == codec->GetId()));
+                std::vector<char> decompressed(data.size());
+                decompressWithHeader(compressed.data(), compressed.size(), decompressed.data(), decompressed.size());
+                BOOST_TEST(decompressed == data, boost::test_tools::per_element());
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(CompressibleDataGetsSmaller)
+{
+    const std::vector<char> data(100000, 'x');
+    for(const CompressionCodec* codec : CompressionCodec::GetAll())
+    {
+        if(codec->GetId() == CodecId::Store)
+            continue;
+        BOOST_TEST_CONTEXT("Codec " << codec->GetName())
+        {
+            const std::vector<char> compressed = compressWithHeader(data.data(), data.size(), codec->GetId());
+            BOOST_TEST(compressed.size() < data.size() / 100u);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(LegacyBzip2DataIsRead)
+{
+    const std::string text = "Data written before the header was introduced was always compressed with bzip2";
+    std::vector<char> compressed;
+    CompressionCodec::Get(CodecId::BZip2)->Compress(text.data(), text.size(), compressed, 9);
+    BOOST_TEST((getCompressedCodec(compressed.data(), compressed.size()) == CodecId::BZip2));
+    std::string decompressed(text.size(), '\0');
+    decompressWithHeader(compressed.data(), compressed.size(), &decompressed[0], decompressed.size());
+    BOOST_TEST(decompressed == text);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidDataThrows)
+{
+    const std::vector<char> data = getTestData()[2];
+    std::vector<char> decompressed(data.size());
+    for(const CompressionCodec* codec : CompressionCodec::GetAll())
+    {
+        BOOST_TEST_CONTEXT("Codec " << codec->GetName())
+        {
+            const std::vector<char> compressed = compressWithHeader(data.data(), data.size(), codec->GetId());
+            // Truncated
+            BOOST_CHECK_THROW(decompressWithHeader(compressed.data(), compressed.size() - 1u, decompressed.data(),
+                                                   decompressed.size()),
+                              CompressionError);
+            // Wrong size
+            BOOST_CHECK_THROW(decompressWithHeader(compressed.data(), compressed.size(), decompressed.data(),
+                                                   decompressed.size() - 1u),
+                              CompressionError);
+            // Random corruptions must never crash
+            for(unsigned i = 0; i < 50; i++)
+            {
+                std::vector<char> corrupted = compressed;
+                corrupted[rttr::test::randomValue<size_t>(0, corrupted.size() - 1)] ^= 0x5A;
+                try
+                {
+                    decompressWithHeader(corrupted.data(), corrupted.size(), decompressed.data(), decompressed.size());
+                } catch(const CompressionError&)
+                {}
+            }
+        }
+    }
+    // Unknown codec
+    std::vector<char> compressed = compressWithHeader(data.data(), data.size(), CodecId::Store);
+    compressed[5] = 42;
+    BOOST_CHECK_THROW(
+      decompressWithHeader(compressed.data(), compressed.size(), decompressed.data(), decompressed.size()),
+      CompressionError);
+}
+
+BOOST_AUTO_TEST_CASE(CompressedDataFromFile)
+{
+    rttr::test::TmpFolder tmp;
+    const boost::filesystem::path inFilepath = tmp.get() / "in.dat";
+    const boost::filesystem::path outFilepath = tmp.get() / "out.dat";
+    const std::vector<char> data = getTestData()[5];
+    {
+        boost::nowide::ofstream file(inFilepath, std::ios::binary);
+        file.write(data.data(), data.size());
+    }
+    for(const CompressionCodec* codec : CompressionCodec::GetAll())
+    {
+        BOOST_TEST_CONTEXT("Codec " << codec->GetName())
+        {
+            CompressedData compressedData;
+            unsigned checksumIn = 0, checksumOut = 1;
+            BOOST_TEST_REQUIRE(compressedData.CompressFromFile(inFilepath, &checksumIn, codec->GetId()));
+            BOOST_TEST(compressedData.length == data.size());
+            BOOST_TEST((compressedData.GetCodec() == codec->GetId()));
+            BOOST_TEST_REQUIRE(compressedData.DecompressToFile(outFilepath, &checksumOut));
+            BOOST_TEST(checksumIn == checksumOut);
+            boost::nowide::ifstream file(outFilepath, std::ios::binary);
+            const std::vector<char> readData((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            BOOST_TEST(readData == data, boost::test_tools::per_element());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
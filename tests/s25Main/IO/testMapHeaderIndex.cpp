@@ -0,0 +1,181 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "MapHeaderIndex.h"
+#include "test/testConfig.h"
+#include "rttr/test/TmpFolder.hpp"
+#include <boost/filesystem.hpp>
+#include <boost/nowide/fstream.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <thread>
+
+namespace bfs = boost::filesystem;
+
+namespace {
+struct MapFolderFixture
+{
+    rttr::test::TmpFolder tmpFolder;
+    bfs::path validMap, brokenMap;
+    MapFolderFixture()
+    {
+        const bfs::path testMapsDir = rttr::test::rttrBaseDir / "tests" / "testData" / "maps";
+        validMap = tmpFolder.get() / "LuaFunctions.SWD";
+        brokenMap = tmpFolder.get() / "Broken.swd";
+        bfs::copy_file(testMapsDir / "LuaFunctions.SWD", validMap);
+        bfs::copy_file(testMapsDir / "LuaFunctions.lua", tmpFolder.get() / "LuaFunctions.lua");
+        boost::nowide::ofstream(brokenMap) << "No map";
+    }
+};
+
+void waitForScan(const MapHeaderIndex& index)
+{
+    const auto endTime = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while(index.IsScanning() && std::chrono::steady_clock::now() < endTime)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    BOOST_TEST_REQUIRE(!index.IsScanning());
+}
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(MapHeaderIndexSuite, MapFolderFixture)
+
+BOOST_AUTO_TEST_CASE(ReadsAndCachesHeaders)
+{
+    MapHeaderIndex index;
+    const MapHeaderInfo info = index.Get(validMap);
+    BOOST_TEST(info.isValid);
+    BOOST_TEST(info.filePath == validMap);
+    BOOST_TEST(info.fileSize == bfs::file_size(validMap));
+    BOOST_TEST(info.numPlayers > 0u);
+    BOOST_TEST(info.width > 0u);
+    BOOST_TEST(info.height > 0u);
+    BOOST_TEST(info.hasLua);
+    const MapHeaderInfo brokenInfo = index.Get(brokenMap);
+    BOOST_TEST(!brokenInfo.isValid);
+    BOOST_TEST(!brokenInfo.errorMsg.empty());
+    BOOST_TEST(!brokenInfo.hasLua);
+    BOOST_TEST(index.GetNumHeadersRead() == 2u);
+    BOOST_TEST(index.IsModified());
+
+    // Unchanged files are not read again
+    index.Get(validMap);
+    BOOST_TEST(index.GetNumHeadersRead() == 2u);
+
+    const bfs::path indexFilePath = tmpFolder.get() / "CACHE" / "maps.idx";
+    BOOST_TEST_REQUIRE(index.Save(indexFilePath));
+    BOOST_TEST(!index.IsModified());
+
+    MapHeaderIndex loadedIndex;
+    BOOST_TEST_REQUIRE(loadedIndex.Load(indexFilePath));
+    const MapHeaderInfo loadedInfo = loadedIndex.Get(validMap);
+    const MapHeaderInfo loadedBrokenInfo = loadedIndex.Get(brokenMap);
+    BOOST_TEST(loadedIndex.GetNumHeadersRead() == 0u);
+    BOOST_TEST(loadedInfo.isValid);
+    BOOST_TEST(loadedInfo.name == info.name);
+    BOOST_TEST(loadedInfo.author == info.author);
+    BOOST_TEST(loadedInfo.numPlayers == info.numPlayers);
+    BOOST_TEST(loadedInfo.width == info.width);
+    BOOST_TEST(loadedInfo.height == info.height);
+    BOOST_TEST(loadedInfo.gfxSet == info.gfxSet);
+    BOOST_TEST(loadedInfo.hasLua);
+    BOOST_TEST(!loadedBrokenInfo.isValid);
+    BOOST_TEST(loadedBrokenInfo.errorMsg == brokenInfo.errorMsg);
+
+    // Changed files and scripts are detected
+    bfs::remove(tmpFolder.get() / "LuaFunctions.lua");
+    BOOST_TEST(!loadedIndex.Get(validMap).hasLua);
+    BOOST_TEST(loadedIndex.GetNumHeadersRead() == 0u);
+    boost::nowide::ofstream(brokenMap, std::ios::app) << "Still no map";
+    BOOST_TEST(!loadedIndex.Get(brokenMap).isValid);
+    BOOST_TEST(loadedIndex.GetNumHeadersRead() == 1u);
+    loadedIndex.Invalidate(validMap);
+    BOOST_TEST(loadedIndex.Get(validMap).isValid);
+    BOOST_TEST(loadedIndex.GetNumHeadersRead() == 2u);
+
+    MapHeaderIndex invalidIndex;
+    BOOST_TEST(!invalidIndex.Load(brokenMap));
+    // The broken file gets replaced
+    BOOST_TEST(invalidIndex.IsModified());
+}
+
+BOOST_AUTO_TEST_CASE(CorruptIndexIsRebuilt)
+{
+    MapHeaderIndex index;
+    index.Get(validMap);
+    const bfs::path indexFilePath = tmpFolder.get() / "maps.idx";
+    BOOST_TEST_REQUIRE(index.Save(indexFilePath));
+
+    // Huge number of entries (after signature and version) and huge length of the first path
+    for(const unsigned offset : {12u, 16u})
+    {
+        BOOST_TEST_REQUIRE(index.Save(indexFilePath));
+        {
+            boost::nowide::fstream file(indexFilePath, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(offset);
+            file.write("\xFF\xFF\xFF\xFF", 4);
+        }
+        MapHeaderIndex loadedIndex;
+        BOOST_TEST(!loadedIndex.Load(indexFilePath));
+        BOOST_TEST(loadedIndex.IsModified());
+        BOOST_TEST(loadedIndex.Get(validMap).isValid);
+        BOOST_TEST(loadedIndex.GetNumHeadersRead() == 1u);
+        BOOST_TEST_REQUIRE(loadedIndex.Save(indexFilePath));
+        MapHeaderIndex rebuiltIndex;
+        BOOST_TEST(rebuiltIndex.Load(indexFilePath));
+    }
+
+    // Missing files are not an error to fix
+    MapHeaderIndex emptyIndex;
+    BOOST_TEST(!emptyIndex.Load(tmpFolder.get() / "missing.idx"));
+    BOOST_TEST(!emptyIndex.IsModified());
+}
+
+BOOST_AUTO_TEST_CASE(ScansInBackground)
+{
+    MapHeaderIndex index;
+    index.StartScan({brokenMap, validMap});
+    waitForScan(index);
+    const std::vector<MapHeaderInfo> results = index.FetchResults();
+    BOOST_TEST_REQUIRE(results.size() == 2u);
+    BOOST_TEST(results[0].filePath == brokenMap);
+    BOOST_TEST(!results[0].isValid);
+    BOOST_TEST(results[1].filePath == validMap);
+    BOOST_TEST(results[1].isValid);
+    BOOST_TEST(index.FetchResults().empty());
+
+    // Maps removed from the folder are dropped from the index when it is scanned again
+    bfs::remove(brokenMap);
+    index.StartScan({validMap});
+    waitForScan(index);
+    BOOST_TEST(index.FetchResults().size() == 1u);
+    BOOST_TEST(index.GetNumHeadersRead() == 2u);
+    const bfs::path indexFilePath = tmpFolder.get() / "maps.idx";
+    BOOST_TEST_REQUIRE(index.Save(indexFilePath));
+    MapHeaderIndex loadedIndex;
+    BOOST_TEST_REQUIRE(loadedIndex.Load(indexFilePath));
+    boost::nowide::ofstream(brokenMap) << "No map";
+    loadedIndex.Get(brokenMap);
+    BOOST_TEST(loadedIndex.GetNumHeadersRead() == 1u);
+
+    // Cancelling discards pending results
+    index.StartScan({validMap, validMap, validMap});
+    index.CancelScan();
+    BOOST_TEST(!index.IsScanning());
+    BOOST_TEST(index.FetchResults().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
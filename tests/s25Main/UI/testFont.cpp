@@ -16,6 +16,8 @@
 // along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
 
 #include "Loader.h"
+#include "helpers/toString.h"
+#include "ogl/FontStyle.h"
 #include "ogl/glFont.h"
 #include "uiHelper/uiHelpers.hpp"
 #include <boost/test/unit_test.hpp>
@@ -49,4 +51,33 @@ BOOST_FIXTURE_TEST_CASE(WrapInfoWithTrailingNewlines, uiHelper::Fixture)
     BOOST_TEST(wrapInfo.CreateSingleStrings(input) == output, boost::test_tools::per_element{});
 }
 
+BOOST_FIXTURE_TEST_CASE(GlyphRunCache, uiHelper::Fixture)
+{
+    LOADER.initResourceFolders();
+    BOOST_TEST_REQUIRE(LOADER.LoadFonts());
+    const glFont& font = *NormalFont;
+    font.ResetCacheStats();
+    font.Draw(DrawPoint(0, 0), "Hello World", FontStyle::LEFT);
+    // Position, alignment and color do not change the layout
+    font.Draw(DrawPoint(10, 20), "Hello World", FontStyle::CENTER, COLOR_RED);
+    BOOST_TEST(font.GetCacheStats().numMisses == 1u);
+    BOOST_TEST(font.GetCacheStats().numHits == 1u);
+
+    // Limiting the width or changing the outline does
+    font.Draw(DrawPoint(0, 0), "Hello World", FontStyle::LEFT, COLOR_WHITE, font.CharWidth('H') * 3);
+    font.Draw(DrawPoint(0, 0), "Hello World", FontStyle::NO_OUTLINE);
+    BOOST_TEST(font.GetCacheStats().numMisses == 3u);
+    font.Draw(DrawPoint(0, 0), "Hello World", FontStyle::LEFT, COLOR_WHITE, font.CharWidth('H') * 3);
+    BOOST_TEST(font.GetCacheStats().numHits == 2u);
+
+    // The cache is bounded, so old texts are evicted
+    for(unsigned i = 0; i < 10000; i++)
+        font.Draw(DrawPoint(0, 0), helpers::toString(i), FontStyle::LEFT);
+    font.ResetCacheStats();
+    font.Draw(DrawPoint(0, 0), "Hello World", FontStyle::LEFT);
+    font.Draw(DrawPoint(0, 0), "9999", FontStyle::LEFT);
+    BOOST_TEST(font.GetCacheStats().numMisses == 1u);
+    BOOST_TEST(font.GetCacheStats().numHits == 1u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,125 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "Loader.h"
+#include "ogl/SpriteBatch.h"
+#include "ogl/glSmartBitmap.h"
+#include "uiHelper/uiHelpers.hpp"
+#include <libsiedler2/ArchivItem_Bitmap_Player.h>
+#include <libsiedler2/ArchivItem_Bitmap_Raw.h>
+#include <libsiedler2/ArchivItem_Palette.h>
+#include <libsiedler2/PixelBufferBGRA.h>
+#include <boost/test/unit_test.hpp>
+#include <memory>
+
+using namespace libsiedler2;
+
+namespace {
+struct SpriteFixture : uiHelper::Fixture
+{
+    ArchivItem_Bitmap_Raw bmp;
+    ArchivItem_Bitmap_Player playerBmp;
+    /// Bitmaps of 10x10 px on 2 different (shared) textures
+    glSmartBitmap spriteA, spriteB;
+    glSmartBitmap playerSprite;
+
+    SpriteFixture()
+    {
+        bmp.init(10, 10, TextureFormat::BGRA);
+        spriteA.add(&bmp);
+        spriteA.setSharedTexture(1);
+        spriteB.add(&bmp);
+        spriteB.setSharedTexture(2);
+
+        PixelBufferBGRA buffer(10, 10);
+        playerBmp.create(buffer, LOADER.GetPaletteN("colors"));
+        playerSprite.add(&playerBmp);
+        playerSprite.setSharedTexture(1);
+    }
+};
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(SpriteBatchTests, SpriteFixture)
+
+BOOST_AUTO_TEST_CASE(DrawsImmediatelyWithoutBatch)
+{
+    SpriteBatch batch;
+    BOOST_TEST(!SpriteBatch::GetActive());
+    spriteA.draw(DrawPoint(0, 0));
+    playerSprite.drawForPlayer(DrawPoint(0, 0), 0xFFFF0000);
+    BOOST_TEST(batch.GetCurrentStats().numSprites == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(GroupsByTexture)
+{
+    SpriteBatch batch;
+    batch.Begin();
+    BOOST_TEST(SpriteBatch::GetActive() == &batch);
+    // Alternating textures without overlap
+    for(int i = 0; i < 5; i++)
+        (i % 2 ? spriteB : spriteA).draw(DrawPoint(i * 20, 0));
+    BOOST_TEST(batch.GetCurrentStats().numSprites == 5u);
+    BOOST_TEST(batch.GetCurrentStats().numDrawCalls == 0u);
+    batch.End();
+    BOOST_TEST(!SpriteBatch::GetActive());
+    BOOST_TEST(batch.GetLastStats().numSprites == 5u);
+    BOOST_TEST(batch.GetLastStats().numDrawCalls == 2u);
+    BOOST_TEST(batch.GetLastStats().numVertices == 20u);
+
+    // Next frame starts with fresh counters
+    batch.Begin();
+    spriteA.draw(DrawPoint(0, 0));
+    BOOST_TEST(batch.GetCurrentStats().numSprites == 1u);
+    batch.End();
+    BOOST_TEST(batch.GetLastStats().numDrawCalls == 1u);
+}
+
+BOOST_AUTO_TEST_CASE(KeepsPainterOrder)
+{
+    SpriteBatch batch;
+    batch.Begin();
+    spriteA.draw(DrawPoint(0, 0));
+    spriteB.draw(DrawPoint(5, 5));
+    // Overlaps the B sprite so it must be drawn after it
+    spriteA.draw(DrawPoint(10, 10));
+    // Does not overlap anything -> Merged into the last group with its texture
+    spriteA.draw(DrawPoint(100, 0));
+    spriteB.draw(DrawPoint(200, 0));
+    batch.End();
+    BOOST_TEST(batch.GetLastStats().numSprites == 5u);
+    BOOST_TEST(batch.GetLastStats().numDrawCalls == 3u);
+}
+
+BOOST_AUTO_TEST_CASE(PlayerSpritesAndFlush)
+{
+    SpriteBatch batch;
+    batch.Begin();
+    playerSprite.drawForPlayer(DrawPoint(0, 0), 0xFFFF0000);
+    spriteA.draw(DrawPoint(50, 0));
+    // Player sprites consist of 2 quads on the same texture
+    BOOST_TEST(batch.GetCurrentStats().numVertices == 12u);
+    batch.Flush();
+    BOOST_TEST(batch.GetCurrentStats().numDrawCalls == 1u);
+    // Sprites after a flush can't be merged with the ones before
+    spriteA.draw(DrawPoint(100, 0));
+    batch.End();
+    BOOST_TEST(batch.GetLastStats().numSprites == 3u);
+    BOOST_TEST(batch.GetLastStats().numDrawCalls == 2u);
+    BOOST_TEST(batch.GetLastStats().numVertices == 16u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
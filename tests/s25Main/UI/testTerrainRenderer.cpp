@@ -15,8 +15,14 @@
 // You should have received a copy of the GNU General Public License
 // along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
 
+#include "Loader.h"
 #include "PointOutput.h"
+#include "Settings.h"
 #include "TerrainRenderer.h"
+#include "uiHelper/uiHelpers.hpp"
+#include "worldFixtures/CreateEmptyWorld.h"
+#include "worldFixtures/WorldFixture.h"
+#include "world/GameWorldViewer.h"
 #include "gameData/MapConsts.h"
 #include <boost/test/unit_test.hpp>
 
@@ -58,3 +64,94 @@ BOOST_AUTO_TEST_CASE(TR_ConvertCoords)
     BOOST_TEST_REQUIRE(tr.ConvertCoords(Position(-10 * w + w / 2, -11 * h + h / 2), &offset) == MapPoint(w / 2, h / 2));
     BOOST_TEST_REQUIRE(offset == Position(-10 * w * TR_W, -11 * h * TR_H));
 }
+
+// Enough rows to use multiple threads
+using TerrainWorldFixture = WorldFixture<CreateEmptyWorld, 1, 24, 128>;
+
+namespace {
+struct TerrainRendererFixture : uiHelper::Fixture, TerrainWorldFixture
+{
+    bool oldVbo;
+    TerrainRendererFixture() : oldVbo(SETTINGS.video.vbo)
+    {
+        // The mockup driver has no buffer objects
+        SETTINGS.video.vbo = false;
+        LOADER.LoadDummyMapFiles(world.GetDescription());
+    }
+    ~TerrainRendererFixture() { SETTINGS.video.vbo = oldVbo; }
+};
+
+/// Check that the data of tr is the same as when fully generated on a single thread
+void checkSameAsSequentialGeneration(const TerrainRenderer& tr, const GameWorldViewer& gwv)
+{
+    TerrainRenderer expectedTr;
+    expectedTr.SetMultiThreaded(false);
+    expectedTr.GenerateOpenGL(gwv);
+    const auto& expectedPos = expectedTr.GetTrianglePositions();
+    const auto& expectedTexCoords = expectedTr.GetTriangleTexCoords();
+    const auto& expectedColors = expectedTr.GetTriangleColors();
+    const auto& pos = tr.GetTrianglePositions();
+    const auto& texCoords = tr.GetTriangleTexCoords();
+    const auto& colors = tr.GetTriangleColors();
+    BOOST_TEST_REQUIRE(pos.size() == expectedPos.size());
+    BOOST_TEST_REQUIRE(texCoords.size() == expectedTexCoords.size());
+    BOOST_TEST_REQUIRE(colors.size() == expectedColors.size());
+    for(unsigned i = 0; i < pos.size(); i++)
+    {
+        BOOST_TEST_INFO("Triangle " << i);
+        for(unsigned j = 0; j < 3; j++)
+        {
+            BOOST_TEST_REQUIRE(pos[i][j] == expectedPos[i][j]);
+            BOOST_TEST_REQUIRE(texCoords[i][j] == expectedTexCoords[i][j]);
+            BOOST_TEST_REQUIRE(colors[i][j].r == expectedColors[i][j].r);
+            BOOST_TEST_REQUIRE(colors[i][j].g == expectedColors[i][j].g);
+            BOOST_TEST_REQUIRE(colors[i][j].b == expectedColors[i][j].b);
+        }
+    }
+}
+} // namespace
+
+BOOST_FIXTURE_TEST_CASE(TR_PendingChanges, TerrainRendererFixture)
+{
+    GameWorldViewer gwv(0, world);
+    TerrainRenderer tr;
+    tr.GenerateOpenGL(gwv);
+    BOOST_TEST(!tr.HasPendingChanges());
+    // Generation on multiple threads
+    checkSameAsSequentialGeneration(tr, gwv);
+
+    const MapPoint pt(5, 70);
+    const MapPoint pt2(20, 3);
+    world.ChangeAltitude(pt, 20);
+    world.ChangeAltitude(pt2, 5);
+    tr.AltitudeChanged(pt);
+    tr.AltitudeChanged(pt2);
+    const std::vector<MapPoint> visPts{pt, MapPoint(0, 0), MapPoint(23, 127)};
+    world.SetVisibility(visPts[0], 0, Visibility::Visible);
+    world.SetVisibility(visPts[1], 0, Visibility::FogOfWar);
+    world.SetVisibility(visPts[2], 0, Visibility::Visible);
+    tr.VisibilityChanged(visPts);
+    BOOST_TEST(tr.HasPendingChanges());
+    tr.ApplyPendingChanges(gwv);
+    BOOST_TEST(!tr.HasPendingChanges());
+    BOOST_TEST(tr.GetVertexPos(pt) == TerrainRenderer::PointF(world.GetNodePos(pt)));
+    BOOST_TEST(tr.GetVertexPos(pt2) == TerrainRenderer::PointF(world.GetNodePos(pt2)));
+    // Incremental update
+    checkSameAsSequentialGeneration(tr, gwv);
+
+    // Update of all colors on multiple threads
+    world.SetVisibility(MapPoint(10, 100), 0, Visibility::Visible);
+    world.SetVisibility(MapPoint(12, 40), 0, Visibility::FogOfWar);
+    tr.UpdateAllColors(gwv);
+    checkSameAsSequentialGeneration(tr, gwv);
+
+    // Incremental update on a single thread
+    tr.SetMultiThreaded(false);
+    world.ChangeAltitude(pt, 15);
+    tr.AltitudeChanged(pt);
+    world.SetVisibility(pt2, 0, Visibility::Visible);
+    tr.VisibilityChanged(pt2);
+    tr.ApplyPendingChanges(gwv);
+    BOOST_TEST(tr.GetVertexPos(pt) == TerrainRenderer::PointF(world.GetNodePos(pt)));
+    checkSameAsSequentialGeneration(tr, gwv);
+}
@@ -16,11 +16,15 @@
 // along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
 
 #include "CollisionDetection.h"
+#include "PointOutput.h"
 #include "ogl/glSmartBitmap.h"
 #include "ogl/glTexturePacker.h"
 #include "uiHelper/uiHelpers.hpp"
 #include "libsiedler2/ArchivItem_Bitmap_Raw.h"
 #include "libsiedler2/PixelBufferBGRA.h"
+#include "rttr/test/TmpFolder.hpp"
+#include <boost/filesystem/operations.hpp>
+#include <boost/nowide/fstream.hpp>
 #include <boost/test/unit_test.hpp>
 #include <Rect.h>
 #include <array>
@@ -74,4 +78,74 @@ BOOST_AUTO_TEST_CASE(SizeAndPosCorrect)
     }
 }
 
+BOOST_AUTO_TEST_CASE(CacheRestoresPlacement)
+{
+    const rttr::test::TmpFolder tmpFolder;
+    const bfs::path cacheFilepath = tmpFolder / bfs::path("textures.dat");
+    constexpr uint64_t cacheKey = 0x123456789ABCDEFu;
+
+    std::array<libsiedler2::ArchivItem_Bitmap_Raw, 3> bmps;
+    for(unsigned i = 0; i < bmps.size(); ++i)
+    {
+        libsiedler2::PixelBufferBGRA buffer(5 + i, 11 + i * 3, libsiedler2::ColorBGRA(0xFFFFFFFF));
+        bmps[i].create(buffer);
+    }
+    std::array<glSmartBitmap, 3> smartBmps;
+    {
+        glTexturePacker packer;
+        for(unsigned i = 0; i < bmps.size(); ++i)
+        {
+            smartBmps[i].add(&bmps[i]);
+            packer.add(smartBmps[i]);
+        }
+        // No cache yet
+        BOOST_TEST(!packer.loadCache(cacheFilepath, cacheKey));
+        BOOST_TEST_REQUIRE(packer.packAndSave(cacheFilepath, cacheKey));
+        for(auto& bmp : smartBmps)
+            bmp.setSharedTexture(0);
+    }
+
+    std::array<glSmartBitmap, 3> cachedBmps;
+    glTexturePacker packer;
+    for(unsigned i = 0; i < bmps.size(); ++i)
+    {
+        cachedBmps[i].add(&bmps[i]);
+        packer.add(cachedBmps[i]);
+    }
+    BOOST_TEST(!packer.loadCache(cacheFilepath, cacheKey + 1));
+    BOOST_TEST_REQUIRE(packer.loadCache(cacheFilepath, cacheKey));
+    BOOST_TEST_REQUIRE(packer.getTextures().size() == 1u);
+    for(unsigned i = 0; i < bmps.size(); ++i)
+    {
+        BOOST_TEST(cachedBmps[i].getTexture() == packer.getTextures()[0].get());
+        for(unsigned j = 0; j < smartBmps[i].texCoords.size(); ++j)
+            BOOST_TEST(cachedBmps[i].texCoords[j] == smartBmps[i].texCoords[j]);
+    }
+
+    // Changed bitmaps must not use the cache
+    std::array<glSmartBitmap, 2> otherBmps;
+    glTexturePacker otherPacker;
+    for(unsigned i = 0; i < otherBmps.size(); ++i)
+    {
+        otherBmps[i].add(&bmps[i + 1]);
+        otherPacker.add(otherBmps[i]);
+    }
+    BOOST_TEST(!otherPacker.loadCache(cacheFilepath, cacheKey));
+    // The file is written under a temporary name and then renamed
+    BOOST_TEST(!bfs::exists(tmpFolder / bfs::path("textures.dat.tmp")));
+
+    // Corrupt files are a cache miss. Number of textures after signature, version and key
+    const bfs::path corruptFilepath = tmpFolder / bfs::path("corrupt.dat");
+    bfs::copy_file(cacheFilepath, corruptFilepath);
+    {
+        boost::nowide::fstream file(corruptFilepath.string(), std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(12 + 2 + 8);
+        const std::array<char, 4> hugeCount = {'\xFF', '\xFF', '\xFF', '\x7F'};
+        file.write(hugeCount.data(), hugeCount.size());
+    }
+    BOOST_TEST(!packer.loadCache(corruptFilepath, cacheKey));
+    bfs::resize_file(cacheFilepath, bfs::file_size(cacheFilepath) - 10u);
+    BOOST_TEST(!packer.loadCache(cacheFilepath, cacheKey));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -349,13 +349,13 @@ BOOST_FIXTURE_TEST_CASE(StartAttack, AttackFixture<>)
     AddSoldiers(milBld1Pos, 1, 0);
     BOOST_TEST_REQUIRE(!milBld1->IsNewBuilt());
     // Try to attack invisible bld -> Fail
-    MapNode& node = world.GetNodeWriteable(milBld1Pos);
-    node.fow[0].visibility = Visibility::FogOfWar;
+    FoWNode& fowNode = world.GetFoWNodeWriteable(milBld1Pos, 0);
+    fowNode.visibility = Visibility::FogOfWar;
     BOOST_TEST_REQUIRE(world.CalcVisiblityWithAllies(milBld1Pos, curPlayer) == Visibility::FogOfWar);
     TestFailingAttack(gwv, milBld1Pos, attackSrc);
 
     // Attack it
-    node.fow[0].visibility = Visibility::Visible;
+    fowNode.visibility = Visibility::Visible;
     std::vector<nofPassiveSoldier*> soldiers(attackSrc.GetTroops().begin(), attackSrc.GetTroops().end()); //-V807
     BOOST_TEST_REQUIRE(soldiers.size() == 6u);
     for(int i = 0; i < 3; i++)
@@ -422,7 +422,7 @@ BOOST_FIXTURE_TEST_CASE(ConquerBld, AttackFixture<>)
     RTTR_EXEC_TILL(300, milBld1->GetNumTroops() == 0);
     // Defender deployed, attacker at flag
     BOOST_TEST_REQUIRE(milBld1->GetDefender());
-    const std::list<noBase*>& figures = world.GetFigures(milBld1->GetFlag()->GetPos());
+    const FigureList& figures = world.GetFigures(milBld1->GetFlag()->GetPos());
     BOOST_TEST_REQUIRE(figures.size() == 1u);
     BOOST_TEST_REQUIRE(dynamic_cast<nofAttacker*>(figures.front()));
     BOOST_TEST_REQUIRE(static_cast<nofAttacker*>(figures.front())->GetPlayer() == curPlayer);
@@ -535,7 +535,7 @@ BOOST_FIXTURE_TEST_CASE(ConquerWithMultipleWalkingIn, AttackFixture4P)
     const_cast<std::list<noFigure*>&>(milBld0->GetLeavingFigures()).pop_front();
     moveObjTo(world, *attacker, milBld1FlagPos); //-V522
     BOOST_TEST_REQUIRE(!milBld1->IsDoorOpen());
-    const std::list<noBase*>& flagFigs = world.GetFigures(milBld1FlagPos);
+    const FigureList& flagFigs = world.GetFigures(milBld1FlagPos);
     RTTR_EXEC_TILL(70, flagFigs.size() == 1u && flagFigs.front()->GetGOT() == GO_Type::Fighting); //-V807
     BOOST_TEST_REQUIRE(!milBld1->IsDoorOpen());
     // Speed up fight by reducing defenders HP to 1
@@ -749,7 +749,7 @@ BOOST_FIXTURE_TEST_CASE(ConquerWithCarriersWalkingIn, AttackFixture<2>)
     // Move him directly out
     const_cast<std::list<noFigure*>&>(milBld0->GetLeavingFigures()).pop_front();
     moveObjTo(world, *attacker, milBld1FlagPos); //-V522
-    const std::list<noBase*>& flagFigs = world.GetFigures(milBld1FlagPos);
+    const FigureList& flagFigs = world.GetFigures(milBld1FlagPos);
     RTTR_EXEC_TILL(20, attacker->GetPos() == milBld1FlagPos);
     // Carriers on pos or to pos get send away as soon as soldier arrives
     rescheduleWalkEvent(em, *carrierIn, 1);
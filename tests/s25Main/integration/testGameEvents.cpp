@@ -21,6 +21,7 @@
 #include "worldFixtures/TestEventManager.h"
 #include <rttr/test/LogAccessor.hpp>
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
 
 BOOST_AUTO_TEST_SUITE(GameEventsTestSuite)
 
@@ -141,6 +142,81 @@ BOOST_AUTO_TEST_CASE(Reschedule)
     BOOST_TEST_REQUIRE(obj.handledEventIds.size() == 1u);
 }
 
+class TestEventRecorder : public GameObject
+{
+public:
+    const EventManager& em;
+    /// GF and ID of handled events
+    std::vector<std::pair<unsigned, unsigned>> handledEvents;
+    TestEventRecorder(const EventManager& em) : em(em) {}
+
+    void HandleEvent(unsigned evId) override { handledEvents.emplace_back(em.GetCurrentGF(), evId); }
+    // LCOV_EXCL_START
+    void Destroy() override {}
+    void Serialize(SerializedGameData&) const override {}
+    GO_Type GetGOT() const override { return GO_Type::Unknown; }
+    // LCOV_EXCL_STOP
+};
+
+static void checkHandledEvents(const std::vector<std::pair<unsigned, unsigned>>& handledEvents,
+                               const std::vector<std::pair<unsigned, unsigned>>& expectedEvents)
+{
+    BOOST_TEST_REQUIRE(handledEvents.size() == expectedEvents.size());
+    for(unsigned i = 0; i < handledEvents.size(); i++)
+    {
+        BOOST_TEST(handledEvents[i].first == expectedEvents[i].first);
+        BOOST_TEST(handledEvents[i].second == expectedEvents[i].second);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(LongRunningEvents)
+{
+    // Events far in the future are moved through different internal structures
+    // Check that they are still executed at the correct GF and in the order they were added
+    const unsigned startGF = 250;
+    const std::vector<unsigned> lengths = {70000, 10, 300, 70000, 300, 6, 140000, 10, 65286, 100000, 65286, 255};
+    std::vector<std::pair<unsigned, unsigned>> expectedEvents;
+    for(unsigned i = 0; i < lengths.size(); i++)
+        expectedEvents.emplace_back(startGF + lengths[i], i);
+    std::stable_sort(expectedEvents.begin(), expectedEvents.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    const unsigned lastGF = expectedEvents.back().first;
+
+    {
+        TestEventManager evMgr(startGF);
+        TestEventRecorder obj(evMgr);
+        for(unsigned i = 0; i < lengths.size(); i++)
+        {
+            evMgr.AddEvent(&obj, lengths[i], i);
+            // Add and remove some events to check that they are found
+            const GameEvent* ev = evMgr.AddEvent(&obj, lengths[i], 1000 + i);
+            evMgr.RemoveEvent(ev);
+        }
+        const std::vector<const GameEvent*> events = evMgr.GetEvents();
+        BOOST_TEST_REQUIRE(events.size() == expectedEvents.size());
+        for(unsigned i = 0; i < events.size(); i++)
+        {
+            BOOST_TEST(events[i]->GetTargetGF() == expectedEvents[i].first);
+            BOOST_TEST(events[i]->id == expectedEvents[i].second);
+        }
+        while(evMgr.GetCurrentGF() < lastGF)
+            evMgr.ExecuteNextGF();
+        checkHandledEvents(obj.handledEvents, expectedEvents);
+        BOOST_TEST(evMgr.GetNumActiveEvents() == 0u);
+    }
+    // Same when skipping directly to the next event
+    {
+        TestEventManager evMgr(startGF);
+        TestEventRecorder obj(evMgr);
+        for(unsigned i = 0; i < lengths.size(); i++)
+            evMgr.AddEvent(&obj, lengths[i], i);
+        while(evMgr.GetCurrentGF() < lastGF)
+            evMgr.ExecuteNextEvent();
+        checkHandledEvents(obj.handledEvents, expectedEvents);
+        BOOST_TEST(evMgr.GetNumActiveEvents() == 0u);
+    }
+}
+
 class TestLogKill : public GameObject
 {
 public:
@@ -18,8 +18,11 @@
 #include "GamePlayer.h"
 #include "buildings/nobBaseWarehouse.h"
 #include "buildings/nobMilitary.h"
+#include "buildings/nobUsual.h"
 #include "factories/BuildingFactory.h"
 #include "figures/nofPassiveSoldier.h"
+#include "helpers/EnumRange.h"
+#include "helpers/containerUtils.h"
 #include "worldFixtures/CreateEmptyWorld.h"
 #include "worldFixtures/WorldFixture.h"
 #include <boost/test/unit_test.hpp>
@@ -48,3 +51,82 @@ BOOST_FIXTURE_TEST_CASE(Defeat, WorldFixtureEmpty2P)
     world.DestroyNO(milBldPos);
     BOOST_TEST_REQUIRE(world.GetPlayer(0).IsDefeated());
 }
+
+namespace {
+unsigned getMilitaryValue(const Inventory& inventory)
+{
+    unsigned result = 0;
+    for(const Job job : SOLDIER_JOBS)
+        result += inventory[job] * (getSoldierRank(job) + 1);
+    return result;
+}
+} // namespace
+
+BOOST_FIXTURE_TEST_CASE(IncrementalStatistics, WorldFixtureEmpty2P)
+{
+    GamePlayer& player = world.GetPlayer(0);
+    const auto checkInventoryStatistics = [&player]() {
+        const Inventory& inventory = player.GetInventory();
+        unsigned numWares = 0, numPeople = 0;
+        for(const auto i : helpers::enumRange<GoodType>())
+            numWares += inventory[i];
+        for(const auto i : helpers::enumRange<Job>())
+            numPeople += inventory[i];
+        BOOST_TEST(player.GetStatisticCurrentValue(StatisticType::Merchandise) == numWares);
+        BOOST_TEST(player.GetStatisticCurrentValue(StatisticType::Inhabitants) == numPeople);
+        BOOST_TEST(player.GetStatisticCurrentValue(StatisticType::Military) == getMilitaryValue(inventory));
+    };
+    checkInventoryStatistics();
+    player.IncreaseInventoryWare(GoodType::ShieldAfricans, 3);
+    player.IncreaseInventoryWare(GoodType::Wood, 5);
+    player.DecreaseInventoryWare(GoodType::Wood, 2);
+    player.IncreaseInventoryJob(Job::Officer, 2);
+    player.IncreaseInventoryJob(Job::Private, 3);
+    player.DecreaseInventoryJob(Job::Private, 1);
+    checkInventoryStatistics();
+
+    const unsigned numSteps = player.GetStatisticTimeSeries().GetNumSteps();
+    player.StatisticStep();
+    const StatisticTimeSeries& series = player.GetStatisticTimeSeries();
+    BOOST_TEST_REQUIRE(series.GetNumSteps() == numSteps + 1u);
+    for(const auto i : helpers::enumRange<StatisticType>())
+        BOOST_TEST(series.GetValue(i, numSteps) == player.GetStatisticCurrentValue(i));
+    BOOST_TEST(player.GetStatistic(StatisticTime::T15Minutes).data[StatisticType::Military][NUM_STAT_STEPS - 1]
+               == getMilitaryValue(player.GetInventory()));
+}
+
+BOOST_FIXTURE_TEST_CASE(WareClients, WorldFixtureEmpty2P)
+{
+    GamePlayer& player = world.GetPlayer(0);
+    const BuildingRegister& buildings = player.GetBuildingRegister();
+    const auto isClient = [&buildings](GoodType ware, const nobUsual* bld) {
+        return helpers::contains(buildings.GetWareClients(ware), bld);
+    };
+    const MapPoint millPos = world.MakeMapPoint(player.GetHQPos() + Position(4, 0));
+    const MapPoint smelterPos = world.MakeMapPoint(player.GetHQPos() + Position(-4, 2));
+    auto* mill = dynamic_cast<nobUsual*>(
+      BuildingFactory::CreateBuilding(world, BuildingType::Mill, millPos, 0, Nation::Romans));
+    auto* smelter = dynamic_cast<nobUsual*>(
+      BuildingFactory::CreateBuilding(world, BuildingType::Ironsmelter, smelterPos, 0, Nation::Romans));
+    BOOST_TEST_REQUIRE(mill);
+    BOOST_TEST_REQUIRE(smelter);
+    // New buildings need all their wares
+    BOOST_TEST(isClient(GoodType::Grain, mill));
+    BOOST_TEST(!isClient(GoodType::Coal, mill));
+    BOOST_TEST(isClient(GoodType::Coal, smelter));
+    BOOST_TEST(isClient(GoodType::IronOre, smelter));
+
+    // Stopped production -> Nothing needed
+    smelter->SetProductionEnabled(false);
+    BOOST_TEST(!isClient(GoodType::Coal, smelter));
+    BOOST_TEST(!isClient(GoodType::IronOre, smelter));
+    BOOST_TEST(isClient(GoodType::Grain, mill));
+    smelter->SetProductionEnabled(true);
+    BOOST_TEST(isClient(GoodType::Coal, smelter));
+    BOOST_TEST(isClient(GoodType::IronOre, smelter));
+
+    // Destroyed buildings are removed
+    world.DestroyNO(millPos);
+    BOOST_TEST(buildings.GetWareClients(GoodType::Grain).empty());
+    BOOST_TEST(isClient(GoodType::Coal, smelter));
+}
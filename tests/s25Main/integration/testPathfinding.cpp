@@ -17,8 +17,13 @@
 
 #include "RttrForeachPt.h"
 #include "helpers/OptionalIO.h"
+#include "helpers/ThreadPool.h"
+#include "pathfinding/RoadPathFinder.h"
+#include "pathfinding/ThreadPathFinders.h"
 #include "worldFixtures/CreateEmptyWorld.h"
 #include "worldFixtures/WorldFixture.h"
+#include "worldFixtures/WorldWithGCExecution.h"
+#include "nodeObjs/noFlag.h"
 #include "nodeObjs/noGranite.h"
 #include "gameTypes/GameTypesOutput.h"
 #include "gameData/GameConsts.h"
@@ -26,6 +31,8 @@
 #include <rttr/test/testHelpers.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/test/unit_test.hpp>
+#include <memory>
+#include <random>
 #include <vector>
 
 // Tests are designed to check for every possible direction and terrain distribution
@@ -37,6 +44,7 @@ BOOST_AUTO_TEST_SUITE(PathfindingSuite)
 namespace {
 using WorldFixtureEmpty0P = WorldFixture<CreateEmptyWorld, 0>;
 using WorldFixtureEmpty1P = WorldFixture<CreateEmptyWorld, 1>;
+using WorldFixtureEmptyLarge = WorldFixture<CreateEmptyWorld, 0, 64, 64>;
 
 /// Sets all terrain to the given terrain
 void clearWorld(GameWorldGame& world, DescIdx<TerrainDesc> terrain)
@@ -298,10 +306,171 @@ BOOST_FIXTURE_TEST_CASE(BlockedPaths, WorldFixtureEmpty0P)
     for(unsigned i = 0; i < 12; i++)
         surroundingPts2.push_back(world.GetNeighbour2(startPt, i));
     for(const MapPoint& pt : surroundingPts2)
+    {
         BOOST_TEST_REQUIRE(!world.FindHumanPath(startPt, pt));
+        BOOST_TEST_REQUIRE(!world.DoesHumanPathExist(startPt, pt));
+        // Search from the enclosed point ends immediately
+        BOOST_TEST_REQUIRE(world.GetFreePathFinder().GetNumExpandedNodes() <= 1u);
+        BOOST_TEST_REQUIRE(!world.DoesHumanPathExist(pt, startPt));
+    }
     // Allow left exit
     world.DestroyNO(surroundingPts[0]);
     BOOST_TEST_REQUIRE(world.FindHumanPath(startPt, surroundingPts2[0]));
+    BOOST_TEST_REQUIRE(world.DoesHumanPathExist(startPt, surroundingPts2[0]));
+}
+
+BOOST_FIXTURE_TEST_CASE(PathExistsMatchesFindPath, WorldFixtureEmptyLarge)
+{
+    // Block random points so there are detours and unreachable points
+    std::mt19937 rng(42);
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        if(rng() % 3 == 0)
+            world.SetNO(pt, new noGranite(GraniteType::One, 1));
+    }
+    for(unsigned i = 0; i < 500; i++)
+    {
+        const MapPoint startPt(rng() % world.GetWidth(), rng() % world.GetHeight());
+        const MapPoint endPt(rng() % world.GetWidth(), rng() % world.GetHeight());
+        if(startPt == endPt)
+            continue;
+        const unsigned maxLength = (i % 2 == 0) ? 0xFFFFFFFF : rng() % 20;
+        unsigned expectedLength = 0, length = 0;
+        const bool expectedResult =
+          static_cast<bool>(world.FindHumanPath(startPt, endPt, maxLength, false, &expectedLength));
+        BOOST_TEST_INFO("From " << startPt << " to " << endPt << " max " << maxLength);
+        BOOST_TEST_REQUIRE(world.DoesHumanPathExist(startPt, endPt, maxLength, &length) == expectedResult);
+        if(expectedResult)
+            BOOST_TEST_REQUIRE(length == expectedLength);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(RoadPathsFollowRoadChanges, WorldWithGCExecution1P)
+{
+    RoadPathFinder& pathFinder = world.GetRoadPathFinder();
+    const MapPoint flagPt = hqPos + MapPoint(4, 0);
+    const MapPoint midFlagPt = flagPt + MapPoint(2, 0);
+    const MapPoint endFlagPt = flagPt + MapPoint(4, 0);
+    this->SetFlag(flagPt);
+    this->BuildRoad(flagPt, false, std::vector<Direction>(4, Direction::East));
+    const noFlag& startFlag = *world.GetSpecObj<noFlag>(flagPt);
+    const noFlag& endFlag = *world.GetSpecObj<noFlag>(endFlagPt);
+
+    unsigned length = 0;
+    RoadPathDirection firstDir = RoadPathDirection::None;
+    MapPoint firstNodePos;
+    BOOST_TEST_REQUIRE(pathFinder.PathExists(startFlag, endFlag, false));
+    BOOST_TEST_REQUIRE(pathFinder.FindPath(startFlag, endFlag, false, 0xFFFFFFFF, nullptr, &length, &firstDir,
+                                           &firstNodePos));
+    BOOST_TEST(length == 4u);
+    BOOST_TEST(firstDir == RoadPathDirection::East);
+    BOOST_TEST(firstNodePos == endFlagPt);
+    BOOST_TEST(!pathFinder.PathExists(startFlag, endFlag, false, 3));
+
+    // Splitting the road changes the first node
+    this->SetFlag(midFlagPt);
+    const noFlag& midFlag = *world.GetSpecObj<noFlag>(midFlagPt);
+    BOOST_TEST_REQUIRE(pathFinder.FindPath(startFlag, endFlag, true, 0xFFFFFFFF, nullptr, &length, &firstDir,
+                                           &firstNodePos));
+    BOOST_TEST(length == 4u);
+    BOOST_TEST(firstNodePos == midFlagPt);
+    // Path to the end is not allowed to use the forbidden road
+    BOOST_TEST(!pathFinder.PathExists(startFlag, endFlag, false, 0xFFFFFFFF, midFlag.GetRoute(Direction::East)));
+
+    // Destroying a road disconnects the flags
+    this->DestroyRoad(midFlagPt, Direction::East);
+    BOOST_TEST(pathFinder.PathExists(startFlag, midFlag, false));
+    BOOST_TEST(!pathFinder.PathExists(startFlag, endFlag, false));
+    BOOST_TEST(!pathFinder.PathExists(endFlag, startFlag, false));
+
+    // Detour
+    this->BuildRoad(midFlagPt, false, {Direction::NorthEast, Direction::East, Direction::SouthEast});
+    BOOST_TEST_REQUIRE(pathFinder.FindPath(startFlag, endFlag, false, 0xFFFFFFFF, nullptr, &length));
+    BOOST_TEST(length == 5u);
+    BOOST_TEST_REQUIRE(pathFinder.FindPath(endFlag, startFlag, false, 0xFFFFFFFF, nullptr, &length, &firstDir));
+    BOOST_TEST(length == 5u);
+    BOOST_TEST(firstDir == RoadPathDirection::NorthWest);
+
+    // Flag removal destroys the roads
+    this->DestroyFlag(midFlagPt);
+    BOOST_TEST(!pathFinder.PathExists(startFlag, endFlag, false));
+
+    // Changing roads of another part of the network keeps the paths of this one
+    this->BuildRoad(flagPt, false, std::vector<Direction>(4, Direction::East));
+    BOOST_TEST_REQUIRE(pathFinder.FindPath(startFlag, endFlag, false, 0xFFFFFFFF, nullptr, &length));
+    BOOST_TEST(length == 4u);
+    const MapPoint otherFlagPt = flagPt + MapPoint(0, 4);
+    this->SetFlag(otherFlagPt);
+    this->BuildRoad(otherFlagPt, false, std::vector<Direction>(2, Direction::East));
+    const noFlag& otherFlag = *world.GetSpecObj<noFlag>(otherFlagPt);
+    const noFlag& otherEndFlag = *world.GetSpecObj<noFlag>(otherFlagPt + MapPoint(2, 0));
+    BOOST_TEST(pathFinder.PathExists(otherFlag, otherEndFlag, false));
+    BOOST_TEST(!pathFinder.PathExists(startFlag, otherEndFlag, false));
+    this->DestroyRoad(otherFlagPt, Direction::East);
+    BOOST_TEST(!pathFinder.PathExists(otherFlag, otherEndFlag, false));
+    BOOST_TEST_REQUIRE(pathFinder.FindPath(endFlag, startFlag, false, 0xFFFFFFFF, nullptr, &length, &firstDir));
+    BOOST_TEST(length == 4u);
+    BOOST_TEST(firstDir == RoadPathDirection::West);
+}
+
+BOOST_FIXTURE_TEST_CASE(RoadPathsOnMultipleThreads, WorldWithGCExecution1P)
+{
+    // Flags connected by roads with detours, so there are alternative routes
+    const MapPoint flagPt = hqPos + MapPoint(4, 0);
+    const MapPoint midFlagPt = flagPt + MapPoint(2, 0);
+    const MapPoint endFlagPt = flagPt + MapPoint(4, 0);
+    this->SetFlag(flagPt);
+    this->BuildRoad(flagPt, false, std::vector<Direction>(2, Direction::East));
+    this->BuildRoad(midFlagPt, false, std::vector<Direction>(2, Direction::East));
+    this->BuildRoad(flagPt, false, {Direction::NorthEast, Direction::East, Direction::SouthEast});
+    this->BuildRoad(midFlagPt, false, {Direction::SouthEast, Direction::East, Direction::NorthEast});
+    std::vector<const noFlag*> flags;
+    for(const MapPoint pt : {flagPt, midFlagPt, endFlagPt})
+    {
+        flags.push_back(world.GetSpecObj<noFlag>(pt));
+        BOOST_TEST_REQUIRE(flags.back());
+    }
+
+    // Expected results from the path finder of the game thread
+    std::vector<unsigned> expectedLengths;
+    for(const noFlag* start : flags)
+    {
+        for(const noFlag* goal : flags)
+        {
+            unsigned length = 0;
+            BOOST_TEST_REQUIRE(world.GetRoadPathFinder().FindPath(*start, *goal, false, 0xFFFFFFFF, nullptr, &length));
+            expectedLengths.push_back(length);
+        }
+    }
+
+    // Each thread uses its own path finders as the AIs do
+    constexpr unsigned numThreads = 4;
+    helpers::ThreadPool pool(numThreads);
+    std::vector<std::unique_ptr<ThreadPathFinders>> pathFinders;
+    for(unsigned i = 0; i < pool.getNumThreads(); i++)
+        pathFinders.push_back(std::make_unique<ThreadPathFinders>(world));
+    std::vector<unsigned> numMismatches(pool.getNumThreads(), 0u);
+    pool.run(numThreads * 4, [&](unsigned, unsigned threadIdx) {
+        ThreadPathFinders::Scope scope(*pathFinders[threadIdx]);
+        RoadPathFinder& pathFinder = world.GetRoadPathFinder();
+        for(unsigned iteration = 0; iteration < 200; iteration++)
+        {
+            unsigned idx = 0;
+            for(const noFlag* start : flags)
+            {
+                for(const noFlag* goal : flags)
+                {
+                    unsigned length = 0;
+                    if(!pathFinder.FindPath(*start, *goal, false, 0xFFFFFFFF, nullptr, &length)
+                       || length != expectedLengths[idx])
+                        numMismatches[threadIdx]++;
+                    idx++;
+                }
+            }
+        }
+    });
+    for(unsigned i = 0; i < numMismatches.size(); i++)
+        BOOST_TEST(numMismatches[i] == 0u);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -188,4 +188,45 @@ BOOST_FIXTURE_TEST_CASE(HarborNeighbors, SeaWorldWithGCExecution<>)
     BOOST_TEST_REQUIRE(world.GetHarborNeighbors(7, ShipDirection::SouthWest).size() == 0u);
 }
 
+BOOST_FIXTURE_TEST_CASE(PrecalculatedHarborRoutes, SeaWorldWithGCExecution<>)
+{
+    const HarborRoutes& routes = world.GetHarborRoutes();
+    // Inside the sea
+    BOOST_TEST(!routes.HasRoutesFrom(MapPoint(0, 0)));
+    for(unsigned startHbId = 1; startHbId <= world.GetNumHarborPoints(); startHbId++)
+    {
+        for(unsigned short seaId = 1; seaId <= world.GetNumSeas(); seaId++)
+        {
+            const MapPoint startPt = world.GetCoastalPoint(startHbId, seaId);
+            if(!startPt.isValid())
+                continue;
+            BOOST_TEST_REQUIRE(routes.HasRoutesFrom(startPt));
+            for(unsigned destHbId = 1; destHbId <= world.GetNumHarborPoints(); destHbId++)
+            {
+                const MapPoint destPt = world.GetCoastalPoint(destHbId, seaId);
+                if(!destPt.isValid() || destPt == startPt)
+                    continue;
+                std::vector<Direction> route, searchedRoute;
+                unsigned length, searchedLength;
+                const bool found = routes.FindRoute(startPt, destPt, 0xFFFFFFFF, &route, &length);
+                // Same result as searching for it
+                BOOST_TEST_REQUIRE(found
+                                   == world.FindShipPath(startPt, destPt, 0xFFFFFFFF, &searchedRoute, &searchedLength));
+                if(!found)
+                    continue;
+                BOOST_TEST_REQUIRE(length == searchedLength);
+                BOOST_TEST_REQUIRE(route.size() == length);
+                MapPoint endPt;
+                BOOST_TEST_REQUIRE(world.CheckShipRoute(startPt, route, 0, &endPt));
+                BOOST_TEST_REQUIRE(endPt == destPt);
+                // Route is limited by the max length
+                BOOST_TEST(!routes.FindRoute(startPt, destPt, length - 1u, nullptr, nullptr));
+                unsigned lengthBack;
+                BOOST_TEST(routes.FindRoute(destPt, startPt, length, nullptr, &lengthBack));
+                BOOST_TEST(lengthBack == length);
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
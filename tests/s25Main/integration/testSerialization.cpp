@@ -15,11 +15,13 @@
 // You should have received a copy of the GNU General Public License
 // along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
 
+#include "AsyncSaveWriter.h"
 #include "GameCommands.h"
 #include "GameEvent.h"
 #include "GamePlayer.h"
 #include "PointOutput.h"
 #include "Replay.h"
+#include "ReplayKeyframes.h"
 #include "RttrForeachPt.h"
 #include "Savegame.h"
 #include "SerializedGameData.h"
@@ -38,11 +40,16 @@
 #include "gameTypes/GameTypesOutput.h"
 #include "gameTypes/MapInfo.h"
 #include "s25util/tmpFile.h"
+#include <rttr/test/TmpFolder.hpp>
 #include <rttr/test/random.hpp>
 #include <rttr/test/testHelpers.hpp>
 #include <boost/filesystem/operations.hpp>
+#include <boost/nowide/fstream.hpp>
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <array>
 #include <memory>
+#include <vector>
 
 // LCOV_EXCL_START
 BOOST_TEST_DONT_PRINT_LOG_VALUE(AsyncChecksum)
@@ -171,6 +178,66 @@ void CheckReplayCmds(Replay& loadReplay, const PlayerGameCommands& recordedCmds)
     BOOST_TEST_REQUIRE(!loadReplay.ReadGF(&gf));
     BOOST_TEST_REQUIRE(gf == 0xFFFFFFFF);
 }
+
+/// Writes replays of an old map exactly like the last release with format version 6 did:
+/// Checksums without the world state hash and the commands stored one after another.
+/// Kept unchanged to check that those replays can still be read
+class ReplayV6Writer : public SavedFile
+{
+public:
+    std::string GetSignature() const override { return "RTTRRP2"; }
+    uint16_t GetVersion() const override { return 6; }
+
+    bool StartRecording(const bfs::path& filepath, const MapInfo& mapInfo, unsigned lastGF)
+    {
+        RTTR_Assert(mapInfo.type == MapType::OldMap);
+        if(!file.Open(filepath, OFM_WRITE))
+            return false;
+        WriteAllHeaderData(file, mapInfo.title);
+        file.WriteUnsignedShort(static_cast<unsigned short>(mapInfo.type));
+        file.WriteUnsignedInt(lastGF);
+        WritePlayerData(file);
+        WriteGGS(file);
+        file.WriteUnsignedInt(0); // random_init
+        file.WriteLongString(mapInfo.filepath.string());
+        file.WriteUnsignedInt(mapInfo.mapData.length);
+        file.WriteUnsignedInt(mapInfo.mapData.data.size());
+        file.WriteRawData(&mapInfo.mapData.data[0], mapInfo.mapData.data.size());
+        file.WriteUnsignedInt(mapInfo.luaData.length);
+        file.WriteUnsignedInt(mapInfo.luaData.data.size());
+        if(!mapInfo.luaData.data.empty())
+            file.WriteRawData(&mapInfo.luaData.data[0], mapInfo.luaData.data.size());
+        return true;
+    }
+
+    void AddChatCommand(unsigned gf, uint8_t player, ChatDestination dest, const std::string& str)
+    {
+        file.WriteUnsignedInt(gf);
+        file.WriteUnsignedChar(static_cast<uint8_t>(ReplayCommand::Chat));
+        file.WriteUnsignedChar(player);
+        file.WriteUnsignedChar(static_cast<uint8_t>(dest));
+        file.WriteLongString(str);
+    }
+
+    void AddGameCommand(unsigned gf, uint8_t player, const PlayerGameCommands& cmds)
+    {
+        file.WriteUnsignedInt(gf);
+        file.WriteUnsignedChar(static_cast<uint8_t>(ReplayCommand::Game));
+        Serializer ser;
+        ser.PushUnsignedChar(player);
+        ser.PushUnsignedInt(cmds.checksum.randChecksum);
+        ser.PushUnsignedInt(cmds.checksum.objCt);
+        ser.PushUnsignedInt(cmds.checksum.objIdCt);
+        ser.PushUnsignedInt(cmds.checksum.eventCt);
+        ser.PushUnsignedInt(cmds.checksum.evInstanceCt);
+        ser.PushUnsignedInt(cmds.gcs.size());
+        for(const gc::GameCommandPtr& gc : cmds.gcs)
+            gc->Serialize(ser);
+        ser.WriteToFile(file);
+    }
+
+    BinaryFile file;
+};
 } // namespace
 
 BOOST_AUTO_TEST_SUITE(Serialization)
@@ -366,6 +433,10 @@ BOOST_FIXTURE_TEST_CASE(BaseSaveLoad, RandWorldFixture)
                 BOOST_TEST_REQUIRE(loadNode.harborId == worldNode.harborId);
                 BOOST_TEST_REQUIRE((loadNode.obj != nullptr) == (worldNode.obj != nullptr));
             }
+            BOOST_TEST_REQUIRE(world.GetStateHash().GetHash() == world.CalcStateHash().GetHash());
+            BOOST_TEST_REQUIRE(newWorld.GetStateHash().GetHash() == world.GetStateHash().GetHash());
+            for(unsigned j = 0; j < world.GetNumPlayers(); j++)
+                BOOST_TEST_REQUIRE(newWorld.GetPlayer(j).GetInventoryHash() == world.GetPlayer(j).GetInventoryHash());
             const nobUsual* newUsual = newWorld.GetSpecObj<nobUsual>(usualBldPos);
             BOOST_TEST_REQUIRE(newUsual);
             BOOST_TEST_REQUIRE(newUsual->is_working == usualBld->is_working);
@@ -386,6 +457,94 @@ BOOST_FIXTURE_TEST_CASE(BaseSaveLoad, RandWorldFixture)
     }
 }
 
+BOOST_FIXTURE_TEST_CASE(SaveInBackground, RandWorldFixture)
+{
+    for(unsigned i = 0; i < 50; i++)
+        em.ExecuteNextGF();
+
+    auto save = std::make_unique<Savegame>();
+    for(unsigned i = 0; i < world.GetNumPlayers(); i++)
+        save->AddPlayer(world.GetPlayer(i));
+    save->ggs = ggs;
+    save->start_gf = em.GetCurrentGF();
+    save->sgd.MakeSnapshot(game);
+    const std::vector<unsigned char> expectedData(save->sgd.GetData(), save->sgd.GetData() + save->sgd.GetLength());
+
+    rttr::test::TmpFolder tmpFolder;
+    const boost::filesystem::path filePath = tmpFolder.get() / "background.sav";
+    AsyncSaveWriter writer;
+    BOOST_TEST(!writer.FetchResult());
+    writer.Start(std::move(save), filePath, "MapTitle");
+    // The game can continue while the file is written
+    for(unsigned i = 0; i < 10; i++)
+        em.ExecuteNextGF();
+    writer.Wait();
+    BOOST_TEST(!writer.IsBusy());
+    BOOST_TEST(writer.GetProgress() == 100u);
+    const boost::optional<AsyncSaveWriter::Result> result = writer.FetchResult();
+    BOOST_TEST_REQUIRE(result.is_initialized());
+    BOOST_TEST(result->success);
+    BOOST_TEST(result->filepath == filePath);
+    // Result is only returned once
+    BOOST_TEST(!writer.FetchResult());
+
+    Savegame loadSave;
+    BOOST_TEST_REQUIRE(loadSave.Load(filePath, SaveGameDataToLoad::All));
+    BOOST_TEST(loadSave.GetMapName() == "MapTitle");
+    BOOST_TEST_REQUIRE(loadSave.sgd.GetLength() == expectedData.size());
+    BOOST_TEST(std::equal(expectedData.begin(), expectedData.end(), loadSave.sgd.GetData()));
+
+    // Errors are reported
+    writer.Start(std::make_unique<Savegame>(), tmpFolder.get() / "invalidFolder" / "x.sav", "MapTitle");
+    writer.Wait();
+    const boost::optional<AsyncSaveWriter::Result> failedResult = writer.FetchResult();
+    BOOST_TEST_REQUIRE(failedResult.is_initialized());
+    BOOST_TEST(!failedResult->success);
+    BOOST_TEST(!failedResult->errorMsg.empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(LoadCorruptSavegame, RandWorldFixture)
+{
+    Savegame save;
+    for(unsigned i = 0; i < world.GetNumPlayers(); i++)
+        save.AddPlayer(world.GetPlayer(i));
+    save.ggs = ggs;
+    save.sgd.MakeSnapshot(game);
+
+    rttr::test::TmpFolder tmpFolder;
+    const bfs::path filePath = tmpFolder.get() / "corrupt.sav";
+    BOOST_TEST_REQUIRE(save.Save(filePath, "MapTitle"));
+    // The sizes of the game data follow the settings
+    unsigned gameDataPos;
+    {
+        BinaryFile file;
+        BOOST_TEST_REQUIRE(file.Open(filePath, OFM_READ));
+        Savegame loadSave;
+        BOOST_TEST_REQUIRE(loadSave.Load(file, SaveGameDataToLoad::HeaderAndSettings));
+        gameDataPos = file.Tell();
+    }
+    // Uncompressed or compressed size way too big
+    for(const unsigned offset : {0u, 4u})
+    {
+        const bfs::path corruptPath = tmpFolder.get() / ("size" + std::to_string(offset) + ".sav");
+        bfs::copy_file(filePath, corruptPath);
+        {
+            boost::nowide::fstream file(corruptPath.string(), std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(gameDataPos + offset);
+            const std::array<char, 4> hugeSize = {'\xFF', '\xFF', '\xFF', '\x7F'};
+            file.write(hugeSize.data(), hugeSize.size());
+        }
+        Savegame loadSave;
+        BOOST_TEST(!loadSave.Load(corruptPath, SaveGameDataToLoad::All));
+        BOOST_TEST(!loadSave.GetLastErrorMsg().empty());
+    }
+    // Truncated file
+    bfs::resize_file(filePath, bfs::file_size(filePath) - 10u);
+    Savegame loadSave;
+    BOOST_TEST(!loadSave.Load(filePath, SaveGameDataToLoad::All));
+    BOOST_TEST(!loadSave.GetLastErrorMsg().empty());
+}
+
 BOOST_AUTO_TEST_CASE(ReplayWithMap)
 {
     MapInfo map;
@@ -590,4 +749,293 @@ BOOST_FIXTURE_TEST_CASE(ReplayWithSavegame, RandWorldFixture)
     }
 }
 
+BOOST_AUTO_TEST_CASE(ReplayBlocksAndIndex)
+{
+    MapInfo map;
+    map.type = MapType::OldMap;
+    map.title = "MapTitle";
+    map.filepath = "Map.swd";
+    map.mapData.data = std::vector<char>(42, 0x42);
+    map.mapData.length = 50;
+    std::vector<PlayerInfo> players(2);
+    players[0].ps = players[1].ps = PlayerState::Occupied;
+
+    rttr::test::TmpFolder tmpFolder;
+    const bfs::path replayPath = tmpFolder.get() / "replay.rpl";
+    const bfs::path crashedReplayPath = tmpFolder.get() / "crashed.rpl";
+    const auto getChecksum = [](unsigned gf) {
+        return AsyncChecksum(gf * 7919u, gf, gf + 1u, 1000u - gf, gf / 2u, gf * 2654435761u);
+    };
+    constexpr unsigned numGFs = 5000;
+    unsigned numCmds = 0;
+    {
+        Replay replay;
+        for(const BasePlayerInfo& player : players)
+            replay.AddPlayer(player);
+        BOOST_TEST_REQUIRE(replay.StartRecording(replayPath, map));
+        Game game(GlobalGameSettings(), 0u, players);
+        PlayerGameCommands cmds = GetTestCommands().create(game).result;
+        for(unsigned gf = 0; gf < numGFs; gf += 10)
+        {
+            cmds.checksum = getChecksum(gf);
+            replay.AddGameCommand(gf, gf % 2u, cmds);
+            ++numCmds;
+            if(gf % 100u == 0u)
+            {
+                replay.AddChatCommand(gf, 1, ChatDestination::All, "Chat" + std::to_string(gf));
+                ++numCmds;
+            }
+        }
+        replay.UpdateLastGF(numGFs);
+        // Simulate a crash: All blocks are written but the index is missing
+        replay.Flush();
+        bfs::copy_file(replayPath, crashedReplayPath);
+        replay.StopRecording();
+    }
+
+    std::vector<Replay::BlockInfo> expectedBlocks;
+    for(const bfs::path& path : {replayPath, crashedReplayPath})
+    {
+        BOOST_TEST_CONTEXT(path.filename())
+        {
+            Replay replay;
+            BOOST_TEST_REQUIRE(replay.LoadHeader(path, true));
+            BOOST_TEST(replay.GetLastGF() == numGFs);
+            MapInfo newMap;
+            BOOST_TEST_REQUIRE(replay.LoadGameData(newMap));
+            BOOST_TEST_REQUIRE(replay.HasBlocks());
+            BOOST_TEST(replay.GetNumCommands() == numCmds);
+            const std::vector<Replay::BlockInfo>& blocks = replay.GetBlocks();
+            // Blocks span at most 1000 GFs
+            BOOST_TEST_REQUIRE(blocks.size() >= numGFs / 1000u);
+            if(expectedBlocks.empty())
+                expectedBlocks = blocks;
+            BOOST_TEST_REQUIRE(blocks.size() == expectedBlocks.size());
+            for(unsigned i = 0; i < blocks.size(); i++)
+            {
+                BOOST_TEST(blocks[i].firstGF == expectedBlocks[i].firstGF);
+                BOOST_TEST(blocks[i].lastGF == expectedBlocks[i].lastGF);
+                BOOST_TEST(blocks[i].numCommands == expectedBlocks[i].numCommands);
+                BOOST_TEST(blocks[i].filePos == expectedBlocks[i].filePos);
+            }
+
+            // Sequential read
+            unsigned gf, expectedGF = 0, numReadCmds = 0;
+            uint8_t player, dest;
+            std::string txt;
+            PlayerGameCommands cmds;
+            while(replay.ReadGF(&gf))
+            {
+                BOOST_TEST_REQUIRE(gf == expectedGF);
+                BOOST_TEST_REQUIRE(replay.ReadRCType() == ReplayCommand::Game);
+                replay.ReadGameCommand(player, cmds);
+                BOOST_TEST_REQUIRE(player == gf % 2u);
+                BOOST_TEST_REQUIRE(cmds.checksum == getChecksum(gf));
+                BOOST_TEST_REQUIRE(cmds.gcs.size() == 2u);
+                ++numReadCmds;
+                if(gf % 100u == 0u)
+                {
+                    BOOST_TEST_REQUIRE(replay.ReadGF(&gf));
+                    BOOST_TEST_REQUIRE(gf == expectedGF);
+                    BOOST_TEST_REQUIRE(replay.ReadRCType() == ReplayCommand::Chat);
+                    replay.ReadChatCommand(player, dest, txt);
+                    BOOST_TEST_REQUIRE(txt == "Chat" + std::to_string(gf));
+                    ++numReadCmds;
+                }
+                expectedGF += 10;
+            }
+            BOOST_TEST(numReadCmds == numCmds);
+            BOOST_TEST(expectedGF == numGFs);
+
+            // Jump to a GF (in the middle of a block)
+            replay.SeekToGF(2345);
+            BOOST_TEST_REQUIRE(replay.ReadGF(&gf));
+            BOOST_TEST(gf == 2350u);
+            const unsigned cmdPos = replay.GetCommandPos();
+            BOOST_TEST_REQUIRE(replay.ReadRCType() == ReplayCommand::Game);
+            replay.ReadGameCommand(player, cmds);
+            BOOST_TEST(cmds.checksum == getChecksum(2350));
+            BOOST_TEST_REQUIRE(replay.ReadGF(&gf));
+            BOOST_TEST(gf == 2360u);
+            // And back to a command
+            replay.SeekToCommand(cmdPos);
+            BOOST_TEST_REQUIRE(replay.ReadGF(&gf));
+            BOOST_TEST(gf == 2350u);
+            BOOST_TEST_REQUIRE(replay.ReadRCType() == ReplayCommand::Game);
+            replay.ReadGameCommand(player, cmds);
+            BOOST_TEST(cmds.checksum == getChecksum(2350));
+            // Past the end
+            replay.SeekToGF(numGFs);
+            BOOST_TEST(!replay.ReadGF(&gf));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ReplayVersion6)
+{
+    MapInfo map;
+    map.type = MapType::OldMap;
+    map.title = "MapTitle";
+    map.filepath = "Map.swd";
+    map.mapData.data = std::vector<char>(42, 0x42);
+    map.mapData.length = 50;
+    std::vector<PlayerInfo> players(2);
+    players[0].ps = players[1].ps = PlayerState::Occupied;
+
+    rttr::test::TmpFolder tmpFolder;
+    const bfs::path replayPath = tmpFolder.get() / "replay.rpl";
+    // Version 6 has no world state hash
+    const auto getChecksum = [](unsigned gf) {
+        return AsyncChecksum(gf * 7919u, gf, gf + 1u, 1000u - gf, gf / 2u, 0u);
+    };
+    constexpr unsigned numGFs = 500;
+    {
+        ReplayV6Writer replay;
+        for(const BasePlayerInfo& player : players)
+            replay.AddPlayer(player);
+        BOOST_TEST_REQUIRE(replay.StartRecording(replayPath, map, numGFs));
+        Game game(GlobalGameSettings(), 0u, players);
+        PlayerGameCommands cmds = GetTestCommands().create(game).result;
+        for(unsigned gf = 0; gf < numGFs; gf += 10)
+        {
+            cmds.checksum = getChecksum(gf);
+            replay.AddGameCommand(gf, gf % 2u, cmds);
+            if(gf % 100u == 0u)
+                replay.AddChatCommand(gf, 1, ChatDestination::All, "Chat" + std::to_string(gf));
+        }
+    }
+
+    Replay replay;
+    BOOST_TEST_REQUIRE(replay.LoadHeader(replayPath, true));
+    BOOST_TEST(replay.GetLastGF() == numGFs);
+    BOOST_TEST(replay.GetNumPlayers() == 2u);
+    MapInfo newMap;
+    BOOST_TEST_REQUIRE(replay.LoadGameData(newMap));
+    BOOST_TEST(!replay.HasBlocks());
+    BOOST_TEST(!replay.HasStateHash());
+    BOOST_TEST((newMap.mapData.data == map.mapData.data));
+
+    // Sequential read
+    unsigned gf, expectedGF = 0;
+    uint8_t player, dest;
+    std::string txt;
+    PlayerGameCommands cmds;
+    while(replay.ReadGF(&gf))
+    {
+        BOOST_TEST_REQUIRE(gf == expectedGF);
+        BOOST_TEST_REQUIRE(replay.ReadRCType() == ReplayCommand::Game);
+        replay.ReadGameCommand(player, cmds);
+        BOOST_TEST_REQUIRE(player == gf % 2u);
+        BOOST_TEST_REQUIRE(cmds.checksum == getChecksum(gf));
+        BOOST_TEST_REQUIRE(cmds.gcs.size() == 2u);
+        if(gf % 100u == 0u)
+        {
+            BOOST_TEST_REQUIRE(replay.ReadGF(&gf));
+            BOOST_TEST_REQUIRE(gf == expectedGF);
+            BOOST_TEST_REQUIRE(replay.ReadRCType() == ReplayCommand::Chat);
+            replay.ReadChatCommand(player, dest, txt);
+            BOOST_TEST_REQUIRE(txt == "Chat" + std::to_string(gf));
+        }
+        expectedGF += 10;
+    }
+    BOOST_TEST(expectedGF == numGFs);
+
+    // Jump to a GF by skipping the previous commands
+    replay.SeekToGF(235);
+    BOOST_TEST_REQUIRE(replay.ReadGF(&gf));
+    BOOST_TEST(gf == 240u);
+    // Position as stored by keyframes
+    const unsigned cmdPos = replay.GetCommandPos();
+    BOOST_TEST_REQUIRE(replay.ReadRCType() == ReplayCommand::Game);
+    replay.ReadGameCommand(player, cmds);
+    BOOST_TEST(cmds.checksum == getChecksum(240));
+    BOOST_TEST_REQUIRE(replay.ReadGF(&gf));
+    BOOST_TEST(gf == 250u);
+    // Restoring a keyframe continues reading at its command
+    replay.SeekToCommand(cmdPos);
+    BOOST_TEST_REQUIRE(replay.ReadGF(&gf));
+    BOOST_TEST(gf == 240u);
+    BOOST_TEST_REQUIRE(replay.ReadRCType() == ReplayCommand::Game);
+    replay.ReadGameCommand(player, cmds);
+    BOOST_TEST(cmds.checksum == getChecksum(240));
+    // Back to the start
+    replay.SeekToGF(0);
+    BOOST_TEST_REQUIRE(replay.ReadGF(&gf));
+    BOOST_TEST(gf == 0u);
+    // Past the end
+    replay.SeekToGF(numGFs);
+    BOOST_TEST(!replay.ReadGF(&gf));
+}
+
+BOOST_FIXTURE_TEST_CASE(ReplayKeyframesSeek, RandWorldFixture)
+{
+    rttr::test::TmpFolder tmpFolder;
+    // Memory limit allows only 1 keyframe. Further ones are dropped or put on disk
+    ReplayKeyframes memKeyframes(10, 1);
+    ReplayKeyframes diskKeyframes(10, 1, tmpFolder.get());
+
+    const unsigned startGF = em.GetCurrentGF();
+    for(ReplayKeyframes* keyframes : {&memKeyframes, &diskKeyframes})
+    {
+        BOOST_TEST(!keyframes->Find(startGF));
+        // First keyframe is always created
+        BOOST_TEST(keyframes->IsKeyframeDue(startGF + 1));
+        keyframes->Add(game, 42, startGF + 5);
+        BOOST_TEST(!keyframes->IsKeyframeDue(startGF));
+        BOOST_TEST(keyframes->GetNumKeyframes() == 1u);
+    }
+    const UsedPRNG startRngState = RANDOM.GetCurrentState();
+    SerializedGameData startSgd;
+    startSgd.MakeSnapshot(game);
+    BOOST_TEST(memKeyframes.GetMemorySize() == startSgd.GetLength());
+
+    for(unsigned i = 0; i < 20; i++)
+    {
+        em.ExecuteNextGF();
+        BOOST_TEST(!memKeyframes.IsKeyframeDue(em.GetCurrentGF()));
+        if(diskKeyframes.IsKeyframeDue(em.GetCurrentGF()))
+        {
+            BOOST_TEST(em.GetCurrentGF() % 10 == 0u);
+            diskKeyframes.Add(game, 1337, em.GetCurrentGF());
+        }
+    }
+    BOOST_TEST(memKeyframes.GetNumKeyframes() == 1u);
+    BOOST_TEST(diskKeyframes.GetNumKeyframes() == 3u);
+    BOOST_TEST(diskKeyframes.GetMemorySize() == startSgd.GetLength());
+
+    const ReplayKeyframes::Keyframe* lastKeyframe = diskKeyframes.Find(em.GetCurrentGF());
+    BOOST_TEST_REQUIRE(lastKeyframe);
+    BOOST_TEST(lastKeyframe->gf % 10 == 0u);
+    BOOST_TEST(lastKeyframe->gf > startGF + 10);
+    BOOST_TEST(lastKeyframe->replayFilePos == 1337u);
+
+    std::vector<PlayerInfo> players;
+    for(unsigned i = 0; i < world.GetNumPlayers(); i++)
+        players.push_back(PlayerInfo(world.GetPlayer(i)));
+    for(ReplayKeyframes* keyframes : {&memKeyframes, &diskKeyframes})
+    {
+        const ReplayKeyframes::Keyframe* keyframe = keyframes->Find(startGF + 9);
+        BOOST_TEST_REQUIRE(keyframe);
+        BOOST_TEST(keyframe->gf == startGF);
+        BOOST_TEST(keyframe->replayFilePos == 42u);
+        BOOST_TEST(keyframe->nextReplayGF == startGF + 5);
+
+        RANDOM.Init(1234);
+        std::shared_ptr<Game> sharedGame(new Game(ggs, keyframe->gf, players));
+        MockLocalGameState localGameState;
+        keyframes->Restore(*keyframe, sharedGame, localGameState);
+        BOOST_TEST(sharedGame->em_->GetCurrentGF() == startGF);
+        BOOST_TEST((RANDOM.GetCurrentState() == startRngState));
+        SerializedGameData loadedSgd;
+        loadedSgd.MakeSnapshot(sharedGame);
+        BOOST_REQUIRE_EQUAL_COLLECTIONS(loadedSgd.GetData(), loadedSgd.GetData() + loadedSgd.GetLength(),
+                                        startSgd.GetData(), startSgd.GetData() + startSgd.GetLength());
+    }
+    // Keyframe from disk
+    std::shared_ptr<Game> sharedGame(new Game(ggs, lastKeyframe->gf, players));
+    MockLocalGameState localGameState;
+    diskKeyframes.Restore(*lastKeyframe, sharedGame, localGameState);
+    BOOST_TEST(sharedGame->em_->GetCurrentGF() == lastKeyframe->gf);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
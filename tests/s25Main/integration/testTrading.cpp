@@ -16,8 +16,10 @@
 // along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
 
 #include "RttrForeachPt.h"
+#include "TradePathCache.h"
 #include "addons/const_addons.h"
 #include "buildings/nobBaseWarehouse.h"
+#include "factories/BuildingFactory.h"
 #include "postSystem/PostBox.h"
 #include "postSystem/PostMsgWithBuilding.h"
 #include "worldFixtures/WorldWithGCExecution.h"
@@ -330,4 +332,72 @@ BOOST_FIXTURE_TEST_CASE(TradeMessages, TradeFixture)
     BOOST_TEST_REQUIRE(msg2->GetText().find(_(WARE_NAMES[GoodType::Boards])) != std::string::npos);
     BOOST_TEST_REQUIRE(msg2->GetText().find(players[1]->name) != std::string::npos);
 }
+
+BOOST_FIXTURE_TEST_CASE(TradePathCacheLookup, TradeFixture)
+{
+    TradePathCache& cache = TradePathCache::inst();
+    const MapPoint flag0 = world.GetNeighbour(players[0]->GetHQPos(), Direction::SouthEast);
+    const MapPoint flag1 = world.GetNeighbour(players[1]->GetHQPos(), Direction::SouthEast);
+    const MapPoint otherPt0 = world.MakeMapPoint(players[0]->GetHQPos() + Position(3, 3));
+    BOOST_TEST(cache.GetNumEntries() == 0u);
+
+    BOOST_TEST(cache.PathExists(world, flag1, flag0, 1));
+    BOOST_TEST(cache.GetStats().misses == 1u);
+    BOOST_TEST(cache.GetStats().hits == 0u);
+    BOOST_TEST(cache.GetNumEntries() == 1u);
+    // Same path again and in reverse by an ally
+    BOOST_TEST(cache.PathExists(world, flag1, flag0, 1));
+    BOOST_TEST(cache.PathExists(world, flag0, flag1, 0));
+    BOOST_TEST(cache.GetStats().misses == 1u);
+    BOOST_TEST(cache.GetStats().hits == 2u);
+    BOOST_TEST(cache.GetNumEntries() == 1u);
+
+    // Only 1 path per player -> Oldest one gets evicted
+    cache.SetMaxEntriesPerPlayer(1);
+    BOOST_TEST(cache.PathExists(world, flag1, otherPt0, 1));
+    BOOST_TEST(cache.GetStats().misses == 2u);
+    BOOST_TEST(cache.GetStats().evictions == 1u);
+    BOOST_TEST(cache.GetNumEntries() == 1u);
+    BOOST_TEST(cache.PathExists(world, flag1, flag0, 1));
+    BOOST_TEST(cache.GetStats().misses == 3u);
+    BOOST_TEST(cache.GetStats().evictions == 2u);
+
+    cache.SetMaxEntriesPerPlayer(TradePathCache::DEFAULT_MAX_ENTRIES_PER_PLAYER);
+    cache.Clear();
+    BOOST_TEST(cache.GetNumEntries() == 0u);
+    BOOST_TEST(cache.GetStats().hits == 0u);
+}
+
+BOOST_FIXTURE_TEST_CASE(TradePathCacheInvalidation, TradeFixture)
+{
+    TradePathCache& cache = TradePathCache::inst();
+    const MapPoint flag0 = world.GetNeighbour(players[0]->GetHQPos(), Direction::SouthEast);
+    const MapPoint flag1 = world.GetNeighbour(players[1]->GetHQPos(), Direction::SouthEast);
+    std::vector<Direction> route;
+    BOOST_TEST_REQUIRE(world.FindTradePath(flag1, flag0, 1, 0xffffffff, false, &route));
+    BOOST_TEST_REQUIRE(route.size() > 2u);
+    BOOST_TEST(cache.PathExists(world, flag1, flag0, 1));
+    BOOST_TEST_REQUIRE(cache.GetNumEntries() == 1u);
+    const TradePathCache::Stats oldStats = cache.GetStats();
+
+    // Territory changes not affecting the route keep it
+    cache.OnOwnersChanged(world, {world.MakeMapPoint(players[2]->GetHQPos() + Position(2, 2))});
+    BOOST_TEST(cache.GetNumEntries() == 1u);
+    BOOST_TEST(cache.GetStats().invalidations == oldStats.invalidations);
+
+    // An enemy building in the middle of the route takes over the territory around it
+    MapPoint midPt = flag1;
+    for(unsigned i = 0; i < route.size() / 2u; i++)
+        midPt = world.GetNeighbour(midPt, route[i]);
+    BuildingFactory::CreateBuilding(world, BuildingType::Headquarters, midPt, 2, Nation::Romans);
+    BOOST_TEST_REQUIRE(world.GetNode(midPt).owner == 2u + 1u);
+    // The stale route got removed by the territory recalculation
+    BOOST_TEST(cache.GetStats().invalidations == oldStats.invalidations + 1u);
+    BOOST_TEST(cache.GetNumEntries() == 0u);
+    // So the next lookup has to search again
+    cache.PathExists(world, flag1, flag0, 1);
+    BOOST_TEST(cache.GetStats().hits == oldStats.hits);
+    BOOST_TEST(cache.GetStats().misses == oldStats.misses + 1u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -20,8 +20,12 @@
 #include "PointOutput.h"
 #include "RttrConfig.h"
 #include "RttrForeachPt.h"
+#include "buildings/noBaseBuilding.h"
+#include "figures/nofScout_Free.h"
 #include "files.h"
+#include "helpers/containerUtils.h"
 #include "lua/GameDataLoader.h"
+#include "notifications/PlayerNodeNote.h"
 #include "ogl/glArchivItem_Map.h"
 #include "worldFixtures/CreateEmptyWorld.h"
 #include "worldFixtures/WorldFixture.h"
@@ -236,4 +240,46 @@ BOOST_FIXTURE_TEST_CASE(CloseHarborSpots, WorldFixture<UninitializedWorldCreator
     }
 }
 
+BOOST_FIXTURE_TEST_CASE(RecalcVisibilitiesAroundPoint, WorldFixture<CreateEmptyWorld, 1, 60, 40>)
+{
+    ggs.exploration = Exploration::FogOfWar;
+    const MapPoint hqPos = world.GetPlayer(0).GetHQPos();
+    const auto* hq = world.GetSpecObj<noBaseBuilding>(hqPos);
+    BOOST_TEST_REQUIRE(hq);
+    // Scout outside the range of the HQ
+    const MapPoint scoutPos = world.MakeMapPoint(hqPos + Position(18, 0));
+    world.AddFigure(scoutPos, new nofScout_Free(scoutPos, 0, nullptr));
+
+    unsigned numPointNotes = 0, numBatchNotes = 0;
+    Subscription pointSub =
+      world.GetNotifications().subscribe<PlayerNodeNote>([&numPointNotes](const PlayerNodeNote&) { ++numPointNotes; });
+    Subscription batchSub = world.GetNotifications().subscribe<PlayerNodesNote>(
+      [&numBatchNotes](const PlayerNodesNote&) { ++numBatchNotes; });
+
+    const MapPoint center = world.MakeMapPoint(hqPos + Position(12, 0));
+    const unsigned radius = 9;
+    const std::vector<MapPoint> pts = world.GetPointsInRadiusWithCenter(center, radius);
+    for(const noBaseBuilding* exception : {static_cast<const noBaseBuilding*>(nullptr), hq})
+    {
+        // Recalculating each point on its own is the reference
+        world.MakeVisibleAroundPoint(center, radius, 0);
+        for(const MapPoint& pt : pts)
+            world.RecalcVisibility(pt, 0, exception);
+        std::vector<Visibility> expectedVisibilities;
+        for(const MapPoint& pt : pts)
+            expectedVisibilities.push_back(world.GetFoWNode(pt, 0).visibility);
+        BOOST_TEST_REQUIRE(helpers::contains(expectedVisibilities, Visibility::Visible));
+        BOOST_TEST_REQUIRE(helpers::contains(expectedVisibilities, Visibility::FogOfWar));
+
+        world.MakeVisibleAroundPoint(center, radius, 0);
+        numPointNotes = numBatchNotes = 0;
+        world.RecalcVisibilitiesAroundPoint(center, radius, 0, exception);
+        for(unsigned i = 0; i < pts.size(); ++i)
+            BOOST_TEST(world.GetFoWNode(pts[i], 0).visibility == expectedVisibilities[i]);
+        // All changes are reported at once
+        BOOST_TEST(numPointNotes == 0u);
+        BOOST_TEST(numBatchNotes == 1u);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
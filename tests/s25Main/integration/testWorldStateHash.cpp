@@ -0,0 +1,101 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "GamePlayer.h"
+#include "PointOutput.h"
+#include "worldFixtures/WorldWithGCExecution.h"
+#include "world/WorldStateHash.h"
+#include "gameTypes/GoodTypes.h"
+#include "gameTypes/JobTypes.h"
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(WorldStateHashSuite)
+
+BOOST_AUTO_TEST_CASE(RegionHashes)
+{
+    WorldStateHash hash;
+    hash.Init(MapExtent(40, 33));
+    BOOST_TEST(hash.GetNumRegions() == Extent(3, 3));
+    BOOST_TEST_REQUIRE(hash.GetRegionHashes().size() == 9u);
+    const unsigned emptyHash = hash.GetHash();
+
+    const MapPoint pt(20, 19);
+    hash.Update(pt, WorldStateHash::Field::Owner, 0, 2);
+    BOOST_TEST(hash.GetHash() != emptyHash);
+    for(unsigned i = 0; i < hash.GetRegionHashes().size(); i++)
+        BOOST_TEST((hash.GetRegionHashes()[i] != 0u) == (i == hash.GetRegionIdx(pt)));
+    // Same value in a different field or at a different point results in a different hash
+    WorldStateHash hash2;
+    hash2.Init(MapExtent(40, 33));
+    hash2.Update(pt, WorldStateHash::Field::Object, 0, 2);
+    BOOST_TEST(hash2.GetHash() != hash.GetHash());
+    hash2.Update(pt, WorldStateHash::Field::Object, 2, 0);
+    hash2.Update(MapPoint(pt.x + 1, pt.y), WorldStateHash::Field::Owner, 0, 2);
+    BOOST_TEST(hash2.GetHash() != hash.GetHash());
+    // Reverting the change gives the original hash
+    hash.Update(pt, WorldStateHash::Field::Owner, 2, 1);
+    hash.Update(pt, WorldStateHash::Field::Owner, 1, 0);
+    BOOST_TEST(hash.GetHash() == emptyHash);
+}
+
+BOOST_FIXTURE_TEST_CASE(UpdatedOnWorldChanges, WorldWithGCExecution2P)
+{
+    const WorldStateHash& stateHash = world.GetStateHash();
+    BOOST_TEST_REQUIRE(stateHash.GetHash() == world.CalcStateHash().GetHash());
+    const std::vector<unsigned> initialRegionHashes = stateHash.GetRegionHashes();
+    const unsigned initialHash = stateHash.GetHash();
+
+    const MapPoint flagPt = hqPos + MapPoint(4, 0);
+    this->SetFlag(flagPt);
+    BOOST_TEST_REQUIRE(stateHash.GetHash() != initialHash);
+    BOOST_TEST_REQUIRE(stateHash.GetHash() == world.CalcStateHash().GetHash());
+    // Only the region containing the flag changed
+    const unsigned flagRegion = stateHash.GetRegionIdx(flagPt);
+    for(unsigned i = 0; i < initialRegionHashes.size(); i++)
+        BOOST_TEST((stateHash.GetRegionHashes()[i] != initialRegionHashes[i]) == (i == flagRegion));
+
+    this->BuildRoad(flagPt, false, std::vector<Direction>(2, Direction::East));
+    BOOST_TEST_REQUIRE(stateHash.GetHash() == world.CalcStateHash().GetHash());
+    this->DestroyFlag(flagPt + MapPoint(2, 0));
+    BOOST_TEST_REQUIRE(stateHash.GetHash() == world.CalcStateHash().GetHash());
+    this->DestroyFlag(flagPt);
+    BOOST_TEST_REQUIRE(stateHash.GetHash() == world.CalcStateHash().GetHash());
+    BOOST_TEST(stateHash.GetHash() == initialHash);
+
+    // Territory changes
+    world.SetOwner(flagPt, 2);
+    BOOST_TEST_REQUIRE(stateHash.GetHash() == world.CalcStateHash().GetHash());
+    world.SetOwner(flagPt, 1);
+    BOOST_TEST(stateHash.GetHash() == initialHash);
+}
+
+BOOST_FIXTURE_TEST_CASE(InventoryHash, WorldWithGCExecution2P)
+{
+    GamePlayer& player = world.GetPlayer(0);
+    const unsigned initialHash = player.GetInventoryHash();
+    player.IncreaseInventoryWare(GoodType::Boards, 2);
+    const unsigned boardsHash = player.GetInventoryHash();
+    BOOST_TEST(boardsHash != initialHash);
+    player.IncreaseInventoryJob(Job::Woodcutter, 2);
+    BOOST_TEST(player.GetInventoryHash() != boardsHash);
+    player.DecreaseInventoryJob(Job::Woodcutter, 2);
+    BOOST_TEST(player.GetInventoryHash() == boardsHash);
+    player.DecreaseInventoryWare(GoodType::Boards, 2);
+    BOOST_TEST(player.GetInventoryHash() == initialHash);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
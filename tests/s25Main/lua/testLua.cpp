@@ -631,7 +631,7 @@ BOOST_AUTO_TEST_CASE(World)
     BOOST_TEST_REQUIRE(obj2->GetGOT() == GO_Type::Envobject);
 
     MapPoint animalPos(20, 12);
-    const std::list<noBase*>& figs = world.GetFigures(animalPos);
+    const FigureList& figs = world.GetFigures(animalPos);
     BOOST_TEST_REQUIRE(figs.empty());
     executeLua(boost::format("world:AddAnimal(%1%, %2%, SPEC_DEER)") % animalPos.x % animalPos.y);
     BOOST_TEST_REQUIRE(figs.size() == 1u);
@@ -755,6 +755,80 @@ BOOST_AUTO_TEST_CASE(WorldEvents)
     BOOST_TEST_REQUIRE(getLog() == (resFmt % 2 % pt3 % "Water" % 5).str());
 }
 
+BOOST_AUTO_TEST_CASE(CallbacksFollowScriptChanges)
+{
+    LuaInterfaceGame& lua = world.GetLua();
+    executeLua("function onGameFrame(gf)\n  rttr:Log('gf: '..gf)\nend");
+    executeLua("assert(type(onGameFrame) == 'function')");
+    lua.EventGameFrame(1);
+    BOOST_TEST_REQUIRE(getLog() == "gf: 1\n");
+    // Callback replacing itself
+    executeLua("function onGameFrame(gf)\n  rttr:Log('old: '..gf)\n"
+               "  onGameFrame = function(gf) rttr:Log('new: '..gf) end\nend");
+    lua.EventGameFrame(2);
+    BOOST_TEST_REQUIRE(getLog() == "old: 2\n");
+    lua.EventGameFrame(3);
+    BOOST_TEST_REQUIRE(getLog() == "new: 3\n");
+    // Removed and not a function
+    executeLua("onGameFrame = nil");
+    executeLua("assert(onGameFrame == nil)");
+    lua.EventGameFrame(4);
+    executeLua("onGameFrame = 42");
+    lua.EventGameFrame(5);
+    BOOST_TEST_REQUIRE(getLog() == "");
+    // Other globals are not affected
+    executeLua("foo = 1\nfoo = foo + 1\nassert(rawget(_G, 'foo') == 2)");
+
+    const LuaCallbackStats& stats = lua.GetCallbackStats(LuaCallback::OnGameFrame);
+    BOOST_TEST(stats.numCalls == 3u);
+    BOOST_TEST(lua.GetCallbackStats(LuaCallback::OnExplored).numCalls == 0u);
+    BOOST_TEST(LuaInterfaceGame::GetCallbackName(LuaCallback::OnGameFrame) == std::string("onGameFrame"));
+}
+
+BOOST_AUTO_TEST_CASE(BatchedEvents)
+{
+    LuaInterfaceGame& lua = world.GetLua();
+    const MapPoint pt1(3, 4), pt2(5, 1), pt3(7, 6);
+    executeLua("function onExplored(player_id, x, y, owner)\n  rttr:Log('single')\nend");
+    executeLua("function onExploredBatch(player_id, points)\n"
+               "  local s = 'explored '..player_id..':'\n"
+               "  for _, pt in ipairs(points) do s = s..' '..pt[1]..','..pt[2]..','..tostring(pt[3]) end\n"
+               "  rttr:Log(s)\nend");
+    executeLua("function onOccupiedBatch(player_id, points)\n"
+               "  local s = 'occupied '..player_id..':'\n"
+               "  for _, pt in ipairs(points) do s = s..' '..pt[1]..','..pt[2] end\n"
+               "  rttr:Log(s)\nend");
+    lua.EventExplored(1, pt1, 0);
+    lua.EventExplored(1, pt2, 3);
+    lua.EventOccupied(0, pt3);
+    lua.EventOccupied(0, pt1);
+    // Nothing delivered before the flush
+    BOOST_TEST_REQUIRE(getLog() == "");
+    lua.EventGameFrame(1);
+    BOOST_TEST_REQUIRE(getLog() == "explored 1: 3,4,nil 5,1,2\noccupied 0: 7,6 3,4\n");
+    // Nothing left
+    lua.FlushBatchedEvents();
+    BOOST_TEST_REQUIRE(getLog() == "");
+    BOOST_TEST(lua.GetCallbackStats(LuaCallback::OnExploredBatch).numCalls == 1u);
+    BOOST_TEST(lua.GetCallbackStats(LuaCallback::OnExplored).numCalls == 0u);
+
+    // Events caused by onGameFrame are delivered at the end of the same GF
+    executeLua("function onGameFrame(gf)\n  rttr:Log('gf '..gf)\nend");
+    lua.EventOccupied(0, pt2);
+    lua.EventGameFrame(2);
+    BOOST_TEST_REQUIRE(getLog() == "gf 2\noccupied 0: 5,1\n");
+    executeLua("onGameFrame = nil");
+
+    // Events collected before the batch callback was removed are passed to the single event callback
+    lua.EventExplored(1, pt3, 1);
+    executeLua("onExploredBatch = nil");
+    lua.FlushBatchedEvents();
+    BOOST_TEST_REQUIRE(getLog() == "single\n");
+    // Removing the batch callback switches back to single events
+    lua.EventExplored(1, pt1, 0);
+    BOOST_TEST_REQUIRE(getLog() == "single\n");
+}
+
 BOOST_AUTO_TEST_CASE(onOccupied)
 {
     executeLua("occupied = {}\n\
@@ -797,10 +871,9 @@ BOOST_AUTO_TEST_CASE(onExplored)
     std::map<int, Points> gamePtsPerPlayer;
     RTTR_FOREACH_PT(MapPoint, world.GetSize())
     {
-        const MapNode& node = world.GetNode(pt);
         for(unsigned i = 0; i < world.GetNumPlayers(); i++)
         {
-            if(node.fow[i].visibility == Visibility::Visible)
+            if(world.GetFoWNode(pt, i).visibility == Visibility::Visible)
                 gamePtsPerPlayer[i].push_back(std::pair<int, int>(pt.x, pt.y));
         }
     }
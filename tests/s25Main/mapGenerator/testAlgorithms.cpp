@@ -65,6 +65,68 @@ BOOST_AUTO_TEST_CASE(UpdateDistances_updates_enqueued_elements_correctly)
     }
 }
 
+BOOST_AUTO_TEST_CASE(UpdateDistances_from_sources_equals_update_from_queue)
+{
+    // Large enough to be processed concurrently
+    MapExtent size(256, 128);
+    NodeMapBase<unsigned> distances;
+    distances.Resize(size, 500u);
+    std::vector<MapPoint> sources{MapPoint(10, 10), MapPoint(200, 3), MapPoint(255, 127)};
+    std::queue<MapPoint> queue;
+    // Only search the left part, the remaining points get the minimum distance of their neighbors + 1
+    RTTR_FOREACH_PT(MapPoint, size)
+    {
+        if(pt.x < 220 && pt.y != 64)
+            distances[pt] = unsigned(-1);
+    }
+    for(const MapPoint& pt : sources)
+    {
+        distances[pt] = 0;
+        queue.push(pt);
+    }
+    NodeMapBase<unsigned> expectedDistances = distances;
+
+    UpdateDistances(expectedDistances, queue);
+    UpdateDistances(distances, sources);
+
+    RTTR_FOREACH_PT(MapPoint, size)
+    {
+        BOOST_TEST_INFO(pt);
+        BOOST_TEST_REQUIRE(distances[pt] == expectedDistances[pt]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Smooth_equals_smoothing_with_neighbors_of_each_point)
+{
+    // Small maps with a radius wrapping around the map included
+    for(const MapExtent size : {MapExtent(16, 8), MapExtent(9, 6), MapExtent(64, 34)})
+    {
+        const unsigned radius = 5;
+        NodeMapBase<int> nodes;
+        nodes.Resize(size);
+        for(unsigned i = 0; i < nodes.GetSize().x * nodes.GetSize().y; i++)
+            nodes[i] = static_cast<int>((i * 7919u) % 101u);
+        NodeMapBase<int> expectedNodes = nodes;
+
+        RTTR_FOREACH_PT(MapPoint, size)
+        {
+            int sum = expectedNodes[pt];
+            const auto neighbors = expectedNodes.GetPointsInRadius(pt, radius);
+            for(const MapPoint& p : neighbors)
+                sum += expectedNodes[p];
+            expectedNodes[pt] = static_cast<int>(round(static_cast<double>(sum) / (neighbors.size() + 1)));
+        }
+
+        Smooth(1, radius, nodes);
+
+        RTTR_FOREACH_PT(MapPoint, size)
+        {
+            BOOST_TEST_INFO(pt);
+            BOOST_TEST_REQUIRE(nodes[pt] == expectedNodes[pt]);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(Smooth_keeps_homogenous_map_unchanged)
 {
     NodeMapBase<int> nodes;
@@ -322,6 +384,26 @@ BOOST_AUTO_TEST_CASE(LimitFor_ignores_map_points_below_minimum_threshold)
     BOOST_TEST(actualNodes == expectedNodes);
 }
 
+BOOST_AUTO_TEST_CASE(LimitFor_handles_small_and_large_value_ranges)
+{
+    MapExtent size(128, 128);
+    NodeMapBase<unsigned> values;
+    values.Resize(size);
+    // Each value covers one column, i.e. 128 nodes
+    RTTR_FOREACH_PT(MapPoint, size)
+    {
+        values[pt] = pt.x;
+    }
+    BOOST_TEST(LimitFor(values, 0.5, 0u) == 63u);
+
+    // Large range
+    RTTR_FOREACH_PT(MapPoint, size)
+    {
+        values[pt] = pt.x * 1000u;
+    }
+    BOOST_TEST(LimitFor(values, 0.5, 0u) == 63000u);
+}
+
 BOOST_AUTO_TEST_CASE(LimitFor_always_chooses_closest_value)
 {
     MapExtent size(8, 8);
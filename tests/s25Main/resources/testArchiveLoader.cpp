@@ -155,6 +155,30 @@ BOOST_FIXTURE_TEST_CASE(Overrides, CreateTestData)
     logAcc.clearLog();
 }
 
+BOOST_FIXTURE_TEST_CASE(LoadAll, CreateTestData)
+{
+    rttr::test::LogAccessor logAcc;
+    ArchiveLoader loader(LOG);
+
+    const std::vector<ResolvedFile> files = {
+      ResolvedFile{mainFile}, ResolvedFile{mainFile, overrideFolder1 / mainFile.filename()},
+      ResolvedFile{mainFile, overrideFolder1 / mainFile.filename(), overrideFolder2 / mainFile.filename()},
+      ResolvedFile{overrideFolder2 / mainFile.filename()}};
+    const auto archives = loader.loadAll(files);
+    BOOST_TEST_REQUIRE(archives.size() == files.size());
+    BOOST_TEST(compareTxts(archives[0], "0|10"));
+    BOOST_TEST(compareTxts(archives[1], "1|10|20"));
+    BOOST_TEST(compareTxts(archives[2], "2|10|20|30"));
+    BOOST_TEST(compareTxts(archives[3], "2|||30"));
+
+    // A missing file makes the whole operation fail
+    BOOST_CHECK_THROW(loader.loadAll({ResolvedFile{mainFile}, ResolvedFile{resourceFolder / fs::path("missing.lst")}}),
+                      LoadError);
+
+    // Avoid log cluttering
+    logAcc.clearLog();
+}
+
 BOOST_AUTO_TEST_CASE(BobOverrides)
 {
     rttr::test::LogAccessor logAcc;
@@ -0,0 +1,78 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "PointOutput.h"
+#include "world/SpatialIndex.h"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace {
+struct Entity
+{
+    MapPoint pos;
+};
+
+std::vector<Entity*> getInRange(const SpatialIndex<Entity>& index, MapPoint pt, unsigned cellRadius)
+{
+    std::vector<Entity*> result;
+    index.GetInRange(pt, cellRadius, result);
+    std::sort(result.begin(), result.end());
+    return result;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(SpatialIndexSuite)
+
+BOOST_AUTO_TEST_CASE(AddRemoveAndQuery)
+{
+    SpatialIndex<Entity> index(10);
+    BOOST_TEST(!index.IsInitialized());
+    // Size is rounded up: 6x4 cells
+    index.Init(MapExtent(55, 40));
+    BOOST_TEST_REQUIRE(index.IsInitialized());
+    BOOST_TEST(index.GetNumCells() == MapExtent(6, 4));
+
+    std::vector<Entity> entities{{MapPoint(0, 0)}, {MapPoint(9, 9)}, {MapPoint(25, 15)}, {MapPoint(54, 39)}};
+    for(Entity& entity : entities)
+        index.Add(&entity, entity.pos);
+
+    // Only the cell itself
+    BOOST_TEST(getInRange(index, MapPoint(5, 5), 0) == (std::vector<Entity*>{&entities[0], &entities[1]}));
+    BOOST_TEST(getInRange(index, MapPoint(20, 10), 0) == (std::vector<Entity*>{&entities[2]}));
+    BOOST_TEST(getInRange(index, MapPoint(30, 0), 0).empty());
+    // Neighbour cells including wrap-around: Cell (0,0) is next to (5,3)
+    const std::vector<Entity*> expected{&entities[0], &entities[1], &entities[3]};
+    BOOST_TEST(getInRange(index, MapPoint(0, 0), 1) == expected);
+    BOOST_TEST(getInRange(index, MapPoint(54, 39), 1) == expected);
+    // Radius bigger than the map returns each entity once
+    std::vector<Entity*> all{&entities[0], &entities[1], &entities[2], &entities[3]};
+    std::sort(all.begin(), all.end());
+    BOOST_TEST(getInRange(index, MapPoint(30, 20), 3) == all);
+    BOOST_TEST(getInRange(index, MapPoint(30, 20), 100) == all);
+
+    index.Remove(&entities[1], entities[1].pos);
+    BOOST_TEST(getInRange(index, MapPoint(5, 5), 0) == (std::vector<Entity*>{&entities[0]}));
+    unsigned numVisited = 0;
+    index.ForEachInRange(MapPoint(30, 20), 100, [&numVisited](Entity*) { ++numVisited; });
+    BOOST_TEST(numVisited == 3u);
+
+    index.Clear();
+    BOOST_TEST(!index.IsInitialized());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,89 @@
+// Copyright (c) 2021 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "StatisticTimeSeries.h"
+#include "helpers/EnumRange.h"
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include <vector>
+
+namespace {
+/// Add numSteps steps where the value of each type is the step number (starting at 1) and the merchandise is 1
+void addSteps(StatisticTimeSeries& series, unsigned numSteps)
+{
+    StatisticTimeSeries::Values values;
+    StatisticTimeSeries::MerchandiseValues merchandise;
+    merchandise.fill(1);
+    for(unsigned i = 0; i < numSteps; i++)
+    {
+        const unsigned step = series.GetNumSteps() + 1;
+        for(const auto type : helpers::enumRange<StatisticType>())
+            values[type] = step;
+        series.AddStep(values, merchandise);
+    }
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(StatisticTimeSeriesSuite)
+
+BOOST_AUTO_TEST_CASE(Downsampling)
+{
+    StatisticTimeSeries series;
+    BOOST_TEST(series.GetNumSteps() == 0u);
+    BOOST_TEST(series.GetDownsampled(StatisticType::Country, 1, 3) == (std::vector<unsigned>{0, 0, 0}));
+
+    addSteps(series, 2);
+    BOOST_TEST(series.GetNumSteps() == 2u);
+    BOOST_TEST(series.GetValue(StatisticType::Military, 1) == 2u);
+    BOOST_TEST(series.GetMerchandise(3, 1) == 1u);
+    // Missing samples are at the front
+    BOOST_TEST(series.GetDownsampled(StatisticType::Country, 1, 3) == (std::vector<unsigned>{0, 1, 2}));
+    // No complete sample yet
+    BOOST_TEST(series.GetDownsampled(StatisticType::Country, 4, 2) == (std::vector<unsigned>{0, 0}));
+
+    addSteps(series, 8);
+    // Only the latest values
+    BOOST_TEST(series.GetDownsampled(StatisticType::Gold, 1, 3) == (std::vector<unsigned>{8, 9, 10}));
+    // Value at the end of each sample, incomplete samples are ignored
+    BOOST_TEST(series.GetDownsampled(StatisticType::Gold, 4, 3) == (std::vector<unsigned>{0, 4, 8}));
+    // Merchandise is summed up
+    BOOST_TEST(series.GetMerchandiseDownsampled(0, 1, 2) == (std::vector<unsigned>{1, 1}));
+    BOOST_TEST(series.GetMerchandiseDownsampled(0, 4, 3) == (std::vector<unsigned>{0, 4, 4}));
+
+    series.Clear();
+    BOOST_TEST(series.GetNumSteps() == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(CSVExport)
+{
+    StatisticTimeSeries series;
+    addSteps(series, 2);
+    std::stringstream s;
+    StatisticTimeSeries::WriteCSVHeader(s, "player,");
+    series.WriteCSV(s, "0,");
+    std::string header, line1, line2, rest;
+    BOOST_TEST_REQUIRE(!!std::getline(s, header));
+    BOOST_TEST_REQUIRE(!!std::getline(s, line1));
+    BOOST_TEST_REQUIRE(!!std::getline(s, line2));
+    BOOST_TEST(!std::getline(s, rest));
+    BOOST_TEST(header.find("player,step,country,buildings,") == 0u);
+    BOOST_TEST(header.find(",merchandise_boats") != std::string::npos);
+    BOOST_TEST(line1 == "0,0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1");
+    BOOST_TEST(line2 == "0,1,2,2,2,2,2,2,2,2,2,1,1,1,1,1,1,1,1,1,1,1,1,1,1");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
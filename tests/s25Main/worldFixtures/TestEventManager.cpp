@@ -22,22 +22,16 @@ unsigned TestEventManager::ExecuteNextEvent(unsigned maxGF)
 {
     if(GetCurrentGF() >= maxGF)
         return 0;
-    if(events.empty())
+    const unsigned nextEventGF = GetNextEventGF();
+    if(numActiveEvents == 0u || nextEventGF > maxGF)
     {
         unsigned numGFs = maxGF - GetCurrentGF();
-        currentGF = maxGF;
+        SkipToGF(maxGF);
         return numGFs;
     }
-    auto itEvents = events.begin();
-    if(itEvents->first > maxGF)
-    {
-        unsigned numGFs = maxGF - GetCurrentGF();
-        currentGF = maxGF;
-        return numGFs;
-    }
-    unsigned numGFs = itEvents->first - GetCurrentGF();
-    currentGF = itEvents->first;
-    ExecuteEvents(itEvents);
+    unsigned numGFs = nextEventGF - GetCurrentGF();
+    SkipToGF(nextEventGF);
+    ExecuteCurrentEvents();
     DestroyCurrentObjects();
     return numGFs;
 }
@@ -45,26 +39,20 @@ unsigned TestEventManager::ExecuteNextEvent(unsigned maxGF)
 std::vector<const GameEvent*> TestEventManager::GetObjEvents(const GameObject& obj) const
 {
     std::vector<const GameEvent*> objEvnts;
-    for(const auto& event : events)
+    for(const GameEvent* ev : GetEvents())
     {
-        for(const GameEvent* ev : event.second)
-        {
-            if(ev->obj == &obj)
-                objEvnts.push_back(ev);
-        }
+        if(ev->obj == &obj)
+            objEvnts.push_back(ev);
     }
     return objEvnts;
 }
 
 bool TestEventManager::IsEventActive(const GameObject& obj, const unsigned id) const
 {
-    for(const auto& event : events)
+    for(const GameEvent* ev : GetEvents())
     {
-        for(const GameEvent* ev : event.second)
-        {
-            if(ev->id == id && ev->obj == &obj)
-                return true;
-        }
+        if(ev->id == id && ev->obj == &obj)
+            return true;
     }
 
     return false;